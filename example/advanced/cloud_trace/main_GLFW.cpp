@@ -114,7 +114,11 @@ void render_loop(AppData& app_data)
 				tile = 0;
 				face++;
 			}
-			else break;
+			else
+			{
+				saver.Finish(app_data);
+				break;
+			}
 		}
 		glfwPollEvents();
 
@@ -131,6 +135,7 @@ void render_loop(AppData& app_data)
 
 		if(glfwGetKey(GLFW_KEY_ESC))
 		{
+			saver.Finish(app_data);
 			glfwCloseWindow();
 			break;
 		}
@@ -363,6 +363,8 @@ void pbuffer_loop(
 		// the next face
 		common.master_ready.Signal(n_threads);
 	}
+	// write the images of the remaining faces
+	saver.Finish(app_data);
 }
 
 void window_loop(
@@ -496,6 +498,8 @@ void window_loop(
 		// the next face
 		common.master_ready.Signal(n_threads);
 	}
+	// write the images of the remaining faces
+	saver.Finish(app_data);
 }
 
 void main_thread(
@@ -4,7 +4,7 @@
  *
  *  @author Matus Chochlik
  *
- *  Copyright 2008-2014 Matus Chochlik. Distributed under the Boost
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
  *  Software License, Version 1.0. (See accompanying file
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
@@ -13,17 +13,56 @@
 
 #include <oglplus/framebuffer.hpp>
 
-#include <string>
-#include <vector>
-#include <fstream>
-
 namespace oglplus {
 namespace cloud_trace {
 
-Saver::Saver(const AppData&)
+static images::FrameFileFormat SaverFileFormat(const AppData& app_data)
+{
+#if OGLPLUS_PNG_FOUND
+	if(app_data.output_suffix == "png")
+	{
+		return images::FrameFileFormat::PNG;
+	}
+#else
+	(void)app_data;
+#endif
+	return images::FrameFileFormat::Raw;
+}
+
+Saver::Saver(const AppData& app_data)
+ : readback(2)
+ , writer(SaverFileFormat(app_data))
+ , face_paths(6)
 {
 }
 
+void Saver::WriteFrames(const AppData& app_data)
+{
+	for(PixelReadbackFrame& frame : frames)
+	{
+		writer.Enqueue(
+			face_paths[frame.tag],
+			frame.width,
+			frame.height,
+			4,
+			std::move(frame.data)
+		);
+	}
+	frames.clear();
+
+	for(const std::string& path : written)
+	{
+		if(app_data.verbosity > 1)
+		{
+			app_data.logstr()
+				<< "Saved "
+				<< path
+				<< std::endl;
+		}
+	}
+	written.clear();
+}
+
 void Saver::SaveFrame(
 	const AppData& app_data,
 	RaytracerTarget& rt_target,
@@ -32,12 +71,6 @@ void Saver::SaveFrame(
 {
 	assert(face < 6);
 
-	gl.Flush();
-
-	std::vector<char> pixels(app_data.render_width * app_data.render_height * 4);
-
-	gl.Finish();
-
 	if(app_data.save_raytrace_data)
 	{
 		rt_target.fbo.Bind(FramebufferTarget::Read);
@@ -47,21 +80,35 @@ void Saver::SaveFrame(
 		dfb.Bind(FramebufferTarget::Read);
 	}
 
-	gl.ReadPixels(
+	std::string& path = face_paths[face];
+	path = app_data.output_prefix;
+	path.append(app_data.output_face_id[face]);
+	path.append(".");
+	path.append(app_data.output_suffix);
+
+	// the pixels are mapped when the GPU is done with the face
+	// and the file is written on the background thread
+	readback.Read(
 		0, 0,
 		app_data.render_width,
 		app_data.render_height,
 		PixelDataFormat::RGBA,
 		PixelDataType::UnsignedByte,
-		pixels.data()
+		face
 	);
-	std::string path = app_data.output_prefix;
-	path.append(app_data.output_face_id[face]);
-	path.append(".");
-	path.append(app_data.output_suffix);
+	gl.Flush();
 
-	std::ofstream output(path.c_str());
-	output.write(pixels.data(), pixels.size());
+	readback.Poll(frames);
+	writer.Poll(written);
+	WriteFrames(app_data);
+}
+
+void Saver::Finish(const AppData& app_data)
+{
+	readback.Flush(frames);
+	WriteFrames(app_data);
+	writer.Wait(written);
+	WriteFrames(app_data);
 }
 
 } // namespace cloud_trace
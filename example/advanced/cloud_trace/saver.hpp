@@ -19,6 +19,11 @@
 
 #include <oglplus/context.hpp>
 #include <oglplus/framebuffer.hpp>
+#include <oglplus/pixel_readback.hpp>
+#include <oglplus/images/frame_writer.hpp>
+
+#include <string>
+#include <vector>
 
 namespace oglplus {
 namespace cloud_trace {
@@ -30,10 +35,18 @@ class Saver
 private:
 	Context gl;
 	DefaultFramebuffer dfb;
+	PixelReadback readback;
+	std::vector<PixelReadbackFrame> frames;
+	images::FrameWriter writer;
+	std::vector<std::string> face_paths, written;
+
+	void WriteFrames(const AppData&);
 public:
 	Saver(const AppData&);
 
 	void SaveFrame(const AppData&, RaytracerTarget&, unsigned);
+
+	void Finish(const AppData&);
 };
 
 } // namespace cloud_trace
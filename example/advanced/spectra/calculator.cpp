@@ -9,35 +9,11 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 #include <oglplus/gl.hpp>
-#include <oglplus/math/constants.hpp>
 
 #include "calculator.hpp"
 
-#include <cmath>
-
-SpectraFourierMatrixGen::SpectraFourierMatrixGen(std::size_t n, std::size_t)
- : inv_n(1.0/n)
- , inv_sqrt_n(1.0/std::sqrt(double(n)), 0.0)
-{ }
-
-std::complex<double> SpectraFourierMatrixGen::operator()(
-	std::size_t i,
-	std::size_t k,
-	std::size_t /*n*/,
-	std::size_t /*m*/
-) const
-{
-	const double twopi = oglplus::math::TwoPi();
-	typedef std::complex<double> C;
-	C x(0.0, -twopi*i*k*inv_n);
-	return exp(x)*inv_sqrt_n;
-}
-
-extern std::shared_ptr<SpectraCalculator>
-SpectraGetDefaultCPUFourierTransf(
-	SpectraSharedObjects&,
-	std::size_t spectrum_size
-);
+#include <cstdlib>
+#include <cstring>
 
 extern std::shared_ptr<SpectraCalculator>
 SpectraGetDefaultGPUFourierTransf(
@@ -52,6 +28,30 @@ SpectraGetDefaultSignalTransform(
 	std::size_t spectrum_size
 )
 {
+	// the SPECTRA_CALCULATOR environment variable can be set to
+	// "gpu", "cpu" (FFT) or "cpu-matrix" to select the calculator.
+	// By default the GPU is tried first, falling back to the CPU FFT
+	const char* calculator = std::getenv("SPECTRA_CALCULATOR");
+	if(calculator)
+	{
+		if(std::strcmp(calculator, "cpu") == 0)
+		{
+			return SpectraGetDefaultCPUFourierTransf(spectrum_size);
+		}
+		if(std::strcmp(calculator, "cpu-matrix") == 0)
+		{
+			return SpectraGetDefaultCPUMatrixFourierTransf(
+				spectrum_size
+			);
+		}
+		if(std::strcmp(calculator, "gpu") == 0)
+		{
+			return SpectraGetDefaultGPUFourierTransf(
+				shared_objects,
+				spectrum_size
+			);
+		}
+	}
 	try
 	{
 		return SpectraGetDefaultGPUFourierTransf(
@@ -61,10 +61,7 @@ SpectraGetDefaultSignalTransform(
 	}
 	catch(...)
 	{
-		return SpectraGetDefaultCPUFourierTransf(
-			shared_objects,
-			spectrum_size
-		);
+		return SpectraGetDefaultCPUFourierTransf(spectrum_size);
 	}
 }
 
@@ -12,8 +12,6 @@
 #ifndef OGLPLUS_EXAMPLE_SPECTRA_CALCULATOR_HPP
 #define OGLPLUS_EXAMPLE_SPECTRA_CALCULATOR_HPP
 
-#include <wx/string.h>
-
 #include <cstdint>
 #include <complex>
 #include <memory>
@@ -56,6 +54,13 @@ SpectraGetDefaultSignalTransform(
 	std::size_t spectrum_size
 );
 
+// The calculators running on the CPU do not need the shared GL objects
+extern std::shared_ptr<SpectraCalculator>
+SpectraGetDefaultCPUFourierTransf(std::size_t spectrum_size);
+
+extern std::shared_ptr<SpectraCalculator>
+SpectraGetDefaultCPUMatrixFourierTransf(std::size_t spectrum_size);
+
 struct SpectraFourierMatrixGen
 {
 	double inv_n;
@@ -9,10 +9,34 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
+#include <oglplus/math/constants.hpp>
+
 #include "calculator.hpp"
+#include "fft.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
+#include <cmath>
+
+// SpectraFourierMatrixGen
+SpectraFourierMatrixGen::SpectraFourierMatrixGen(std::size_t n, std::size_t)
+ : inv_n(1.0/n)
+ , inv_sqrt_n(1.0/std::sqrt(double(n)), 0.0)
+{ }
+
+std::complex<double> SpectraFourierMatrixGen::operator()(
+	std::size_t i,
+	std::size_t k,
+	std::size_t /*n*/,
+	std::size_t /*m*/
+) const
+{
+	const double twopi = oglplus::math::TwoPi();
+	typedef std::complex<double> C;
+	C x(0.0, -twopi*i*k*inv_n);
+	return exp(x)*inv_sqrt_n;
+}
 
 // SpectraNoOpValueTransform
 struct SpectraNoOpValueTransform
@@ -169,7 +193,7 @@ BeginTransform(
 	for(std::size_t row=0; row!=out_size; ++row)
 	{
 		const float* i = input;
-		auto m = mat.begin()+row*out_size;
+		auto m = mat.begin()+row*in_size;
 		ValueType sum = ValueType(0.0);
 		for(std::size_t col=0; col!=in_size; ++col)
 		{
@@ -191,11 +215,193 @@ FinishTransform(
 	assert(tid == 0);
 }
 
-std::shared_ptr<SpectraCalculator>
-SpectraGetDefaultCPUFourierTransf(
-	SpectraSharedObjects&,
-	std::size_t spectrum_size
+// SpectraFFTTransf
+//
+// The inputs of the concurrent transforms are collected and the pending
+// transforms are calculated in parallel when the first one is finished.
+class SpectraFFTTransf
+ : public SpectraCalculator
+{
+private:
+	SpectraFFTSpectrum spectrum;
+	std::string name;
+
+	const unsigned thread_count;
+	const unsigned max_transforms;
+	unsigned current_transform;
+
+	std::vector<float> inputs;
+	std::vector<float> outputs;
+	std::vector<unsigned> pending;
+
+	static unsigned default_thread_count(void);
+
+	void compute_pending(void);
+public:
+	SpectraFFTTransf(
+		std::size_t in_size,
+		std::size_t out_size,
+		const std::string& transf_name,
+		SpectraWindow window = SpectraWindow::Rectangular,
+		unsigned threads = 0
+	);
+
+	std::size_t InputSize(void) const;
+
+	std::size_t OutputSize(void) const;
+
+	const char* Name(void) const;
+
+	unsigned MaxConcurrentTransforms(void) const;
+
+	void BeginBatch(void);
+
+	void FinishBatch(void);
+
+	unsigned BeginTransform(
+		const float* input,
+		std::size_t inbufsize,
+		float* output,
+		std::size_t outbufsize
+	);
+
+	void FinishTransform(
+		unsigned tid,
+		float* output,
+		std::size_t outbufsize
+	);
+};
+
+unsigned SpectraFFTTransf::default_thread_count(void)
+{
+#if !OGLPLUS_NO_THREADS
+	return std::max(std::thread::hardware_concurrency(), 1u);
+#else
+	return 1;
+#endif
+}
+
+SpectraFFTTransf::SpectraFFTTransf(
+	std::size_t in_size,
+	std::size_t out_size,
+	const std::string& transf_name,
+	SpectraWindow window,
+	unsigned threads
+): spectrum(in_size, out_size, window)
+ , name(transf_name)
+ , thread_count(threads?threads:default_thread_count())
+ // a few transforms per thread, but limited because the visualisation
+ // loads a number of rows proportional to the concurrent transforms
+ , max_transforms(std::min(thread_count*4, 32u))
+ , current_transform(0)
+ , inputs(max_transforms*in_size)
+ , outputs(max_transforms*out_size)
+{
+	pending.reserve(max_transforms);
+}
+
+void SpectraFFTTransf::compute_pending(void)
+{
+	const std::size_t in_size = spectrum.InputSize();
+	const std::size_t out_size = spectrum.OutputSize();
+
+	SpectraParallelFor(
+		pending.size(),
+		thread_count,
+		[=](std::size_t begin, std::size_t end)
+		{
+			auto ws = spectrum.MakeWorkspace();
+			for(std::size_t i=begin; i!=end; ++i)
+			{
+				const unsigned slot = pending[i];
+				spectrum.Compute(
+					inputs.data()+slot*in_size,
+					outputs.data()+slot*out_size,
+					ws
+				);
+			}
+		}
+	);
+	pending.clear();
+}
+
+std::size_t SpectraFFTTransf::InputSize(void) const
+{
+	return spectrum.InputSize();
+}
+
+std::size_t SpectraFFTTransf::OutputSize(void) const
+{
+	return spectrum.OutputSize();
+}
+
+const char* SpectraFFTTransf::Name(void) const
+{
+	return name.c_str();
+}
+
+unsigned SpectraFFTTransf::MaxConcurrentTransforms(void) const
+{
+	return max_transforms;
+}
+
+void SpectraFFTTransf::BeginBatch(void)
+{
+}
+
+void SpectraFFTTransf::FinishBatch(void)
+{
+	pending.clear();
+}
+
+unsigned SpectraFFTTransf::BeginTransform(
+	const float* input,
+	std::size_t inbufsize,
+	float* /*output*/,
+	std::size_t /*outbufsize*/
+)
+{
+	const std::size_t in_size = spectrum.InputSize();
+	assert(inbufsize >= in_size);
+	(void)inbufsize;
+
+	if(current_transform >= max_transforms)
+	{
+		current_transform = 0;
+	}
+	const unsigned slot = current_transform++;
+
+	// the slot is reused before its result was picked up
+	if(std::find(pending.begin(), pending.end(), slot) != pending.end())
+	{
+		compute_pending();
+	}
+	std::copy(input, input+in_size, inputs.begin()+slot*in_size);
+	pending.push_back(slot);
+	return slot;
+}
+
+void SpectraFFTTransf::FinishTransform(
+	unsigned tid,
+	float* output,
+	std::size_t outbufsize
 )
+{
+	const std::size_t out_size = spectrum.OutputSize();
+	assert(tid < max_transforms);
+	assert(outbufsize >= out_size);
+	(void)outbufsize;
+
+	if(std::find(pending.begin(), pending.end(), tid) != pending.end())
+	{
+		compute_pending();
+	}
+	auto o = outputs.begin()+tid*out_size;
+	std::copy(o, o+out_size, output);
+}
+
+std::shared_ptr<SpectraCalculator>
+SpectraGetDefaultCPUMatrixFourierTransf(std::size_t spectrum_size)
 {
 	std::size_t frame_size = spectrum_size*2-1;
 	assert(spectrum_size > 2);
@@ -212,3 +418,14 @@ SpectraGetDefaultCPUFourierTransf(
 	);
 }
 
+std::shared_ptr<SpectraCalculator>
+SpectraGetDefaultCPUFourierTransf(std::size_t spectrum_size)
+{
+	std::size_t frame_size = spectrum_size*2-1;
+	assert(spectrum_size > 2);
+	return std::make_shared<SpectraFFTTransf>(
+		frame_size,
+		spectrum_size,
+		"Fast Fourier Transform (CPU)"
+	);
+}
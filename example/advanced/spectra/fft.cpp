@@ -0,0 +1,356 @@
+/*
+ *  .file advanced/spectra/fft.cpp
+ *  .brief Implements the fast Fourier transform used by the CPU calculator
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2012-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <oglplus/math/constants.hpp>
+
+#include "fft.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include <cmath>
+
+// the largest prime factor handled by the generic butterfly,
+// sizes with larger prime factors use the Bluestein algorithm
+static const std::size_t spectra_fft_max_direct_radix = 32;
+
+SpectraFFT::SpectraFFT(std::size_t n)
+ : size(n)
+ , max_radix(1)
+{
+	if(n == 0)
+	{
+		throw std::runtime_error("Invalid FFT size");
+	}
+
+	const double twopi = oglplus::math::TwoPi();
+
+	twiddles.resize(n);
+	for(std::size_t k=0; k!=n; ++k)
+	{
+		twiddles[k] = std::polar(1.0, -twopi*double(k)/double(n));
+	}
+
+	// factorize n, preferring radix 4 then 2 then odd radices
+	std::size_t p = 4, r = n;
+	do
+	{
+		while(r % p)
+		{
+			if(p == 4) p = 2;
+			else if(p == 2) p = 3;
+			else p += 2;
+			if(p*p > r) p = r;
+		}
+		r /= p;
+		factors.push_back(p);
+		factors.push_back(r);
+		max_radix = std::max(max_radix, p);
+	}
+	while(r > 1);
+
+	if(max_radix > spectra_fft_max_direct_radix)
+	{
+		// find a power of two suitable for the cyclic convolution
+		std::size_t m = 1;
+		while(m < 2*n-1) m *= 2;
+		conv_fft.reset(new SpectraFFT(m));
+
+		const double pi = oglplus::math::Pi();
+		chirp.resize(n);
+		for(std::size_t k=0; k!=n; ++k)
+		{
+			// k^2 mod 2n keeps the angles precise for large k
+			std::size_t kk = (k*k) % (2*n);
+			chirp[k] = std::polar(1.0, -pi*double(kk)/double(n));
+		}
+
+		std::vector<Complex> b(m, Complex(0.0));
+		b[0] = std::conj(chirp[0]);
+		for(std::size_t k=1; k!=n; ++k)
+		{
+			b[k] = b[m-k] = std::conj(chirp[k]);
+		}
+		chirp_fft.resize(m);
+		std::vector<Complex> scratch(conv_fft->ScratchSize());
+		conv_fft->Transform(b.data(), chirp_fft.data(), scratch.data());
+	}
+}
+
+std::size_t SpectraFFT::ScratchSize(void) const
+{
+	if(conv_fft)
+	{
+		return 2*conv_fft->Size()+conv_fft->ScratchSize();
+	}
+	return max_radix;
+}
+
+void SpectraFFT::butterfly2(
+	Complex* out,
+	std::size_t fstride,
+	std::size_t m
+) const
+{
+	const Complex* tw = twiddles.data();
+	for(std::size_t k=0; k!=m; ++k)
+	{
+		Complex t = out[m+k]*tw[k*fstride];
+		out[m+k] = out[k]-t;
+		out[k] += t;
+	}
+}
+
+void SpectraFFT::butterfly4(
+	Complex* out,
+	std::size_t fstride,
+	std::size_t m
+) const
+{
+	const Complex* tw = twiddles.data();
+	for(std::size_t k=0; k!=m; ++k)
+	{
+		Complex s0 = out[k+1*m]*tw[1*k*fstride];
+		Complex s1 = out[k+2*m]*tw[2*k*fstride];
+		Complex s2 = out[k+3*m]*tw[3*k*fstride];
+
+		Complex s5 = out[k]-s1;
+		out[k] += s1;
+		Complex s3 = s0+s2;
+		Complex s4 = s0-s2;
+
+		out[k+2*m] = out[k]-s3;
+		out[k] += s3;
+		// s5 -/+ i*s4
+		out[k+1*m] = Complex(s5.real()+s4.imag(), s5.imag()-s4.real());
+		out[k+3*m] = Complex(s5.real()-s4.imag(), s5.imag()+s4.real());
+	}
+}
+
+void SpectraFFT::butterfly(
+	Complex* out,
+	std::size_t fstride,
+	std::size_t m,
+	std::size_t p,
+	Complex* scratch
+) const
+{
+	const Complex* tw = twiddles.data();
+	for(std::size_t u=0; u!=m; ++u)
+	{
+		std::size_t k = u;
+		for(std::size_t q=0; q!=p; ++q)
+		{
+			scratch[q] = out[k];
+			k += m;
+		}
+
+		k = u;
+		for(std::size_t q1=0; q1!=p; ++q1)
+		{
+			std::size_t twidx = 0;
+			Complex sum = scratch[0];
+			for(std::size_t q=1; q!=p; ++q)
+			{
+				twidx += fstride*k;
+				if(twidx >= size) twidx -= size;
+				sum += scratch[q]*tw[twidx];
+			}
+			out[k] = sum;
+			k += m;
+		}
+	}
+}
+
+void SpectraFFT::work(
+	Complex* out,
+	const Complex* in,
+	std::size_t fstride,
+	const std::size_t* f,
+	Complex* scratch
+) const
+{
+	const std::size_t p = f[0];
+	const std::size_t m = f[1];
+	Complex* const out_begin = out;
+	Complex* const out_end = out+p*m;
+
+	if(m == 1)
+	{
+		for(; out!=out_end; ++out)
+		{
+			*out = *in;
+			in += fstride;
+		}
+	}
+	else
+	{
+		// the p interleaved sub-sequences are transformed
+		// into consecutive blocks of m elements
+		for(; out!=out_end; out+=m)
+		{
+			work(out, in, fstride*p, f+2, scratch);
+			in += fstride;
+		}
+	}
+
+	switch(p)
+	{
+		case 2: butterfly2(out_begin, fstride, m); break;
+		case 4: butterfly4(out_begin, fstride, m); break;
+		default: butterfly(out_begin, fstride, m, p, scratch);
+	}
+}
+
+void SpectraFFT::bluestein(
+	const Complex* in,
+	Complex* out,
+	Complex* scratch
+) const
+{
+	const std::size_t m = conv_fft->Size();
+	Complex* a = scratch;
+	Complex* b = scratch+m;
+
+	for(std::size_t k=0; k!=size; ++k)
+	{
+		a[k] = in[k]*chirp[k];
+	}
+	std::fill(a+size, a+m, Complex(0.0));
+
+	conv_fft->Transform(a, b, scratch+2*m);
+	// the inverse transform of the product is calculated
+	// as the conjugate of the forward transform of the conjugate
+	for(std::size_t k=0; k!=m; ++k)
+	{
+		b[k] = std::conj(b[k]*chirp_fft[k]);
+	}
+	conv_fft->Transform(b, a, scratch+2*m);
+
+	const double inv_m = 1.0/double(m);
+	for(std::size_t k=0; k!=size; ++k)
+	{
+		out[k] = std::conj(a[k])*inv_m*chirp[k];
+	}
+}
+
+void SpectraFFT::Transform(
+	const Complex* input,
+	Complex* output,
+	Complex* scratch
+) const
+{
+	assert(input != output);
+	if(conv_fft)
+	{
+		bluestein(input, output, scratch);
+	}
+	else
+	{
+		work(output, input, 1, factors.data(), scratch);
+	}
+}
+
+SpectraFFTSpectrum::SpectraFFTSpectrum(
+	std::size_t in_size,
+	std::size_t out_sz,
+	SpectraWindow window_kind
+): fft(in_size)
+ , out_size(out_sz)
+ , window(in_size, 1.0)
+{
+	if(out_size > in_size)
+	{
+		throw std::runtime_error("Invalid spectrum size");
+	}
+
+	const double twopi = oglplus::math::TwoPi();
+	const double d = (in_size > 1)?double(in_size-1):1.0;
+	for(std::size_t i=0; i!=in_size; ++i)
+	{
+		const double x = twopi*double(i)/d;
+		switch(window_kind)
+		{
+			case SpectraWindow::Rectangular:
+				break;
+			case SpectraWindow::Hann:
+				window[i] = 0.5-0.5*std::cos(x);
+				break;
+			case SpectraWindow::Hamming:
+				window[i] = 0.54-0.46*std::cos(x);
+				break;
+			case SpectraWindow::Blackman:
+				window[i] =
+					0.42-
+					0.50*std::cos(x)+
+					0.08*std::cos(2*x);
+				break;
+		}
+	}
+	// keep the normalization of the matrix transform
+	const double inv_sqrt_n = 1.0/std::sqrt(double(in_size));
+	for(double& w : window)
+	{
+		w *= inv_sqrt_n;
+	}
+}
+
+SpectraFFTSpectrum::Workspace
+SpectraFFTSpectrum::MakeWorkspace(void) const
+{
+	Workspace ws;
+	ws.input.resize(fft.Size());
+	ws.output.resize(fft.Size());
+	ws.scratch.resize(fft.ScratchSize());
+	return ws;
+}
+
+void SpectraFFTSpectrum::Compute(
+	const float* input,
+	float* output,
+	Workspace& ws
+) const
+{
+	const std::size_t n = fft.Size();
+	assert(ws.input.size() == n);
+
+	for(std::size_t i=0; i!=n; ++i)
+	{
+		ws.input[i] = SpectraFFT::Complex(input[i]*window[i], 0.0);
+	}
+	fft.Transform(ws.input.data(), ws.output.data(), ws.scratch.data());
+	for(std::size_t k=0; k!=out_size; ++k)
+	{
+		output[k] = float(std::abs(ws.output[k]));
+	}
+}
+
+void SpectraFFTSpectrum::Compute(
+	const float* input,
+	std::size_t in_stride,
+	std::size_t count,
+	float* output,
+	std::size_t out_stride,
+	unsigned threads
+) const
+{
+	SpectraParallelFor(
+		count,
+		threads,
+		[=](std::size_t begin, std::size_t end)
+		{
+			Workspace ws = MakeWorkspace();
+			for(std::size_t i=begin; i!=end; ++i)
+			{
+				Compute(input+i*in_stride, output+i*out_stride, ws);
+			}
+		}
+	);
+}
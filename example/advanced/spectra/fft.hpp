@@ -0,0 +1,186 @@
+/*
+ *  .file advanced/spectra/fft.hpp
+ *  .brief Declares the fast Fourier transform used by the CPU calculator
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2012-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef OGLPLUS_EXAMPLE_SPECTRA_FFT_HPP
+#define OGLPLUS_EXAMPLE_SPECTRA_FFT_HPP
+
+#include <oglplus/config/compiler.hpp>
+
+#include <complex>
+#include <vector>
+#include <memory>
+#include <exception>
+#include <cstddef>
+
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#endif
+
+// Mixed-radix fast Fourier transform of a fixed size
+//
+// The size is factorized into radix 4, 2, 3, 5, ... butterflies
+// with precomputed twiddle factors. Sizes having a large prime factor
+// are transformed by the Bluestein algorithm using a power-of-two FFT.
+class SpectraFFT
+{
+public:
+	typedef std::complex<double> Complex;
+private:
+	std::size_t size;
+	// pairs of (radix, remaining length)
+	std::vector<std::size_t> factors;
+	// exp(-2*pi*i*k/size)
+	std::vector<Complex> twiddles;
+	std::size_t max_radix;
+
+	// the Bluestein convolution (if used)
+	std::unique_ptr<SpectraFFT> conv_fft;
+	std::vector<Complex> chirp;
+	std::vector<Complex> chirp_fft;
+
+	void butterfly2(Complex* out, std::size_t fstride, std::size_t m) const;
+	void butterfly4(Complex* out, std::size_t fstride, std::size_t m) const;
+	void butterfly(
+		Complex* out,
+		std::size_t fstride,
+		std::size_t m,
+		std::size_t p,
+		Complex* scratch
+	) const;
+
+	void work(
+		Complex* out,
+		const Complex* in,
+		std::size_t fstride,
+		const std::size_t* f,
+		Complex* scratch
+	) const;
+
+	void bluestein(const Complex* in, Complex* out, Complex* scratch) const;
+public:
+	explicit SpectraFFT(std::size_t n);
+
+	std::size_t Size(void) const { return size; }
+
+	// the number of elements of the scratch buffer for Transform
+	std::size_t ScratchSize(void) const;
+
+	// computes the DFT of size elements from input into output
+	// (the input and the output must not overlap)
+	void Transform(
+		const Complex* input,
+		Complex* output,
+		Complex* scratch
+	) const;
+};
+
+enum class SpectraWindow
+{
+	Rectangular,
+	Hann,
+	Hamming,
+	Blackman
+};
+
+// Calculates the normalized magnitude spectra of signal windows
+class SpectraFFTSpectrum
+{
+private:
+	SpectraFFT fft;
+	std::size_t out_size;
+	std::vector<double> window;
+public:
+	// per-thread buffers used by the calculation
+	struct Workspace
+	{
+		std::vector<SpectraFFT::Complex> input, output, scratch;
+	};
+
+	SpectraFFTSpectrum(
+		std::size_t in_size,
+		std::size_t out_size,
+		SpectraWindow window_kind = SpectraWindow::Rectangular
+	);
+
+	std::size_t InputSize(void) const { return fft.Size(); }
+	std::size_t OutputSize(void) const { return out_size; }
+
+	Workspace MakeWorkspace(void) const;
+
+	// calculates the spectrum of a single window
+	void Compute(const float* input, float* output, Workspace& ws) const;
+
+	// calculates the spectra of count windows starting in_stride
+	// samples apart, storing them out_stride values apart
+	void Compute(
+		const float* input,
+		std::size_t in_stride,
+		std::size_t count,
+		float* output,
+		std::size_t out_stride,
+		unsigned threads
+	) const;
+};
+
+// Calls func(begin, end) for ranges splitting [0, count) into (at most)
+// the specified number of parallel threads (0 = hardware concurrency)
+template <typename Func>
+void SpectraParallelFor(std::size_t count, unsigned threads, Func func)
+{
+#if !OGLPLUS_NO_THREADS
+	if(threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+	}
+	if(threads > count)
+	{
+		threads = unsigned(count);
+	}
+	if(threads > 1)
+	{
+		std::vector<std::thread> workers;
+		std::vector<std::exception_ptr> errors(threads);
+		workers.reserve(threads);
+
+		for(unsigned t=0; t!=threads; ++t)
+		{
+			std::size_t begin = (count*t)/threads;
+			std::size_t end = (count*(t+1))/threads;
+			std::exception_ptr& error = errors[t];
+
+			workers.push_back(std::thread(
+				[=, &func, &error](void)
+				{
+					try { func(begin, end); }
+					catch(...)
+					{
+						error = std::current_exception();
+					}
+				}
+			));
+		}
+		for(std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		for(std::exception_ptr& error : errors)
+		{
+			if(error) std::rethrow_exception(error);
+		}
+		return;
+	}
+#else
+	(void)threads;
+#endif
+	func(std::size_t(0), count);
+}
+
+#endif // include guard
@@ -0,0 +1,155 @@
+/**
+ *  @file advanced/spectra/tools/fft_bench.cpp
+ *  @brief Compares the matrix and the FFT spectrum calculators on the CPU
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/math/constants.hpp>
+
+#include "../calculator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+template <typename Func>
+static double measure(Func func, std::size_t windows)
+{
+	typedef std::chrono::steady_clock clock;
+	auto start = clock::now();
+	func();
+	std::chrono::duration<double> t = clock::now() - start;
+	return t.count()*1e6/windows;
+}
+
+// runs the transforms of all windows through the specified calculator
+static void transform(
+	SpectraCalculator& calculator,
+	const std::vector<float>& signal,
+	std::size_t hop,
+	std::size_t windows,
+	std::vector<float>& output
+)
+{
+	const std::size_t in_size = calculator.InputSize();
+	const std::size_t out_size = calculator.OutputSize();
+	const std::size_t max_concurrent = calculator.MaxConcurrentTransforms();
+
+	std::vector<unsigned> tids;
+	tids.reserve(max_concurrent);
+
+	calculator.BeginBatch();
+	std::size_t w = 0;
+	while(w != windows)
+	{
+		// like the visualisation, begin as many concurrent
+		// transforms as possible and then pick up their results
+		const std::size_t first = w;
+		while((w != windows) && (tids.size() != max_concurrent))
+		{
+			tids.push_back(calculator.BeginTransform(
+				signal.data()+w*hop,
+				in_size,
+				output.data()+w*out_size,
+				out_size
+			));
+			++w;
+		}
+		for(std::size_t t=0; t!=tids.size(); ++t)
+		{
+			calculator.FinishTransform(
+				tids[t],
+				output.data()+(first+t)*out_size,
+				out_size
+			);
+		}
+		tids.clear();
+	}
+	calculator.FinishBatch();
+}
+
+static void bench(std::size_t spectrum_size, std::size_t windows)
+{
+	auto matrix = SpectraGetDefaultCPUMatrixFourierTransf(spectrum_size);
+	auto fft = SpectraGetDefaultCPUFourierTransf(spectrum_size);
+
+	const std::size_t frame_size = fft->InputSize();
+	const std::size_t hop = frame_size/4;
+
+	std::vector<float> signal((windows-1)*hop+frame_size);
+	for(std::size_t i=0; i!=signal.size(); ++i)
+	{
+		const double t = double(i)/44100.0;
+		signal[i] = float(
+			0.6*std::sin(440.0*oglplus::math::TwoPi()*t)+
+			0.3*std::sin(1250.0*oglplus::math::TwoPi()*t)+
+			0.1*(double(std::rand())/RAND_MAX-0.5)
+		);
+	}
+
+	std::vector<float> mat_out(windows*spectrum_size);
+	std::vector<float> fft_out(windows*spectrum_size);
+
+	const double mat_us = measure(
+		[&](void) { transform(*matrix, signal, hop, windows, mat_out); },
+		windows
+	);
+	const double fft_us = measure(
+		[&](void) { transform(*fft, signal, hop, windows, fft_out); },
+		windows
+	);
+
+	float max_diff = 0.0f;
+	for(std::size_t i=0; i!=mat_out.size(); ++i)
+	{
+		max_diff = std::max(max_diff, std::abs(mat_out[i]-fft_out[i]));
+	}
+
+	std::cout << "Spectrum size " << spectrum_size
+		<< " (frame " << frame_size << "), "
+		<< windows << " windows" << std::endl;
+	std::cout << "  " << matrix->Name() << ": "
+		<< mat_us << " us/window" << std::endl;
+	std::cout << "  " << fft->Name() << ": "
+		<< fft_us << " us/window"
+		<< " (" << mat_us/fft_us << "x)" << std::endl;
+	std::cout << "  max. difference: " << max_diff << std::endl;
+
+	if(!(max_diff < 1e-3f))
+	{
+		throw std::runtime_error("FFT results differ from the matrix");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		const std::size_t windows = 256;
+		if(argc > 1)
+		{
+			bench(std::size_t(std::atoi(argv[1])), windows);
+		}
+		else
+		{
+			// both directly factorized and Bluestein-transformed sizes
+			bench(256, windows);
+			bench(512, windows);
+			bench(1024, windows);
+			bench(2049, windows);
+		}
+	}
+	catch(std::exception& error)
+	{
+		std::cerr << "Error: " << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -14,8 +14,6 @@
 #include <oglplus/all.hpp>
 #include <oglplus/shapes/cube.hpp>
 
-#include <algorithm>
-
 #include "example.hpp"
 
 namespace oglplus {
@@ -117,33 +115,38 @@ public:
 		// make the matrices
 		{
 			// nr_cubes x 4x4 matrices
-			std::vector<GLfloat> matrix_data(max_cubes*16);
-			auto p = matrix_data.begin(), e = matrix_data.end();
+			std::vector<Mat4f> rotations(max_cubes);
+			std::vector<Mat4f> matrices(max_cubes);
+			std::vector<Mat4f> matrix_data(max_cubes);
 
 			Angle<GLfloat> angle;
 			Angle<GLfloat> astep = Degrees(360.0f/float(max_cubes));
-			while(p != e)
+			for(Mat4f& rotation : rotations)
 			{
 				GLfloat cx = Cos(angle);
 				GLfloat sx = Sin(angle);
-				auto matrix = Transposed(Mat4f(
+				rotation = Mat4f(
 					Vec4f( cx, 0.0, -sx, 0.0),
 					Vec4f(0.0, 1.0, 0.0, 0.0),
 					Vec4f( sx, 0.0,  cx, 0.0),
 					Vec4f(0.0, 0.0, 0.0, 1.0)
-				) * Mat4f(
+				);
+				angle += astep;
+			}
+			// rotate all translated cubes at once
+			MultiplyBatch(
+				rotations.data(),
+				Mat4f(
 					Vec4f(1.0, 0.0, 0.0,12.0),
 					Vec4f(0.0, 1.0, 0.0, 0.0),
 					Vec4f(0.0, 0.0, 1.0, 0.0),
 					Vec4f(0.0, 0.0, 0.0, 1.0)
-				));
-				p = std::copy(
-					Data(matrix),
-					Data(matrix)+Size(matrix),
-					p
-				);
-				angle += astep;
-			}
+				),
+				matrices.data(),
+				max_cubes
+			);
+			// GLSL expects column-major matrices
+			TransposeBatch(matrices.data(), matrix_data.data(), max_cubes);
 
 			ShaderStorageBlock model_block(prog, "ModelBlock");
 			model_block.Binding(0);
@@ -38,9 +38,193 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <new>
 
 #include "example.hpp"
 #include "example_main.hpp"
+#include "example_framedump.hpp"
+#include "example_benchmark.hpp"
+
+namespace oglplus {
+
+static std::atomic<unsigned long> example_allocations(0);
+
+unsigned long example_allocation_count(void)
+{
+	return example_allocations.load(std::memory_order_relaxed);
+}
+
+static void* example_allocate(std::size_t size)
+{
+	example_allocations.fetch_add(1, std::memory_order_relaxed);
+	if(size == 0) size = 1;
+	while(true)
+	{
+		if(void* ptr = std::malloc(size)) return ptr;
+		std::new_handler handler = std::get_new_handler();
+		if(!handler) throw std::bad_alloc();
+		handler();
+	}
+}
+
+static void* example_allocate(std::size_t size, const std::nothrow_t&)
+noexcept
+{
+	try { return example_allocate(size); }
+	catch(...) { return nullptr; }
+}
+
+#if __cpp_aligned_new
+static void* example_allocate(std::size_t size, std::align_val_t al)
+{
+	example_allocations.fetch_add(1, std::memory_order_relaxed);
+	const std::size_t alignment = std::size_t(al);
+	// aligned_alloc requires the size to be a multiple of the alignment
+	size = ((size?size:1)+alignment-1)/alignment*alignment;
+	while(true)
+	{
+		if(void* ptr = std::aligned_alloc(alignment, size)) return ptr;
+		std::new_handler handler = std::get_new_handler();
+		if(!handler) throw std::bad_alloc();
+		handler();
+	}
+}
+
+static void* example_allocate(
+	std::size_t size,
+	std::align_val_t al,
+	const std::nothrow_t&
+) noexcept
+{
+	try { return example_allocate(size, al); }
+	catch(...) { return nullptr; }
+}
+#endif
+
+} // namespace oglplus
+
+// all forms of the global operator new and delete are replaced
+// to count the allocations made by the examples in the benchmark mode
+void* operator new(std::size_t size)
+{
+	return oglplus::example_allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return oglplus::example_allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& nt) noexcept
+{
+	return oglplus::example_allocate(size, nt);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& nt) noexcept
+{
+	return oglplus::example_allocate(size, nt);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+#if __cpp_sized_deallocation
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+#endif
+
+#if __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t al)
+{
+	return oglplus::example_allocate(size, al);
+}
+
+void* operator new[](std::size_t size, std::align_val_t al)
+{
+	return oglplus::example_allocate(size, al);
+}
+
+void* operator new(
+	std::size_t size,
+	std::align_val_t al,
+	const std::nothrow_t& nt
+) noexcept
+{
+	return oglplus::example_allocate(size, al, nt);
+}
+
+void* operator new[](
+	std::size_t size,
+	std::align_val_t al,
+	const std::nothrow_t& nt
+) noexcept
+{
+	return oglplus::example_allocate(size, al, nt);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(
+	void* ptr,
+	std::align_val_t,
+	const std::nothrow_t&
+) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](
+	void* ptr,
+	std::align_val_t,
+	const std::nothrow_t&
+) noexcept
+{
+	std::free(ptr);
+}
+#endif
 
 namespace oglplus {
 
@@ -112,6 +296,9 @@ struct ExampleOptions
 {
 	const char* screenshot_path;
 	const char* framedump_prefix;
+	const char* benchmark_path;
+	std::string example_name;
+	GLuint benchmark_frames;
 	GLuint width;
 	GLuint height;
 	GLint samples;
@@ -256,7 +443,11 @@ void run_framedump_loop(
 	double t = 0.0;
 	double period = 1.0 / 25.0;
 	GLuint frame_no = 0;
-	std::vector<char> pixels(opts.width * opts.height * 4);
+	ExampleFrameDump framedump(
+		opts.framedump_prefix,
+		opts.width,
+		opts.height
+	);
 
 	GLuint border = 32;
 
@@ -320,39 +511,13 @@ void run_framedump_loop(
 		}
 		while(comp < 1.0);
 
-		glFinish();
-		glReadPixels(
-			0, 0,
-			opts.width,
-			opts.height,
-			GL_RGBA,
-			GL_UNSIGNED_BYTE,
-			pixels.data()
-		);
-		glFinish();
+		// the frame is read back without waiting for the GPU
+		// and written into a file on a background thread
+		bool acknowledged = framedump.Frame(frame_no++);
 		surface.SwapBuffers();
-		std::stringstream filename;
-		filename <<
-			opts.framedump_prefix <<
-			std::setfill('0') << std::setw(6) <<
-			frame_no << ".rgba";
-		{
-			std::ofstream file(filename.str());
-			file.write(pixels.data(), pixels.size());
-			file.flush();
-		}
-		std::cout << filename.str() << std::endl;
-		++frame_no;
-
-		txtbuf.resize(filename.str().size()+1);
-		std::cin.getline(txtbuf.data(), txtbuf.size());
-
-		if(std::strncmp(
-			filename.str().c_str(),
-			txtbuf.data(),
-			txtbuf.size()
-		) != 0) break;
+		if(!acknowledged) break;
 	}
+	framedump.Finish();
 }
 
 void make_screenshot(
@@ -401,6 +566,87 @@ void make_screenshot(
 	surface.SwapBuffers();
 }
 
+void run_benchmark(
+	eglplus::Surface& surface,
+	std::unique_ptr<Example>& example,
+	ExampleClock& clock,
+	const ExampleOptions& opts
+)
+{
+	// the examples are animated with a fixed time step
+	// so that every run renders the same frames
+	double s = example->HeatUpTime();
+	double dt = example->FrameTime();
+
+	clock.Update(s);
+
+	glEnable(GL_MULTISAMPLE);
+
+	// heat-up, the frames are not measured
+	for(GLuint f=0, n=example->HeatUpFrames(); f!=n; ++f)
+	{
+		s += dt;
+		clock.Update(s);
+
+		unsigned part_no = 0;
+		double comp = 0.0;
+		do
+		{
+			comp = example->RenderPart(part_no++, clock);
+		}
+		while(comp < 1.0);
+		surface.SwapBuffers();
+	}
+	glFinish();
+
+	ExampleBenchmark benchmark(
+		opts.example_name,
+		opts.width,
+		opts.height,
+		opts.benchmark_frames
+	);
+
+	for(GLuint f=0; f!=opts.benchmark_frames; ++f)
+	{
+		s += dt;
+		clock.Update(s);
+
+		if(!example->Continue(clock)) break;
+
+		benchmark.BeginFrame();
+		unsigned part_no = 0;
+		double comp = 0.0;
+		do
+		{
+			comp = example->RenderPart(part_no++, clock);
+		}
+		while(comp < 1.0);
+		benchmark.FrameRendered();
+		surface.SwapBuffers();
+		glFinish();
+		benchmark.EndFrame();
+	}
+
+	const std::string path(opts.benchmark_path);
+	std::ofstream output(path);
+	if(!output.good())
+	{
+		throw std::runtime_error(
+			"Unable to open benchmark output: "+path
+		);
+	}
+	const char csv_ext[] = ".csv";
+	const std::size_t csv_len = sizeof(csv_ext)-1;
+	if(
+		(path.size() >= csv_len) &&
+		(path.compare(path.size()-csv_len, csv_len, csv_ext) == 0)
+	)
+	{
+		ExampleBenchmark::WriteCSVHeader(output);
+		benchmark.WriteCSV(output);
+	}
+	else benchmark.WriteJSON(output);
+}
 
 void run_example(
 	const eglplus::Display& display,
@@ -565,6 +811,10 @@ void run_example(
 		{
 			run_framedump_loop(surface, example, clock, opts);
 		}
+		else if(opts.benchmark_path)
+		{
+			run_benchmark(surface, example, clock, opts);
+		}
 		else assert(!"Never should get here!");
 
 		example_thread_common_data.done = true;
@@ -611,10 +861,20 @@ int egl_example_main(int argc, char ** argv)
 
 	opts.screenshot_path = nullptr;
 	opts.framedump_prefix = nullptr;
+	opts.benchmark_path = nullptr;
+	opts.benchmark_frames = 100;
 	opts.width = 800;
 	opts.height = 600;
 	opts.samples = 0;
 
+	// the name of the example is the name of its executable
+	opts.example_name = argv[0];
+	std::string::size_type slash = opts.example_name.find_last_of("/\\");
+	if(slash != std::string::npos)
+	{
+		opts.example_name.erase(0, slash+1);
+	}
+
 	int a=1;
 	while(a<argc)
 	{
@@ -630,6 +890,16 @@ int egl_example_main(int argc, char ** argv)
 			opts.framedump_prefix = argv[a+1];
 			parsed = 2;
 		}
+		else if((std::strcmp(argv[a], "--benchmark")) == 0 && (a+1<argc))
+		{
+			opts.benchmark_path = argv[a+1];
+			parsed = 2;
+		}
+		else if((std::strcmp(argv[a], "--frames")) == 0 && (a+1<argc))
+		{
+			opts.benchmark_frames = GLuint(std::atoi(argv[a+1]));
+			parsed = 2;
+		}
 		else if((std::strcmp(argv[a], "--width")) == 0 && (a+1<argc))
 		{
 			opts.width = GLuint(std::atoi(argv[a+1]));
@@ -660,10 +930,10 @@ int egl_example_main(int argc, char ** argv)
 		}
 	}
 
-	if(!(opts.screenshot_path || opts.framedump_prefix))
+	if(!(opts.screenshot_path || opts.framedump_prefix || opts.benchmark_path))
 	{
 		std::cout <<
-			"--screenshot or --framedump option "
+			"--screenshot, --framedump or --benchmark option "
 			"must be specified" <<
 			std::endl;
 		return 1;
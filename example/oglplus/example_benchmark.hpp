@@ -0,0 +1,313 @@
+/**
+ *  @file oglplus/example_benchmark.hpp
+ *  @brief Implements the benchmark mode of the example harnesses
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef OGLPLUS_EXAMPLE_EXAMPLE_BENCHMARK_1509291010_HPP
+#define OGLPLUS_EXAMPLE_EXAMPLE_BENCHMARK_1509291010_HPP
+
+#if OGLPLUS_GL_DISPATCH
+#include <oglplus/dispatch/recorder.hpp>
+#endif
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+
+namespace oglplus {
+
+// Returns the number of allocations made through the global operator new
+// so far. This is implemented by the harness which replaces the operator.
+unsigned long example_allocation_count(void);
+
+// Measures the CPU-side cost of the individual frames of an example
+// and writes the summary in the JSON or in the CSV format.
+// The CPU time of a frame is the time spent issuing its rendering
+// commands, the frame time includes the wait for the GL to finish it.
+// If the wrapped GL functions are called through the dispatch table
+// (OGLPLUS_GL_DISPATCH, enabled by the OGLPLUS_EXAMPLES_GL_DISPATCH
+// CMake option) then the calls are counted too, the times then include
+// the overhead of the counting.
+class ExampleBenchmark
+{
+private:
+	typedef std::chrono::steady_clock _clock;
+
+	struct _frame
+	{
+		double cpu_time;
+		double frame_time;
+		unsigned long allocations;
+		unsigned long gl_calls;
+	};
+
+	struct _summary
+	{
+		double mean, p50, p90, p99, max;
+	};
+
+	std::string _name;
+	GLuint _width, _height;
+	std::vector<_frame> _frames;
+	_clock::time_point _begin, _rendered;
+	unsigned long _alloc_begin;
+	unsigned long _calls_begin;
+#if OGLPLUS_GL_DISPATCH
+	GLCallRecorder _recorder;
+#endif
+
+	static double _seconds(_clock::duration d)
+	{
+		return std::chrono::duration<double>(d).count();
+	}
+
+	unsigned long _gl_call_count(void) const
+	{
+#if OGLPLUS_GL_DISPATCH
+		return _recorder.TotalCount();
+#else
+		return 0;
+#endif
+	}
+
+	template <typename Getter>
+	_summary _summarize(Getter get, double scale) const
+	{
+		_summary result = {0.0, 0.0, 0.0, 0.0, 0.0};
+		if(_frames.empty()) return result;
+
+		std::vector<double> values;
+		values.reserve(_frames.size());
+		for(const _frame& frame : _frames)
+		{
+			values.push_back(double(get(frame))*scale);
+		}
+		std::sort(values.begin(), values.end());
+
+		double sum = 0.0;
+		for(double value : values) sum += value;
+
+		// nearest-rank percentiles
+		auto percentile = [&values](double p) -> double
+		{
+			std::size_t rank = std::size_t(
+				std::ceil(p*double(values.size()))
+			);
+			if(rank > 0) --rank;
+			return values[std::min(rank, values.size()-1)];
+		};
+		result.mean = sum/double(values.size());
+		result.p50 = percentile(0.50);
+		result.p90 = percentile(0.90);
+		result.p99 = percentile(0.99);
+		result.max = values.back();
+		return result;
+	}
+
+	static void _write_json_string(std::ostream& output, const std::string& s)
+	{
+		output << '"';
+		for(char c : s)
+		{
+			if((c == '"') || (c == '\\')) output << '\\';
+			if((unsigned char)c >= 0x20) output << c;
+		}
+		output << '"';
+	}
+
+	static void _write_json(
+		std::ostream& output,
+		const char* name,
+		const _summary& s,
+		bool percentiles
+	)
+	{
+		output << "\t\"" << name << "\": {";
+		output << "\"mean\": " << s.mean;
+		if(percentiles)
+		{
+			output << ", \"p50\": " << s.p50;
+			output << ", \"p90\": " << s.p90;
+			output << ", \"p99\": " << s.p99;
+		}
+		output << ", \"max\": " << s.max << "}";
+	}
+
+	static void _write_csv(
+		std::ostream& output,
+		const _summary& s,
+		bool percentiles
+	)
+	{
+		output << ',' << s.mean;
+		if(percentiles)
+		{
+			output << ',' << s.p50;
+			output << ',' << s.p90;
+			output << ',' << s.p99;
+		}
+		output << ',' << s.max;
+	}
+public:
+	ExampleBenchmark(
+		std::string name,
+		GLuint width,
+		GLuint height,
+		std::size_t frames
+	): _name(name)
+	 , _width(width)
+	 , _height(height)
+	 , _alloc_begin(0)
+	 , _calls_begin(0)
+	{
+		_frames.reserve(frames);
+	}
+
+	// returns true if the GL calls are counted
+	static bool CountsGLCalls(void)
+	{
+		return OGLPLUS_GL_DISPATCH != 0;
+	}
+
+	void BeginFrame(void)
+	{
+		_calls_begin = _gl_call_count();
+		_alloc_begin = example_allocation_count();
+		_begin = _clock::now();
+	}
+
+	// called when the rendering commands of the frame are issued
+	void FrameRendered(void)
+	{
+		_rendered = _clock::now();
+	}
+
+	// called when the GL finished the frame
+	void EndFrame(void)
+	{
+		const _clock::time_point end = _clock::now();
+		_frame frame;
+		frame.cpu_time = _seconds(_rendered-_begin);
+		frame.frame_time = _seconds(end-_begin);
+		frame.allocations = example_allocation_count()-_alloc_begin;
+		frame.gl_calls = _gl_call_count()-_calls_begin;
+		_frames.push_back(frame);
+	}
+
+	void WriteJSON(std::ostream& output) const
+	{
+		const _summary cpu = _summarize(
+			[](const _frame& f) { return f.cpu_time; },
+			1000.0
+		);
+		const _summary frame = _summarize(
+			[](const _frame& f) { return f.frame_time; },
+			1000.0
+		);
+		const _summary allocs = _summarize(
+			[](const _frame& f) { return f.allocations; },
+			1.0
+		);
+		output << "{\n\t\"example\": ";
+		_write_json_string(output, _name);
+		output << ",\n\t\"width\": " << _width;
+		output << ",\n\t\"height\": " << _height;
+		output << ",\n\t\"frames\": " << _frames.size();
+		output << ",\n";
+		_write_json(output, "cpu_ms", cpu, true);
+		output << ",\n";
+		_write_json(output, "frame_ms", frame, true);
+		output << ",\n";
+		_write_json(output, "allocations_per_frame", allocs, false);
+		output << ",\n";
+		if(CountsGLCalls())
+		{
+			const _summary calls = _summarize(
+				[](const _frame& f) { return f.gl_calls; },
+				1.0
+			);
+			_write_json(output, "gl_calls_per_frame", calls, false);
+		}
+		else output << "\t\"gl_calls_per_frame\": null";
+#if OGLPLUS_GL_DISPATCH
+		// the most frequently called functions
+		std::vector<GLCallStats> stats = _recorder.Statistics();
+		std::sort(
+			stats.begin(),
+			stats.end(),
+			[](const GLCallStats& a, const GLCallStats& b)
+			{
+				return a.Count > b.Count;
+			}
+		);
+		if(stats.size() > 16) stats.resize(16);
+
+		const double frames = _frames.empty()?1.0:double(_frames.size());
+		output << ",\n\t\"gl_functions\": [";
+		for(std::size_t i=0, n=stats.size(); i!=n; ++i)
+		{
+			output << (i?",\n\t\t":"\n\t\t");
+			output << "{\"name\": \"gl" << stats[i].Name << "\", ";
+			output << "\"calls_per_frame\": ";
+			output << double(stats[i].Count)/frames << "}";
+		}
+		output << "\n\t]";
+#endif
+		output << "\n}\n";
+	}
+
+	static void WriteCSVHeader(std::ostream& output)
+	{
+		output	<< "example,width,height,frames"
+			<< ",cpu_mean_ms,cpu_p50_ms,cpu_p90_ms,cpu_p99_ms,cpu_max_ms"
+			<< ",frame_mean_ms,frame_p50_ms,frame_p90_ms"
+			<< ",frame_p99_ms,frame_max_ms"
+			<< ",allocations_mean,allocations_max"
+			<< ",gl_calls_mean,gl_calls_max"
+			<< std::endl;
+	}
+
+	void WriteCSV(std::ostream& output) const
+	{
+		output << _name;
+		output << ',' << _width;
+		output << ',' << _height;
+		output << ',' << _frames.size();
+		_write_csv(
+			output,
+			_summarize([](const _frame& f) { return f.cpu_time; }, 1000.0),
+			true
+		);
+		_write_csv(
+			output,
+			_summarize([](const _frame& f) { return f.frame_time; }, 1000.0),
+			true
+		);
+		_write_csv(
+			output,
+			_summarize([](const _frame& f) { return f.allocations; }, 1.0),
+			false
+		);
+		if(CountsGLCalls())
+		{
+			_write_csv(
+				output,
+				_summarize([](const _frame& f) { return f.gl_calls; }, 1.0),
+				false
+			);
+		}
+		else output << ",,";
+		output << std::endl;
+	}
+};
+
+} // namespace oglplus
+
+#endif // include guard
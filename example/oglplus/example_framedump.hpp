@@ -0,0 +1,156 @@
+/**
+ *  @file oglplus/example_framedump.hpp
+ *  @brief Implements the frame dump shared by the example harnesses
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef OGLPLUS_EXAMPLE_EXAMPLE_FRAMEDUMP_1509281430_HPP
+#define OGLPLUS_EXAMPLE_EXAMPLE_FRAMEDUMP_1509281430_HPP
+
+#include <oglplus/pixel_readback.hpp>
+#include <oglplus/images/frame_writer.hpp>
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+namespace oglplus {
+
+// Saves the rendered frames into numbered raw RGBA files.
+// The frames are read back through pixel-pack buffers and written
+// on a background thread so that the rendering does not wait for them.
+// The path of each file is printed when the file is written and
+// the dump continues only while the paths are echoed on the input.
+class ExampleFrameDump
+{
+private:
+	const char* _prefix;
+	GLuint _width, _height;
+#if GL_VERSION_3_2 || GL_ARB_sync
+	PixelReadback _readback;
+	std::vector<PixelReadbackFrame> _frames;
+#endif
+	images::FrameWriter _writer;
+	std::vector<std::string> _written;
+	std::vector<char> _txtbuf;
+	bool _acknowledged;
+
+	std::string _path(std::uint64_t frame_no) const
+	{
+		std::stringstream filename;
+		filename <<
+			_prefix <<
+			std::setfill('0') << std::setw(6) <<
+			frame_no << ".rgba";
+		return filename.str();
+	}
+
+	bool _report(void)
+	{
+		for(const std::string& path : _written)
+		{
+			if(!_acknowledged) break;
+
+			std::cout << path << std::endl;
+
+			_txtbuf.resize(path.size()+1);
+			std::cin.getline(
+				_txtbuf.data(),
+				std::streamsize(_txtbuf.size())
+			);
+
+			_acknowledged = std::strncmp(
+				path.c_str(),
+				_txtbuf.data(),
+				_txtbuf.size()
+			) == 0;
+		}
+		_written.clear();
+		return _acknowledged;
+	}
+
+#if GL_VERSION_3_2 || GL_ARB_sync
+	void _enqueue(void)
+	{
+		for(PixelReadbackFrame& frame : _frames)
+		{
+			_writer.Enqueue(
+				_path(frame.tag),
+				frame.width,
+				frame.height,
+				4,
+				std::move(frame.data)
+			);
+		}
+		_frames.clear();
+	}
+#endif
+public:
+	ExampleFrameDump(const char* prefix, GLuint width, GLuint height)
+	 : _prefix(prefix)
+	 , _width(width)
+	 , _height(height)
+#if GL_VERSION_3_2 || GL_ARB_sync
+	 , _readback(3)
+#endif
+	 , _writer(images::FrameFileFormat::Raw, 8)
+	 , _acknowledged(true)
+	{ }
+
+	// reads the current frame from the back buffer, call before swapping
+	// returns false if the dump should not continue
+	bool Frame(GLuint frame_no)
+	{
+#if GL_VERSION_3_2 || GL_ARB_sync
+		_readback.Read(
+			0, 0,
+			GLsizei(_width),
+			GLsizei(_height),
+			PixelDataFormat::RGBA,
+			PixelDataType::UnsignedByte,
+			frame_no
+		);
+		_readback.Poll(_frames);
+		_enqueue();
+#else
+		std::vector<GLubyte> pixels(_width * _height * 4);
+		glReadPixels(
+			0, 0,
+			GLsizei(_width),
+			GLsizei(_height),
+			GL_RGBA,
+			GL_UNSIGNED_BYTE,
+			pixels.data()
+		);
+		_writer.Enqueue(
+			_path(frame_no),
+			GLsizei(_width),
+			GLsizei(_height),
+			4,
+			std::move(pixels)
+		);
+#endif
+		_writer.Poll(_written);
+		return _report();
+	}
+
+	// writes the remaining frames and reports them if the dump continues
+	void Finish(void)
+	{
+#if GL_VERSION_3_2 || GL_ARB_sync
+		_readback.Flush(_frames);
+		_enqueue();
+#endif
+		_writer.Wait(_written);
+		_report();
+	}
+};
+
+} // namespace oglplus
+
+#endif // include guard
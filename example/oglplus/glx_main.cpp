@@ -44,6 +44,7 @@
 
 #include "example.hpp"
 #include "example_main.hpp"
+#include "example_framedump.hpp"
 
 namespace oglplus {
 
@@ -418,7 +419,11 @@ void run_framedump_loop(
 	double t = 0.0;
 	double period = 1.0 / 25.0;
 	GLuint frame_no = 0;
-	std::vector<char> pixels(opts.width * opts.height * 4);
+	ExampleFrameDump framedump(
+		opts.framedump_prefix,
+		opts.width,
+		opts.height
+	);
 
 	GLuint border = 32;
 	bool done = false;
@@ -485,39 +490,13 @@ void run_framedump_loop(
 		}
 		while(comp < 1.0);
 
-		glFinish();
-		glReadPixels(
-			0, 0,
-			GLsizei(opts.width),
-			GLsizei(opts.height),
-			GL_RGBA,
-			GL_UNSIGNED_BYTE,
-			pixels.data()
-		);
-		glFinish();
+		// the frame is read back without waiting for the GPU
+		// and written into a file on a background thread
+		bool acknowledged = framedump.Frame(frame_no++);
 		ctx.SwapBuffers(win);
-		std::stringstream filename;
-		filename <<
-			opts.framedump_prefix <<
-			std::setfill('0') << std::setw(6) <<
-			frame_no << ".rgba";
-		{
-			std::ofstream file(filename.str());
-			file.write(pixels.data(), std::streamsize(pixels.size()));
-			file.flush();
-		}
-		std::cout << filename.str() << std::endl;
-		++frame_no;
-
-		txtbuf.resize(filename.str().size()+1);
-		std::cin.getline(txtbuf.data(), std::streamsize(txtbuf.size()));
-
-		if(std::strncmp(
-			filename.str().c_str(),
-			txtbuf.data(),
-			txtbuf.size()
-		) != 0) break;
+		if(!acknowledged) break;
 	}
+	framedump.Finish();
 	while(display.NextEvent(event));
 }
 
@@ -0,0 +1,183 @@
+/**
+ *  @example standalone/030_cell_image_bench.cpp
+ *  @brief Compares the reference and the parallel cell image generator
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#include <oglplus/gl.hpp>
+#include <oglplus/images/cell.hpp>
+#include <oglplus/images/random.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace oglplus;
+
+struct NearestPointColor
+{
+	Vec3d operator()(
+		const GLdouble* dists,
+		const Vec3d* colors,
+		GLsizei count
+	) const
+	{
+		double md = 2.0;
+		GLsizei mi = 0;
+		for(GLsizei i=0; i!=count; ++i)
+		{
+			if(md > dists[i])
+			{
+				md = dists[i];
+				mi = i;
+			}
+		}
+		return colors[mi];
+	}
+};
+
+typedef images::CellImageGen<GLubyte, 3> CellGen;
+
+template <typename Func>
+double measure(Func func, unsigned repeat)
+{
+	typedef std::chrono::steady_clock clock;
+	double best = 0.0;
+	for(unsigned r=0; r!=repeat; ++r)
+	{
+		auto start = clock::now();
+		func();
+		std::chrono::duration<double> t = clock::now() - start;
+		if((r == 0) || (best > t.count())) best = t.count();
+	}
+	return best;
+}
+
+bool same(const images::Image& a, const images::Image& b)
+{
+	return	(a.DataSize() == b.DataSize()) &&
+		(std::memcmp(a.RawData(), b.RawData(), a.DataSize()) == 0);
+}
+
+// measures the generators of an image with the specified dimensions
+bool bench(
+	const char* label,
+	const images::Image& input,
+	GLsizei cell_w,
+	GLsizei cell_h,
+	GLsizei cell_d,
+	unsigned threads,
+	unsigned repeat
+)
+{
+	std::cout
+		<< label << ": "
+		<< input.Width()*cell_w << "x"
+		<< input.Height()*cell_h << "x"
+		<< input.Depth()*cell_d
+		<< " texels, threads: " << threads
+		<< std::endl;
+
+	CellGen ref(
+		cell_w, cell_h, cell_d, input,
+		CellGen::EulerDistance(),
+		NearestPointColor()
+	);
+	CellGen par(
+		cell_w, cell_h, cell_d, input,
+		CellGen::EulerDistance(),
+		NearestPointColor(),
+		threads
+	);
+	CellGen one(
+		cell_w, cell_h, cell_d, input,
+		CellGen::EulerDistance(),
+		NearestPointColor(),
+		1
+	);
+
+	double t_ref = measure([&](void)
+	{
+		CellGen(
+			cell_w, cell_h, cell_d, input,
+			CellGen::EulerDistance(),
+			NearestPointColor()
+		);
+	}, repeat);
+	double t_one = measure([&](void)
+	{
+		CellGen(
+			cell_w, cell_h, cell_d, input,
+			CellGen::EulerDistance(),
+			NearestPointColor(),
+			1
+		);
+	}, repeat);
+	double t_par = measure([&](void)
+	{
+		CellGen(
+			cell_w, cell_h, cell_d, input,
+			CellGen::EulerDistance(),
+			NearestPointColor(),
+			threads
+		);
+	}, repeat);
+	double t_fast = measure([&](void)
+	{
+		CellGen(
+			cell_w, cell_h, cell_d, input,
+			CellGen::FastEulerDistance(),
+			NearestPointColor(),
+			threads
+		);
+	}, repeat);
+
+	std::cout << "  reference:             " << t_ref  << " s" << std::endl;
+	std::cout << "  parallel (1 thread):   " << t_one  << " s" << std::endl;
+	std::cout << "  parallel:              " << t_par  << " s" << std::endl;
+	std::cout << "  parallel (fast euler): " << t_fast << " s" << std::endl;
+	std::cout << "  speedup:               " << t_ref/t_par << "x" << std::endl;
+
+	bool ok = same(ref, par) && same(ref, one);
+	std::cout
+		<< "  output "
+		<< (ok?"matches":"DOES NOT match")
+		<< " the reference"
+		<< std::endl;
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	GLsizei in_size = (argc > 1)?std::atoi(argv[1]):32;
+	GLsizei cell_size = (argc > 2)?std::atoi(argv[2]):32;
+	unsigned threads = (argc > 3)?unsigned(std::atoi(argv[3])):0u;
+	GLsizei in_size_3d = (argc > 4)?std::atoi(argv[4]):8;
+	GLsizei cell_size_3d = (argc > 5)?std::atoi(argv[5]):12;
+	const unsigned repeat = 3;
+
+	images::RandomRGBUByte input_2d(in_size, in_size, 1);
+	images::RandomRGBUByte input_3d(in_size_3d, in_size_3d, in_size_3d);
+
+	bool ok_2d = bench(
+		"2D",
+		input_2d,
+		cell_size, cell_size, 1,
+		threads,
+		repeat
+	);
+	bool ok_3d = bench(
+		"3D",
+		input_3d,
+		cell_size_3d, cell_size_3d, cell_size_3d,
+		threads,
+		repeat
+	);
+
+	return (ok_2d && ok_3d)?0:1;
+}
@@ -0,0 +1,228 @@
+/**
+ *  @example standalone/031_math_bench.cpp
+ *  @brief Compares the 4x4 float math kernels with plain scalar code
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#include <oglplus/gl.hpp>
+#include <oglplus/math/matrix.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace oglplus;
+
+template <typename Func>
+double measure(Func func, unsigned repeat)
+{
+	typedef std::chrono::steady_clock clock;
+	double best = 0.0;
+	for(unsigned r=0; r!=repeat; ++r)
+	{
+		auto start = clock::now();
+		func();
+		std::chrono::duration<double> t = clock::now() - start;
+		if((r == 0) || (best > t.count())) best = t.count();
+	}
+	return best;
+}
+
+float random_value(void)
+{
+	return float(std::rand())/RAND_MAX-0.5f;
+}
+
+Mat4f random_matrix(void)
+{
+	float data[16];
+	for(std::size_t i=0; i!=16; ++i)
+		data[i] = random_value();
+	for(std::size_t i=0; i!=4; ++i)
+		data[i*5] += 2.0f;
+	data[12] = data[13] = data[14] = 0.0f;
+	data[15] = 1.0f;
+	return Mat4f(data);
+}
+
+// the scalar reference implementations
+Mat4f scalar_multiply(const Mat4f& a, const Mat4f& b)
+{
+	float t[16];
+	const float* pa = a.Data();
+	const float* pb = b.Data();
+	for(std::size_t i=0; i!=4; ++i)
+	for(std::size_t j=0; j!=4; ++j)
+	{
+		t[i*4+j] =
+			pa[i*4+0]*pb[0*4+j]+
+			pa[i*4+1]*pb[1*4+j]+
+			pa[i*4+2]*pb[2*4+j]+
+			pa[i*4+3]*pb[3*4+j];
+	}
+	return Mat4f(t);
+}
+
+Mat4f scalar_inverse(const Mat4f& a)
+{
+	Mat4f m(a), i;
+	GaussJordan(m, i);
+	return i;
+}
+
+Vec4f scalar_transform(const Mat4f& m, const Vec4f& v)
+{
+	const float* pm = m.Data();
+	return Vec4f(
+		pm[ 0]*v.x()+pm[ 1]*v.y()+pm[ 2]*v.z()+pm[ 3]*v.w(),
+		pm[ 4]*v.x()+pm[ 5]*v.y()+pm[ 6]*v.z()+pm[ 7]*v.w(),
+		pm[ 8]*v.x()+pm[ 9]*v.y()+pm[10]*v.z()+pm[11]*v.w(),
+		pm[12]*v.x()+pm[13]*v.y()+pm[14]*v.z()+pm[15]*v.w()
+	);
+}
+
+Quatf scalar_multiply(const Quatf& p, const Quatf& q)
+{
+	return Quatf(
+		p.At(0)*q.At(0)-p.At(1)*q.At(1)-p.At(2)*q.At(2)-p.At(3)*q.At(3),
+		p.At(0)*q.At(1)+p.At(1)*q.At(0)+p.At(2)*q.At(3)-p.At(3)*q.At(2),
+		p.At(0)*q.At(2)-p.At(1)*q.At(3)+p.At(2)*q.At(0)+p.At(3)*q.At(1),
+		p.At(0)*q.At(3)+p.At(1)*q.At(2)-p.At(2)*q.At(1)+p.At(3)*q.At(0)
+	);
+}
+
+template <typename T>
+float checksum(const std::vector<T>& values)
+{
+	float result = 0.0f;
+	for(const T& value : values)
+		result += value.At(0, 0);
+	return result;
+}
+
+float checksum(const std::vector<Vec4f>& values)
+{
+	float result = 0.0f;
+	for(const Vec4f& value : values)
+		result += value.x();
+	return result;
+}
+
+float checksum(const std::vector<Quatf>& values)
+{
+	float result = 0.0f;
+	for(const Quatf& value : values)
+		result += value.At(0);
+	return result;
+}
+
+void report(const char* name, double t_scalar, double t_kernel)
+{
+	std::cout
+		<< name
+		<< t_scalar << " s / "
+		<< t_kernel << " s ("
+		<< t_scalar/t_kernel << "x)"
+		<< std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count = (argc > 1)?std::size_t(std::atoi(argv[1])):100000;
+	const unsigned repeat = 5;
+
+	std::vector<Mat4f> a(count), b(count), m(count);
+	std::vector<Vec4f> v(count), r(count);
+	std::vector<Quatf> p, q, s(count, Quatf(1, 0, 0, 0));
+	p.reserve(count);
+	q.reserve(count);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		a[i] = random_matrix();
+		b[i] = random_matrix();
+		v[i] = Vec4f(random_value(), random_value(), random_value(), 1);
+		p.push_back(Quatf(1, random_value(), random_value(), random_value()));
+		q.push_back(Quatf(1, random_value(), random_value(), random_value()));
+	}
+
+	std::cout
+		<< "Elements: " << count
+		<< ", SIMD: "
+		<< (OGLPLUS_MATH_SSE?"SSE":OGLPLUS_MATH_NEON?"NEON":"none")
+		<< std::endl;
+	std::cout << "operation:         scalar / kernel (speedup)" << std::endl;
+
+	float sum = 0.0f;
+
+	double t_s = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			m[i] = scalar_multiply(a[i], b[i]);
+	}, repeat);
+	sum += checksum(m);
+	double t_k = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			m[i] = a[i]*b[i];
+	}, repeat);
+	sum += checksum(m);
+	report("matrix multiply:   ", t_s, t_k);
+
+	t_s = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			m[i] = scalar_inverse(a[i]);
+	}, repeat);
+	sum += checksum(m);
+	t_k = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			m[i] = Inverse(a[i]);
+	}, repeat);
+	sum += checksum(m);
+	report("matrix inverse:    ", t_s, t_k);
+
+	t_k = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			m[i] = InverseAffine(a[i]);
+	}, repeat);
+	sum += checksum(m);
+	report("affine inverse:    ", t_s, t_k);
+
+	t_s = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			r[i] = scalar_transform(a[i], v[i]);
+	}, repeat);
+	sum += checksum(r);
+	t_k = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			r[i] = a[i]*v[i];
+	}, repeat);
+	sum += checksum(r);
+	report("vector transform:  ", t_s, t_k);
+
+	t_s = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			s[i] = scalar_multiply(p[i], q[i]);
+	}, repeat);
+	sum += checksum(s);
+	t_k = measure([&](void)
+	{
+		for(std::size_t i=0; i!=count; ++i)
+			s[i] = p[i]*q[i];
+	}, repeat);
+	sum += checksum(s);
+	report("quaternion mult.:  ", t_s, t_k);
+
+	// prevent the optimizer from removing the computations
+	std::cout << "checksum: " << sum << std::endl;
+	return 0;
+}
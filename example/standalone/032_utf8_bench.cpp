@@ -0,0 +1,171 @@
+/**
+ *  @example standalone/032_utf8_bench.cpp
+ *  @brief Measures the throughput of the UTF-8 to code point conversions
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#include <oglplus/gl.hpp>
+#include <oglplus/string/utf8.hpp>
+#include <oglplus/text/unicode.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace oglplus;
+
+template <typename Func>
+double measure(Func func, unsigned repeat)
+{
+	typedef std::chrono::steady_clock clock;
+	double best = 0.0;
+	for(unsigned r=0; r!=repeat; ++r)
+	{
+		auto start = clock::now();
+		func();
+		std::chrono::duration<double> t = clock::now() - start;
+		if((r == 0) || (best > t.count())) best = t.count();
+	}
+	return best;
+}
+
+// the previous decoder: counting pass followed by per-code-point decoding
+void decode_per_code_point(const std::string& str, text::CodePoints& result)
+{
+	const char* s = str.data();
+	std::size_t len = str.size();
+	result.resize(aux::CodePointsRequired(s, len));
+	text::CodePoint* cp = result.data();
+	while(len)
+	{
+		std::size_t cp_len = 0;
+		*cp++ = aux::ConvertUTF8ToCodePoint(s, len, cp_len);
+		s += cp_len;
+		len -= cp_len;
+	}
+}
+
+void run(const char* name, const std::vector<std::string>& strings)
+{
+	const unsigned repeat = 5;
+	std::size_t bytes = 0, max_len = 0;
+	for(const std::string& str : strings)
+	{
+		bytes += str.size();
+		if(max_len < str.size()) max_len = str.size();
+	}
+	std::size_t checksum[4] = {0, 0, 0, 0};
+
+	double t_old = measure([&](void)
+	{
+		text::CodePoints cps;
+		for(const std::string& str : strings)
+		{
+			cps = text::CodePoints();
+			decode_per_code_point(str, cps);
+			checksum[0] += cps.size();
+		}
+	}, repeat);
+
+	double t_new = measure([&](void)
+	{
+		for(const std::string& str : strings)
+		{
+			text::CodePoints cps = text::UTF8ToCodePoints(
+				str.data(),
+				str.size()
+			);
+			checksum[1] += cps.size();
+		}
+	}, repeat);
+
+	double t_reuse = measure([&](void)
+	{
+		text::CodePoints cps;
+		for(const std::string& str : strings)
+		{
+			text::UTF8ToCodePoints(str.data(), str.size(), cps);
+			checksum[2] += cps.size();
+		}
+	}, repeat);
+
+	std::vector<text::CodePoint> buffer(max_len);
+	double t_span = measure([&](void)
+	{
+		for(const std::string& str : strings)
+		{
+			checksum[3] += text::UTF8ToCodePoints(
+				str.data(),
+				str.size(),
+				buffer.data(),
+				buffer.size()
+			);
+		}
+	}, repeat);
+
+	const double mb = double(bytes)/(1024.0*1024.0);
+	std::cout << name << std::endl;
+	std::cout << "  previous decoder:    " << mb/t_old   << " MB/s" << std::endl;
+	std::cout << "  new, fresh vector:   " << mb/t_new   << " MB/s" << std::endl;
+	std::cout << "  new, reused vector:  " << mb/t_reuse << " MB/s" << std::endl;
+	std::cout << "  new, caller buffer:  " << mb/t_span  << " MB/s" << std::endl;
+
+	if(	(checksum[0] != checksum[1]) ||
+		(checksum[0] != checksum[2]) ||
+		(checksum[0] != checksum[3])
+	) std::cout << "  results DO NOT match" << std::endl;
+}
+
+std::vector<std::string> make_strings(
+	const char* const* words,
+	std::size_t word_count,
+	std::size_t count,
+	std::size_t length
+)
+{
+	std::vector<std::string> result(count);
+	for(std::string& str : result)
+	{
+		while(str.size() < length)
+		{
+			str.append(words[std::rand() % word_count]);
+			str.append(" ");
+		}
+	}
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count = (argc > 1)?std::size_t(std::atoi(argv[1])):10000;
+	std::size_t length = (argc > 2)?std::size_t(std::atoi(argv[2])):48;
+
+	const char* ascii[] = {
+		"Score:", "Health", "FPS", "1234", "Ammo", "x", "Level", "07"
+	};
+	const char* latin[] = {
+		"P\xC5\x99\xC3\xAD\x6C\x69\xC5\xA1", "\xC5\xBE\x6C\x75\xC5\xA5ou\xC4\x8Dk\xC3\xBD",
+		"k\xC5\xAF\xC5\x88", "\xC3\xBA\x70\xC4\x9Bl", "Stra\xC3\x9F" "e", "HUD"
+	};
+	const char* cjk[] = {
+		"\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E",
+		"\xE3\x83\x86\xE3\x82\xAD\xE3\x82\xB9\xE3\x83\x88",
+		"\xE4\xB8\xAD\xE6\x96\x87", "\xF0\x9F\x98\x80"
+	};
+
+	std::cout
+		<< "Strings: " << count
+		<< ", length: " << length
+		<< std::endl;
+
+	run("ASCII", make_strings(ascii, sizeof(ascii)/sizeof(ascii[0]), count, length));
+	run("Latin", make_strings(latin, sizeof(latin)/sizeof(latin[0]), count, length));
+	run("CJK", make_strings(cjk, sizeof(cjk)/sizeof(cjk[0]), count, length));
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ *  @example standalone/033_dispatch_bench.cpp
+ *  @brief Measures the CPU-side overhead of the wrappers without a GL context
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#define OGLPLUS_GL_DISPATCH 1
+
+#include <oglplus/gl.hpp>
+#include <oglplus/all.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+#include <oglplus/dispatch/recorder.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace oglplus;
+
+template <typename Func>
+double measure(Func func, unsigned repeat)
+{
+	typedef std::chrono::steady_clock clock;
+	double best = 0.0;
+	for(unsigned r=0; r!=repeat; ++r)
+	{
+		auto start = clock::now();
+		func();
+		std::chrono::duration<double> t = clock::now() - start;
+		if((r == 0) || (best > t.count())) best = t.count();
+	}
+	return best;
+}
+
+struct Scene
+{
+	Context gl;
+	VertexShader vs;
+	FragmentShader fs;
+	Program prog;
+	std::vector<VertexArray> vaos;
+	std::vector<Buffer> bufs;
+	std::vector<GLfloat> data;
+
+	Scene(std::size_t count)
+	 : vaos(count)
+	 , bufs(count)
+	 , data(64, 1.0f)
+	{
+		vs.Source("#version 330\nvoid main(void) { }\n").Compile();
+		fs.Source("#version 330\nvoid main(void) { }\n").Compile();
+		prog.AttachShader(vs).AttachShader(fs).Link().Use();
+
+		for(std::size_t i=0; i!=count; ++i)
+		{
+			vaos[i].Bind();
+			bufs[i].Bind(Buffer::Target::Array);
+			Buffer::Data(Buffer::Target::Array, data);
+		}
+	}
+
+	// draws the objects through the OGLplus wrappers
+	void DrawWrapped(void)
+	{
+		gl.Enable(Capability::DepthTest);
+		gl.Disable(Capability::Blend);
+		prog.Use();
+		for(std::size_t i=0; i!=vaos.size(); ++i)
+		{
+			vaos[i].Bind();
+			bufs[i].Bind(Buffer::Target::Array);
+			Buffer::SubData(Buffer::Target::Array, 0, data);
+			gl.DrawArrays(PrimitiveType::Triangles, 0, 3);
+		}
+	}
+
+	// makes the same calls directly through the dispatch table
+	void DrawDirect(void)
+	{
+		OGLPLUS_GLFUNC(Enable)(GL_DEPTH_TEST);
+		OGLPLUS_GLFUNC(Disable)(GL_BLEND);
+		OGLPLUS_GLFUNC(UseProgram)(GetGLName(prog));
+		const GLsizeiptr size = GLsizeiptr(data.size()*sizeof(GLfloat));
+		for(std::size_t i=0; i!=vaos.size(); ++i)
+		{
+			OGLPLUS_GLFUNC(BindVertexArray)(GetGLName(vaos[i]));
+			OGLPLUS_GLFUNC(BindBuffer)(GL_ARRAY_BUFFER, GetGLName(bufs[i]));
+			OGLPLUS_GLFUNC(BufferSubData)(
+				GL_ARRAY_BUFFER,
+				0, size,
+				data.data()
+			);
+			OGLPLUS_GLFUNC(DrawArrays)(GL_TRIANGLES, 0, 3);
+		}
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	std::size_t count = (argc > 1)?std::size_t(std::atoi(argv[1])):1000;
+	const unsigned frames = 100;
+	const unsigned repeat = 5;
+
+	GLNullBackend null_backend;
+	Scene scene(count);
+
+	double t_direct = measure([&](void)
+	{
+		for(unsigned f=0; f!=frames; ++f) scene.DrawDirect();
+	}, repeat);
+
+	double t_wrapped = measure([&](void)
+	{
+		for(unsigned f=0; f!=frames; ++f) scene.DrawWrapped();
+	}, repeat);
+
+	std::cout
+		<< "Objects: " << count
+		<< ", frames: " << frames
+		<< ", null backend, " << null_backend.NameCount()
+		<< " object names"
+		<< std::endl;
+	std::cout << "  direct calls:   " << t_direct*1e3  << " ms" << std::endl;
+	std::cout << "  wrapped calls:  " << t_wrapped*1e3 << " ms" << std::endl;
+	std::cout << "  overhead/frame: "
+		<< (t_wrapped-t_direct)*1e6/frames << " us"
+		<< std::endl;
+
+	// record the call stream of a single frame
+	GLCallRecorder recorder(8);
+	scene.DrawWrapped();
+
+	std::cout << std::endl << "Calls of one wrapped frame:" << std::endl;
+	recorder.Report(std::cout);
+
+	std::cout << std::endl << "First calls:" << std::endl;
+	for(const GLRecordedCall& call : recorder.Log())
+	{
+		std::cout << "  gl" << call.Name << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ *  @example standalone/034_state_cache_bench.cpp
+ *  @brief Counts the GL calls saved by the StateCache without a GL context
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#define OGLPLUS_GL_DISPATCH 1
+
+#include <oglplus/gl.hpp>
+#include <oglplus/all.hpp>
+#include <oglplus/state_cache.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+#include <oglplus/dispatch/recorder.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace oglplus;
+
+struct Scene
+{
+	Context gl;
+	Program prog;
+	VertexArray vao;
+	std::vector<Buffer> bufs;
+	std::vector<Texture> texs;
+
+	Scene(std::size_t count)
+	 : bufs(count)
+	 , texs(4)
+	{ }
+
+	// renders the objects the way a naive renderer does,
+	// setting the full state for every object
+	void Draw(void)
+	{
+		for(std::size_t i=0; i!=bufs.size(); ++i)
+		{
+			gl.Viewport(800, 600);
+			gl.Enable(Capability::DepthTest);
+			gl.Enable(Capability::CullFace);
+			gl.Disable(Capability::Blend);
+			gl.DepthFunc(CompareFunction::LEqual);
+			gl.DepthMask(true);
+			gl.BlendFunc(BlendFunction::SrcAlpha, BlendFunction::OneMinusSrcAlpha);
+
+			prog.Use();
+			vao.Bind();
+			Texture::Active(0);
+			texs[i%texs.size()].Bind(Texture::Target::_2D);
+			bufs[i].Bind(Buffer::Target::Array);
+			gl.DrawArrays(PrimitiveType::Triangles, 0, 3);
+		}
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	std::size_t count = (argc > 1)?std::size_t(std::atoi(argv[1])):1000;
+
+	GLNullBackend null_backend;
+	Scene scene(count);
+
+	unsigned long uncached_calls = 0;
+	double uncached_time = 0.0;
+	{
+		GLCallRecorder uncached;
+		scene.Draw();
+		uncached_calls = uncached.TotalCount();
+		uncached_time = uncached.TotalTime();
+	}
+
+	StateCache state_cache;
+	// the first frame fills the cache
+	scene.Draw();
+	state_cache.ResetCounters();
+
+	GLCallRecorder cached;
+	scene.Draw();
+
+	std::cout << "Objects: " << count << ", null backend" << std::endl;
+	std::cout << "  without cache: "
+		<< uncached_calls << " GL calls, "
+		<< uncached_time*1e3 << " ms"
+		<< std::endl;
+	std::cout << "  with cache:    "
+		<< cached.TotalCount() << " GL calls, "
+		<< cached.TotalTime()*1e3 << " ms"
+		<< std::endl;
+	std::cout << "  state changes: "
+		<< state_cache.CallCount() << " checked, "
+		<< state_cache.SavedCount() << " saved"
+		<< std::endl;
+
+	std::cout << std::endl << "Calls of one cached frame:" << std::endl;
+	cached.Report(std::cout);
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ *  @example standalone/035_name_pool_bench.cpp
+ *  @brief Counts the GL calls saved by the NamePool without a GL context
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#define OGLPLUS_GL_DISPATCH 1
+
+#include <oglplus/gl.hpp>
+#include <oglplus/all.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+#include <oglplus/dispatch/recorder.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace oglplus;
+
+// creates and destroys short-lived buffers and queries
+static void frame(std::size_t count)
+{
+	std::vector<Buffer> buffers;
+	buffers.reserve(count);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		buffers.push_back(Buffer());
+		Query query;
+	}
+	Array<Buffer> more(count/4);
+}
+
+static void report(
+	const char* label,
+	const GLCallRecorder& recorder,
+	unsigned frames
+)
+{
+	std::cout << "  " << label
+		<< double(recorder.TotalCount())/frames << " GL calls/frame, "
+		<< recorder.TotalTime()*1e6/frames << " us/frame"
+		<< std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::size_t count = (argc > 1)?std::size_t(std::atoi(argv[1])):1000;
+	const unsigned frames = 100;
+
+	GLNullBackend null_backend;
+
+	std::cout << "Objects: " << count << ", null backend" << std::endl;
+	{
+		GLCallRecorder recorder;
+		for(unsigned f=0; f!=frames; ++f) frame(count);
+		report("without pools: ", recorder, frames);
+	}
+
+	NamePool<tag::Buffer> buffer_pool(64, 2*count);
+	NamePool<tag::Query> query_pool(16);
+	{
+		GLCallRecorder recorder;
+		for(unsigned f=0; f!=frames; ++f) frame(count);
+		report("with pools:    ", recorder, frames);
+	}
+
+	std::cout << "  buffer pool:   "
+		<< buffer_pool.HitCount() << " hits, "
+		<< buffer_pool.MissCount() << " misses, "
+		<< buffer_pool.GeneratedCount() << " names generated"
+		<< std::endl;
+	std::cout << "  query pool:    "
+		<< query_pool.HitCount() << " hits, "
+		<< query_pool.MissCount() << " misses, "
+		<< query_pool.GeneratedCount() << " names generated"
+		<< std::endl;
+
+	return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ *  @example standalone/036_blend_file_bench.cpp
+ *  @brief Compares loading .blend files from a stream and memory-mapped
+ *
+ *  Without arguments, it writes a synthetic file with a linked list
+ *  of blocks and measures opening the file and walking the list.
+ *  With the path of a .blend file as the argument, it measures opening
+ *  the file and loading the positions of all its meshes. The average
+ *  time per load in both modes and the speedup of the mapped mode are
+ *  printed. The speedup depends on the optimization level of the build.
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#include <oglplus/gl.hpp>
+#include <oglplus/imports/blend_file.hpp>
+#include <oglplus/shapes/blender_mesh.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace oglplus;
+
+// helper writing a minimal little-endian .blend file with 64-bit pointers
+class BlendWriter
+{
+private:
+	std::string _out;
+
+	template <typename T>
+	void _put(T value)
+	{
+		for(std::size_t i=0; i!=sizeof(T); ++i)
+		{
+			_out.push_back(char((std::uint64_t(value) >> (8*i)) & 0xFF));
+		}
+	}
+
+	void _str(const char* str, bool terminate)
+	{
+		_out.append(str);
+		if(terminate) _out.push_back('\0');
+	}
+
+	void _align(void)
+	{
+		while(_out.size() % 4) _out.push_back('\0');
+	}
+
+	void _block(
+		const char* code,
+		std::uint32_t size,
+		std::uint64_t ptr,
+		std::uint32_t sdna_index
+	)
+	{
+		_str(code, false);
+		_put<std::uint32_t>(size);
+		_put<std::uint64_t>(ptr);
+		_put<std::uint32_t>(sdna_index);
+		_put<std::uint32_t>(1);
+	}
+
+	// the structures:
+	//  struct Node { Node *next; int index; float value[3]; };
+	//  struct Global { void *curscreen; Node *curscene; };
+	std::string _sdna(void)
+	{
+		std::string result;
+		std::swap(result, _out);
+
+		const char* names[] = {
+			"*curscreen", "*curscene", "*next", "index", "value[3]"
+		};
+		_str("SDNA", false);
+		_str("NAME", false);
+		_put<std::uint32_t>(5);
+		for(const char* name : names) _str(name, true);
+		_align();
+
+		const char* types[] = {
+			"char", "int", "float", "void", "Node", "Global"
+		};
+		const std::uint16_t sizes[] = { 1, 4, 4, 0, 24, 16 };
+		_str("TYPE", false);
+		_put<std::uint32_t>(6);
+		for(const char* type : types) _str(type, true);
+		_align();
+		_str("TLEN", false);
+		for(std::uint16_t size : sizes) _put<std::uint16_t>(size);
+		_align();
+
+		const std::uint16_t structs[] = {
+			4, 3,  4, 2,  1, 3,  2, 4,
+			5, 2,  3, 0,  4, 1
+		};
+		_str("STRC", false);
+		_put<std::uint32_t>(2);
+		for(std::uint16_t s : structs) _put<std::uint16_t>(s);
+
+		std::swap(result, _out);
+		return result;
+	}
+public:
+	static std::uint64_t NodePtr(std::size_t i)
+	{
+		return 0x100000+i*0x40;
+	}
+
+	BlendWriter(std::size_t node_count)
+	{
+		_str("BLENDER-v276", false);
+
+		_block("GLOB", 16, 0x1000, 1);
+		_put<std::uint64_t>(0);
+		_put<std::uint64_t>(NodePtr(0));
+
+		for(std::size_t i=0; i!=node_count; ++i)
+		{
+			_block("DATA", 24, NodePtr(i), 0);
+			_put<std::uint64_t>((i+1<node_count)?NodePtr(i+1):0);
+			_put<std::uint32_t>(std::uint32_t(i));
+			for(unsigned c=0; c!=3; ++c) _put<std::uint32_t>(0);
+		}
+
+		std::string sdna = _sdna();
+		_block("DNA1", std::uint32_t(sdna.size()), 0, 0);
+		_out.append(sdna);
+		_block("ENDB", 0, 0, 0);
+	}
+
+	void Save(const char* path) const
+	{
+		std::ofstream output(path, std::ios::out | std::ios::binary);
+		output.write(_out.data(), std::streamsize(_out.size()));
+		if(!output.good())
+		{
+			throw std::runtime_error("Failed to write blend file");
+		}
+	}
+};
+
+// walks the linked list of nodes in the synthetic file
+static std::size_t walk_nodes(imports::BlendFile& blend_file)
+{
+	std::size_t result = 0;
+	auto glob_block = blend_file.StructuredGlobalBlock();
+	imports::BlendFilePointer node_ptr = glob_block.curscene;
+	while(node_ptr)
+	{
+		auto node = blend_file[node_ptr];
+		result += std::size_t(node.Field<int>("index").Get());
+		node_ptr = node.Field<void*>("next").Get();
+	}
+	return result;
+}
+
+// loads all meshes in a real .blend file
+static std::size_t load_meshes(imports::BlendFile& blend_file)
+{
+	shapes::BlenderMesh mesh(blend_file);
+	std::vector<GLfloat> positions;
+	return mesh.Positions(positions);
+}
+
+template <typename Func>
+static double measure(
+	Func func,
+	const char* path,
+	bool mapped,
+	unsigned n,
+	std::size_t& result
+)
+{
+	typedef std::chrono::steady_clock clock;
+	auto start = clock::now();
+	for(unsigned i=0; i!=n; ++i)
+	{
+		if(mapped)
+		{
+			imports::BlendFile blend_file(path);
+			result = func(blend_file);
+		}
+		else
+		{
+			std::ifstream input(path, std::ios::in | std::ios::binary);
+			imports::BlendFile blend_file(input);
+			result = func(blend_file);
+		}
+	}
+	std::chrono::duration<double> t = clock::now() - start;
+	return t.count()*1e3/n;
+}
+
+template <typename Func>
+static void compare(Func func, const char* path, unsigned n)
+{
+	std::size_t stream_result = 0, mapped_result = 0;
+	const double stream_ms = measure(func, path, false, n, stream_result);
+	const double mapped_ms = measure(func, path, true, n, mapped_result);
+
+	std::cout << "  stream: " << stream_ms << " ms/load"
+		<< " (result " << stream_result << ")" << std::endl;
+	std::cout << "  mapped: " << mapped_ms << " ms/load"
+		<< " (result " << mapped_result << ")" << std::endl;
+	std::cout << "  speedup: " << stream_ms/mapped_ms << "x" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		if(argc > 1)
+		{
+			std::cout << "Loading the meshes from " << argv[1] << std::endl;
+			compare(load_meshes, argv[1], 10);
+		}
+		else
+		{
+			const std::size_t nodes = 20000;
+			const char* path = "036_blend_file_bench.blend";
+			BlendWriter(nodes).Save(path);
+
+			std::cout << "Walking " << nodes << " blocks" << std::endl;
+			compare(walk_nodes, path, 5);
+			std::remove(path);
+		}
+	}
+	catch(std::exception& error)
+	{
+		std::cerr << "Error: " << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
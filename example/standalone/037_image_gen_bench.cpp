@@ -0,0 +1,117 @@
+/**
+ *  @example standalone/037_image_gen_bench.cpp
+ *  @brief Measures the tile-parallel procedural image generators
+ *
+ *  Copyright 2008-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+#include <oglplus/gl.hpp>
+#include <oglplus/images/tiled.hpp>
+#include <oglplus/images/newton.hpp>
+#include <oglplus/images/metaballs.hpp>
+#include <oglplus/images/sphere_bmap.hpp>
+#include <oglplus/images/brushed_metal.hpp>
+#include <oglplus/images/random.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace oglplus;
+
+bool same(const images::Image& a, const images::Image& b)
+{
+	return	(a.DataSize() == b.DataSize()) &&
+		(std::memcmp(a.RawData(), b.RawData(), a.DataSize()) == 0);
+}
+
+// generates the image with a single thread and with the specified
+// number of threads and checks that the results are the same
+template <typename Func>
+bool measure(const char* name, unsigned threads, Func func)
+{
+	typedef std::chrono::steady_clock clock;
+
+	images::ImageTileExecutor::DefaultThreads(1);
+	auto start = clock::now();
+	images::Image single = func();
+	std::chrono::duration<double> t_one = clock::now() - start;
+
+	images::ImageTileExecutor::DefaultThreads(threads);
+	start = clock::now();
+	images::Image parallel = func();
+	std::chrono::duration<double> t_par = clock::now() - start;
+
+	bool ok = same(single, parallel);
+	std::cout
+		<< name
+		<< t_one.count() << " s (1 thread), "
+		<< t_par.count() << " s (" << threads << " threads), "
+		<< "speedup: " << t_one.count()/t_par.count() << "x"
+		<< (ok?"":" (NOT reproducible)")
+		<< std::endl;
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	GLsizei size = (argc > 1)?std::atoi(argv[1]):4096;
+	unsigned threads = (argc > 2)?unsigned(std::atoi(argv[2])):0u;
+	if(threads == 0)
+	{
+		threads = std::max(std::thread::hardware_concurrency(), 2u);
+	}
+
+	std::cout
+		<< "Output: " << size << "x" << size
+		<< " texels, threads: " << threads
+		<< std::endl;
+
+	const GLfloat stars[] = {
+		0.2f, 0.3f, 0.10f, 5.0f, 0.3f,
+		0.7f, 0.7f, 0.15f, 7.0f, 0.6f,
+		0.4f, 0.8f, 0.05f, 4.0f, 0.5f
+	};
+
+	bool ok = true;
+	ok &= measure("newton fractal:   ", threads, [&](void)
+	{
+		return images::NewtonFractal(
+			size, size,
+			Vec3f(0.2f, 0.1f, 0.4f),
+			Vec3f(0.8f, 0.8f, 0.9f),
+			Vec2f(-1.0f, -1.0f),
+			Vec2f( 1.0f,  1.0f),
+			images::NewtonFractal::X4Minus1(),
+			images::NewtonFractal::DefaultMixer()
+		);
+	});
+	ok &= measure("metastars:        ", threads, [&](void)
+	{
+		return images::Metastars(size, size, stars, 15);
+	});
+	ok &= measure("sphere bump map:  ", threads, [&](void)
+	{
+		return images::SphereBumpMap(size, size, 4, 4);
+	});
+	ok &= measure("brushed metal:    ", threads, [&](void)
+	{
+		return images::BrushedMetalUByte(
+			size, size,
+			GLuint(size)*40,
+			-32, 32, 16, 32,
+			1234
+		);
+	});
+	ok &= measure("random RGB:       ", threads, [&](void)
+	{
+		return images::RandomRGBUByte(size, size, 1, 1234);
+	});
+
+	return ok?0:1;
+}
@@ -0,0 +1,383 @@
+/**
+ *  @file oglplus/dispatch/null_backend.ipp
+ *  @brief Implementation of the GLNullBackend
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <cassert>
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+GLNullBackend*& GLNullBackend::_current(void)
+{
+	static GLNullBackend* current = nullptr;
+	return current;
+}
+
+OGLPLUS_LIB_FUNC
+GLNullBackend& GLNullBackend::_self(void)
+{
+	assert(_current());
+	return *_current();
+}
+
+OGLPLUS_LIB_FUNC
+GLenum GLNullBackend::_binding_query(GLenum target)
+{
+	switch(target)
+	{
+		case GL_ARRAY_BUFFER:
+			return GL_ARRAY_BUFFER_BINDING;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+		case GL_PIXEL_PACK_BUFFER:
+			return GL_PIXEL_PACK_BUFFER_BINDING;
+		case GL_PIXEL_UNPACK_BUFFER:
+			return GL_PIXEL_UNPACK_BUFFER_BINDING;
+		case GL_TRANSFORM_FEEDBACK_BUFFER:
+			return GL_TRANSFORM_FEEDBACK_BUFFER_BINDING;
+#if GL_VERSION_3_1 || GL_ARB_uniform_buffer_object
+		case GL_UNIFORM_BUFFER:
+			return GL_UNIFORM_BUFFER_BINDING;
+#endif
+#if GL_VERSION_3_1 || GL_ARB_copy_buffer
+		case GL_COPY_READ_BUFFER:
+			return GL_COPY_READ_BUFFER_BINDING;
+		case GL_COPY_WRITE_BUFFER:
+			return GL_COPY_WRITE_BUFFER_BINDING;
+#endif
+#if GL_VERSION_4_0 || GL_ARB_draw_indirect
+		case GL_DRAW_INDIRECT_BUFFER:
+			return GL_DRAW_INDIRECT_BUFFER_BINDING;
+#endif
+#if GL_VERSION_4_3 || GL_ARB_shader_storage_buffer_object
+		case GL_SHADER_STORAGE_BUFFER:
+			return GL_SHADER_STORAGE_BUFFER_BINDING;
+#endif
+		case GL_TEXTURE_1D:
+			return GL_TEXTURE_BINDING_1D;
+		case GL_TEXTURE_2D:
+			return GL_TEXTURE_BINDING_2D;
+		case GL_TEXTURE_3D:
+			return GL_TEXTURE_BINDING_3D;
+		case GL_TEXTURE_CUBE_MAP:
+			return GL_TEXTURE_BINDING_CUBE_MAP;
+		case GL_TEXTURE_2D_ARRAY:
+			return GL_TEXTURE_BINDING_2D_ARRAY;
+		case GL_FRAMEBUFFER:
+		case GL_DRAW_FRAMEBUFFER:
+			return GL_DRAW_FRAMEBUFFER_BINDING;
+		case GL_READ_FRAMEBUFFER:
+			return GL_READ_FRAMEBUFFER_BINDING;
+		case GL_RENDERBUFFER:
+			return GL_RENDERBUFFER_BINDING;
+		default:;
+	}
+	return GL_NONE;
+}
+
+OGLPLUS_LIB_FUNC
+void GLNullBackend::_set_binding(GLenum target, GLuint name)
+{
+	GLenum query = _binding_query(target);
+	if(query != GL_NONE)
+	{
+		_integers[query] = GLint(name);
+		if(target == GL_FRAMEBUFFER)
+		{
+			_integers[GL_READ_FRAMEBUFFER_BINDING] = GLint(name);
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void* GLNullBackend::_scratch_memory(GLsizeiptr size)
+{
+	if(_scratch.size() < std::size_t(size))
+	{
+		_scratch.resize(std::size_t(size));
+	}
+	return _scratch.empty()?nullptr:_scratch.data();
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_gen_names(GLsizei n, GLuint* names)
+{
+	GLNullBackend& self = _self();
+	for(GLsizei i=0; i<n; ++i)
+	{
+		names[i] = self._next_name++;
+	}
+}
+
+OGLPLUS_LIB_FUNC
+GLuint GLAPIENTRY GLNullBackend::_create_shader(GLenum)
+{
+	return _self()._next_name++;
+}
+
+OGLPLUS_LIB_FUNC
+GLuint GLAPIENTRY GLNullBackend::_create_program(void)
+{
+	return _self()._next_name++;
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_bind(GLenum target, GLuint name)
+{
+	_self()._set_binding(target, name);
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_bind_vertex_array(GLuint name)
+{
+	_self()._integers[GL_VERTEX_ARRAY_BINDING] = GLint(name);
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_use_program(GLuint name)
+{
+	_self()._integers[GL_CURRENT_PROGRAM] = GLint(name);
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_enable(GLenum cap)
+{
+	_self()._capabilities[cap] = true;
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_disable(GLenum cap)
+{
+	_self()._capabilities[cap] = false;
+}
+
+OGLPLUS_LIB_FUNC
+GLboolean GLAPIENTRY GLNullBackend::_is_enabled(GLenum cap)
+{
+	const GLNullBackend& self = _self();
+	auto pos = self._capabilities.find(cap);
+	if(pos == self._capabilities.end())
+	{
+		// dithering is the only capability enabled initially
+		return (cap == GL_DITHER)?GL_TRUE:GL_FALSE;
+	}
+	return pos->second?GL_TRUE:GL_FALSE;
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_get_integer(GLenum pname, GLint* data)
+{
+	const GLNullBackend& self = _self();
+	auto pos = self._integers.find(pname);
+	*data = (pos != self._integers.end())?pos->second:0;
+}
+
+OGLPLUS_LIB_FUNC
+const GLubyte* GLAPIENTRY GLNullBackend::_get_string(GLenum name)
+{
+	const char* result = "";
+	switch(name)
+	{
+		case GL_VENDOR: result = "OGLplus"; break;
+		case GL_RENDERER: result = "Null backend"; break;
+		case GL_VERSION: result = "4.5.0"; break;
+		case GL_SHADING_LANGUAGE_VERSION: result = "4.50"; break;
+		default:;
+	}
+	return reinterpret_cast<const GLubyte*>(result);
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_get_object_iv(
+	GLuint,
+	GLenum pname,
+	GLint* params
+)
+{
+	switch(pname)
+	{
+		case GL_COMPILE_STATUS:
+		case GL_LINK_STATUS:
+		case GL_VALIDATE_STATUS:
+			*params = GL_TRUE;
+			break;
+		default: *params = 0;
+	}
+}
+
+OGLPLUS_LIB_FUNC
+GLint GLAPIENTRY GLNullBackend::_get_location(GLuint, const GLchar*)
+{
+	return _self()._next_location++;
+}
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY GLNullBackend::_buffer_data(
+	GLenum,
+	GLsizeiptr size,
+	const void*,
+	GLenum
+)
+{
+	// make sure that mapping of the whole buffer works
+	_self()._scratch_memory(size);
+}
+
+OGLPLUS_LIB_FUNC
+void* GLAPIENTRY GLNullBackend::_map_buffer(GLenum, GLenum)
+{
+	return _self()._scratch_memory(1);
+}
+
+OGLPLUS_LIB_FUNC
+void* GLAPIENTRY GLNullBackend::_map_buffer_range(
+	GLenum,
+	GLintptr,
+	GLsizeiptr length,
+	GLbitfield
+)
+{
+	return _self()._scratch_memory(length);
+}
+
+OGLPLUS_LIB_FUNC
+GLboolean GLAPIENTRY GLNullBackend::_unmap_buffer(GLenum)
+{
+	return GL_TRUE;
+}
+
+OGLPLUS_LIB_FUNC
+GLenum GLAPIENTRY GLNullBackend::_check_framebuffer_status(GLenum)
+{
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+#if GL_VERSION_3_2 || GL_ARB_sync
+OGLPLUS_LIB_FUNC
+GLsync GLAPIENTRY GLNullBackend::_fence_sync(GLenum, GLbitfield)
+{
+	// the fake fences are never dereferenced
+	return reinterpret_cast<GLsync>(std::size_t(_self()._next_name++));
+}
+
+OGLPLUS_LIB_FUNC
+GLenum GLAPIENTRY GLNullBackend::_client_wait_sync(GLsync, GLbitfield, GLuint64)
+{
+	return GL_ALREADY_SIGNALED;
+}
+#endif
+
+OGLPLUS_LIB_FUNC
+void GLNullBackend::_install(bool install)
+{
+#define OGLPLUS_NULL_BACKEND_OVERRIDE(FUNCNAME, FUNC) \
+	OGLPLUS_GLFUNC_OVERRIDE(FUNCNAME, install?&FUNC:nullptr)
+
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenBuffers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenTextures, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenQueries, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenFramebuffers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenRenderbuffers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenVertexArrays, _gen_names);
+#if GL_VERSION_3_3 || GL_ARB_sampler_objects
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenSamplers, _gen_names);
+#endif
+#if GL_VERSION_4_0 || GL_ARB_transform_feedback2
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenTransformFeedbacks, _gen_names);
+#endif
+#if GL_VERSION_4_1 || GL_ARB_separate_shader_objects
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GenProgramPipelines, _gen_names);
+#endif
+#if GL_VERSION_4_5 || GL_ARB_direct_state_access
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateBuffers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateFramebuffers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateRenderbuffers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateVertexArrays, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateSamplers, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateTransformFeedbacks, _gen_names);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateProgramPipelines, _gen_names);
+#endif
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateShader, _create_shader);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(CreateProgram, _create_program);
+
+	OGLPLUS_NULL_BACKEND_OVERRIDE(BindBuffer, _bind);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(BindTexture, _bind);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(BindFramebuffer, _bind);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(BindRenderbuffer, _bind);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(BindVertexArray, _bind_vertex_array);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(UseProgram, _use_program);
+
+	OGLPLUS_NULL_BACKEND_OVERRIDE(Enable, _enable);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(Disable, _disable);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(IsEnabled, _is_enabled);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GetIntegerv, _get_integer);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GetString, _get_string);
+
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GetShaderiv, _get_object_iv);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GetProgramiv, _get_object_iv);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GetUniformLocation, _get_location);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(GetAttribLocation, _get_location);
+
+	OGLPLUS_NULL_BACKEND_OVERRIDE(BufferData, _buffer_data);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(MapBuffer, _map_buffer);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(MapBufferRange, _map_buffer_range);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(UnmapBuffer, _unmap_buffer);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(
+		CheckFramebufferStatus,
+		_check_framebuffer_status
+	);
+#if GL_VERSION_3_2 || GL_ARB_sync
+	OGLPLUS_NULL_BACKEND_OVERRIDE(FenceSync, _fence_sync);
+	OGLPLUS_NULL_BACKEND_OVERRIDE(ClientWaitSync, _client_wait_sync);
+#endif
+
+#undef OGLPLUS_NULL_BACKEND_OVERRIDE
+}
+
+OGLPLUS_LIB_FUNC
+GLNullBackend::GLNullBackend(void)
+ : _prev_backend(SetGLDispatchBackend(GLDispatchBackend::Null))
+ , _next_name(1)
+ , _next_location(0)
+{
+	assert(!_current());
+	_current() = this;
+
+	_integers[GL_MAJOR_VERSION] = 4;
+	_integers[GL_MINOR_VERSION] = 5;
+	_integers[GL_MAX_TEXTURE_SIZE] = 16384;
+	_integers[GL_MAX_3D_TEXTURE_SIZE] = 2048;
+	_integers[GL_MAX_ARRAY_TEXTURE_LAYERS] = 2048;
+	_integers[GL_MAX_VERTEX_ATTRIBS] = 16;
+	_integers[GL_MAX_DRAW_BUFFERS] = 8;
+	_integers[GL_MAX_COLOR_ATTACHMENTS] = 8;
+	_integers[GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS] = 96;
+	_integers[GL_MAX_TEXTURE_IMAGE_UNITS] = 16;
+#if GL_VERSION_3_1 || GL_ARB_uniform_buffer_object
+	_integers[GL_MAX_UNIFORM_BUFFER_BINDINGS] = 36;
+	_integers[GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT] = 256;
+#endif
+#if GL_VERSION_4_1 || GL_ARB_viewport_array
+	_integers[GL_MAX_VIEWPORTS] = 16;
+#endif
+
+	_install(true);
+}
+
+OGLPLUS_LIB_FUNC
+GLNullBackend::~GLNullBackend(void)
+{
+	_install(false);
+	SetGLDispatchBackend(_prev_backend);
+	_current() = nullptr;
+}
+
+} // namespace oglplus
+
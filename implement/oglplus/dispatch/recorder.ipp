@@ -0,0 +1,144 @@
+/**
+ *  @file oglplus/dispatch/recorder.ipp
+ *  @brief Implementation of the GLCallRecorder
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <algorithm>
+#include <ostream>
+#include <iomanip>
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+GLCallRecorder::GLCallRecorder(std::size_t log_limit)
+{
+	aux::GLDispatchTable& table = aux::GLDispatchTable::Current();
+	table.ResetStatistics();
+	table.StartRecording(log_limit);
+}
+
+OGLPLUS_LIB_FUNC
+GLCallRecorder::~GLCallRecorder(void)
+{
+	aux::GLDispatchTable::Current().StopRecording();
+}
+
+OGLPLUS_LIB_FUNC
+void GLCallRecorder::Reset(void)
+{
+	aux::GLDispatchTable::Current().ResetStatistics();
+}
+
+OGLPLUS_LIB_FUNC
+unsigned long GLCallRecorder::TotalCount(void) const
+{
+	unsigned long result = 0;
+	const aux::GLDispatchSlot* slot =
+		aux::GLDispatchTable::Current().Slots();
+	while(slot)
+	{
+		result += slot->call_count;
+		slot = slot->next;
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+double GLCallRecorder::TotalTime(void) const
+{
+	double result = 0.0;
+	const aux::GLDispatchSlot* slot =
+		aux::GLDispatchTable::Current().Slots();
+	while(slot)
+	{
+		result += slot->call_time;
+		slot = slot->next;
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+std::vector<GLCallStats> GLCallRecorder::Statistics(void) const
+{
+	std::vector<GLCallStats> result;
+	const aux::GLDispatchSlot* slot =
+		aux::GLDispatchTable::Current().Slots();
+	while(slot)
+	{
+		if(slot->call_count > 0)
+		{
+			GLCallStats stats = {
+				slot->name,
+				slot->call_count,
+				slot->call_time
+			};
+			result.push_back(stats);
+		}
+		slot = slot->next;
+	}
+	std::sort(
+		result.begin(),
+		result.end(),
+		[](const GLCallStats& a, const GLCallStats& b) -> bool
+		{
+			return a.Time > b.Time;
+		}
+	);
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+std::vector<GLRecordedCall> GLCallRecorder::Log(void) const
+{
+	const std::vector<aux::GLDispatchCall>& log =
+		aux::GLDispatchTable::Current().Log();
+
+	std::vector<GLRecordedCall> result;
+	result.reserve(log.size());
+	for(const aux::GLDispatchCall& call : log)
+	{
+		GLRecordedCall recorded = { call.slot->name, call.time };
+		result.push_back(recorded);
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+void GLCallRecorder::Report(std::ostream& output) const
+{
+	const std::vector<GLCallStats> stats = Statistics();
+	const double total_time = TotalTime();
+
+	output	<< std::setw(32) << std::left << "function"
+		<< std::setw(12) << std::right << "calls"
+		<< std::setw(14) << "time [us]"
+		<< std::setw(12) << "per call"
+		<< std::setw(8) << "%"
+		<< std::endl;
+
+	for(const GLCallStats& entry : stats)
+	{
+		output	<< "gl" << std::setw(30) << std::left << entry.Name
+			<< std::setw(12) << std::right << entry.Count
+			<< std::setw(14) << std::fixed << std::setprecision(1)
+			<< entry.Time*1e6
+			<< std::setw(12) << std::setprecision(3)
+			<< entry.Time*1e6/double(entry.Count)
+			<< std::setw(8) << std::setprecision(1)
+			<< (total_time > 0.0?100.0*entry.Time/total_time:0.0)
+			<< std::endl;
+	}
+	output	<< "total: " << TotalCount() << " calls, "
+		<< std::fixed << std::setprecision(1)
+		<< total_time*1e6 << " us"
+		<< std::endl;
+}
+
+} // namespace oglplus
+
@@ -0,0 +1,59 @@
+/**
+ *  @file oglplus/dispatch/table.ipp
+ *  @brief Implementation of the GL dispatch table
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+namespace oglplus {
+namespace aux {
+
+OGLPLUS_LIB_FUNC
+GLDispatchTable& GLDispatchTable::Current(void)
+{
+	static GLDispatchTable table;
+	return table;
+}
+
+OGLPLUS_LIB_FUNC
+void GLDispatchTable::StartRecording(std::size_t log_limit)
+{
+	_log_limit = log_limit;
+	_log.clear();
+	_log.reserve(log_limit);
+	_recording = true;
+	_update();
+}
+
+OGLPLUS_LIB_FUNC
+void GLDispatchTable::ResetStatistics(void)
+{
+	for(GLDispatchSlot* slot = _slots; slot; slot = slot->next)
+	{
+		slot->call_count = 0;
+		slot->call_time = 0.0;
+	}
+	_log.clear();
+}
+
+OGLPLUS_LIB_FUNC
+GLDispatchSlot::AnyFunc GLDispatchTable::Override(
+	GLDispatchSlot& slot,
+	GLDispatchSlot::AnyFunc func
+)
+{
+	GLDispatchSlot::AnyFunc result = slot.override_func;
+	if(result) --_override_count;
+	if(func) ++_override_count;
+	slot.override_func = func;
+	_update();
+	return result;
+}
+
+} // namespace aux
+} // namespace oglplus
+
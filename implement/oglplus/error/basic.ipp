@@ -9,6 +9,8 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
+#include <string>
+
 namespace oglplus {
 
 OGLPLUS_LIB_FUNC
@@ -146,5 +148,61 @@ GLint Error::Index(void) const
 #endif
 }
 
+namespace aux {
+
+OGLPLUS_LIB_FUNC
+ErrorCheckState& CurrentErrorCheckState(void)
+{
+#if !OGLPLUS_NO_THREADS
+	static thread_local ErrorCheckState state;
+#else
+	static ErrorCheckState state;
+#endif
+	return state;
+}
+
+OGLPLUS_LIB_FUNC
+void ErrorCheckState::CheckRecent(void)
+{
+	const std::size_t call_count = _call_count;
+	_call_count = 0;
+
+	GLenum error_code = OGLPLUS_GL_GET_ERROR();
+	if(error_code == GL_NO_ERROR)
+	{
+		return;
+	}
+
+	// the error is attributed to the first of the calls made
+	// since the last check, the message lists all of them
+	std::string message(Error::Message(error_code));
+	message.append(" in one of the recent GL calls:");
+	for(std::size_t i=0; i!=call_count; ++i)
+	{
+		const GLCallInfo& call = _calls[i];
+		message.append(" gl");
+		message.append(call.gl_func?call.gl_func:"?");
+		message.append(" (");
+		message.append(call.source_file?call.source_file:"?");
+		message.append(":");
+		message.append(std::to_string(call.source_line));
+		message.append(")");
+	}
+
+	Error error(message.c_str());
+	error.Code(error_code);
+	if(call_count != 0)
+	{
+		const GLCallInfo& first = _calls[0];
+		(void)error
+			.GLFunc(first.gl_func)
+			.SourceFile(first.source_file)
+			.SourceLine(first.source_line);
+	}
+	HandleError(error);
+}
+
+} // namespace aux
+
 } // namespace oglplus
 
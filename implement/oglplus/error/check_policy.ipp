@@ -0,0 +1,158 @@
+/**
+ *  @file oglplus/error/check_policy.ipp
+ *  @brief Implementation of the GL error check policy scopes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/capability.hpp>
+#include <oglplus/lib/incl_end.ipp>
+#include <exception>
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+DeferredErrorCheck::DeferredErrorCheck(void)
+ : _prev(CurrentErrorCheckPolicy())
+ , _uncaught(aux::UncaughtExceptions())
+{
+	// errors of the enclosing deferred scope are not
+	// to be attributed to the calls in this scope
+	Check();
+	SetErrorCheckPolicy(ErrorCheckPolicy::Deferred);
+}
+
+OGLPLUS_LIB_FUNC
+void DeferredErrorCheck::Check(void)
+{
+	aux::ErrorCheckState& state = aux::CurrentErrorCheckState();
+	if(state.Policy() == ErrorCheckPolicy::Deferred)
+	{
+		state.CheckRecent();
+	}
+}
+
+OGLPLUS_LIB_FUNC
+DeferredErrorCheck::~DeferredErrorCheck(void)
+OGLPLUS_NOEXCEPT(false)
+{
+	// do not throw if the scope is left because of an exception
+	if(aux::UncaughtExceptions() == _uncaught)
+	{
+		try { Check(); }
+		catch(...)
+		{
+			SetErrorCheckPolicy(_prev);
+			throw;
+		}
+	}
+	SetErrorCheckPolicy(_prev);
+}
+
+#if GL_VERSION_4_3 || GL_KHR_debug
+
+OGLPLUS_LIB_FUNC
+void GLAPIENTRY DebugOutputErrorCheck::_gl_debug_proc(
+	GLenum source,
+	GLenum type,
+	GLuint id,
+	GLenum severity,
+	GLsizei length,
+	const GLchar* message,
+	GLvoid* user_param
+)
+{
+	DebugOutputErrorCheck* self =
+		static_cast<DebugOutputErrorCheck*>(user_param);
+	assert(self);
+
+	if(type == GL_DEBUG_TYPE_ERROR)
+	{
+		// the output is synchronous, so this is the thread
+		// which made the failed call
+		aux::CurrentErrorCheckState().NoteDebugError();
+	}
+
+	if(self->_prev_callback)
+	{
+		self->_prev_callback(
+			source,
+			type,
+			id,
+			severity,
+			length,
+			message,
+			self->_prev_context
+		);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+DebugOutputErrorCheck::DebugOutputErrorCheck(void)
+ : _prev_callback(nullptr)
+ , _prev_context(nullptr)
+ , _prev(CurrentErrorCheckPolicy())
+ , _was_synchronous(false)
+{
+	// get the previous callback
+	GLDEBUGPROC _tmp_callback = nullptr;
+	void** _tmp_ptr=reinterpret_cast<void**>(&_tmp_callback);
+	OGLPLUS_GLFUNC(GetPointerv)(
+		GL_DEBUG_CALLBACK_FUNCTION,
+		_tmp_ptr
+	);
+	OGLPLUS_IGNORE(GetPointerv);
+	_prev_callback = _tmp_callback;
+
+	//get the previous context
+	OGLPLUS_GLFUNC(GetPointerv)(
+		GL_DEBUG_CALLBACK_USER_PARAM,
+		&_prev_context
+	);
+	OGLPLUS_IGNORE(GetPointerv);
+
+	_was_synchronous = OGLPLUS_GLFUNC(IsEnabled)(
+		GL_DEBUG_OUTPUT_SYNCHRONOUS
+	) == GL_TRUE;
+	aux::EnableCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS, true);
+
+	OGLPLUS_GLFUNC(DebugMessageCallback)(
+		GLDEBUGPROC(&DebugOutputErrorCheck::_gl_debug_proc),
+		static_cast<void*>(this)
+	);
+	OGLPLUS_VERIFY_SIMPLE(DebugMessageCallback);
+
+	SetErrorCheckPolicy(ErrorCheckPolicy::DebugOutput);
+}
+
+OGLPLUS_LIB_FUNC
+DebugOutputErrorCheck::~DebugOutputErrorCheck(void)
+{
+	SetErrorCheckPolicy(_prev);
+
+	OGLPLUS_GLFUNC(DebugMessageCallback)(
+		_prev_callback,
+		_prev_context
+	);
+	if(!_was_synchronous)
+	{
+		try
+		{
+			aux::EnableCapability(
+				GL_DEBUG_OUTPUT_SYNCHRONOUS,
+				false
+			);
+		}
+		catch(...) { }
+	}
+}
+
+#endif // GL_VERSION_4_3 || KHR_debug
+
+} // namespace oglplus
+
@@ -0,0 +1,307 @@
+/**
+ *  @file oglplus/gpu_profiler.ipp
+ *  @brief Implementation of GpuProfiler
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <ostream>
+#include <utility>
+
+namespace oglplus {
+
+#if GL_VERSION_3_3 || GL_ARB_timer_query
+
+namespace aux {
+
+inline void GpuProfilerWriteJSONString(
+	std::ostream& output,
+	const std::string& str
+)
+{
+	static const char hex[] = "0123456789abcdef";
+	output << '"';
+	for(char c : str)
+	{
+		switch(c)
+		{
+			case '"': output << "\\\""; break;
+			case '\\': output << "\\\\"; break;
+			case '\n': output << "\\n"; break;
+			case '\r': output << "\\r"; break;
+			case '\t': output << "\\t"; break;
+			default:
+			if((unsigned char)c < 0x20)
+			{
+				output << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+			}
+			else output << c;
+		}
+	}
+	output << '"';
+}
+
+// writes a nanosecond interval as microseconds with three decimals
+// without changing the formatting flags of the stream
+inline void GpuProfilerWriteMicroseconds(std::ostream& output, GLuint64 ns)
+{
+	const char frac[4] = {
+		char('0'+(ns / 100) % 10),
+		char('0'+(ns /  10) % 10),
+		char('0'+(ns /   1) % 10),
+		'\0'
+	};
+	output << (unsigned long long)(ns / 1000) << '.' << frac;
+}
+
+inline void GpuProfilerWriteEvent(
+	std::ostream& output,
+	const std::string& name,
+	const char* category,
+	GLuint64 begin,
+	GLuint64 end,
+	GLuint64 origin,
+	std::uint64_t frame
+)
+{
+	output << ",\n{\"name\":";
+	GpuProfilerWriteJSONString(output, name);
+	output << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":";
+	GpuProfilerWriteMicroseconds(output, begin-origin);
+	output << ",\"dur\":";
+	GpuProfilerWriteMicroseconds(output, (end > begin)?end-begin:0);
+	output << ",\"pid\":1,\"tid\":1,\"args\":{\"frame\":";
+	output << (unsigned long long)frame << "}}";
+}
+
+} // namespace aux
+
+OGLPLUS_LIB_FUNC
+GpuProfiler::GpuProfiler(std::size_t latency, std::size_t history)
+ : _ring(latency>1?latency:2)
+ , _current(0)
+ , _frame_number(0)
+ , _in_frame(false)
+ , _measuring(false)
+ , _history(history)
+ , _dropped(0)
+{ }
+
+OGLPLUS_LIB_FUNC
+std::size_t GpuProfiler::_timestamp(_slot& slot)
+{
+	const std::size_t index = slot.query_count++;
+	if(index == slot.queries.size())
+	{
+		slot.queries.emplace_back();
+	}
+	slot.queries[index].Timestamp();
+	return index;
+}
+
+OGLPLUS_LIB_FUNC
+void GpuProfiler::BeginFrame(void)
+{
+	assert(!_in_frame);
+	Resolve();
+
+	_slot& slot = _ring[_current];
+	// the oldest frame in the ring is still in flight,
+	// skip this frame rather than wait for the GPU
+	if(slot.pending)
+	{
+		++_dropped;
+		_measuring = false;
+	}
+	else
+	{
+		slot.query_count = 0;
+		slot.record_count = 0;
+		slot.number = _frame_number;
+		_timestamp(slot);
+		_measuring = true;
+	}
+	++_frame_number;
+	_open.clear();
+	_in_frame = true;
+}
+
+OGLPLUS_LIB_FUNC
+void GpuProfiler::EndFrame(void)
+{
+	assert(_in_frame);
+	assert(_open.empty());
+
+	if(_measuring)
+	{
+		_slot& slot = _ring[_current];
+		slot.end_query = _timestamp(slot);
+		slot.pending = true;
+		_current = (_current+1) % _ring.size();
+	}
+	_measuring = false;
+	_in_frame = false;
+}
+
+OGLPLUS_LIB_FUNC
+void GpuProfiler::BeginScope(const StrCRef& name)
+{
+	assert(_in_frame);
+	if(!_measuring)
+	{
+		_open.push_back(std::size_t(GpuProfilerScope::npos));
+		return;
+	}
+
+	_slot& slot = _ring[_current];
+	const std::size_t index = slot.record_count++;
+	if(index == slot.records.size())
+	{
+		slot.records.emplace_back();
+	}
+	_record& record = slot.records[index];
+	// reuses the storage of the name from the previous frames
+	record.name.assign(name.begin(), name.size());
+	record.parent = _open.empty()?
+		std::size_t(GpuProfilerScope::npos):
+		_open.back();
+	record.depth = _open.size();
+	record.begin_query = _timestamp(slot);
+	record.end_query = record.begin_query;
+
+	_open.push_back(index);
+}
+
+OGLPLUS_LIB_FUNC
+void GpuProfiler::EndScope(void)
+{
+	assert(_in_frame);
+	assert(!_open.empty());
+
+	const std::size_t index = _open.back();
+	_open.pop_back();
+	if(_measuring)
+	{
+		_slot& slot = _ring[_current];
+		slot.records[index].end_query = _timestamp(slot);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+bool GpuProfiler::_resolve(_slot& slot)
+{
+	assert(slot.pending);
+	// the timestamps of a frame become available in order,
+	// so if the last one is available then all of them are
+	if(!slot.queries[slot.end_query].ResultAvailable())
+	{
+		return false;
+	}
+
+	GpuProfilerFrame frame;
+	if(_history > 0 && _frames.size() >= _history)
+	{
+		// reuse the storage of the oldest frame
+		frame = std::move(_frames.front());
+		_frames.pop_front();
+	}
+	frame.number = slot.number;
+	slot.queries[0].Result(frame.begin);
+	slot.queries[slot.end_query].Result(frame.end);
+
+	frame.scopes.resize(slot.record_count);
+	for(std::size_t i=0; i!=slot.record_count; ++i)
+	{
+		const _record& record = slot.records[i];
+		GpuProfilerScope& scope = frame.scopes[i];
+		scope.name = record.name;
+		scope.parent = record.parent;
+		scope.depth = record.depth;
+		slot.queries[record.begin_query].Result(scope.begin);
+		slot.queries[record.end_query].Result(scope.end);
+	}
+	slot.pending = false;
+
+	if(_history > 0)
+	{
+		_frames.push_back(std::move(frame));
+	}
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t GpuProfiler::Resolve(void)
+{
+	// the current slot holds the oldest frame in flight
+	std::size_t count = 0;
+	for(std::size_t i=0, n=_ring.size(); i!=n; ++i)
+	{
+		_slot& slot = _ring[(_current+i) % n];
+		if(slot.pending)
+		{
+			if(!_resolve(slot)) break;
+			++count;
+		}
+	}
+	return count;
+}
+
+OGLPLUS_LIB_FUNC
+void GpuProfiler::Flush(void)
+{
+	assert(!_in_frame);
+	for(std::size_t i=0, n=_ring.size(); i!=n; ++i)
+	{
+		_slot& slot = _ring[(_current+i) % n];
+		if(slot.pending)
+		{
+			GLuint64 end = 0;
+			slot.queries[slot.end_query].WaitForResult(end);
+			_resolve(slot);
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void GpuProfiler::WriteChromeTrace(std::ostream& output) const
+{
+	const GLuint64 origin = _frames.empty()?0:_frames.front().begin;
+
+	output << "{\"traceEvents\":[\n";
+	output << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,";
+	output << "\"args\":{\"name\":\"GPU\"}}";
+
+	for(const GpuProfilerFrame& frame : _frames)
+	{
+		aux::GpuProfilerWriteEvent(
+			output,
+			"Frame",
+			"frame",
+			frame.begin,
+			frame.end,
+			origin,
+			frame.number
+		);
+		for(const GpuProfilerScope& scope : frame.scopes)
+		{
+			aux::GpuProfilerWriteEvent(
+				output,
+				scope.name,
+				"scope",
+				scope.begin,
+				scope.end,
+				origin,
+				frame.number
+			);
+		}
+	}
+	output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+#endif // GL_VERSION_3_3 || GL_ARB_timer_query
+
+} // namespace oglplus
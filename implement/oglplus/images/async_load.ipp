@@ -0,0 +1,341 @@
+/**
+ *  @file oglplus/images/async_load.ipp
+ *  @brief Implementation of the asynchronous image loader
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/opt/resources.hpp>
+
+#if OGLPLUS_PNG_FOUND
+#include <oglplus/images/png.hpp>
+#endif
+#include <oglplus/images/xpm.hpp>
+#include <oglplus/lib/incl_end.ipp>
+
+#include <fstream>
+#include <stdexcept>
+#include <cassert>
+
+namespace oglplus {
+namespace images {
+
+OGLPLUS_LIB_FUNC
+AsyncImageLoader::AsyncImageLoader(
+	std::size_t max_bytes_in_flight,
+	unsigned threads
+): _max_bytes(max_bytes_in_flight)
+ , _bytes_in_flight(0)
+ , _next_ticket(0)
+ , _pending(0)
+#if !OGLPLUS_NO_THREADS
+ , _stop(false)
+#endif
+{
+#if !OGLPLUS_NO_THREADS
+	if(threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+		if(threads == 0) threads = 1;
+	}
+	_workers.reserve(threads);
+	for(unsigned t=0; t!=threads; ++t)
+	{
+		_workers.push_back(std::thread(&AsyncImageLoader::_work, this));
+	}
+#else
+	OGLPLUS_FAKE_USE(threads);
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+AsyncImageLoader::~AsyncImageLoader(void)
+{
+#if !OGLPLUS_NO_THREADS
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+		_requests.clear();
+	}
+	_request_cond.notify_all();
+	_budget_cond.notify_all();
+	for(std::thread& worker : _workers)
+	{
+		worker.join();
+	}
+#endif
+}
+
+#if !OGLPLUS_NO_THREADS
+OGLPLUS_LIB_FUNC
+void AsyncImageLoader::_work(void)
+{
+	while(true)
+	{
+		_request request;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while(!_stop && _requests.empty())
+			{
+				_request_cond.wait(lock);
+			}
+			if(_stop) return;
+			request = std::move(_requests.front());
+			_requests.pop_front();
+		}
+
+		_result result = _load(request);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if(_stop) return;
+			_results.push_back(std::move(result));
+		}
+		_result_cond.notify_one();
+	}
+}
+#endif
+
+OGLPLUS_LIB_FUNC
+bool AsyncImageLoader::_acquire(std::size_t bytes)
+{
+#if !OGLPLUS_NO_THREADS
+	std::unique_lock<std::mutex> lock(_mutex);
+	// an image larger than the whole budget is admitted
+	// only if nothing else is in flight
+	while(
+		!_stop &&
+		(_bytes_in_flight != 0) &&
+		(_bytes_in_flight+bytes > _max_bytes)
+	) _budget_cond.wait(lock);
+	if(_stop) return false;
+#endif
+	_bytes_in_flight += bytes;
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+void AsyncImageLoader::_adjust(std::size_t estimate, std::size_t bytes)
+{
+#if !OGLPLUS_NO_THREADS
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		assert(_bytes_in_flight >= estimate);
+		_bytes_in_flight -= estimate;
+		_bytes_in_flight += bytes;
+	}
+	if(bytes < estimate) _budget_cond.notify_all();
+#else
+	assert(_bytes_in_flight >= estimate);
+	_bytes_in_flight -= estimate;
+	_bytes_in_flight += bytes;
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+AsyncImageLoader::_result
+AsyncImageLoader::_load(const _request& request)
+{
+	_result result;
+	result.ticket = request.ticket;
+	result.bytes = 0;
+
+	std::size_t estimate = 0;
+	bool acquired = false;
+	try
+	{
+		std::ifstream file;
+		const char* exts[] = {".png", ".xpm"};
+		std::size_t nexts = sizeof(exts)/sizeof(exts[0]);
+		std::size_t iext = oglplus::FindResourceFile(
+			file,
+			request.category,
+			request.name,
+			exts,
+			nexts
+		);
+
+		if(!file.good())
+		{
+			throw std::runtime_error(
+				"Unable to open image: "+request.name
+			);
+		}
+		if(iext == 0) //.png
+		{
+#if OGLPLUS_PNG_FOUND
+			// the size of the decoded image is known
+			// from the header before decoding the pixels
+			PNGDecoder decoder(file);
+			estimate = decoder.DataSize();
+			if(!(acquired = _acquire(estimate)))
+			{
+				return result;
+			}
+			result.image.push_back(PNGImage(
+				decoder,
+				request.y_is_up,
+				request.x_is_right
+			));
+#endif
+		}
+		else if(iext == 1) //.xpm
+		{
+			// the textual XPM file is larger than
+			// the decoded image, use its size as estimate
+			file.seekg(0, std::ios::end);
+			std::streamoff size = file.tellg();
+			file.seekg(0, std::ios::beg);
+			estimate = (size > 0)?std::size_t(size):0;
+			if(!(acquired = _acquire(estimate)))
+			{
+				return result;
+			}
+			result.image.push_back(XPMImage(
+				file,
+				request.y_is_up,
+				request.x_is_right
+			));
+		}
+		if(result.image.empty())
+		{
+			throw std::runtime_error(
+				"Unable to open this image type"
+			);
+		}
+		result.bytes = result.image.front().DataSize();
+		_adjust(estimate, result.bytes);
+	}
+	catch(...)
+	{
+		if(acquired) _adjust(estimate, 0);
+		result.image.clear();
+		result.bytes = 0;
+		result.error = std::current_exception();
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t AsyncImageLoader::Enqueue(
+	std::string category,
+	std::string name,
+	bool y_is_up,
+	bool x_is_right
+)
+{
+	_request request;
+	request.category = std::move(category);
+	request.name = std::move(name);
+	request.y_is_up = y_is_up;
+	request.x_is_right = x_is_right;
+	std::size_t ticket;
+	{
+#if !OGLPLUS_NO_THREADS
+		std::lock_guard<std::mutex> lock(_mutex);
+#endif
+		ticket = request.ticket = _next_ticket++;
+		++_pending;
+		_requests.push_back(std::move(request));
+	}
+#if !OGLPLUS_NO_THREADS
+	_request_cond.notify_one();
+#endif
+	return ticket;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t AsyncImageLoader::EnqueueTextures(
+	const std::vector<std::string>& names,
+	bool y_is_up,
+	bool x_is_right
+)
+{
+	std::size_t first = 0;
+	for(std::size_t i=0, n=names.size(); i!=n; ++i)
+	{
+		std::size_t ticket = EnqueueTexture(
+			names[i],
+			y_is_up,
+			x_is_right
+		);
+		if(i == 0) first = ticket;
+	}
+	return first;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t AsyncImageLoader::Pending(void) const
+{
+#if !OGLPLUS_NO_THREADS
+	std::lock_guard<std::mutex> lock(_mutex);
+#endif
+	return _pending;
+}
+
+OGLPLUS_LIB_FUNC
+bool AsyncImageLoader::Ready(void) const
+{
+#if !OGLPLUS_NO_THREADS
+	std::lock_guard<std::mutex> lock(_mutex);
+	return !_results.empty();
+#else
+	return !_requests.empty();
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+Image AsyncImageLoader::Next(std::size_t& ticket)
+{
+	_result result;
+#if !OGLPLUS_NO_THREADS
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(_pending == 0)
+		{
+			throw std::runtime_error(
+				"No pending image in the asynchronous image loader"
+			);
+		}
+		while(_results.empty())
+		{
+			_result_cond.wait(lock);
+		}
+		result = std::move(_results.front());
+		_results.pop_front();
+		--_pending;
+		assert(_bytes_in_flight >= result.bytes);
+		_bytes_in_flight -= result.bytes;
+	}
+	_budget_cond.notify_all();
+#else
+	if(_pending == 0)
+	{
+		throw std::runtime_error(
+			"No pending image in the asynchronous image loader"
+		);
+	}
+	assert(!_requests.empty());
+	_request request = std::move(_requests.front());
+	_requests.pop_front();
+	result = _load(request);
+	--_pending;
+	_bytes_in_flight -= result.bytes;
+#endif
+	ticket = result.ticket;
+	if(result.error)
+	{
+		std::rethrow_exception(result.error);
+	}
+	assert(!result.image.empty());
+	return std::move(result.image.front());
+}
+
+} // images
+} // oglplus
+
@@ -9,13 +9,39 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/images/tiled.hpp>
+#include <oglplus/lib/incl_end.ipp>
+
+#include <vector>
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 
 namespace oglplus {
 namespace images {
 
+OGLPLUS_LIB_FUNC
+bool BrushedMetalUByte::_segment_in_rows(
+	const _segment& s,
+	GLsizei h,
+	GLint y_begin,
+	GLint y_end
+)
+{
+	// the pixels of the segment lie between y and y+dy
+	GLint lo = s.y+std::min(s.dy, 0);
+	GLint len = std::abs(s.dy)+1;
+	if(len >= h) return true;
+	lo %= h;
+	if(lo < 0) lo += h;
+	// the wrapped range may continue at the top of the image
+	return	((lo < y_end) && (y_begin < lo+len)) ||
+		((lo < y_end+h) && (y_begin+h < lo+len));
+}
+
 OGLPLUS_LIB_FUNC
 void BrushedMetalUByte::_make_pixel(
 	GLubyte* b,
@@ -26,13 +52,16 @@ void BrushedMetalUByte::_make_pixel(
 	GLint y,
 	GLdouble /*c*/,
 	GLubyte r,
-	GLubyte g
+	GLubyte g,
+	GLint y_begin,
+	GLint y_end
 )
 {
 	while(x < 0) x += w;
 	while(y < 0) y += h;
 	if(x >= w) x %= w;
 	if(y >= h) y %= h;
+	if((y < y_begin) || (y >= y_end)) return;
 	GLubyte* p = b + (y*w + x)*3;
 	GLubyte* pr = p;
 	GLubyte* pg = p+1;
@@ -55,7 +84,9 @@ void BrushedMetalUByte::_make_scratch(
 	GLint x,
 	GLint y,
 	GLint dx,
-	GLint dy
+	GLint dy,
+	GLint y_begin,
+	GLint y_end
 )
 {
 	if((dx == 0) && (dy == 0)) return;
@@ -73,7 +104,7 @@ void BrushedMetalUByte::_make_scratch(
 			{
 				GLdouble c = GLdouble(i)/dx;
 				GLint j = GLint(dy*c);
-				_make_pixel(b,e,w,h,x+i,y+j,c,r,g);
+				_make_pixel(b,e,w,h,x+i,y+j,c,r,g,y_begin,y_end);
 			}
 		}
 		else
@@ -82,32 +113,124 @@ void BrushedMetalUByte::_make_scratch(
 			{
 				GLdouble c = GLdouble(i)/dx;
 				GLint j = GLint(dy*c);
-				_make_pixel(b,e,w,h,x+i,y+j,c,r,g);
+				_make_pixel(b,e,w,h,x+i,y+j,c,r,g,y_begin,y_end);
 			}
 		}
 	}
 	else
 	{
-		if(dy >= 0)
+		// only the steps ending up in the rows [y_begin, y_end)
+		// (possibly after wrapping around) are made, all pixels
+		// of a scratch get the same color so the order is irrelevant
+		const GLint rows = y_end-y_begin;
+		const GLint n = (dy >= 0)?dy:-dy;
+		GLint first = (dy >= 0)?(y_begin-y)%h:(y-y_end+1)%h;
+		if(first < 0) first += h;
+		if(first+rows > h) first -= h;
+
+		for(GLint base=first; base<n; base+=h)
 		{
-			for(GLint j=0; j<dy; ++j)
+			for(GLint k=std::max(base, 0); k<std::min(base+rows, n); ++k)
 			{
+				GLint j = (dy >= 0)?k:-k;
 				GLdouble c = GLdouble(j)/dy;
 				GLint i = GLint(dx*c);
-				_make_pixel(b,e,w,h,x+i,y+j,c,r,g);
+				_make_pixel(b,e,w,h,x+i,y+j,c,r,g,y_begin,y_end);
 			}
 		}
-		else
+	}
+
+}
+
+OGLPLUS_LIB_FUNC
+void BrushedMetalUByte::_make(
+	GLsizei width,
+	GLsizei height,
+	unsigned n_scratches,
+	int s_disp_min,
+	int s_disp_max,
+	int t_disp_min,
+	int t_disp_max,
+	GLuint seed
+)
+{
+	GLubyte *p = this->_begin_ub(), *e = this->_end_ub();
+
+	// the scratches start in the individual tiles and their
+	// shapes are determined by the coordinates of the tile
+	ImageTileExecutor tiles;
+	const std::size_t tile_count = tiles.TileCount(width, height);
+	std::vector<std::vector<_segment>> tile_segments(tile_count);
+
+	tiles.Execute(
+		width, height, 1,
+		[&](const ImageTile& tile)
 		{
-			for(GLint j=0; j>dy; --j)
+			ImageTileRandom rand(seed, tile);
+			const unsigned long long k = tile.index;
+			unsigned n = unsigned(
+				(n_scratches*(k+1))/tile_count-
+				(n_scratches*k)/tile_count
+			);
+			std::vector<_segment>& segments = tile_segments[k];
+			while(n--)
 			{
-				GLdouble c = GLdouble(j)/dy;
-				GLint i = GLint(dx*c);
-				_make_pixel(b,e,w,h,x+i,y+j,c,r,g);
+				const GLuint n_segments = 1 + rand() % 4;
+				GLint x = tile.x + GLint(rand() % GLuint(tile.width));
+				GLint y = tile.y + GLint(rand() % GLuint(tile.height));
+				for(GLuint seg=0; seg<n_segments; ++seg)
+				{
+					GLint dx = s_disp_min + GLint(
+						rand()%GLuint(s_disp_max-s_disp_min+1)
+					);
+					GLint dy = t_disp_min + GLint(
+						rand()%GLuint(t_disp_max-t_disp_min+1)
+					);
+					_segment s = { x, y, dx, dy };
+					segments.push_back(s);
+					x += dx;
+					y += dy;
+				}
 			}
 		}
+	);
+
+	std::vector<_segment> segments;
+	for(const std::vector<_segment>& ts : tile_segments)
+	{
+		segments.insert(segments.end(), ts.begin(), ts.end());
 	}
 
+	// the image is drawn in bands of rows in parallel, each band
+	// draws its part of all segments in the same order so the result
+	// does not depend on the number of threads
+	ImageTileExecutor(width, 64).Execute(
+		width, height, 1,
+		[&](const ImageTile& band)
+		{
+			const GLint y_begin = band.y;
+			const GLint y_end = band.y+band.height;
+			std::memset(
+				p+y_begin*width*3, 0,
+				std::size_t(band.height*width*3)
+			);
+
+			for(const _segment& s : segments)
+			{
+				if(_segment_in_rows(s, height, y_begin, y_end))
+				{
+					_make_scratch(
+						p, e,
+						width,
+						height,
+						s.x, s.y,
+						s.dx, s.dy,
+						y_begin, y_end
+					);
+				}
+			}
+		}
+	);
 }
 
 OGLPLUS_LIB_FUNC
@@ -121,33 +244,40 @@ BrushedMetalUByte::BrushedMetalUByte(
 	int t_disp_max
 ): Image(width, height, 1, 3, &TypeTag<GLubyte>())
 {
-	this->_bzero();
-
-	GLubyte *p = this->_begin_ub(), *e = this->_end_ub();
+	_make(
+		width,
+		height,
+		n_scratches,
+		s_disp_min,
+		s_disp_max,
+		t_disp_min,
+		t_disp_max,
+		GLuint(std::rand())
+	);
+}
 
-	while(n_scratches--)
-	{
-		const GLuint n_segments = 1 + std::rand() % 4;
-		GLint x = std::rand() % width;
-		GLint y = std::rand() % height;
-		for(GLuint seg=0; seg<n_segments; ++seg)
-		{
-			GLint dx = s_disp_min +
-				(std::rand()%(s_disp_max-s_disp_min+1));
-			GLint dy = t_disp_min +
-				(std::rand()%(t_disp_max-t_disp_min+1));
-
-			_make_scratch(
-				p, e,
-				width,
-				height,
-				x, y,
-				dx, dy
-			);
-			x += dx;
-			y += dy;
-		}
-	}
+OGLPLUS_LIB_FUNC
+BrushedMetalUByte::BrushedMetalUByte(
+	SizeType width,
+	SizeType height,
+	unsigned n_scratches,
+	int s_disp_min,
+	int s_disp_max,
+	int t_disp_min,
+	int t_disp_max,
+	GLuint seed
+): Image(width, height, 1, 3, &TypeTag<GLubyte>())
+{
+	_make(
+		width,
+		height,
+		n_scratches,
+		s_disp_min,
+		s_disp_max,
+		t_disp_min,
+		t_disp_max,
+		seed
+	);
 }
 
 } // images
@@ -0,0 +1,357 @@
+/**
+ *  @file oglplus/images/frame_writer.ipp
+ *  @brief Implementation of the FrameWriter
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <fstream>
+#include <stdexcept>
+#include <cassert>
+
+#if OGLPLUS_PNG_FOUND
+#include <png.h>
+#endif
+
+namespace oglplus {
+namespace images {
+namespace aux {
+
+#if OGLPLUS_PNG_FOUND
+// encodes a single PNG image into an output stream
+class FrameWriterPNG
+{
+private:
+	::png_structp _png;
+	::png_infop _info;
+
+	OGLPLUS_NORETURN
+	static void _handle_error(::png_structp /*png*/, const char* msg)
+	{
+		throw std::runtime_error(msg);
+	}
+
+	static void _handle_warning(::png_structp /*png*/, const char* /*msg*/)
+	{ }
+
+	static void _write_data(
+		::png_structp png,
+		::png_bytep data,
+		::png_size_t size
+	)
+	{
+		std::ostream& output =
+			*static_cast<std::ostream*>(::png_get_io_ptr(png));
+		output.write(
+			reinterpret_cast<const char*>(data),
+			std::streamsize(size)
+		);
+		if(!output.good())
+		{
+			throw std::runtime_error("Unable to write PNG data");
+		}
+	}
+
+	static void _flush_data(::png_structp png)
+	{
+		static_cast<std::ostream*>(::png_get_io_ptr(png))->flush();
+	}
+
+	FrameWriterPNG(const FrameWriterPNG&);
+public:
+	FrameWriterPNG(std::ostream& output)
+	 : _png(::png_create_write_struct(
+		PNG_LIBPNG_VER_STRING,
+		nullptr,
+		&_handle_error,
+		&_handle_warning
+	)), _info(nullptr)
+	{
+		if(!_png)
+		{
+			throw std::runtime_error("Unable to create PNG writer");
+		}
+		_info = ::png_create_info_struct(_png);
+		if(!_info)
+		{
+			::png_destroy_write_struct(
+				&_png,
+				static_cast<::png_infopp>(nullptr)
+			);
+			throw std::runtime_error("Unable to create PNG info");
+		}
+		::png_set_write_fn(_png, &output, &_write_data, &_flush_data);
+	}
+
+	~FrameWriterPNG(void)
+	{
+		::png_destroy_write_struct(&_png, &_info);
+	}
+
+	void Write(
+		const GLubyte* pixels,
+		GLsizei width,
+		GLsizei height,
+		GLsizei channels,
+		bool y_is_up
+	)
+	{
+		int color_type = 0;
+		switch(channels)
+		{
+			case 1: color_type = PNG_COLOR_TYPE_GRAY; break;
+			case 2: color_type = PNG_COLOR_TYPE_GRAY_ALPHA; break;
+			case 3: color_type = PNG_COLOR_TYPE_RGB; break;
+			case 4: color_type = PNG_COLOR_TYPE_RGB_ALPHA; break;
+			default:
+			throw std::runtime_error(
+				"Invalid number of PNG image channels"
+			);
+		}
+		::png_set_IHDR(
+			_png,
+			_info,
+			::png_uint_32(width),
+			::png_uint_32(height),
+			8,
+			color_type,
+			PNG_INTERLACE_NONE,
+			PNG_COMPRESSION_TYPE_DEFAULT,
+			PNG_FILTER_TYPE_DEFAULT
+		);
+		// the frames are written while rendering, prefer speed to size
+		::png_set_compression_level(_png, 1);
+		::png_write_info(_png, _info);
+
+		const std::size_t row_size = std::size_t(width*channels);
+		for(GLsizei r=0; r!=height; ++r)
+		{
+			const GLsizei row = y_is_up?height-r-1:r;
+			::png_write_row(
+				_png,
+				const_cast<::png_bytep>(
+					pixels+row_size*std::size_t(row)
+				)
+			);
+		}
+		::png_write_end(_png, nullptr);
+	}
+};
+#endif // OGLPLUS_PNG_FOUND
+
+} // namespace aux
+
+OGLPLUS_LIB_FUNC
+FrameWriter::FrameWriter(
+	FrameFileFormat format,
+	std::size_t max_queued,
+	bool y_is_up
+): _format(format)
+ , _y_is_up(y_is_up)
+ , _max_queued(max_queued>0?max_queued:1)
+ , _queued(0)
+#if !OGLPLUS_NO_THREADS
+ , _stop(false)
+#endif
+{
+#if !OGLPLUS_PNG_FOUND
+	if(_format == FrameFileFormat::PNG)
+	{
+		throw std::runtime_error(
+			"FrameWriter: PNG support is not available"
+		);
+	}
+#endif
+#if !OGLPLUS_NO_THREADS
+	_worker = std::thread(&FrameWriter::_work, this);
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+FrameWriter::~FrameWriter(void)
+{
+#if !OGLPLUS_NO_THREADS
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_job_cond.notify_all();
+	_worker.join();
+#endif
+}
+
+#if !OGLPLUS_NO_THREADS
+OGLPLUS_LIB_FUNC
+void FrameWriter::_work(void)
+{
+	while(true)
+	{
+		_job job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while(!_stop && _jobs.empty())
+			{
+				_job_cond.wait(lock);
+			}
+			// the queued frames are written even when stopping
+			if(_jobs.empty()) return;
+			job = std::move(_jobs.front());
+			_jobs.pop_front();
+		}
+
+		_result result = _write(job);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_results.push_back(std::move(result));
+			--_queued;
+		}
+		_done_cond.notify_all();
+	}
+}
+#endif
+
+OGLPLUS_LIB_FUNC
+FrameWriter::_result FrameWriter::_write(const _job& job) const
+{
+	_result result;
+	result.path = job.path;
+	try
+	{
+		const std::size_t size =
+			std::size_t(job.width)*
+			std::size_t(job.height)*
+			std::size_t(job.channels);
+		assert(job.pixels.size() >= size);
+
+		std::ofstream file(job.path, std::ios::out|std::ios::binary);
+		if(!file.good())
+		{
+			throw std::runtime_error(
+				"Unable to open file for writing: "+job.path
+			);
+		}
+		if(_format == FrameFileFormat::Raw)
+		{
+			file.write(
+				reinterpret_cast<const char*>(job.pixels.data()),
+				std::streamsize(size)
+			);
+		}
+#if OGLPLUS_PNG_FOUND
+		else if(_format == FrameFileFormat::PNG)
+		{
+			aux::FrameWriterPNG(file).Write(
+				job.pixels.data(),
+				job.width,
+				job.height,
+				job.channels,
+				_y_is_up
+			);
+		}
+#endif
+		file.close();
+		if(file.fail())
+		{
+			throw std::runtime_error(
+				"Unable to write file: "+job.path
+			);
+		}
+	}
+	catch(...)
+	{
+		result.error = std::current_exception();
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+void FrameWriter::Enqueue(
+	std::string path,
+	SizeType width,
+	SizeType height,
+	SizeType channels,
+	std::vector<GLubyte> pixels
+)
+{
+	_job job;
+	job.path = std::move(path);
+	job.width = width;
+	job.height = height;
+	job.channels = channels;
+	job.pixels = std::move(pixels);
+#if !OGLPLUS_NO_THREADS
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while(_queued >= _max_queued)
+		{
+			_done_cond.wait(lock);
+		}
+		_jobs.push_back(std::move(job));
+		++_queued;
+	}
+	_job_cond.notify_one();
+#else
+	_results.push_back(_write(job));
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t FrameWriter::Pending(void) const
+{
+#if !OGLPLUS_NO_THREADS
+	std::lock_guard<std::mutex> lock(_mutex);
+#endif
+	return _queued+_results.size();
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t FrameWriter::Poll(std::vector<std::string>& written)
+{
+	std::exception_ptr error;
+	std::size_t count = 0;
+	{
+#if !OGLPLUS_NO_THREADS
+		std::lock_guard<std::mutex> lock(_mutex);
+#endif
+		while(!_results.empty())
+		{
+			_result result = std::move(_results.front());
+			_results.pop_front();
+			if(result.error)
+			{
+				error = result.error;
+				break;
+			}
+			written.push_back(std::move(result.path));
+			++count;
+		}
+	}
+	if(error)
+	{
+		std::rethrow_exception(error);
+	}
+	return count;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t FrameWriter::Wait(std::vector<std::string>& written)
+{
+#if !OGLPLUS_NO_THREADS
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while(_queued > 0)
+		{
+			_done_cond.wait(lock);
+		}
+	}
+#endif
+	return Poll(written);
+}
+
+} // images
+} // oglplus
@@ -10,12 +10,15 @@
  */
 
 #include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/images/tiled.hpp>
 #include <oglplus/math/angle.hpp>
 #include <oglplus/math/vector.hpp>
 #include <oglplus/lib/incl_end.ipp>
 
+#include <vector>
 #include <cassert>
 #include <cstdlib>
+#include <cmath>
 
 namespace oglplus {
 namespace images {
@@ -40,49 +43,69 @@ BaseMetaballs::BaseMetaballs(
 	assert(size % n == 0);
 
 	const auto fc = FullCircle();
-	auto a = this->_begin<GLfloat>();
+	GLfloat* data = this->_begin<GLfloat>();
 
-	for(GLsizei y=0; y!=height; ++y)
+	// the squared distance beyond which a ball does not contribute;
+	// the radius of stars varies by up to the pointiness of the star
+	std::vector<GLfloat> cutoff(size/n);
+	for(std::size_t b=0; b!=size; b+=n)
 	{
-		const GLfloat j = (y+0.5f)/GLfloat(height);
+		GLfloat r = balls[b+2];
+		if(n > 4) r += std::fabs(balls[b+4]*r);
+		else if(n > 3) r += std::fabs(0.25f*r);
+		// with a margin for the rounding errors
+		cutoff[b/n] = 4.5f*r*r;
+	}
 
-		for(GLsizei x=0; x!=width; ++x)
+	ImageTileExecutor().Execute(
+		width, height, 1,
+		[=, &cutoff](const ImageTile& tile)
 		{
-			GLfloat v = 0.0f;
-			const GLfloat i = (x+0.5f)/GLfloat(width);
-			const Vec2f p(i, j);
-
-			for(std::size_t b=0; b!=size; b+=n)
+			for(GLsizei y=tile.y; y!=tile.y+tile.height; ++y)
 			{
-				const Vec2f c(balls+b, 2);
+				const GLfloat j = (y+0.5f)/GLfloat(height);
+				GLfloat* a = data+y*width+tile.x;
 
-				for(int yo=-1; yo!=2; ++yo)
-				for(int xo=-1; xo!=2; ++xo)
+				for(GLsizei x=tile.x; x!=tile.x+tile.width; ++x)
 				{
-					const Vec2f o(xo, yo);
-					const Vec2f d = p - c + o;
-
-					GLfloat r = balls[b+2];
+					GLfloat v = 0.0f;
+					const GLfloat i = (x+0.5f)/GLfloat(width);
+					const Vec2f p(i, j);
 
-					if(n > 3)
+					for(std::size_t b=0; b!=size; b+=n)
 					{
-						GLfloat w = ArcTan(d.y(), d.x())/fc;
-						w += balls[b+2];
-						w = Sin(fc*w*balls[b+3]);
+						const Vec2f c(balls+b, 2);
 
-						if(n > 4) r += balls[b+4]*r*w;
-						else r += 0.25f*r*w;
-					}
+						for(int yo=-1; yo!=2; ++yo)
+						for(int xo=-1; xo!=2; ++xo)
+						{
+							const Vec2f o(xo, yo);
+							const Vec2f d = p - c + o;
+							const GLfloat dd = Dot(d,d);
+
+							if(dd > cutoff[b/n]) continue;
 
-					float t = (r*r/Dot(d,d))-0.25f;
-					v += (t>0.0f)?t:0.0f;
+							GLfloat r = balls[b+2];
+
+							if(n > 3)
+							{
+								GLfloat w = ArcTan(d.y(), d.x())/fc;
+								w += balls[b+2];
+								w = Sin(fc*w*balls[b+3]);
+
+								if(n > 4) r += balls[b+4]*r*w;
+								else r += 0.25f*r*w;
+							}
+
+							float t = (r*r/dd)-0.25f;
+							v += (t>0.0f)?t:0.0f;
+						}
+					}
+					*a++ = v;
 				}
 			}
-			assert(a != this->_end<GLfloat>());
-			*a++ = v;
 		}
-	}
-	assert(a == this->_end<GLfloat>());
+	);
 }
 
 std::vector<GLfloat> RandomMetaballs::_make_balls(
@@ -13,6 +13,8 @@
 #include <fstream>
 #include <cassert>
 #include <iostream>
+#include <algorithm>
+#include <vector>
 #include <png.h>
 
 namespace oglplus {
@@ -80,11 +82,25 @@ private:
 
 	PNGReadInfoEndStruct _png;
 
-	static GLenum _translate_format(GLuint color_type, bool /*has_alpha*/);
+	GLuint _width, _height, _channels;
+	std::size_t _rowsize;
+	int _passes;
+	bool _done;
+
+	static GLenum _translate_format(GLuint channels);
 public:
-	PNGLoader(
-		std::istream& input,
-		Image& image,
+	PNGLoader(std::istream& input);
+
+	GLuint Width(void) const { return _width; }
+	GLuint Height(void) const { return _height; }
+	GLuint Channels(void) const { return _channels; }
+	std::size_t RowSize(void) const { return _rowsize; }
+	GLenum Format(void) const { return _translate_format(_channels); }
+	bool Done(void) const { return _done; }
+
+	void ReadRows(
+		::png_bytep dest,
+		std::size_t row_stride,
 		bool y_is_up,
 		bool x_is_right
 	);
@@ -242,7 +258,7 @@ void PNGLoader::_read_data(::png_bytep data, ::png_size_t size)
 	if(!_input.good())
 	{
 		throw std::runtime_error(
-			"Unable to read PNG signature"
+			"Unable to read PNG data"
 		);
 	}
 }
@@ -254,43 +270,32 @@ int PNGLoader::_read_user_chunk(::png_unknown_chunkp /*chunk*/)
 }
 
 OGLPLUS_LIB_FUNC
-GLenum PNGLoader::_translate_format(GLuint color_type, bool /*has_alpha*/)
+GLenum PNGLoader::_translate_format(GLuint channels)
 {
-	switch(color_type)
+	switch(channels)
 	{
-		case PNG_COLOR_TYPE_GRAY:
-			return GL_RED;
-		case PNG_COLOR_TYPE_GRAY_ALPHA:
-			return GL_RG;
-		case PNG_COLOR_TYPE_RGB:
-			return GL_RGB;
-		case PNG_COLOR_TYPE_RGB_ALPHA:
-			return GL_RGBA;
-		// TODO other color types
+		case 1: return GL_RED;
+		case 2: return GL_RG;
+		case 3: return GL_RGB;
+		case 4: return GL_RGBA;
 		default:;
 	}
-	OGLPLUS_ABORT("Unknown color type!");
+	OGLPLUS_ABORT("Unsupported number of channels!");
 	return 0;
 }
 
 OGLPLUS_LIB_FUNC
-PNGLoader::PNGLoader(
-	std::istream& input,
-	Image& image,
-	bool y_is_up,
-	bool x_is_right
-): _input(input)
+PNGLoader::PNGLoader(std::istream& input)
+ : _input(input)
  , _validate_header(_input)
  , _png(*this)
+ , _done(false)
 {
 	const size_t sig_size = 8;
 	::png_set_sig_bytes(_png._read, sig_size);
 	::png_read_info(_png._read, _png._info);
 
-	GLuint width = GLuint(png_get_image_width(_png._read, _png._info));
-	GLuint height = GLuint(png_get_image_height(_png._read, _png._info));
 	GLuint bitdepth = png_get_bit_depth(_png._read, _png._info);
-	GLuint channels = png_get_channels(_png._read, _png._info);
 	GLuint color_type = png_get_color_type(_png._read, _png._info);
 
 	// color conversions
@@ -298,24 +303,19 @@ PNGLoader::PNGLoader(
 	{
 		case PNG_COLOR_TYPE_PALETTE:
 			::png_set_palette_to_rgb(_png._read);
-			channels = 3;
 			break;
 		case PNG_COLOR_TYPE_GRAY:
 			if(bitdepth < 8)
 				::png_set_expand_gray_1_2_4_to_8(_png._read);
-			bitdepth = 8;
 			break;
 		// TODO: other conversions
 		default:;
 	}
 
 	// handle transparency
-	bool has_alpha = false;
 	if(::png_get_valid(_png._read, _png._info, PNG_INFO_tRNS))
 	{
 		::png_set_tRNS_to_alpha(_png._read);
-		channels += 1;
-		has_alpha = true;
 	}
 
 	// if there are too many bits per channel strip them down
@@ -324,70 +324,209 @@ PNGLoader::PNGLoader(
 		::png_set_strip_16(_png._read);
 	}
 
-	// bytes per row
-	GLuint rowsize = width * channels * bitdepth / 8;
-	// allocate the buffer
-	std::vector<GLubyte> data(rowsize * height, GLubyte(0));
+	_passes = ::png_set_interlace_handling(_png._read);
+
+	// get the properties of the transformed rows
+	::png_read_update_info(_png._read, _png._info);
+
+	_width = GLuint(png_get_image_width(_png._read, _png._info));
+	_height = GLuint(png_get_image_height(_png._read, _png._info));
+	_channels = png_get_channels(_png._read, _png._info);
+	_rowsize = png_get_rowbytes(_png._read, _png._info);
+
+	assert(_rowsize == std::size_t(_width)*_channels);
+}
+
+OGLPLUS_LIB_FUNC
+void PNGLoader::ReadRows(
+	::png_bytep dest,
+	std::size_t row_stride,
+	bool y_is_up,
+	bool x_is_right
+)
+{
+	assert(!_done);
+	assert(row_stride >= _rowsize);
+	_done = true;
+
+	auto row_ptr = [=](GLuint r) -> ::png_bytep
 	{
-		// allocate and initialize the row pointers
-		std::vector< ::png_bytep> rows(height);
-		//
-		for(GLuint r=0; r<height; ++r)
+		GLuint row = y_is_up? (_height-r-1): r;
+		return dest + std::size_t(row) * row_stride;
+	};
+
+	if(_passes > 1)
+	{
+		// interlaced images need the whole image for the passes
+		// but the rows still go directly into the destination
+		std::vector< ::png_bytep> rows(_height);
+		for(GLuint r=0; r<_height; ++r)
 		{
-			GLuint row = y_is_up? (height-r-1): r;
-			GLuint offs = row * rowsize;
-			rows[r] = reinterpret_cast<::png_bytep>(data.data()) + offs;
+			rows[r] = row_ptr(r);
 		}
-
-		// read
 		::png_read_image(_png._read, rows.data());
+	}
+	else
+	{
+		for(GLuint r=0; r<_height; ++r)
+		{
+			::png_read_row(_png._read, row_ptr(r), nullptr);
+		}
+	}
 
-		if(!x_is_right)
+	if(!x_is_right)
+	{
+		for(GLuint r=0; r<_height; ++r)
 		{
-			for(GLuint r=0; r<height; ++r)
+			::png_bytep row = row_ptr(r);
+			for(GLuint p=0; p<_width/2; ++p)
 			{
-				for(GLuint p=0; p<width/2; ++p)
+				::png_bytep a = row+p*_channels;
+				::png_bytep b = row+(_width-p-1)*_channels;
+				for(GLuint c=0; c<_channels; ++c)
 				{
-					for(GLuint c=0; c<channels; ++c)
-					{
-						::png_byte tmp = rows[r][p*channels+c];
-						rows[r][p*channels+c] = rows[r][(width-p-1)*channels+c];
-						rows[r][(width-p-1)*channels+c] = tmp;
-					}
+					std::swap(a[c], b[c]);
 				}
 			}
 		}
 	}
+}
+
+} // namespace aux
 
-	GLenum gl_format = _translate_format(color_type, has_alpha);
-	std::size_t size = data.size();
+OGLPLUS_LIB_FUNC
+PNGDecoder::PNGDecoder(const char* file_path)
+ : _file(file_path, std::ios::binary)
+ , _loader(new aux::PNGLoader(_file))
+{ }
 
-	assert(size % (width*height) == 0);
+OGLPLUS_LIB_FUNC
+PNGDecoder::PNGDecoder(std::istream& input)
+ : _loader(new aux::PNGLoader(input))
+{ }
 
-	image = Image(
-		width,
-		height,
-		1,
-		channels,
-		data.data(),
-		PixelDataFormat(gl_format),
-		PixelDataInternalFormat(gl_format)
+OGLPLUS_LIB_FUNC
+PNGDecoder::~PNGDecoder(void)
+{ }
+
+OGLPLUS_LIB_FUNC
+SizeType PNGDecoder::Width(void) const
+{
+	return MakeSizeType(GLsizei(_loader->Width()), std::nothrow);
+}
+
+OGLPLUS_LIB_FUNC
+SizeType PNGDecoder::Height(void) const
+{
+	return MakeSizeType(GLsizei(_loader->Height()), std::nothrow);
+}
+
+OGLPLUS_LIB_FUNC
+SizeType PNGDecoder::Channels(void) const
+{
+	return MakeSizeType(GLsizei(_loader->Channels()), std::nothrow);
+}
+
+OGLPLUS_LIB_FUNC
+PixelDataFormat PNGDecoder::Format(void) const
+{
+	return PixelDataFormat(_loader->Format());
+}
+
+OGLPLUS_LIB_FUNC
+PixelDataInternalFormat PNGDecoder::InternalFormat(void) const
+{
+	return PixelDataInternalFormat(_loader->Format());
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t PNGDecoder::RowSize(void) const
+{
+	return _loader->RowSize();
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t PNGDecoder::DataSize(void) const
+{
+	return _loader->RowSize()*_loader->Height();
+}
+
+OGLPLUS_LIB_FUNC
+bool PNGDecoder::Decoded(void) const
+{
+	return _loader->Done();
+}
+
+OGLPLUS_LIB_FUNC
+void PNGDecoder::DecodeStrided(
+	void* dest,
+	std::size_t dest_size,
+	std::size_t row_stride,
+	bool y_is_up,
+	bool x_is_right
+)
+{
+	if(_loader->Done())
+	{
+		throw std::runtime_error(
+			"PNG image was already decoded"
+		);
+	}
+	if(row_stride < RowSize())
+	{
+		throw std::runtime_error(
+			"PNG row stride is smaller than the row size"
+		);
+	}
+	std::size_t height = _loader->Height();
+	if((height != 0) && (dest_size < (height-1)*row_stride+RowSize()))
+	{
+		throw std::runtime_error(
+			"PNG decoding destination is too small"
+		);
+	}
+	_loader->ReadRows(
+		static_cast<::png_bytep>(dest),
+		row_stride,
+		y_is_up,
+		x_is_right
 	);
 }
 
-} // namespace aux
+OGLPLUS_LIB_FUNC
+void PNGImage::_decode(PNGDecoder& decoder, bool y_is_up, bool x_is_right)
+{
+	// allocate the storage and decode the rows directly into it
+	Image::operator = (Image(
+		decoder.Width(),
+		decoder.Height(),
+		1,
+		decoder.Channels(),
+		static_cast<GLubyte*>(nullptr),
+		decoder.Format(),
+		decoder.InternalFormat()
+	));
+	decoder.Decode(_begin<GLubyte>(), DataSize(), y_is_up, x_is_right);
+}
 
 OGLPLUS_LIB_FUNC
 PNGImage::PNGImage(const char* file_path, bool y_is_up, bool x_is_right)
 {
-	std::ifstream  file(file_path, std::ios::binary);
-	aux::PNGLoader(file, *this, y_is_up, x_is_right);
+	PNGDecoder decoder(file_path);
+	_decode(decoder, y_is_up, x_is_right);
 }
 
 OGLPLUS_LIB_FUNC
 PNGImage::PNGImage(std::istream& input, bool y_is_up, bool x_is_right)
 {
-	aux::PNGLoader(input, *this, y_is_up, x_is_right);
+	PNGDecoder decoder(input);
+	_decode(decoder, y_is_up, x_is_right);
+}
+
+OGLPLUS_LIB_FUNC
+PNGImage::PNGImage(PNGDecoder& decoder, bool y_is_up, bool x_is_right)
+{
+	_decode(decoder, y_is_up, x_is_right);
 }
 
 } // images
@@ -9,47 +9,106 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
-#include <cassert>
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/images/tiled.hpp>
+#include <oglplus/lib/incl_end.ipp>
+
 #include <cstdlib>
 
 namespace oglplus {
 namespace images {
 
+namespace aux {
+
+// Fills the image with random bytes, every tile with its own generator
+template <unsigned CH>
+inline void random_ubyte_image(
+	GLubyte* data,
+	GLsizei width,
+	GLsizei height,
+	GLsizei depth,
+	GLuint seed
+)
+{
+	ImageTileExecutor().Execute(
+		width, height, depth,
+		[=](const ImageTile& tile)
+		{
+			ImageTileRandom rand(seed, tile);
+			for(GLsizei j=tile.y; j!=tile.y+tile.height; ++j)
+			{
+				GLubyte* p = data+
+					((tile.z*height+j)*width+tile.x)*GLsizei(CH);
+				for(GLsizei i=0; i!=tile.width*GLsizei(CH); ++i)
+				{
+					*p++ = GLubyte(rand() >> 24);
+				}
+			}
+		}
+	);
+}
+
+} // namespace aux
+
+OGLPLUS_LIB_FUNC
+void RandomRedUByte::_make(GLuint seed)
+{
+	aux::random_ubyte_image<1>(
+		this->_begin_ub(),
+		GLsizei(Width()),
+		GLsizei(Height()),
+		GLsizei(Depth()),
+		seed
+	);
+}
+
 OGLPLUS_LIB_FUNC
 RandomRedUByte::RandomRedUByte(SizeType width, SizeType height, SizeType depth)
  : Image(width, height, depth, 1, &TypeTag<GLubyte>())
 {
-	auto p = this->_begin_ub(), e = this->_end_ub();
-	for(GLsizei k=0, d=depth; k<d; ++k)
-	for(GLsizei j=0, h=height; j<h; ++j)
-	for(GLsizei i=0, w=width; i<w; ++i)
-	{
-		assert(p != e);
-		*p = GLubyte(::std::rand() % 0x100);
-		++p;
-	}
-	OGLPLUS_FAKE_USE(e);
-	assert(p == e);
+	_make(GLuint(::std::rand()));
+}
+
+OGLPLUS_LIB_FUNC
+RandomRedUByte::RandomRedUByte(
+	SizeType width,
+	SizeType height,
+	SizeType depth,
+	GLuint seed
+): Image(width, height, depth, 1, &TypeTag<GLubyte>())
+{
+	_make(seed);
+}
+
+OGLPLUS_LIB_FUNC
+void RandomRGBUByte::_make(GLuint seed)
+{
+	aux::random_ubyte_image<3>(
+		this->_begin_ub(),
+		GLsizei(Width()),
+		GLsizei(Height()),
+		GLsizei(Depth()),
+		seed
+	);
 }
 
 OGLPLUS_LIB_FUNC
 RandomRGBUByte::RandomRGBUByte(SizeType width, SizeType height, SizeType depth)
  : Image(width, height, depth, 3, &TypeTag<GLubyte>())
 {
-	auto p = this->_begin_ub(), e = this->_end_ub();
-	for(GLsizei k=0, d=depth; k<d; ++k)
-	for(GLsizei j=0, h=height; j<h; ++j)
-	for(GLsizei i=0, w=width; i<w; ++i)
-	for(GLsizei c=0; c<3; ++c)
-	{
-		assert(p != e);
-		*p = GLubyte(::std::rand() % 0x100);
-		++p;
-	}
-	OGLPLUS_FAKE_USE(e);
-	assert(p == e);
+	_make(GLuint(::std::rand()));
+}
+
+OGLPLUS_LIB_FUNC
+RandomRGBUByte::RandomRGBUByte(
+	SizeType width,
+	SizeType height,
+	SizeType depth,
+	GLuint seed
+): Image(width, height, depth, 3, &TypeTag<GLubyte>())
+{
+	_make(seed);
 }
 
 } // images
 } // oglplus
-
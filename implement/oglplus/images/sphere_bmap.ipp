@@ -10,6 +10,7 @@
  */
 
 #include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/images/tiled.hpp>
 #include <oglplus/math/vector.hpp>
 #include <oglplus/lib/incl_end.ipp>
 
@@ -45,29 +46,35 @@ SphereBumpMap::SphereBumpMap(
 	GLsizei hi = width/xrep;
 	GLsizei hj = height/yrep;
 
-	auto p = this->_begin<GLfloat>();
-	for(GLsizei j=0; j<height; ++j)
-	{
-		number y = number((j % hj) - hj/2)*invh;
-		for(GLsizei i=0; i<width; ++i)
+	GLfloat* data = this->_begin<GLfloat>();
+
+	ImageTileExecutor().Execute(
+		width, height, 1,
+		[=](const ImageTile& tile)
 		{
-			number x = number((i % hi) - hi/2)*invw;
-			number l = std::sqrt(x*x + y*y);
-			number d = sqrt(one-l*l);
-			Vector<number, 3> z(0.0, 0.0, one);
-			Vector<number, 3> n(-x, -y, d);
-			Vector<number, 3> v = (l >= one)?
-				z:
-				Normalized(z+n);
-			if(l >= one) d = 0;
-			assert(p != this->_end<GLfloat>());
-			*p = GLfloat(v.x()); ++p;
-			*p = GLfloat(v.y()); ++p;
-			*p = GLfloat(v.z()); ++p;
-			*p = GLfloat(d); ++p;
+			for(GLsizei j=tile.y; j!=tile.y+tile.height; ++j)
+			{
+				number y = number((j % hj) - hj/2)*invh;
+				GLfloat* p = data+(j*width+tile.x)*4;
+				for(GLsizei i=tile.x; i!=tile.x+tile.width; ++i)
+				{
+					number x = number((i % hi) - hi/2)*invw;
+					number l = std::sqrt(x*x + y*y);
+					number d = sqrt(one-l*l);
+					Vector<number, 3> z(0.0, 0.0, one);
+					Vector<number, 3> n(-x, -y, d);
+					Vector<number, 3> v = (l >= one)?
+						z:
+						Normalized(z+n);
+					if(l >= one) d = 0;
+					*p = GLfloat(v.x()); ++p;
+					*p = GLfloat(v.y()); ++p;
+					*p = GLfloat(v.z()); ++p;
+					*p = GLfloat(d); ++p;
+				}
+			}
 		}
-	}
-	assert(p == this->_end<GLfloat>());
+	);
 }
 
 } // images
@@ -50,7 +50,8 @@ VoronoiDiagram::VoronoiDiagram(
 		cell_w, cell_h, cell_d,
 		input,
 		CellImageGen<GLubyte, 3>::EulerDistance(),
-		VoronoiNearestPointColor()
+		VoronoiNearestPointColor(),
+		0
 	)
 ))
 { }
@@ -74,7 +75,7 @@ VoronoiCells::VoronoiCells(
 	WorleyCellGen(
 		cell_w, cell_h, cell_d,
 		input,
-		VoronoiCellDistance(), 1
+		VoronoiCellDistance(), 1, 0
 	)
 ))
 { }
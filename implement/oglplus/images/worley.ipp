@@ -35,7 +35,7 @@ WorleyCells::WorleyCells(
 	WorleyCellGen(
 		cell_w, cell_h, cell_d,
 		input,
-		WorleyCellDistance(), 2
+		WorleyCellDistance(), 2, 0
 	)
 ))
 { }
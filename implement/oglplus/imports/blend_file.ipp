@@ -9,16 +9,14 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 #include <oglplus/config/basic.hpp>
+#include <algorithm>
 #include <cassert>
 
 namespace oglplus {
 namespace imports {
 
 OGLPLUS_LIB_FUNC
-BlendFile::BlendFile(std::istream& input)
- : _reader(input)
- , _info(_reader)
- , _glob_block_index(std::size_t(-1))
+void BlendFile::_load(void)
 {
 	std::size_t block_idx = 0;
 	while(!_eof(_reader))
@@ -56,7 +54,7 @@ BlendFile::BlendFile(std::istream& input)
 				)
 			);
 		}
-		_block_map[_blocks.back()._old_ptr] = block_idx++;
+		++block_idx;
 	}
 	if(_glob_block_index == std::size_t(-1))
 	{
@@ -66,6 +64,53 @@ BlendFile::BlendFile(std::istream& input)
 	{
 		throw std::runtime_error("Blend file does not contain SDNA block");
 	}
+	_make_block_index();
+}
+
+OGLPLUS_LIB_FUNC
+void BlendFile::_make_block_index(void)
+{
+	_block_index.reserve(_blocks.size());
+	for(std::size_t i=0, n=_blocks.size(); i!=n; ++i)
+	{
+		_block_index.push_back(_block_ref(_blocks[i]._old_ptr, i));
+	}
+	std::stable_sort(
+		_block_index.begin(),
+		_block_index.end(),
+		_block_ref_less()
+	);
+	// if several blocks have the same pointer keep the last one
+	auto i = _block_index.begin(), e = _block_index.end(), o = i;
+	while(i != e)
+	{
+		auto n = i+1;
+		if((n == e) || (n->first != i->first))
+		{
+			*o++ = *i;
+		}
+		i = n;
+	}
+	_block_index.erase(o, e);
+}
+
+OGLPLUS_LIB_FUNC
+BlendFile::BlendFile(std::istream& input)
+ : _reader(input)
+ , _info(_reader)
+ , _glob_block_index(std::size_t(-1))
+{
+	_load();
+}
+
+OGLPLUS_LIB_FUNC
+BlendFile::BlendFile(const char* path)
+ : _mapped(new BlendFileMappedInput(path))
+ , _reader(_mapped->Input())
+ , _info(_reader)
+ , _glob_block_index(std::size_t(-1))
+{
+	_load();
 }
 
 OGLPLUS_LIB_FUNC
@@ -75,31 +120,34 @@ const BlendFileBlock& BlendFile::BlockByPointer(
 ) const
 {
 	auto ptr = pointer.Value();
-	auto pos = _block_map.find(ptr);
-	if(allow_offset && (pos == _block_map.end()))
+	// find the last block starting at or before the pointer
+	auto pos = std::upper_bound(
+		_block_index.begin(),
+		_block_index.end(),
+		_block_ref(ptr, 0),
+		_block_ref_less()
+	);
+	if(pos != _block_index.begin())
 	{
-		auto pos2 = _block_map.lower_bound(ptr);
-		if(pos2 != _block_map.end())
+		--pos;
+		assert(!(ptr < pos->first));
+		assert(pos->second < _blocks.size());
+		if(pos->first == ptr)
 		{
-			if(pos2 != _block_map.begin())
+			return _blocks[pos->second];
+		}
+		if(allow_offset)
+		{
+			std::size_t size = _blocks[pos->second].Size();
+			if(ptr - pos->first < size)
 			{
-				--pos2;
-				assert(pos2->first < ptr);
-				assert(pos2->second < _blocks.size());
-				std::size_t size = _blocks[pos2->second].Size();
-				if(ptr - pos2->first < size) pos = pos2;
+				return _blocks[pos->second];
 			}
 		}
 	}
-	if(pos == _block_map.end())
-	{
-		throw std::runtime_error(
-			"Unable to find block by pointer"
-		);
-	}
-	assert(pos->second < _blocks.size());
-
-	return _blocks[pos->second];
+	throw std::runtime_error(
+		"Unable to find block by pointer"
+	);
 }
 
 OGLPLUS_LIB_FUNC
@@ -130,6 +178,26 @@ BlendFileFlatStructBlockData BlendFile::StructuredBlockByPointer(
 OGLPLUS_LIB_FUNC
 BlendFileBlockData BlendFile::BlockData(const BlendFileBlock& block)
 {
+	const std::size_t struct_size = _sdna->_type_sizes[
+		_sdna->_structs[block._sdna_index]._type_index
+	];
+	if(_mapped)
+	{
+		const std::size_t pos = std::size_t(block.DataPosition());
+		if(pos+block.Size() > _mapped->Size())
+		{
+			throw std::runtime_error(
+				"Blend file block data out of file bounds"
+			);
+		}
+		return BlendFileBlockData(
+			_mapped->Data()+pos,
+			block.Size(),
+			_info.ByteOrder(),
+			_info.PointerSize(),
+			struct_size
+		);
+	}
 	std::vector<char> data;
 	if(block.Size())
 	{
@@ -146,9 +214,7 @@ BlendFileBlockData BlendFile::BlockData(const BlendFileBlock& block)
 		std::move(data),
 		_info.ByteOrder(),
 		_info.PointerSize(),
-		_sdna->_type_sizes[
-			_sdna->_structs[block._sdna_index]._type_index
-		]
+		struct_size
 	);
 }
 
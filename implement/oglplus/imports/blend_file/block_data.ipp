@@ -23,12 +23,12 @@ BlendFilePointerTpl<Level> BlendFileBlockData::_do_make_pointer(
 	if(_ptr_size == 4)
 		return BlendFilePointerTpl<Level>(aux::ReorderToNative(
 			_byte_order,
-			*reinterpret_cast<const uint32_t*>(pos)
+			_read<uint32_t>(pos)
 		), type_index);
 	if(_ptr_size == 8)
 		return BlendFilePointerTpl<Level>(aux::ReorderToNative(
 			_byte_order,
-			*reinterpret_cast<const uint64_t*>(pos)
+			_read<uint64_t>(pos)
 		), type_index);
 	OGLPLUS_ABORT("Invalid pointer size!");
 	return BlendFilePointerTpl<Level>();
@@ -44,7 +44,7 @@ BlendFilePointerTpl<Level> BlendFileBlockData::_do_get_pointer(
 ) const
 {
 	const char* pos =
-		_block_data.data() +
+		_data +
 		data_offset +
 		block_element * _struct_size +
 		field_element * _ptr_size +
@@ -85,7 +85,7 @@ BlendFilePointer BlendFileBlockData::AsPointerTo(
 ) const
 {
 	const char* pos =
-		_block_data.data() +
+		_data +
 		data_offset +
 		index * _ptr_size;
 	return _do_make_pointer<1>(pos, type._type_index);
@@ -133,7 +133,7 @@ std::string BlendFileBlockData::GetString(
 ) const
 {
 	const char* pos =
-		_block_data.data() +
+		_data +
 		data_offset +
 		block_element * _struct_size +
 		field_element * field_size +
@@ -281,7 +281,7 @@ void BlendFileBlockData::ValueVisitRef(
 		else
 		{
 			visitor.VisitRaw(
-				_block_data.data() +
+				_data +
 				data_offset +
 				block_element * _struct_size +
 				flat_field.Offset(),
@@ -0,0 +1,329 @@
+/**
+ *  @file oglplus/pixel_readback.ipp
+ *  @brief Implementation of the PixelReadback
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <stdexcept>
+#include <cstring>
+#include <cassert>
+
+namespace oglplus {
+
+#if GL_VERSION_3_2 || GL_ARB_sync
+
+OGLPLUS_LIB_FUNC
+std::size_t PixelReadback::PixelSize(
+	PixelDataFormat format,
+	PixelDataType type
+)
+{
+	// the packed types store all components of a pixel together
+	switch(GLenum(type))
+	{
+		case GL_UNSIGNED_BYTE_3_3_2:
+		case GL_UNSIGNED_BYTE_2_3_3_REV:
+			return 1;
+		case GL_UNSIGNED_SHORT_5_6_5:
+		case GL_UNSIGNED_SHORT_5_6_5_REV:
+		case GL_UNSIGNED_SHORT_4_4_4_4:
+		case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+		case GL_UNSIGNED_SHORT_5_5_5_1:
+		case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+			return 2;
+		case GL_UNSIGNED_INT_8_8_8_8:
+		case GL_UNSIGNED_INT_8_8_8_8_REV:
+		case GL_UNSIGNED_INT_10_10_10_2:
+		case GL_UNSIGNED_INT_2_10_10_10_REV:
+#if GL_VERSION_3_0
+		case GL_UNSIGNED_INT_24_8:
+		case GL_UNSIGNED_INT_10F_11F_11F_REV:
+		case GL_UNSIGNED_INT_5_9_9_9_REV:
+#endif
+			return 4;
+#if GL_VERSION_3_0
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+			return 8;
+#endif
+		default:;
+	}
+
+	std::size_t component_size = 0;
+	switch(GLenum(type))
+	{
+		case GL_UNSIGNED_BYTE:
+		case GL_BYTE:
+			component_size = 1;
+			break;
+		case GL_UNSIGNED_SHORT:
+		case GL_SHORT:
+#if GL_VERSION_3_0
+		case GL_HALF_FLOAT:
+#endif
+			component_size = 2;
+			break;
+		case GL_UNSIGNED_INT:
+		case GL_INT:
+		case GL_FLOAT:
+			component_size = 4;
+			break;
+		default:;
+	}
+
+	std::size_t components = 0;
+	switch(GLenum(format))
+	{
+		case GL_RED:
+		case GL_GREEN:
+		case GL_BLUE:
+		case GL_ALPHA:
+		case GL_DEPTH_COMPONENT:
+		case GL_STENCIL_INDEX:
+#if GL_VERSION_3_0
+		case GL_RED_INTEGER:
+		case GL_GREEN_INTEGER:
+		case GL_BLUE_INTEGER:
+#endif
+			components = 1;
+			break;
+#if GL_VERSION_3_0
+		case GL_RG:
+		case GL_RG_INTEGER:
+			components = 2;
+			break;
+#endif
+		case GL_RGB:
+		case GL_BGR:
+#if GL_VERSION_3_0
+		case GL_RGB_INTEGER:
+		case GL_BGR_INTEGER:
+#endif
+			components = 3;
+			break;
+		case GL_RGBA:
+		case GL_BGRA:
+#if GL_VERSION_3_0
+		case GL_RGBA_INTEGER:
+		case GL_BGRA_INTEGER:
+#endif
+			components = 4;
+			break;
+		default:;
+	}
+
+	if((component_size == 0) || (components == 0))
+	{
+		throw std::runtime_error(
+			"PixelReadback: Unsupported pixel data format or type"
+		);
+	}
+	return components*component_size;
+}
+
+OGLPLUS_LIB_FUNC
+PixelReadback::PixelReadback(std::size_t latency)
+ : _slots(latency>0?latency:1)
+ , _oldest(0)
+ , _pending(0)
+ , _stall_count(0)
+ , _wait_timeout(10000000000ull) // 10 s
+{
+	_fences.reserve(_slots.size());
+	for(std::size_t s=0, n=_slots.size(); s!=n; ++s)
+	{
+		_fences.push_back(Sync());
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void PixelReadback::_retrieve(void)
+{
+	assert(_pending > 0);
+	_slot& slot = _slots[_oldest];
+	PixelReadbackFrame& frame = slot.frame;
+
+	const std::size_t row_size = std::size_t(frame.width)*frame.pixel_size;
+	const std::size_t size = row_size*std::size_t(frame.height);
+	const GLsizeiptr mapped_size = slot.row_stride*(frame.height-1)+
+		GLsizeiptr(row_size);
+
+	const BufferName previous = Buffer::Binding(BufferTarget::PixelPack);
+	slot.buffer.Bind(BufferTarget::PixelPack);
+	try
+	{
+		frame.data.resize(size);
+		if(size > 0)
+		{
+			BufferRawMap map(
+				BufferTarget::PixelPack,
+				BufferSize(0),
+				BufferSize(mapped_size),
+				BufferMapAccess::Read
+			);
+			const GLubyte* src =
+				static_cast<const GLubyte*>(map.RawData());
+			if(slot.row_stride == GLsizeiptr(row_size))
+			{
+				std::memcpy(frame.data.data(), src, size);
+			}
+			else
+			{
+				// drop the padding required by the pack alignment
+				for(GLsizei row=0; row!=frame.height; ++row)
+				{
+					std::memcpy(
+						frame.data.data()+row_size*std::size_t(row),
+						src+slot.row_stride*row,
+						row_size
+					);
+				}
+			}
+		}
+	}
+	catch(...)
+	{
+		Buffer::Bind(BufferTarget::PixelPack, previous);
+		throw;
+	}
+	Buffer::Bind(BufferTarget::PixelPack, previous);
+
+	_ready.push_back(std::move(frame));
+	frame.data = std::vector<GLubyte>();
+
+	_oldest = (_oldest+1) % _slots.size();
+	--_pending;
+}
+
+OGLPLUS_LIB_FUNC
+void PixelReadback::Read(
+	GLint x,
+	GLint y,
+	SizeType width,
+	SizeType height,
+	PixelDataFormat format,
+	PixelDataType type,
+	std::uint64_t tag
+)
+{
+	const std::size_t pixel_size = PixelSize(format, type);
+
+	if(_pending == _slots.size())
+	{
+		// all buffers are in flight, wait for the oldest one
+		if(aux::SyncWaitFlush(
+			_fences[_oldest],
+			_wait_timeout,
+			"PixelReadback"
+		))
+		{
+			++_stall_count;
+		}
+		_retrieve();
+	}
+
+	GLint alignment = 4;
+	OGLPLUS_GLFUNC(GetIntegerv)(GL_PACK_ALIGNMENT, &alignment);
+	OGLPLUS_VERIFY_SIMPLE(GetIntegerv);
+	if(alignment < 1) alignment = 1;
+
+	const GLsizeiptr row_size = GLsizeiptr(width)*GLsizeiptr(pixel_size);
+	const GLsizeiptr row_stride =
+		((row_size+alignment-1)/alignment)*alignment;
+	const GLsizeiptr size = row_stride*GLsizeiptr(height);
+
+	const std::size_t index = (_oldest+_pending) % _slots.size();
+	_slot& slot = _slots[index];
+
+	const BufferName previous = Buffer::Binding(BufferTarget::PixelPack);
+	slot.buffer.Bind(BufferTarget::PixelPack);
+	try
+	{
+		if(slot.capacity < size)
+		{
+			Buffer::Data(
+				BufferTarget::PixelPack,
+				BufferData(BufferSize(size), nullptr),
+				BufferUsage::StreamRead
+			);
+			slot.capacity = size;
+		}
+		if(size > 0)
+		{
+			OGLPLUS_GLFUNC(ReadPixels)(
+				x, y,
+				width, height,
+				GLenum(format),
+				GLenum(type),
+				nullptr
+			);
+			OGLPLUS_CHECK(
+				ReadPixels,
+				Error,
+				EnumParam(format)
+			);
+		}
+	}
+	catch(...)
+	{
+		Buffer::Bind(BufferTarget::PixelPack, previous);
+		throw;
+	}
+	Buffer::Bind(BufferTarget::PixelPack, previous);
+
+	_fences[index] = Sync();
+
+	slot.row_stride = row_stride;
+	slot.frame.tag = tag;
+	slot.frame.x = x;
+	slot.frame.y = y;
+	slot.frame.width = width;
+	slot.frame.height = height;
+	slot.frame.format = format;
+	slot.frame.type = type;
+	slot.frame.pixel_size = pixel_size;
+	++_pending;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t PixelReadback::Poll(std::vector<PixelReadbackFrame>& frames)
+{
+	// the fences are signaled in the order in which they were placed
+	while(
+		(_pending > 0) &&
+		aux::SyncSignaled(_fences[_oldest], "PixelReadback")
+	)
+	{
+		_retrieve();
+	}
+	const std::size_t count = _ready.size();
+	while(!_ready.empty())
+	{
+		frames.push_back(std::move(_ready.front()));
+		_ready.pop_front();
+	}
+	return count;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t PixelReadback::Flush(std::vector<PixelReadbackFrame>& frames)
+{
+	while(_pending > 0)
+	{
+		aux::SyncWaitFlush(
+			_fences[_oldest],
+			_wait_timeout,
+			"PixelReadback"
+		);
+		_retrieve();
+	}
+	return Poll(frames);
+}
+
+#endif // GL_VERSION_3_2 || GL_ARB_sync
+
+} // namespace oglplus
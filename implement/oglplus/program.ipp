@@ -13,6 +13,7 @@
 #include <oglplus/detail/info_log.hpp>
 #include <oglplus/object/reference.hpp>
 #include <oglplus/shader.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/lib/incl_end.ipp>
 
 namespace oglplus {
@@ -71,6 +72,7 @@ ObjectOps<tag::DirectState, tag::Program>::
 Link(void)
 {
 	OGLPLUS_GLFUNC(LinkProgram)(_obj_name());
+	ProgramReflection::Invalidate(*this);
 	OGLPLUS_CHECK(
 		LinkProgram,
 		ObjectError,
@@ -93,6 +95,7 @@ ObjectOps<tag::DirectState, tag::Program>::
 Link(std::nothrow_t)
 {
 	OGLPLUS_GLFUNC(LinkProgram)(_obj_name());
+	ProgramReflection::Invalidate(*this);
 	OGLPLUS_DEFERRED_CHECK(
 		LinkProgram,
 		ObjectError,
@@ -349,6 +352,7 @@ Binary(const std::vector<GLubyte>& binary, GLenum format)
 		binary.data(),
 		GLsizei(binary.size())
 	);
+	ProgramReflection::Invalidate(*this);
 	OGLPLUS_CHECK(
 		ProgramBinary,
 		ObjectError,
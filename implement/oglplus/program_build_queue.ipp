@@ -0,0 +1,278 @@
+/**
+ *  @file oglplus/program_build_queue.ipp
+ *  @brief Implementation of ProgramBuildQueue
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/object/reference.hpp>
+#include <oglplus/shader.hpp>
+#include <oglplus/program_reflection.hpp>
+#include <oglplus/error/program.hpp>
+#include <oglplus/lib/incl_end.ipp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+ProgramBuildQueue::ProgramBuildQueue(void)
+ : _parallel(false)
+{
+#if GL_KHR_parallel_shader_compile
+	_parallel = KHR_parallel_shader_compile::Available();
+#endif
+}
+
+OGLPLUS_LIB_FUNC
+ProgramBuildQueue::ProgramBuildQueue(bool use_parallel_compile)
+ : _parallel(false)
+{
+#if GL_KHR_parallel_shader_compile
+	_parallel = use_parallel_compile &&
+		KHR_parallel_shader_compile::Available();
+#else
+	(void)use_parallel_compile;
+#endif
+}
+
+template <typename Compiler>
+inline ProgramBuildQueue::Ticket
+ProgramBuildQueue::_submit(ProgramOps& program, Compiler compile)
+{
+	std::vector<ShaderName> entry_shaders;
+
+	ProgramOps::ShaderRange shaders = program.AttachedShaders();
+	while(!shaders.Empty())
+	{
+		Reference<ShaderOps> shader = shaders.Front();
+		// the status of shaders compiled by the queue is not queried
+		// until the results are requested, because that would block
+		if(_compiled.find(GetGLName(shader)) != _compiled.end())
+		{
+			entry_shaders.push_back(shader);
+		}
+		else if(!shader.IsCompiled())
+		{
+			compile(shader);
+			_compiled.insert(GetGLName(shader));
+			entry_shaders.push_back(shader);
+		}
+		shaders.Next();
+	}
+
+	OGLPLUS_GLFUNC(LinkProgram)(GetGLName(program));
+	ProgramReflection::Invalidate(program);
+	OGLPLUS_CHECK(
+		LinkProgram,
+		ObjectError,
+		Object(program)
+	);
+
+	// reuse the entries of the programs whose results were retrieved
+	std::size_t index;
+	if(_free.empty())
+	{
+		index = _entries.size();
+		_entries.push_back(_entry());
+		_entries.back().generation = 0;
+	}
+	else
+	{
+		index = _free.back();
+		_free.pop_back();
+	}
+	_entry& entry = _entries[index];
+	entry.program = &program;
+	entry.shaders = std::move(entry_shaders);
+	entry.finished = false;
+
+	const Ticket ticket(index, entry.generation);
+	_pending.push_back(ticket);
+	return ticket;
+}
+
+OGLPLUS_LIB_FUNC
+ProgramBuildQueue::Ticket
+ProgramBuildQueue::Submit(ProgramOps& program)
+{
+	return _submit(program, [](const ShaderOps& shader)
+	{
+		OGLPLUS_GLFUNC(CompileShader)(GetGLName(shader));
+		OGLPLUS_CHECK(
+			CompileShader,
+			ObjectError,
+			Object(shader).
+			EnumParam(shader.Type())
+		);
+	});
+}
+
+#if GL_ARB_shading_language_include
+OGLPLUS_LIB_FUNC
+ProgramBuildQueue::Ticket
+ProgramBuildQueue::SubmitInclude(
+	ProgramOps& program,
+	SizeType count,
+	const GLchar* const* paths,
+	const GLint* lengths
+)
+{
+	return _submit(program, [=](const ShaderOps& shader)
+	{
+		OGLPLUS_GLFUNC(CompileShaderIncludeARB)(
+			GetGLName(shader),
+			count,
+			const_cast<const GLchar**>(paths),
+			lengths
+		);
+		OGLPLUS_CHECK(
+			CompileShaderIncludeARB,
+			ObjectError,
+			Object(shader).
+			EnumParam(shader.Type())
+		);
+	});
+}
+#endif
+
+OGLPLUS_LIB_FUNC
+bool ProgramBuildQueue::_is_finished(const _entry& entry) const
+{
+	if(entry.finished)
+	{
+		return true;
+	}
+#if GL_KHR_parallel_shader_compile
+	if(_parallel)
+	{
+		// the link is issued after the compilation of the shaders
+		// so the program is finished only after all its shaders
+		return KHR_parallel_shader_compile::CompletionStatus(
+			ProgramName(*entry.program)
+		);
+	}
+#endif
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramBuildQueue::_is_valid(Ticket ticket) const
+{
+	return	(ticket._index < _entries.size()) &&
+		(_entries[ticket._index].program != nullptr) &&
+		(_entries[ticket._index].generation == ticket._generation);
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramBuildQueue::_release(std::size_t index)
+{
+	_entry& entry = _entries[index];
+	assert(entry.program != nullptr);
+	entry.program = nullptr;
+	entry.shaders.clear();
+	++entry.generation;
+	_free.push_back(index);
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t ProgramBuildQueue::Poll(std::vector<Ticket>& finished)
+{
+	std::size_t count = 0;
+	auto p = _pending.begin();
+	while(p != _pending.end())
+	{
+		_entry& entry = _entries[p->_index];
+		if(_is_finished(entry))
+		{
+			entry.finished = true;
+			finished.push_back(*p);
+			p = _pending.erase(p);
+			++count;
+		}
+		else ++p;
+	}
+	// the shader names may be reused after the shaders are deleted
+	if(_pending.empty())
+	{
+		_compiled.clear();
+	}
+	return count;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramBuildQueue::Finished(Ticket ticket) const
+{
+	assert(_is_valid(ticket));
+	return _is_finished(_entries[ticket._index]);
+}
+
+OGLPLUS_LIB_FUNC
+Outcome<ProgramOps&> ProgramBuildQueue::Result(Ticket ticket)
+{
+	assert(_is_valid(ticket));
+	_entry& entry = _entries[ticket._index];
+
+	if(!entry.finished)
+	{
+		_pending.erase(std::find(_pending.begin(), _pending.end(), ticket));
+		if(_pending.empty())
+		{
+			_compiled.clear();
+		}
+	}
+
+	// the entry is released before the result is checked
+	// because the error handler may throw
+	ProgramOps& program = *entry.program;
+	std::vector<ShaderName> shaders;
+	shaders.swap(entry.shaders);
+	_release(ticket._index);
+
+	for(const ShaderName& shader_name : shaders)
+	{
+		Reference<ShaderOps> shader(shader_name);
+		OGLPLUS_RETURN_HANDLER_IF(
+			!shader.IsCompiled(),
+			GL_INVALID_OPERATION,
+			CompileError::Message(),
+			CompileError,
+			Log(shader.GetInfoLog()).
+			Object(shader).
+			EnumParam(shader.Type())
+		);
+	}
+
+	ProgramOps* program_ptr = &program;
+	OGLPLUS_RETURN_HANDLER_IF(
+		!program.IsLinked(),
+		GL_INVALID_OPERATION,
+		LinkError::Message(),
+		LinkError,
+		Log(program_ptr->GetInfoLog()).
+		Object(*program_ptr)
+	);
+	return program;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramBuildQueue::Clear(void)
+{
+	for(std::size_t i=0; i!=_entries.size(); ++i)
+	{
+		if(_entries[i].program != nullptr)
+		{
+			_release(i);
+		}
+	}
+	_pending.clear();
+	_compiled.clear();
+}
+
+} // namespace oglplus
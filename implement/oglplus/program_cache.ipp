@@ -0,0 +1,619 @@
+/**
+ *  @file oglplus/program_cache.ipp
+ *  @brief Implementation of ProgramCache
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/object/reference.hpp>
+#include <oglplus/shader.hpp>
+#include <oglplus/named_string.hpp>
+#include <oglplus/context/string_queries.hpp>
+#include <oglplus/utils/filesystem.hpp>
+#include <oglplus/lib/incl_end.ipp>
+
+#include <fstream>
+#include <chrono>
+#include <set>
+#include <cstdio>
+#include <cstring>
+
+namespace oglplus {
+
+#if GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+namespace aux {
+
+// Two-lane 64-bit hash of the data identifying the cache entries
+// and checking the stored binaries
+class ProgramCacheHash
+{
+private:
+	std::uint64_t _a, _b;
+
+	static std::uint64_t _fin(std::uint64_t z)
+	{
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+public:
+	ProgramCacheHash(void)
+	 : _a(0xCBF29CE484222325ull)
+	 , _b(0x9E3779B97F4A7C15ull)
+	{ }
+
+	void AddBytes(const void* data, std::size_t size)
+	{
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+		for(std::size_t i=0; i!=size; ++i)
+		{
+			_a = (_a ^ p[i]) * 0x100000001B3ull;
+			_b = (_b ^ p[i]) * 0xFF51AFD7ED558CCDull;
+			_b ^= _b >> 29;
+		}
+	}
+
+	// adds the value in a byte-order independent way
+	void AddValue(std::uint64_t value)
+	{
+		unsigned char bytes[8];
+		for(unsigned i=0; i!=8; ++i)
+		{
+			bytes[i] = (unsigned char)(value >> (i*8));
+		}
+		AddBytes(bytes, sizeof(bytes));
+	}
+
+	// the length is added first so that the boundaries between
+	// the consecutive strings are a part of the hash
+	void AddString(const char* str, std::size_t size)
+	{
+		AddValue(size);
+		AddBytes(str, size);
+	}
+
+	void AddString(const std::string& str)
+	{
+		AddString(str.data(), str.size());
+	}
+
+	std::uint64_t First(void) const
+	{
+		return _fin(_a);
+	}
+
+	std::uint64_t Second(void) const
+	{
+		return _fin(_b ^ _fin(_a));
+	}
+};
+
+#if GL_ARB_shading_language_include
+
+// finds the names in the #include directives of a GLSL source
+inline void ProgramCacheFindIncludes(
+	const String& source,
+	std::vector<String>& names
+)
+{
+	std::size_t pos = 0, end = source.size();
+	while(pos < end)
+	{
+		std::size_t eol = source.find('\n', pos);
+		if(eol == String::npos) eol = end;
+
+		std::size_t i = pos;
+		while(i < eol && (source[i] == ' ' || source[i] == '\t')) ++i;
+		if(i < eol && source[i] == '#')
+		{
+			++i;
+			while(i < eol && (source[i]==' ' || source[i]=='\t')) ++i;
+			if(source.compare(i, 7, "include") == 0)
+			{
+				i += 7;
+				while(i<eol && (source[i]==' '||source[i]=='\t')) ++i;
+				if(i < eol && (source[i] == '"' || source[i] == '<'))
+				{
+					const char close = (source[i] == '"')?'"':'>';
+					std::size_t b = ++i;
+					while(i < eol && source[i] != close) ++i;
+					if(i < eol) names.push_back(source.substr(b, i-b));
+				}
+			}
+		}
+		pos = eol+1;
+	}
+}
+
+inline String ProgramCacheJoinPath(const String& dir, const String& name)
+{
+	if(dir.empty()) return name;
+	if(dir[dir.size()-1] == '/') return dir+name;
+	return dir+"/"+name;
+}
+
+// resolves an included name to the name of an existing named string
+// the same way as the GL does, relative to the directory
+// of the including string and then to the search paths
+inline bool ProgramCacheResolveInclude(
+	const String& name,
+	const String& parent_dir,
+	SizeType count,
+	const GLchar* const* paths,
+	const GLint* lengths,
+	String& result
+)
+{
+	if(!name.empty() && name[0] == '/')
+	{
+		result = name;
+		return NamedString::IsA(result);
+	}
+	if(!parent_dir.empty())
+	{
+		result = ProgramCacheJoinPath(parent_dir, name);
+		if(NamedString::IsA(result)) return true;
+	}
+	for(GLsizei p=0; p!=GLsizei(count); ++p)
+	{
+		const String dir = (lengths && lengths[p] >= 0)?
+			String(paths[p], std::size_t(lengths[p])):
+			String(paths[p]);
+		result = ProgramCacheJoinPath(dir, name);
+		if(NamedString::IsA(result)) return true;
+	}
+	return false;
+}
+
+// adds the named strings included by the source (recursively) to the hash
+inline void ProgramCacheHashIncludes(
+	ProgramCacheHash& hash,
+	const String& source,
+	const String& source_dir,
+	SizeType count,
+	const GLchar* const* paths,
+	const GLint* lengths,
+	std::set<String>& visited
+)
+{
+	std::vector<String> names;
+	ProgramCacheFindIncludes(source, names);
+
+	for(const String& name : names)
+	{
+		hash.AddString(name);
+
+		String resolved;
+		if(!ProgramCacheResolveInclude(
+			name,
+			source_dir,
+			count,
+			paths,
+			lengths,
+			resolved
+		))
+		{
+			// the build fails anyway, but it may succeed
+			// later when the named string is defined
+			hash.AddValue(0);
+			continue;
+		}
+		hash.AddString(resolved);
+
+		if(visited.insert(resolved).second)
+		{
+			const String content = NamedString::Get(resolved);
+			hash.AddString(content);
+
+			ProgramCacheHashIncludes(
+				hash,
+				content,
+				resolved.substr(0, resolved.rfind('/')),
+				count,
+				paths,
+				lengths,
+				visited
+			);
+		}
+	}
+}
+#endif // GL_ARB_shading_language_include
+
+// the layout of the cache entry header
+// magic, key check, binary format, binary size, binary checksum
+static const char program_cache_magic[8] = {
+	'O','G','L','P','B','I','N','1'
+};
+static const std::size_t program_cache_header_size = 8+8+4+4+8;
+static const std::size_t program_cache_max_binary_size = 1u << 28;
+
+inline void ProgramCachePut(unsigned char* dst, std::uint64_t v, unsigned n)
+{
+	for(unsigned i=0; i!=n; ++i)
+	{
+		dst[i] = (unsigned char)(v >> (i*8));
+	}
+}
+
+inline std::uint64_t ProgramCacheGet(const unsigned char* src, unsigned n)
+{
+	std::uint64_t v = 0;
+	for(unsigned i=0; i!=n; ++i)
+	{
+		v |= std::uint64_t(src[i]) << (i*8);
+	}
+	return v;
+}
+
+inline std::uint64_t ProgramCacheChecksum(
+	const std::vector<GLubyte>& binary,
+	GLenum format
+)
+{
+	ProgramCacheHash hash;
+	hash.AddValue(format);
+	hash.AddValue(binary.size());
+	hash.AddBytes(binary.data(), binary.size());
+	return hash.Second();
+}
+
+inline GLint ProgramCacheNumBinaryFormats(void)
+{
+	GLint result = 0;
+	OGLPLUS_GLFUNC(GetIntegerv)(GL_NUM_PROGRAM_BINARY_FORMATS, &result);
+	OGLPLUS_VERIFY_SIMPLE(GetIntegerv);
+	return result;
+}
+
+} // namespace aux
+
+OGLPLUS_LIB_FUNC
+ProgramCache::ProgramCache(const std::string& directory)
+ : _directory(directory)
+ , _driver(DriverIdentity())
+ , _enabled(aux::ProgramCacheNumBinaryFormats() > 0)
+ , _hit_count(0)
+ , _miss_count(0)
+ , _store_count(0)
+ , _discard_count(0)
+{ }
+
+OGLPLUS_LIB_FUNC
+ProgramCache::ProgramCache(
+	const std::string& directory,
+	const std::string& driver_identity
+): _directory(directory)
+ , _driver(driver_identity)
+ , _enabled(aux::ProgramCacheNumBinaryFormats() > 0)
+ , _hit_count(0)
+ , _miss_count(0)
+ , _store_count(0)
+ , _discard_count(0)
+{ }
+
+OGLPLUS_LIB_FUNC
+std::string ProgramCache::DriverIdentity(void)
+{
+	std::string result;
+	const char* vendor = context::StringQueries::Vendor();
+	const char* renderer = context::StringQueries::Renderer();
+	const char* version = context::StringQueries::Version();
+	if(vendor) result.append(vendor);
+	result.append(1, '\n');
+	if(renderer) result.append(renderer);
+	result.append(1, '\n');
+	if(version) result.append(version);
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+ProgramCache::_key_t ProgramCache::_make_key(
+	const ProgramOps& program,
+	SizeType count,
+	const GLchar* const* paths,
+	const GLint* lengths,
+	const StrCRef& variant
+) const
+{
+	aux::ProgramCacheHash hash;
+	hash.AddString(_driver);
+	hash.AddString(variant.begin(), variant.size());
+
+	hash.AddValue(std::uint64_t(count));
+	for(GLsizei p=0; p!=GLsizei(count); ++p)
+	{
+		if(lengths && lengths[p] >= 0)
+		{
+			hash.AddString(paths[p], std::size_t(lengths[p]));
+		}
+		else hash.AddString(paths[p], std::strlen(paths[p]));
+	}
+
+#if GL_ARB_shading_language_include
+	std::set<String> visited;
+#endif
+	ProgramOps::ShaderRange shaders = program.AttachedShaders();
+	hash.AddValue(shaders.Size());
+	while(!shaders.Empty())
+	{
+		Reference<ShaderOps> shader = shaders.Front();
+		const String source = shader.GetSource();
+		hash.AddValue(GLenum(shader.Type()));
+		hash.AddString(source);
+#if GL_ARB_shading_language_include
+		aux::ProgramCacheHashIncludes(
+			hash,
+			source,
+			String(),
+			count,
+			paths,
+			lengths,
+			visited
+		);
+#endif
+		shaders.Next();
+	}
+
+	_key_t key;
+	key.name = hash.First();
+	key.check = hash.Second();
+	return key;
+}
+
+OGLPLUS_LIB_FUNC
+std::string ProgramCache::_entry_path(const _key_t& key) const
+{
+	static const char hex[] = "0123456789abcdef";
+	char name[17];
+	for(unsigned i=0; i!=16; ++i)
+	{
+		name[i] = hex[(key.name >> ((15-i)*4)) & 0xF];
+	}
+	name[16] = '\0';
+
+	std::string result(_directory);
+	if(!result.empty() && !aux::IsFilesysPathSep(
+		result.c_str()+result.size()-1, 1
+	)) result.append(aux::FilesysPathSep());
+	result.append(name);
+	result.append(".glbin");
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+std::string ProgramCache::EntryPath(
+	const ProgramOps& program,
+	const StrCRef& variant
+) const
+{
+	return _entry_path(_make_key(program, 0, nullptr, nullptr, variant));
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramCache::_discard(const std::string& path)
+{
+	std::remove(path.c_str());
+	++_discard_count;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramCache::_load(ProgramOps& program, const _key_t& key)
+{
+	const std::string path = _entry_path(key);
+	std::vector<GLubyte> binary;
+	GLenum format = GL_NONE;
+	{
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		if(!file.is_open())
+		{
+			return false;
+		}
+
+		unsigned char header[aux::program_cache_header_size];
+		file.read((char*)header, sizeof(header));
+
+		bool valid = file.good() && (std::memcmp(
+			header,
+			aux::program_cache_magic,
+			sizeof(aux::program_cache_magic)
+		) == 0);
+
+		const unsigned char* p = header+8;
+		const std::uint64_t check = aux::ProgramCacheGet(p, 8);
+		format = GLenum(aux::ProgramCacheGet(p+8, 4));
+		const std::size_t size = std::size_t(aux::ProgramCacheGet(p+12,4));
+		const std::uint64_t checksum = aux::ProgramCacheGet(p+16, 8);
+
+		// a different program with the same entry name is not
+		// an error, the entry is replaced when it is built
+		if(valid && (check != key.check))
+		{
+			return false;
+		}
+		valid &= (size > 0) && (size <= aux::program_cache_max_binary_size);
+
+		if(valid)
+		{
+			binary.resize(size);
+			file.read((char*)binary.data(), std::streamsize(size));
+			valid = file.good() && (file.peek() == EOF);
+		}
+		valid &= (aux::ProgramCacheChecksum(binary, format) == checksum);
+
+		if(!valid)
+		{
+			file.close();
+			_discard(path);
+			return false;
+		}
+	}
+
+	// the binary may be rejected for example after a driver update
+	// with an unchanged version string
+	try { program.Binary(binary, format); }
+	catch(Error&) { }
+
+	if(!program.IsLinked())
+	{
+		_discard(path);
+		return false;
+	}
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramCache::_store(const ProgramOps& program, const _key_t& key)
+{
+	std::vector<GLubyte> binary;
+	GLenum format = GL_NONE;
+
+	try { program.GetBinary(binary, format); }
+	catch(Error&) { return false; }
+
+	if(binary.empty() || binary.size() > aux::program_cache_max_binary_size)
+	{
+		return false;
+	}
+
+	unsigned char header[aux::program_cache_header_size];
+	std::memcpy(header, aux::program_cache_magic, 8);
+	aux::ProgramCachePut(header+ 8, key.check, 8);
+	aux::ProgramCachePut(header+16, format, 4);
+	aux::ProgramCachePut(header+20, binary.size(), 4);
+	aux::ProgramCachePut(
+		header+24,
+		aux::ProgramCacheChecksum(binary, format),
+		8
+	);
+
+	// the temporary file name must be unique among the processes
+	// which may be storing the same entry concurrently
+	const std::string path = _entry_path(key);
+	aux::ProgramCacheHash unique;
+	unique.AddValue(std::uint64_t(
+		std::chrono::high_resolution_clock::now().time_since_epoch().count()
+	));
+	unique.AddValue(std::uint64_t(reinterpret_cast<std::uintptr_t>(this)));
+	unique.AddValue(_store_count);
+
+	std::string temp_path(path);
+	temp_path.append(".tmp");
+	for(std::uint64_t u = unique.First() & 0xFFFFFFFF; u; u >>= 4)
+	{
+		temp_path.append(1, char('a'+(u & 0xF)));
+	}
+
+	bool written = false;
+	{
+		std::ofstream file(
+			temp_path,
+			std::ios::out | std::ios::binary | std::ios::trunc
+		);
+		if(file.is_open())
+		{
+			file.write((const char*)header, sizeof(header));
+			file.write(
+				(const char*)binary.data(),
+				std::streamsize(binary.size())
+			);
+			file.flush();
+			written = file.good();
+		}
+	}
+
+	if(written)
+	{
+		if(std::rename(temp_path.c_str(), path.c_str()) != 0)
+		{
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+			// rename does not replace existing files on Windows
+			std::remove(path.c_str());
+			written = std::rename(temp_path.c_str(), path.c_str()) == 0;
+#else
+			written = false;
+#endif
+		}
+	}
+	if(!written)
+	{
+		std::remove(temp_path.c_str());
+		return false;
+	}
+	++_store_count;
+	return true;
+}
+
+template <typename Builder>
+inline Outcome<ProgramOps&> ProgramCache::_build(
+	ProgramOps& program,
+	const _key_t& key,
+	Builder build
+)
+{
+	if(_load(program, key))
+	{
+		++_hit_count;
+		return Outcome<ProgramOps&>(program);
+	}
+	++_miss_count;
+
+	program.MakeRetrievable(true);
+	Outcome<ProgramOps&> outcome = build();
+	if(!outcome.Done())
+	{
+		return outcome;
+	}
+	_store(program, key);
+	return outcome;
+}
+
+OGLPLUS_LIB_FUNC
+Outcome<ProgramOps&> ProgramCache::Build(
+	ProgramOps& program,
+	const StrCRef& variant
+)
+{
+	if(!_enabled)
+	{
+		++_miss_count;
+		return program.Build();
+	}
+	return _build(
+		program,
+		_make_key(program, 0, nullptr, nullptr, variant),
+		[&program](void) { return program.Build(); }
+	);
+}
+
+#if GL_ARB_shading_language_include
+OGLPLUS_LIB_FUNC
+Outcome<ProgramOps&> ProgramCache::BuildInclude(
+	ProgramOps& program,
+	SizeType count,
+	const GLchar* const* paths,
+	const GLint* lengths,
+	const StrCRef& variant
+)
+{
+	if(!_enabled)
+	{
+		++_miss_count;
+		return program.BuildInclude(count, paths, lengths);
+	}
+	return _build(
+		program,
+		_make_key(program, count, paths, lengths, variant),
+		[&](void) { return program.BuildInclude(count, paths, lengths); }
+	);
+}
+#endif
+
+#endif // GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+} // namespace oglplus
@@ -0,0 +1,331 @@
+/**
+ *  @file oglplus/program_reflection.ipp
+ *  @brief Implementation of ProgramReflection
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/glfunc.hpp>
+#include <oglplus/error/object.hpp>
+#include <oglplus/lib/incl_end.ipp>
+#include <vector>
+#include <cassert>
+
+namespace oglplus {
+
+OGLPLUS_LIB_FUNC
+std::map<GLuint, ProgramReflection>&
+ProgramReflection::_registry(void)
+{
+	static std::map<GLuint, ProgramReflection> registry;
+	return registry;
+}
+
+OGLPLUS_LIB_FUNC
+ProgramReflection* ProgramReflection::_find(GLuint prog_name)
+{
+	std::map<GLuint, ProgramReflection>& registry = _registry();
+	if(registry.empty()) return nullptr;
+
+	auto pos = registry.find(prog_name);
+	if(pos == registry.end()) return nullptr;
+
+	if(!pos->second._valid)
+	{
+		pos->second._build(prog_name);
+	}
+	return &pos->second;
+}
+
+OGLPLUS_LIB_FUNC
+const ProgramReflection::VariableInfo*
+ProgramReflection::_lookup(const _var_map& vars, StrCRef identifier)
+{
+	String key(identifier.begin(), identifier.end());
+	auto pos = vars.find(key);
+	if(pos != vars.end()) return &pos->second;
+
+	// the GL reports the names of arrays with the [0] suffix
+	// but allows to get their location by the plain name
+	if(!key.empty() && (key.back() != ']'))
+	{
+		key.append("[0]");
+		pos = vars.find(key);
+		if(pos != vars.end()) return &pos->second;
+	}
+	return nullptr;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::_build_uniforms(GLuint prog_name)
+{
+	GLint count = 0, max_len = 0;
+	OGLPLUS_GLFUNC(GetProgramiv)(prog_name, GL_ACTIVE_UNIFORMS, &count);
+	OGLPLUS_VERIFY(
+		GetProgramiv,
+		ObjectError,
+		Object(ProgramName(prog_name)).
+		EnumParam(GLenum(GL_ACTIVE_UNIFORMS))
+	);
+	OGLPLUS_GLFUNC(GetProgramiv)(
+		prog_name,
+		GL_ACTIVE_UNIFORM_MAX_LENGTH,
+		&max_len
+	);
+	OGLPLUS_VERIFY(
+		GetProgramiv,
+		ObjectError,
+		Object(ProgramName(prog_name)).
+		EnumParam(GLenum(GL_ACTIVE_UNIFORM_MAX_LENGTH))
+	);
+	assert(!(count < 0));
+	assert(!(max_len < 0));
+
+	if(count == 0) return;
+
+	std::size_t n = std::size_t(count);
+	std::vector<GLchar> buffer(std::size_t(max_len)+1);
+	std::vector<GLuint> indices(n);
+	std::vector<GLint> block_indices(n, -1);
+
+#if GL_VERSION_3_1 || GL_ARB_uniform_buffer_object
+	for(GLint index=0; index<count; ++index)
+	{
+		indices[std::size_t(index)] = GLuint(index);
+	}
+	// get the block indices of all uniforms in a single call
+	OGLPLUS_GLFUNC(GetActiveUniformsiv)(
+		prog_name,
+		count,
+		indices.data(),
+		GL_UNIFORM_BLOCK_INDEX,
+		block_indices.data()
+	);
+	OGLPLUS_VERIFY(
+		GetActiveUniformsiv,
+		ObjectError,
+		Object(ProgramName(prog_name)).
+		EnumParam(GLenum(GL_UNIFORM_BLOCK_INDEX))
+	);
+#endif
+
+	for(GLint index=0; index<count; ++index)
+	{
+		GLsizei length = 0;
+		VariableInfo info;
+		OGLPLUS_GLFUNC(GetActiveUniform)(
+			prog_name,
+			GLuint(index),
+			GLsizei(buffer.size()),
+			&length,
+			&info.size,
+			&info.type,
+			buffer.data()
+		);
+		OGLPLUS_VERIFY(
+			GetActiveUniform,
+			ObjectError,
+			Object(ProgramName(prog_name)).
+			Index(GLuint(index))
+		);
+		assert(!(length < 0));
+
+		info.block_index = block_indices[std::size_t(index)];
+		info.location = -1;
+
+		if(info.block_index < 0)
+		{
+			info.location = OGLPLUS_GLFUNC(GetUniformLocation)(
+				prog_name,
+				buffer.data()
+			);
+			OGLPLUS_VERIFY(
+				GetUniformLocation,
+				ObjectError,
+				Object(ProgramName(prog_name))
+			);
+		}
+		_uniforms.insert(_var_map::value_type(
+			String(buffer.data(), std::size_t(length)),
+			info
+		));
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::_build_attribs(GLuint prog_name)
+{
+	GLint count = 0, max_len = 0;
+	OGLPLUS_GLFUNC(GetProgramiv)(prog_name, GL_ACTIVE_ATTRIBUTES, &count);
+	OGLPLUS_VERIFY(
+		GetProgramiv,
+		ObjectError,
+		Object(ProgramName(prog_name)).
+		EnumParam(GLenum(GL_ACTIVE_ATTRIBUTES))
+	);
+	OGLPLUS_GLFUNC(GetProgramiv)(
+		prog_name,
+		GL_ACTIVE_ATTRIBUTE_MAX_LENGTH,
+		&max_len
+	);
+	OGLPLUS_VERIFY(
+		GetProgramiv,
+		ObjectError,
+		Object(ProgramName(prog_name)).
+		EnumParam(GLenum(GL_ACTIVE_ATTRIBUTE_MAX_LENGTH))
+	);
+	assert(!(count < 0));
+	assert(!(max_len < 0));
+
+	std::vector<GLchar> buffer(std::size_t(max_len)+1);
+
+	for(GLint index=0; index<count; ++index)
+	{
+		GLsizei length = 0;
+		VariableInfo info;
+		OGLPLUS_GLFUNC(GetActiveAttrib)(
+			prog_name,
+			GLuint(index),
+			GLsizei(buffer.size()),
+			&length,
+			&info.size,
+			&info.type,
+			buffer.data()
+		);
+		OGLPLUS_VERIFY(
+			GetActiveAttrib,
+			ObjectError,
+			Object(ProgramName(prog_name)).
+			Index(GLuint(index))
+		);
+		assert(!(length < 0));
+
+		info.block_index = -1;
+		info.location = OGLPLUS_GLFUNC(GetAttribLocation)(
+			prog_name,
+			buffer.data()
+		);
+		OGLPLUS_VERIFY(
+			GetAttribLocation,
+			ObjectError,
+			Object(ProgramName(prog_name))
+		);
+		_attribs.insert(_var_map::value_type(
+			String(buffer.data(), std::size_t(length)),
+			info
+		));
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::_build(GLuint prog_name)
+{
+	_uniforms.clear();
+	_attribs.clear();
+
+	GLint linked = GL_FALSE;
+	OGLPLUS_GLFUNC(GetProgramiv)(prog_name, GL_LINK_STATUS, &linked);
+	OGLPLUS_VERIFY(
+		GetProgramiv,
+		ObjectError,
+		Object(ProgramName(prog_name)).
+		EnumParam(GLenum(GL_LINK_STATUS))
+	);
+	// the table of a program that is not linked yet stays invalid
+	// and every lookup falls back to the GL until it is linked
+	if(linked != GL_TRUE) return;
+
+	_build_uniforms(prog_name);
+	_build_attribs(prog_name);
+	_valid = true;
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::Enable(ProgramName program)
+{
+	_registry()[GetGLName(program)];
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::Disable(ProgramName program)
+{
+	std::map<GLuint, ProgramReflection>& registry = _registry();
+	if(!registry.empty())
+	{
+		registry.erase(GetGLName(program));
+	}
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::IsEnabled(ProgramName program)
+{
+	std::map<GLuint, ProgramReflection>& registry = _registry();
+	return registry.find(GetGLName(program)) != registry.end();
+}
+
+OGLPLUS_LIB_FUNC
+void ProgramReflection::Invalidate(ProgramName program)
+{
+	std::map<GLuint, ProgramReflection>& registry = _registry();
+	if(registry.empty()) return;
+
+	auto pos = registry.find(GetGLName(program));
+	if(pos != registry.end())
+	{
+		pos->second._valid = false;
+		pos->second._uniforms.clear();
+		pos->second._attribs.clear();
+	}
+}
+
+OGLPLUS_LIB_FUNC
+const ProgramReflection* ProgramReflection::Get(ProgramName program)
+{
+	ProgramReflection* refl = _find(GetGLName(program));
+	if(refl && refl->_valid) return refl;
+	return nullptr;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::QueryUniform(
+	ProgramName program,
+	StrCRef identifier,
+	VariableInfo& info
+)
+{
+	if(const ProgramReflection* refl = Get(program))
+	{
+		if(const VariableInfo* found = refl->FindUniform(identifier))
+		{
+			info = *found;
+			return true;
+		}
+	}
+	return false;
+}
+
+OGLPLUS_LIB_FUNC
+bool ProgramReflection::QueryAttrib(
+	ProgramName program,
+	StrCRef identifier,
+	VariableInfo& info
+)
+{
+	if(const ProgramReflection* refl = Get(program))
+	{
+		if(const VariableInfo* found = refl->FindAttrib(identifier))
+		{
+			info = *found;
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace oglplus
+
@@ -21,6 +21,7 @@ _binding(TextureUnitSelector tex_unit)
 		Error,
 		Index(GLuint(tex_unit))
 	);
+	aux::StateCacheForget(aux::StateCacheGroup::ActiveTexture);
 
 	GLint name = 0;
 	OGLPLUS_GLFUNC(GetIntegerv)(GL_SAMPLER_BINDING, &name);
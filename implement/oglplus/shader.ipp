@@ -27,6 +27,41 @@ GetInfoLog(void) const
 	);
 }
 
+OGLPLUS_LIB_FUNC
+String ObjectOps<tag::DirectState, tag::Shader>::
+GetSource(void) const
+{
+	GLint length = 0;
+	OGLPLUS_GLFUNC(GetShaderiv)(
+		_obj_name(),
+		GL_SHADER_SOURCE_LENGTH,
+		&length
+	);
+	OGLPLUS_VERIFY(
+		GetShaderiv,
+		ObjectError,
+		Object(*this)
+	);
+	// the length includes the terminating null character
+	if(length <= 1) return String();
+
+	String result(std::size_t(length), '\0');
+	GLsizei real_length = 0;
+	OGLPLUS_GLFUNC(GetShaderSource)(
+		_obj_name(),
+		length,
+		&real_length,
+		&result.front()
+	);
+	OGLPLUS_VERIFY(
+		GetShaderSource,
+		ObjectError,
+		Object(*this)
+	);
+	result.resize(std::size_t(real_length));
+	return result;
+}
+
 OGLPLUS_LIB_FUNC
 ObjectOps<tag::DirectState, tag::Shader>&
 ObjectOps<tag::DirectState, tag::Shader>::
@@ -10,8 +10,11 @@
  */
 
 #include <oglplus/assert.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <utility>
 
 namespace oglplus {
 namespace shapes {
@@ -632,83 +635,212 @@ _contin_faces(GLuint fa, GLuint ea, GLuint fb, GLuint eb)
 	return result;
 }
 
+OGLPLUS_LIB_FUNC
+std::uint64_t ShapeAnalyzerGraphData::
+_hash_cell(std::uint64_t hash, GLdouble cell)
+{
+	// make sure that -0.0 and 0.0 hash to the same value
+	cell += GLdouble(0);
+	std::uint64_t bits = 0;
+	std::memcpy(&bits, &cell, sizeof(bits));
+	hash ^= bits+0x9E3779B97F4A7C15ull+(hash << 6)+(hash >> 2);
+	return hash;
+}
+
+OGLPLUS_LIB_FUNC
+std::uint64_t ShapeAnalyzerGraphData::
+_hash_edge(std::uint64_t c0, std::uint64_t c1)
+{
+	// the key does not depend on the orientation of the edge
+	if(c0 > c1) std::swap(c0, c1);
+	std::uint64_t hash = c0*0xFF51AFD7ED558CCDull;
+	hash ^= (hash >> 33)+c1;
+	hash *= 0xC4CEB9FE1A85EC53ull;
+	return hash ^ (hash >> 29);
+}
+
+OGLPLUS_LIB_FUNC
+void ShapeAnalyzerGraphData::_vert_cells(
+	GLuint vert,
+	GLdouble cell_size,
+	GLdouble margin,
+	std::vector<std::uint64_t>& cells
+) const
+{
+	// the first hash is the one of the grid cell containing
+	// the vertex, the following are the hashes of the neighboring
+	// cells which are closer to the vertex than the margin
+	cells.clear();
+	cells.push_back(0);
+
+	const GLdouble* v = _main_va.data()+vert*_main_vpv;
+	for(GLuint c=0; c!=_main_vpv; ++c)
+	{
+		const GLdouble q = v[c]/cell_size;
+		const GLdouble cell = std::floor(q);
+		const std::size_t n = cells.size();
+
+		if((margin > 0) && (q-cell <= margin))
+		{
+			for(std::size_t k=0; k!=n; ++k)
+			{
+				cells.push_back(_hash_cell(cells[k], cell-1));
+			}
+		}
+		if((margin > 0) && (cell+1-q <= margin))
+		{
+			for(std::size_t k=0; k!=n; ++k)
+			{
+				cells.push_back(_hash_cell(cells[k], cell+1));
+			}
+		}
+		for(std::size_t k=0; k!=n; ++k)
+		{
+			cells[k] = _hash_cell(cells[k], cell);
+		}
+	}
+}
+
 OGLPLUS_LIB_FUNC
 void ShapeAnalyzerGraphData::_detect_adjacent(void)
 {
-	const auto fb=_face_index.begin();
-	const auto fe=_face_index.end();
+	const GLuint face_count = GLuint(_face_index.size());
+
+	assert(face_count != 0);
+	assert(_main_vpv != 0);
+
+	// The edges are hashed by the grid cells containing the main
+	// attribute values of their vertices. The cells are much larger
+	// than the epsilon so vertices with the same values within
+	// the epsilon fall into the same or into a neighboring cell,
+	// which is searched only if the vertex is close to its border.
+	// The candidates found this way are then checked exactly
+	// in the same way as by pairwise comparison.
+	const GLdouble cell_size = (_eps > 0)?_eps*256:GLdouble(1);
+	const GLdouble margin = (_eps > 0)?(_eps*2)/cell_size:GLdouble(0);
+
+	const GLuint vert_count = GLuint(_main_va.size()/_main_vpv);
+	std::vector<std::uint64_t> cells;
+	std::vector<std::uint64_t> vert_cell(vert_count);
+	for(GLuint v=0; v!=vert_count; ++v)
+	{
+		_vert_cells(v, cell_size, 0, cells);
+		vert_cell[v] = cells.front();
+	}
+
+	// edges, which are not yet adjacent to any other, sorted by the key
+	typedef std::pair<std::uint64_t, GLuint> edge_entry;
+	std::vector<edge_entry> edges;
+	std::vector<GLuint> edge_face(_face_verts.size(), _nil_face());
+	edges.reserve(_face_verts.size());
 
-	assert(fb != fe);
+	for(GLuint f=0; f!=face_count; ++f)
+	{
+		const GLuint n = _face_arity(f);
+		for(GLuint e=0; e!=n; ++e)
+		{
+			const GLuint i = _face_index[f]+e;
+			edge_face[i] = f;
+			if(_face_adj_f[i] == _nil_face())
+			{
+				const GLuint v0 = _face_verts[i];
+				const GLuint v1 = _face_verts[_face_index[f]+(e+1)%n];
+				edges.push_back(edge_entry(
+					_hash_edge(vert_cell[v0], vert_cell[v1]),
+					i
+				));
+			}
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+
+	std::vector<std::uint64_t> cells0, cells1;
+	std::vector<GLuint> candidates;
 
-	auto fi=fb;
 	// for each face
-	while(fi != fe)
+	for(GLuint fi=0; fi!=face_count; ++fi)
 	{
-		GLuint fifb = GLuint(fi-fb);
-		GLuint fien = _face_arity(fifb);
+		const GLuint fien = _face_arity(fi);
 		for(GLuint fie=0; fie!=fien; ++fie)
 		{
-			GLuint i=*fi+fie;
-			if(_face_adj_f[i] == _nil_face())
+			GLuint i=_face_index[fi]+fie;
+			if(_face_adj_f[i] != _nil_face())
+			{
+				continue;
+			}
+
+			_vert_cells(
+				_face_verts[i],
+				cell_size,
+				margin,
+				cells0
+			);
+			_vert_cells(
+				_face_verts[_face_index[fi]+(fie+1)%fien],
+				cell_size,
+				margin,
+				cells1
+			);
+
+			// find the edges of the following faces
+			// which may be adjacent to the current one
+			candidates.clear();
+			for(auto c0=cells0.begin(); c0!=cells0.end(); ++c0)
+			for(auto c1=cells1.begin(); c1!=cells1.end(); ++c1)
 			{
-				auto fj = fi+1;
-				while(fj != fe)
+				const std::uint64_t key = _hash_edge(*c0, *c1);
+				auto p = std::lower_bound(
+					edges.begin(),
+					edges.end(),
+					edge_entry(key, 0)
+				);
+				while((p != edges.end()) && (p->first == key))
 				{
-					GLuint fjfb = GLuint(fj-fb);
-					GLuint fjen = _face_arity(fjfb);
-					for(GLuint fje=0; fje!=fjen; ++fje)
+					if(edge_face[p->second] > fi)
 					{
-						GLuint j=*fj+fje;
-						bool nadj = (
-							_face_adj_f[j] ==
-							_nil_face()
-						);
-						bool adjf = _adjacent_faces(
-							fifb,
-							fie,
-							fjfb,
-							fje
-						);
-						bool smtf = adjf&&_smooth_faces(
-							fifb,
-							fie,
-							fjfb,
-							fje
-						);
-						bool cntf = adjf&&_contin_faces(
-							fifb,
-							fie,
-							fjfb,
-							fje
-						);
-						if(nadj && adjf)
-						{
-							_face_adj_f[i]=fjfb;
-							_face_adj_f[j]=fifb;
-
-							_face_adj_e[i]=fje;
-							_face_adj_e[j]=fie;
-						}
-						if(nadj && smtf)
-						{
-							_face_edge_flags[i] |=
-								_flg_smooth_edge;
-							_face_edge_flags[j] |=
-								_flg_smooth_edge;
-						}
-						if(nadj && cntf)
-						{
-							_face_edge_flags[i] |=
-								_flg_contin_edge;
-							_face_edge_flags[j] |=
-								_flg_contin_edge;
-						}
+						candidates.push_back(p->second);
 					}
-					++fj;
+					++p;
+				}
+			}
+			// keep the order in which the faces are compared
+			std::sort(candidates.begin(), candidates.end());
+			candidates.erase(
+				std::unique(candidates.begin(), candidates.end()),
+				candidates.end()
+			);
+
+			for(auto cj=candidates.begin(); cj!=candidates.end(); ++cj)
+			{
+				GLuint j=*cj;
+				GLuint fjfb = edge_face[j];
+				GLuint fje = j-_face_index[fjfb];
+
+				bool nadj = (_face_adj_f[j] == _nil_face());
+				bool adjf = _adjacent_faces(fi, fie, fjfb, fje);
+				bool smtf = adjf&&_smooth_faces(fi, fie, fjfb, fje);
+				bool cntf = adjf&&_contin_faces(fi, fie, fjfb, fje);
+
+				if(nadj && adjf)
+				{
+					_face_adj_f[i]=fjfb;
+					_face_adj_f[j]=fi;
+
+					_face_adj_e[i]=fje;
+					_face_adj_e[j]=fie;
+				}
+				if(nadj && smtf)
+				{
+					_face_edge_flags[i] |= _flg_smooth_edge;
+					_face_edge_flags[j] |= _flg_smooth_edge;
+				}
+				if(nadj && cntf)
+				{
+					_face_edge_flags[i] |= _flg_contin_edge;
+					_face_edge_flags[j] |= _flg_contin_edge;
 				}
 			}
 		}
-		++fi;
 	}
 }
 
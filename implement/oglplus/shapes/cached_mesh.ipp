@@ -0,0 +1,356 @@
+/**
+ *  @file oglplus/shapes/cached_mesh.ipp
+ *  @brief Implementation of shapes::CachedMesh
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+
+namespace oglplus {
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+const char** CachedMesh::_attrib_names(void)
+{
+	static const char* names[_n_attribs] = {
+		"Position",
+		"Normal",
+		"Tangent",
+		"Bitangent",
+		"TexCoord",
+		"Material"
+	};
+	return names;
+}
+
+OGLPLUS_LIB_FUNC
+std::uint64_t CachedMesh::_checksum(const char* begin, const char* end)
+{
+	// 64-bit FNV-1a processing the data by 8-byte words
+	const std::uint64_t prime = 0x100000001b3ull;
+	std::uint64_t result = 0xcbf29ce484222325ull;
+
+	while(end-begin >= 8)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, begin, 8);
+		result ^= word;
+		result *= prime;
+		begin += 8;
+	}
+	while(begin != end)
+	{
+		result ^= std::uint64_t(static_cast<unsigned char>(*begin));
+		result *= prime;
+		++begin;
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+bool CachedMesh::_source_info(
+	const char* source_path,
+	std::uint64_t& size,
+	std::uint64_t& checksum
+)
+{
+	aux::MappedFile source(source_path);
+	if(!source.IsOpen()) return false;
+	size = source.Size();
+	checksum = _checksum(source.Begin(), source.End());
+	return true;
+}
+
+OGLPLUS_LIB_FUNC
+const CachedMesh::_header*
+CachedMesh::_check_header(const aux::MappedFile& file)
+{
+	if(!file.IsOpen()) return nullptr;
+	if(file.Size() < sizeof(_header)) return nullptr;
+
+	const _header* hdr = reinterpret_cast<const _header*>(file.Begin());
+
+	if(std::memcmp(hdr->magic, _magic(), 8) != 0)
+	{
+		return nullptr;
+	}
+	if(hdr->version != GLuint(_version)) return nullptr;
+	if(hdr->byte_order != GLuint(_byte_order)) return nullptr;
+	if(hdr->payload_size != file.Size()-sizeof(_header)) return nullptr;
+
+	const std::size_t elem_size[_n_sections] = {
+		sizeof(GLfloat),
+		sizeof(GLfloat),
+		sizeof(GLfloat),
+		sizeof(GLfloat),
+		sizeof(GLfloat),
+		sizeof(GLfloat),
+		sizeof(GLuint),
+		6*sizeof(GLuint),
+		sizeof(char)
+	};
+
+	for(std::size_t s=0; s!=_n_sections; ++s)
+	{
+		const _section& sec = hdr->sections[s];
+		if(sec.offset % std::size_t(_align) != 0) return nullptr;
+		if(sec.offset > file.Size()) return nullptr;
+		if(sec.count > (file.Size()-sec.offset)/elem_size[s])
+		{
+			return nullptr;
+		}
+	}
+	return hdr;
+}
+
+OGLPLUS_LIB_FUNC
+void CachedMesh::_write(
+	const _mesh_data& mesh,
+	const char* cache_path,
+	std::uint64_t source_size,
+	std::uint64_t source_checksum
+)
+{
+	std::vector<char> buffer(sizeof(_header), '\0');
+
+	_header hdr;
+	std::memset(&hdr, 0, sizeof(hdr));
+	std::memcpy(hdr.magic, _magic(), 8);
+	hdr.version = GLuint(_version);
+	hdr.byte_order = GLuint(_byte_order);
+	hdr.source_size = source_size;
+	hdr.source_checksum = source_checksum;
+	hdr.face_winding = GLuint(GLenum(mesh.face_winding));
+	hdr.bounding_sphere[0] = mesh.bounding_sphere.Center().x();
+	hdr.bounding_sphere[1] = mesh.bounding_sphere.Center().y();
+	hdr.bounding_sphere[2] = mesh.bounding_sphere.Center().z();
+	hdr.bounding_sphere[3] = mesh.bounding_sphere.Radius();
+
+	auto append = [&buffer](
+		_section& sec,
+		const void* data,
+		std::size_t count,
+		std::size_t elem_size
+	)
+	{
+		std::size_t offset = buffer.size();
+		offset += (std::size_t(_align)-offset%std::size_t(_align))%
+			std::size_t(_align);
+		buffer.resize(offset+count*elem_size, '\0');
+		if(count != 0)
+		{
+			std::memcpy(buffer.data()+offset, data, count*elem_size);
+		}
+		sec.offset = offset;
+		sec.count = count;
+	};
+
+	for(std::size_t a=0; a!=_n_attribs; ++a)
+	{
+		append(
+			hdr.sections[a],
+			mesh.attribs[a].data(),
+			mesh.attribs[a].size(),
+			sizeof(GLfloat)
+		);
+		hdr.sections[a].values_per_vertex = mesh.values_per_vertex[a];
+	}
+
+	append(
+		hdr.sections[_indices],
+		mesh.indices.data(),
+		mesh.indices.size(),
+		sizeof(GLuint)
+	);
+	hdr.sections[_indices].values_per_vertex = 1;
+
+	std::vector<GLuint> operations;
+	operations.reserve(mesh.operations.size()*6);
+	for(const DrawOperation& op : mesh.operations)
+	{
+		operations.push_back(GLuint(op.method));
+		operations.push_back(GLuint(GLenum(op.mode)));
+		operations.push_back(op.first);
+		operations.push_back(op.count);
+		operations.push_back(op.restart_index);
+		operations.push_back(op.phase);
+	}
+	append(
+		hdr.sections[_operations],
+		operations.data(),
+		mesh.operations.size(),
+		6*sizeof(GLuint)
+	);
+
+	// the material names are stored as a sequence of null-terminated
+	// strings, the values_per_vertex field holds the number of names
+	std::string names;
+	for(const std::string& name : mesh.material_names)
+	{
+		names.append(name);
+		names.push_back('\0');
+	}
+	append(
+		hdr.sections[_material_names],
+		names.data(),
+		names.size(),
+		sizeof(char)
+	);
+	hdr.sections[_material_names].values_per_vertex =
+		GLuint(mesh.material_names.size());
+
+	hdr.payload_size = buffer.size()-sizeof(_header);
+	hdr.payload_checksum = _checksum(
+		buffer.data()+sizeof(_header),
+		buffer.data()+buffer.size()
+	);
+	std::memcpy(buffer.data(), &hdr, sizeof(hdr));
+
+	// the cache is written into a temporary file in the same directory
+	// and renamed over the cache file so that concurrent readers never
+	// see a partially written cache
+	std::string temp_path(cache_path);
+	temp_path.append(".tmp");
+
+	bool written = false;
+	{
+		std::ofstream output(
+			temp_path,
+			std::ios::out | std::ios::binary | std::ios::trunc
+		);
+		if(output.is_open())
+		{
+			output.write(buffer.data(), std::streamsize(buffer.size()));
+			output.flush();
+			written = output.good();
+		}
+	}
+
+	if(written)
+	{
+		if(std::rename(temp_path.c_str(), cache_path) != 0)
+		{
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+			// rename does not replace existing files on Windows
+			std::remove(cache_path);
+			written = std::rename(temp_path.c_str(), cache_path) == 0;
+#else
+			written = false;
+#endif
+		}
+	}
+	if(!written)
+	{
+		std::remove(temp_path.c_str());
+		throw std::runtime_error(
+			"Cached mesh: Unable to write file: "+
+			std::string(cache_path)
+		);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+CachedMesh::CachedMesh(const char* cache_path)
+ : _file(cache_path)
+ , _hdr(_check_header(_file))
+{
+	if(!_hdr)
+	{
+		throw std::runtime_error(
+			"Cached mesh: Invalid or missing cache file: "+
+			std::string(cache_path)
+		);
+	}
+
+	const char* names = _data<char>(_material_names);
+	const char* names_end = names+_count(_material_names);
+	GLuint n = _hdr->sections[_material_names].values_per_vertex;
+	_mtl_names.reserve(n);
+	while((names != names_end) && (n-- != 0))
+	{
+		const char* name_end = std::find(names, names_end, '\0');
+		_mtl_names.push_back(std::string(names, name_end));
+		names = (name_end == names_end)?name_end:name_end+1;
+	}
+}
+
+OGLPLUS_LIB_FUNC
+bool CachedMesh::IsUpToDate(const char* cache_path, const char* source_path)
+{
+	aux::MappedFile cache(cache_path);
+	const _header* hdr = _check_header(cache);
+	if(!hdr) return false;
+
+	std::uint64_t source_size = 0, source_checksum = 0;
+	if(!_source_info(source_path, source_size, source_checksum))
+	{
+		return false;
+	}
+	return	(hdr->source_size == source_size) &&
+		(hdr->source_checksum == source_checksum);
+}
+
+OGLPLUS_LIB_FUNC
+bool CachedMesh::VerifyChecksum(void) const
+{
+	return _hdr->payload_checksum == _checksum(
+		_file.Begin()+sizeof(_header),
+		_file.End()
+	);
+}
+
+OGLPLUS_LIB_FUNC
+bool CachedMesh::QueryVertexAttrib(
+	StrCRef name,
+	const GLfloat*& values,
+	GLuint& count,
+	GLuint& values_per_vertex
+) const
+{
+	for(std::size_t a=0; a!=_n_attribs; ++a)
+	{
+		if(std::strcmp(name.c_str(), _attrib_names()[a]) == 0)
+		{
+			const _section& sec = _hdr->sections[a];
+			if(sec.values_per_vertex == 0) return false;
+			values = _data<GLfloat>(_section_index(a));
+			count = GLuint(sec.count);
+			values_per_vertex = sec.values_per_vertex;
+			return true;
+		}
+	}
+	return false;
+}
+
+OGLPLUS_LIB_FUNC
+DrawingInstructions CachedMesh::Instructions(Default) const
+{
+	DrawingInstructions instr = this->MakeInstructions();
+	const GLuint* ops = _data<GLuint>(_operations);
+	for(std::size_t o=0, n=_count(_operations); o!=n; ++o)
+	{
+		DrawOperation operation;
+		operation.method = DrawOperation::Method(ops[o*6+0]);
+		operation.mode = PrimitiveType(ops[o*6+1]);
+		operation.first = ops[o*6+2];
+		operation.count = ops[o*6+3];
+		operation.restart_index = ops[o*6+4];
+		operation.phase = ops[o*6+5];
+		this->AddInstruction(instr, operation);
+	}
+	return instr;
+}
+
+} // shapes
+} // oglplus
+
@@ -12,6 +12,7 @@
 #include <oglplus/lib/incl_begin.ipp>
 #include <oglplus/glfunc.hpp>
 #include <oglplus/error/basic.hpp>
+#include <oglplus/capability.hpp>
 #include <oglplus/lib/incl_end.ipp>
 #include <oglplus/assert.hpp>
 
@@ -24,13 +25,11 @@ void DrawOperation::SetupPrimitiveRestart_(void) const
 #if GL_VERSION_3_1
 	if(restart_index == NoRestartIndex())
 	{
-		OGLPLUS_GLFUNC(Disable)(GL_PRIMITIVE_RESTART);
-		OGLPLUS_VERIFY_SIMPLE(Disable);
+		aux::EnableCapability(GL_PRIMITIVE_RESTART, false);
 	}
 	else
 	{
-		OGLPLUS_GLFUNC(Enable)(GL_PRIMITIVE_RESTART);
-		OGLPLUS_VERIFY_SIMPLE(Enable);
+		aux::EnableCapability(GL_PRIMITIVE_RESTART, true);
 		OGLPLUS_GLFUNC(PrimitiveRestartIndex)(restart_index);
 		OGLPLUS_VERIFY_SIMPLE(PrimitiveRestartIndex);
 	}
@@ -51,8 +50,7 @@ void DrawOperation::CleanupPrimitiveRestart_(void) const
 	if(restart_index != NoRestartIndex())
 	{
 #if GL_VERSION_3_1
-		OGLPLUS_GLFUNC(Disable)(GL_PRIMITIVE_RESTART);
-		OGLPLUS_VERIFY_SIMPLE(Disable);
+		aux::EnableCapability(GL_PRIMITIVE_RESTART, false);
 #endif
 	}
 }
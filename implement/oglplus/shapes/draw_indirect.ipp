@@ -0,0 +1,246 @@
+/**
+ *  @file oglplus/shapes/draw_indirect.ipp
+ *  @brief Implementation of the compilation of shape draw instructions
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/glfunc.hpp>
+#include <oglplus/error/basic.hpp>
+#include <oglplus/capability.hpp>
+#include <oglplus/lib/incl_end.ipp>
+#include <stdexcept>
+
+namespace oglplus {
+namespace shapes {
+
+OGLPLUS_LIB_FUNC
+DrawCommandCompiler::_group&
+DrawCommandCompiler::_find_group(
+	const DrawOperation& op,
+	DataType index_type
+)
+{
+	const bool elements = (op.method == DrawOperation::Method::DrawElements);
+	// the index type and restart index do not matter for DrawArrays
+	const DataType type = elements?index_type:DataType::UnsignedInt;
+	const GLuint restart = elements?
+		op.restart_index:
+		DrawOperation::NoRestartIndex();
+
+	for(_group& group : _groups)
+	{
+		const DrawCommandBatch& batch = group.batch;
+		if(	(batch.method == op.method) &&
+			(batch.mode == op.mode) &&
+			(batch.index_type == type) &&
+			(batch.restart_index == restart) &&
+			(batch.phase == op.phase)
+		) return group;
+	}
+
+	_group group;
+	group.batch.method = op.method;
+	group.batch.mode = op.mode;
+	group.batch.index_type = type;
+	group.batch.restart_index = restart;
+	group.batch.phase = op.phase;
+	group.batch.offset = 0;
+	group.batch.count = 0;
+	_groups.push_back(group);
+	return _groups.back();
+}
+
+OGLPLUS_LIB_FUNC
+void DrawCommandCompiler::_add(
+	const DrawingInstructions& instructions,
+	DataType index_type,
+	GLuint base_vertex,
+	GLuint base_index,
+	GLuint inst_count,
+	GLuint base_inst
+)
+{
+	for(const DrawOperation& op : instructions.Operations())
+	{
+		_group& group = _find_group(op, index_type);
+		if(op.method == DrawOperation::Method::DrawElements)
+		{
+			const DrawElementsIndirectCommand cmd = {
+				op.count,
+				inst_count,
+				base_index+op.first,
+				GLint(base_vertex),
+				base_inst
+			};
+			const GLuint* p = reinterpret_cast<const GLuint*>(&cmd);
+			group.words.insert(group.words.end(), p, p+5);
+		}
+		else
+		{
+			const DrawArraysIndirectCommand cmd = {
+				op.count,
+				inst_count,
+				base_vertex+op.first,
+				base_inst
+			};
+			const GLuint* p = reinterpret_cast<const GLuint*>(&cmd);
+			group.words.insert(group.words.end(), p, p+4);
+		}
+		++group.batch.count;
+		++_command_count;
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void DrawCommandCompiler::Add(
+	const DrawingInstructions& instructions,
+	GLuint base_vertex,
+	GLuint inst_count,
+	GLuint base_inst
+)
+{
+	for(const DrawOperation& op : instructions.Operations())
+	{
+		if(op.method == DrawOperation::Method::DrawElements)
+		{
+			throw std::runtime_error(
+				"DrawCommandCompiler: Element index info "
+				"required by the drawing instructions"
+			);
+		}
+	}
+	// the index type is not used by DrawArrays
+	_add(
+		instructions,
+		DataType::UnsignedInt,
+		base_vertex,
+		0,
+		inst_count,
+		base_inst
+	);
+}
+
+OGLPLUS_LIB_FUNC
+std::vector<DrawCommandBatch> DrawCommandCompiler::Batches(void) const
+{
+	std::vector<DrawCommandBatch> result;
+	result.reserve(_groups.size());
+	GLintptr offset = 0;
+	for(const _group& group : _groups)
+	{
+		result.push_back(group.batch);
+		result.back().offset = offset;
+		offset += GLintptr(group.words.size()*sizeof(GLuint));
+	}
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+std::vector<GLuint> DrawCommandCompiler::Data(void) const
+{
+	std::size_t size = 0;
+	for(const _group& group : _groups)
+	{
+		size += group.words.size();
+	}
+	std::vector<GLuint> result;
+	result.reserve(size);
+	for(const _group& group : _groups)
+	{
+		result.insert(
+			result.end(),
+			group.words.begin(),
+			group.words.end()
+		);
+	}
+	return result;
+}
+
+#if GL_VERSION_4_3 || GL_ARB_multi_draw_indirect
+
+OGLPLUS_LIB_FUNC
+DrawCommandBuffer::DrawCommandBuffer(const DrawCommandCompiler& compiler)
+ : _batches(compiler.Batches())
+ , _command_count(compiler.CommandCount())
+{
+	_buffer.Bind(BufferTarget::DrawIndirect);
+	Buffer::Data(BufferTarget::DrawIndirect, compiler.Data());
+}
+
+OGLPLUS_LIB_FUNC
+void DrawCommandBuffer::_begin(void) const
+{
+	_buffer.Bind(BufferTarget::DrawIndirect);
+	// the batches are drawn with primitive restart disabled
+	// unless they specify a restart index
+	aux::EnableCapability(GL_PRIMITIVE_RESTART, false);
+}
+
+OGLPLUS_LIB_FUNC
+void DrawCommandBuffer::_draw(
+	const DrawCommandBatch& batch,
+	GLuint& restart
+) const
+{
+	const void* indirect = reinterpret_cast<const void*>(batch.offset);
+	if(batch.method == DrawOperation::Method::DrawElements)
+	{
+		// change the primitive restart state only between batches
+		// using different restart indices
+		if(restart != batch.restart_index)
+		{
+			if(batch.restart_index == DrawOperation::NoRestartIndex())
+			{
+				aux::EnableCapability(GL_PRIMITIVE_RESTART, false);
+			}
+			else
+			{
+				aux::EnableCapability(GL_PRIMITIVE_RESTART, true);
+				OGLPLUS_GLFUNC(PrimitiveRestartIndex)(
+					batch.restart_index
+				);
+				OGLPLUS_VERIFY_SIMPLE(PrimitiveRestartIndex);
+			}
+			restart = batch.restart_index;
+		}
+		OGLPLUS_GLFUNC(MultiDrawElementsIndirect)(
+			GLenum(batch.mode),
+			GLenum(batch.index_type),
+			indirect,
+			batch.count,
+			0
+		);
+		OGLPLUS_CHECK_SIMPLE(MultiDrawElementsIndirect);
+	}
+	else
+	{
+		OGLPLUS_GLFUNC(MultiDrawArraysIndirect)(
+			GLenum(batch.mode),
+			indirect,
+			batch.count,
+			0
+		);
+		OGLPLUS_CHECK_SIMPLE(MultiDrawArraysIndirect);
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void DrawCommandBuffer::_end(GLuint restart) const
+{
+	if(restart != DrawOperation::NoRestartIndex())
+	{
+		aux::EnableCapability(GL_PRIMITIVE_RESTART, false);
+	}
+}
+
+#endif // GL_VERSION_4_3 || GL_ARB_multi_draw_indirect
+
+} // namespace shapes
+} // namespace oglplus
+
@@ -9,20 +9,222 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 
+#include <oglplus/lib/incl_begin.ipp>
+#include <oglplus/utils/mapped_file.hpp>
+#include <oglplus/lib/incl_end.ipp>
+
 #include <algorithm>
+#include <iterator>
 #include <sstream>
+#include <locale>
 #include <stdexcept>
+#include <exception>
+#include <cstdint>
+#include <cstring>
 #include <cassert>
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#endif
 
 namespace oglplus {
+namespace aux {
+
+// Parses a floating-point value from the range [i, e).
+// Values with at most 19 significant digits and a small decimal exponent
+// are converted exactly (and locale-independently) by a single multiply
+// or divide, the rest is parsed by an istream using the classic locale
+// so that the result is always the same as when reading from a stream.
+OGLPLUS_LIB_FUNC
+bool ObjParseDouble(const char*& i, const char* e, double& result)
+{
+	static const double pow10[23] = {
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+		1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	while((i != e) && std::isspace(*i)) ++i;
+	const char* b = i;
+
+	bool neg = false;
+	if((i != e) && ((*i == '-') || (*i == '+')))
+	{
+		neg = (*i == '-');
+		++i;
+	}
+
+	std::uint64_t mant = 0;
+	int digits = 0;
+	int exp10 = 0;
+	bool any = false;
+	bool exact = true;
+
+	while((i != e) && (*i >= '0') && (*i <= '9'))
+	{
+		if(digits < 19)
+		{
+			mant = mant*10 + std::uint64_t(*i-'0');
+			if(mant != 0) ++digits;
+		}
+		else
+		{
+			if(*i != '0') exact = false;
+			++exp10;
+		}
+		any = true;
+		++i;
+	}
+	if((i != e) && (*i == '.'))
+	{
+		++i;
+		while((i != e) && (*i >= '0') && (*i <= '9'))
+		{
+			if(digits < 19)
+			{
+				mant = mant*10 + std::uint64_t(*i-'0');
+				if(mant != 0) ++digits;
+				--exp10;
+			}
+			else if(*i != '0') exact = false;
+			any = true;
+			++i;
+		}
+	}
+	if((i != e) && ((*i == 'e') || (*i == 'E')))
+	{
+		++i;
+		bool eneg = false;
+		if((i != e) && ((*i == '-') || (*i == '+')))
+		{
+			eneg = (*i == '-');
+			++i;
+		}
+		if((i == e) || (*i < '0') || (*i > '9'))
+		{
+			exact = false;
+		}
+		int ev = 0;
+		while((i != e) && (*i >= '0') && (*i <= '9'))
+		{
+			if(ev < 100000) ev = ev*10 + (*i-'0');
+			++i;
+		}
+		exp10 += eneg?-ev:ev;
+	}
+	if(!any)
+	{
+		result = 0.0;
+		return false;
+	}
+
+	if(mant == 0)
+	{
+		if(exact)
+		{
+			result = neg?-0.0:0.0;
+			return true;
+		}
+	}
+	else if(exact && (mant <= (std::uint64_t(1) << 53)))
+	{
+		if((exp10 >= 0) && (exp10 <= 22))
+		{
+			result = double(mant)*pow10[exp10];
+			if(neg) result = -result;
+			return true;
+		}
+		if((exp10 < 0) && (exp10 >= -22))
+		{
+			result = double(mant)/pow10[-exp10];
+			if(neg) result = -result;
+			return true;
+		}
+	}
+
+	std::istringstream input(std::string(b, e));
+	input.imbue(std::locale::classic());
+	input >> result;
+	if(input.fail())
+	{
+		result = 0.0;
+		return false;
+	}
+	std::streamoff pos = input.tellg();
+	i = (pos < 0)?e:b+pos;
+	return true;
+}
+
+// Calls func on every element of chunks, in parallel (if possible)
+template <typename Chunk, typename Func>
+void ObjForEachChunk(std::vector<Chunk>& chunks, Func func)
+{
+#if !OGLPLUS_NO_THREADS
+	if(chunks.size() > 1)
+	{
+		std::vector<std::thread> workers;
+		workers.reserve(chunks.size()-1);
+		for(std::size_t c=1; c!=chunks.size(); ++c)
+		{
+			Chunk& chunk = chunks[c];
+			workers.push_back(std::thread(
+				[&func, &chunk](void) { func(chunk); }
+			));
+		}
+		func(chunks.front());
+		for(std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		return;
+	}
+#endif
+	for(Chunk& chunk : chunks)
+	{
+		func(chunk);
+	}
+}
+
+} // namespace aux
+
 namespace shapes {
 
+struct ObjMesh::_chunk
+{
+	// the range of the input parsed in this chunk
+	const char* begin;
+	const char* end;
+	// the vertex attrib tuple counts in this chunk
+	_vert_indices counts;
+	// the vertex attrib tuple counts before this chunk
+	_vert_indices base;
+	// the face vertex indices (the material numbers are local to
+	// the chunk, zero means the material in use before this chunk)
+	std::vector<_vert_indices> idx_data;
+
+	// the mtllib, usemtl and o statements and the offsets
+	// into idx_data where they appeared
+	struct _statement
+	{
+		char tag;
+		std::size_t offset;
+		std::string value;
+	};
+	std::vector<_statement> statements;
+
+	std::exception_ptr error;
+
+	_chunk(const char* b, const char* e)
+	 : begin(b)
+	 , end(e)
+	{ }
+};
+
 OGLPLUS_LIB_FUNC
 bool ObjMesh::_load_index(
 	GLuint& value,
 	GLuint n_verts,
-	std::string::const_iterator& i,
-	std::string::const_iterator& e
+	const char*& i,
+	const char* e
 )
 {
 	bool neg = false;
@@ -55,8 +257,8 @@ OGLPLUS_LIB_FUNC
 bool ObjMesh::_load_indices(
 	_vert_indices& indices,
 	const _vert_indices& counts,
-	std::string::const_iterator& i,
-	std::string::const_iterator& e
+	const char*& i,
+	const char* e
 )
 {
 	indices = _vert_indices();
@@ -77,7 +279,7 @@ bool ObjMesh::_load_indices(
 					return false;
 				}
 			}
-			if(*i == '/')
+			if((i != e) && (*i == '/'))
 			{
 				++i;
 				if(i == e) return false;
@@ -94,50 +296,45 @@ bool ObjMesh::_load_indices(
 }
 
 OGLPLUS_LIB_FUNC
-void ObjMesh::_load_meshes(
-	const _loading_options& opts, //TODO
-	aux::AnyInputIter<const char*> names_begin,
-	aux::AnyInputIter<const char*> names_end,
-	std::istream& input
-)
+void ObjMesh::_count_chunk(_chunk& chunk)
 {
-	if(!input.good())
+	const char* i = chunk.begin;
+	while(i != chunk.end)
 	{
-		throw std::runtime_error("Obj file loader: Unable to read input.");
+		const char* e = std::find(i, chunk.end, '\n');
+		const char* n = (e == chunk.end)?e:e+1;
+
+		while((i != e) && std::isspace(*i)) ++i;
+		if((i != e) && (*i == 'v') && (++i != e))
+		{
+			if(*i == ' ') ++chunk.counts._pos;
+			else if(*i == 'n') ++chunk.counts._nml;
+			else if(*i == 't') ++chunk.counts._tex;
+		}
+		i = n;
 	}
+}
 
-	const double unused[3] = {0.0, 0.0, 0.0};
-	// unused position
-	std::vector<double> pos_data(unused, unused+3);
-	// unused normal
-	std::vector<double> nml_data(unused, unused+3);
-	// unused tex. coord.
-	std::vector<double> tex_data(unused, unused+3);
-	// unused material
-	std::vector<double> mtl_data(1, 0);
+OGLPLUS_LIB_FUNC
+void ObjMesh::_parse_chunk(
+	_chunk& chunk,
+	double* pos_data,
+	double* nml_data,
+	double* tex_data
+)
+{
 	// vertex attrib tuple counts
-	_vert_indices n_attr;
-	n_attr._pos = 1;
-	n_attr._nml = 1;
-	n_attr._tex = 1;
-	n_attr._mtl = 1;
-	// unused index
-	std::vector<_vert_indices> idx_data(1, _vert_indices());
-	_mtl_names.push_back(std::string());
-	// the current count of vertices
-
-	std::vector<std::string> mesh_names;
-	std::vector<GLuint> mesh_offsets;
-	std::vector<GLuint> mesh_counts;
-
+	_vert_indices n_attr = chunk.base;
 	GLuint curr_mtl = 0;
-	std::string mtllib;
 
-	const std::string vert_tags(" tnp");
- 	std::string line;
-	while(std::getline(input, line))
+	const char* vert_tags = " tnp";
+	const char* l = chunk.begin;
+	while(l != chunk.end)
 	{
-		std::string::const_iterator b = line.begin(), i = b, e = line.end();
+		const char* b = l, *i = b;
+		const char* e = std::find(l, chunk.end, '\n');
+		l = (e == chunk.end)?e:e+1;
+		const std::string::size_type line_len = std::size_t(e-b);
 		// rtrim \r
 		while((b < e) && e[-1] == '\r') --e;
 		// ltrim
@@ -155,14 +352,19 @@ void ObjMesh::_load_meshes(
 			{
 				throw std::runtime_error(
 					"Obj file loader: Unknown tag at line: "+
-					line
+					std::string(b, line_len)
 				);
 			}
 			i += 6;
 			while((i != e) && std::isspace(*i)) ++i;
-			std::string::const_iterator f = i;
+			const char* f = i;
 			while((f != e) && !std::isspace(*f)) ++f;
-			mtllib = std::string(i, f);
+			_chunk::_statement stmt = {
+				'm',
+				chunk.idx_data.size(),
+				std::string(i, f)
+			};
+			chunk.statements.push_back(std::move(stmt));
 		}
 		// if it is a use material statement
 		else if(*i == 'u')
@@ -172,20 +374,20 @@ void ObjMesh::_load_meshes(
 			{
 				throw std::runtime_error(
 					"Obj file loader: Unknown tag at line: "+
-					line
+					std::string(b, line_len)
 				);
 			}
 			i += 6;
 			while((i != e) && std::isspace(*i)) ++i;
-			std::string::const_iterator f = i;
+			const char* f = i;
 			while((f != e) && !std::isspace(*f)) ++f;
-
-			std::string material;
-			if(!mtllib.empty()) material = mtllib + '#';
-			material.append(std::string(i, f));
-
-			curr_mtl = GLuint(_mtl_names.size());
-			_mtl_names.push_back(material);
+			_chunk::_statement stmt = {
+				'u',
+				chunk.idx_data.size(),
+				std::string(i, f)
+			};
+			chunk.statements.push_back(std::move(stmt));
+			++curr_mtl;
 		}
 		// if the line contains vertex data
 		else if(*i == 'v')
@@ -195,34 +397,36 @@ void ObjMesh::_load_meshes(
 			{
 				throw std::runtime_error(
 					"Obj file loader: Unexpected end of line: "+
-					line
+					std::string(b, line_len)
 				);
 			}
 			char t = *i;
 			++i;
-			std::stringstream str(line.c_str()+std::distance(b, i));
 			// if it is a known tag
-			if(vert_tags.find(t) != std::string::npos)
+			if(std::strchr(vert_tags, t) != nullptr)
 			{
 				double v[3] = {0.0, 0.0, 0.0};
-				str >> v[0];
-				str >> v[1];
-				str >> v[2];
+				for(std::size_t c=0; c!=3; ++c)
+				{
+					if(!aux::ObjParseDouble(i, e, v[c])) break;
+				}
+				double* dest = nullptr;
 				if(t == ' ')
 				{
-					pos_data.insert(pos_data.end(), v, v+3);
+					dest = pos_data + n_attr._pos*3;
 					++n_attr._pos;
 				}
 				if(t == 'n')
 				{
-					nml_data.insert(nml_data.end(), v, v+3);
+					dest = nml_data + n_attr._nml*3;
 					++n_attr._nml;
 				}
 				if(t == 't')
 				{
-					tex_data.insert(tex_data.end(), v, v+3);
+					dest = tex_data + n_attr._tex*3;
 					++n_attr._tex;
 				}
+				if(dest) std::copy(v, v+3, dest);
 			}
 		}
 		else if(*i == 'f')
@@ -236,17 +440,17 @@ void ObjMesh::_load_meshes(
 				{
 					throw std::runtime_error(
 						"Obj file loader: Error reading indices: "+
-						line
+						std::string(b, line_len)
 					);
 				}
 				vi1[n]._mtl = curr_mtl;
 			}
-			idx_data.insert(idx_data.end(), vi1, vi1+3);
+			chunk.idx_data.insert(chunk.idx_data.end(), vi1, vi1+3);
 			_vert_indices vi2[3] = {vi1[0], vi1[2], _vert_indices()};
 			while(_load_indices(vi2[2], n_attr, i, e))
 			{
 				vi2[2]._mtl = curr_mtl;
-				idx_data.insert(idx_data.end(), vi2, vi2+3);
+				chunk.idx_data.insert(chunk.idx_data.end(), vi2, vi2+3);
 				vi2[1] = vi2[2];
 			}
 		}
@@ -254,16 +458,210 @@ void ObjMesh::_load_meshes(
 		{
 			++i;
 			while((i != e) && std::isspace(*i)) ++i;
-			if(!mesh_offsets.empty())
+			_chunk::_statement stmt = {
+				'o',
+				chunk.idx_data.size(),
+				std::string(i, e)
+			};
+			chunk.statements.push_back(std::move(stmt));
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ObjMesh::_calc_tangents(
+	const Vec3d* p,
+	const Vec2d* uv,
+	GLfloat* tgt,
+	GLfloat* btg
+)
+{
+	for(std::size_t v=0; v!=3; ++v)
+	{
+		std::size_t j[3] = {
+			v,
+			(v+1)%3,
+			(v+2)%3
+		};
+
+		Vec3d v0 = p[j[1]] - p[j[0]];
+		Vec3d v1 = p[j[2]] - p[j[0]];
+
+		Vec2d duv0 = uv[j[1]] - uv[j[0]];
+		Vec2d duv1 = uv[j[2]] - uv[j[0]];
+
+		double d = duv0.x()*duv1.y()-duv0.y()*duv1.x();
+		if(d != 0.0f) d = 1.0f/d;
+
+		if(tgt)
+		{
+			Vec3f t = (duv1.y()*v0 - duv0.y()*v1)*d;
+			Vec3f nt = Normalized(t);
+
+			tgt[v*3+0] = nt.x();
+			tgt[v*3+1] = nt.y();
+			tgt[v*3+2] = nt.z();
+		}
+
+		if(btg)
+		{
+			Vec3f b = (duv0.x()*v1 - duv1.x()*v0)*d;
+			Vec3f nb = Normalized(b);
+
+			btg[v*3+0] = nb.x();
+			btg[v*3+1] = nb.y();
+			btg[v*3+2] = nb.z();
+		}
+	}
+}
+
+OGLPLUS_LIB_FUNC
+void ObjMesh::_load_meshes(
+	const _loading_options& opts, //TODO
+	aux::AnyInputIter<const char*> names_begin,
+	aux::AnyInputIter<const char*> names_end,
+	const char* input_begin,
+	const char* input_end
+)
+{
+	// split the input into chunks at line boundaries
+	std::size_t n_chunks = 1;
+#if !OGLPLUS_NO_THREADS
+	const std::size_t min_chunk_size = 256*1024;
+	n_chunks = std::size_t(input_end-input_begin)/min_chunk_size;
+	n_chunks = std::min<std::size_t>(
+		n_chunks,
+		std::thread::hardware_concurrency()
+	);
+	if(n_chunks < 1) n_chunks = 1;
+#endif
+	if(opts.chunks > 0) n_chunks = opts.chunks;
+	std::vector<_chunk> chunks;
+	chunks.reserve(n_chunks);
+	const char* chunk_begin = input_begin;
+	for(std::size_t c=1; c<=n_chunks; ++c)
+	{
+		const char* chunk_end = input_end;
+		if(c != n_chunks)
+		{
+			chunk_end = input_begin+
+				std::size_t(input_end-input_begin)*c/n_chunks;
+			if(chunk_end < chunk_begin) chunk_end = chunk_begin;
+			chunk_end = std::find(chunk_end, input_end, '\n');
+			if(chunk_end != input_end) ++chunk_end;
+		}
+		chunks.push_back(_chunk(chunk_begin, chunk_end));
+		chunk_begin = chunk_end;
+	}
+
+	// count the vertex attributes in the individual chunks
+	aux::ObjForEachChunk(chunks, &ObjMesh::_count_chunk);
+
+	// vertex attrib tuple counts (including the unused ones)
+	_vert_indices n_attr;
+	n_attr._pos = 1;
+	n_attr._nml = 1;
+	n_attr._tex = 1;
+	n_attr._mtl = 1;
+
+	for(_chunk& chunk : chunks)
+	{
+		chunk.base = n_attr;
+		n_attr._pos += chunk.counts._pos;
+		n_attr._nml += chunk.counts._nml;
+		n_attr._tex += chunk.counts._tex;
+	}
+
+	// the first (unused) position, normal and tex. coord. are zero
+	std::vector<double> pos_data(n_attr._pos*3, 0.0);
+	std::vector<double> nml_data(n_attr._nml*3, 0.0);
+	std::vector<double> tex_data(n_attr._tex*3, 0.0);
+
+	aux::ObjForEachChunk(
+		chunks,
+		[&pos_data, &nml_data, &tex_data](_chunk& chunk)
+		{
+			try
 			{
-				mesh_counts.push_back(
-					GLuint(idx_data.size())-
-					mesh_offsets.back()
+				_parse_chunk(
+					chunk,
+					pos_data.data(),
+					nml_data.data(),
+					tex_data.data()
 				);
 			}
-			mesh_names.push_back(std::string(i, e));
-			mesh_offsets.push_back(GLuint(idx_data.size()));
+			catch(...)
+			{
+				chunk.error = std::current_exception();
+			}
+		}
+	);
+	for(_chunk& chunk : chunks)
+	{
+		if(chunk.error) std::rethrow_exception(chunk.error);
+	}
+
+	// unused index
+	std::vector<_vert_indices> idx_data(1, _vert_indices());
+	_mtl_names.push_back(std::string());
+
+	std::size_t n_idx = 1;
+	for(_chunk& chunk : chunks)
+	{
+		n_idx += chunk.idx_data.size();
+	}
+	idx_data.reserve(n_idx);
+
+	std::vector<std::string> mesh_names;
+	std::vector<GLuint> mesh_offsets;
+	std::vector<GLuint> mesh_counts;
+
+	GLuint curr_mtl = 0;
+	std::string mtllib;
+
+	// merge the chunks in the order in which they appear in the input
+	for(_chunk& chunk : chunks)
+	{
+		const GLuint idx_base = GLuint(idx_data.size());
+		const GLuint mtl_base = GLuint(_mtl_names.size()-1);
+		const GLuint prev_mtl = curr_mtl;
+
+		for(_chunk::_statement& stmt : chunk.statements)
+		{
+			if(stmt.tag == 'm')
+			{
+				mtllib = std::move(stmt.value);
+			}
+			else if(stmt.tag == 'u')
+			{
+				std::string material;
+				if(!mtllib.empty()) material = mtllib + '#';
+				material.append(stmt.value);
+
+				curr_mtl = GLuint(_mtl_names.size());
+				_mtl_names.push_back(material);
+			}
+			else if(stmt.tag == 'o')
+			{
+				const GLuint offset = idx_base+GLuint(stmt.offset);
+				if(!mesh_offsets.empty())
+				{
+					mesh_counts.push_back(
+						offset-
+						mesh_offsets.back()
+					);
+				}
+				mesh_names.push_back(std::move(stmt.value));
+				mesh_offsets.push_back(offset);
+			}
 		}
+
+		for(_vert_indices vi : chunk.idx_data)
+		{
+			vi._mtl = (vi._mtl != 0)?mtl_base+vi._mtl:prev_mtl;
+			idx_data.push_back(vi);
+		}
+		std::vector<_vert_indices>().swap(chunk.idx_data);
 	}
 	// the last mesh element count
 	if(mesh_offsets.empty())
@@ -292,6 +690,18 @@ void ObjMesh::_load_meshes(
 	_tex_data.resize(ni*3);
 	_mtl_data.resize(ni*1);
 
+	if(opts.load_tangents)
+	{
+		if(opts.load_tangents)
+		{
+			_tgt_data.resize(_pos_data.size());
+		}
+		if(opts.load_bitangents)
+		{
+			_btg_data.resize(_pos_data.size());
+		}
+	}
+
 	std::vector<std::size_t> meshes_to_load;
 
 	if(names_begin == names_end)
@@ -321,6 +731,11 @@ void ObjMesh::_load_meshes(
 		}
 	}
 
+	// the faces which are not loaded are left zeroed and get
+	// the tangents of a degenerate face
+	std::vector<bool> loaded_faces(ni/3, false);
+	bool has_bbox = false;
+
 	for(std::size_t l = 0; l!=meshes_to_load.size(); ++l)
 	{
 		std::size_t m = meshes_to_load[l];
@@ -332,11 +747,49 @@ void ObjMesh::_load_meshes(
 			for(std::size_t c=0; c!=3; ++c)
 			{
 				std::size_t oi = (ii-1)*3+c;
-				_pos_data[oi] = pos_data[idx_data[ii]._pos*3+c];
-				_nml_data[oi] = nml_data[idx_data[ii]._nml*3+c];
-				_tex_data[oi] = tex_data[idx_data[ii]._tex*3+c];
+				_pos_data[oi] = GLfloat(pos_data[idx_data[ii]._pos*3+c]);
+				_nml_data[oi] = GLfloat(nml_data[idx_data[ii]._nml*3+c]);
+				_tex_data[oi] = GLfloat(tex_data[idx_data[ii]._tex*3+c]);
 			}
 			_mtl_data[ii-1] = idx_data[ii]._mtl;
+
+			const double* vp = &pos_data[idx_data[ii]._pos*3];
+			if(!has_bbox)
+			{
+				_bbox_min = _bbox_max = Vec3d(vp, 3);
+				has_bbox = true;
+			}
+			for(std::size_t c=0; c!=3; ++c)
+			{
+				if(_bbox_min[c] > vp[c]) _bbox_min[c] = vp[c];
+				if(_bbox_max[c] < vp[c]) _bbox_max[c] = vp[c];
+			}
+			loaded_faces[(ii-1)/3] = true;
+
+			if(opts.load_tangents && ((ii-1) % 3 == 2))
+			{
+				std::size_t f = (ii-1)/3;
+				Vec3d p[3];
+				Vec2d uv[3];
+				for(std::size_t k=0; k<3; ++k)
+				{
+					const _vert_indices& vi = idx_data[f*3+k+1];
+					p[k] = Vec3d(
+						pos_data[vi._pos*3+0],
+						pos_data[vi._pos*3+1],
+						pos_data[vi._pos*3+2]
+					);
+					uv[k] = Vec2d(
+						tex_data[vi._tex*3+0],
+						tex_data[vi._tex*3+1]
+					);
+				}
+				_calc_tangents(
+					p, uv,
+					_tgt_data.empty()?nullptr:&_tgt_data[f*9],
+					_btg_data.empty()?nullptr:&_btg_data[f*9]
+				);
+			}
 			++ii;
 		}
 		_mesh_offsets.push_back(GLuint(mo));
@@ -347,84 +800,71 @@ void ObjMesh::_load_meshes(
 	assert(_pos_data.size() % 9 == 0);
 	assert(_pos_data.size() == _tex_data.size());
 
-	if(opts.load_tangents)
+	for(std::size_t f=0, nf=loaded_faces.size(); f!=nf; ++f)
 	{
-		if(opts.load_tangents)
+		if(loaded_faces[f]) continue;
+		const Vec3d origin;
+		if(!has_bbox)
 		{
-			_tgt_data.resize(_pos_data.size());
+			_bbox_min = _bbox_max = origin;
+			has_bbox = true;
 		}
-		if(opts.load_bitangents)
+		_bbox_min = Vec3d(
+			std::min(_bbox_min.x(), 0.0),
+			std::min(_bbox_min.y(), 0.0),
+			std::min(_bbox_min.z(), 0.0)
+		);
+		_bbox_max = Vec3d(
+			std::max(_bbox_max.x(), 0.0),
+			std::max(_bbox_max.y(), 0.0),
+			std::max(_bbox_max.z(), 0.0)
+		);
+		if(opts.load_tangents)
 		{
-			_btg_data.resize(_pos_data.size());
+			const Vec3d p[3];
+			const Vec2d uv[3];
+			_calc_tangents(
+				p, uv,
+				_tgt_data.empty()?nullptr:&_tgt_data[f*9],
+				_btg_data.empty()?nullptr:&_btg_data[f*9]
+			);
 		}
+	}
+}
 
-		for(std::size_t f=0, nf = _pos_data.size()/9; f != nf; ++f)
-		{
-			for(std::size_t v=0; v!=3; ++v)
-			{
-				std::size_t j[3] = {
-					v,
-					(v+1)%3,
-					(v+2)%3
-				};
-
-				Vec3d p[3];
-				Vec2d uv[3];
-				for(std::size_t k=0; k<3; ++k)
-				{
-					p[k] = Vec3d(
-						_pos_data[f*9+j[k]*3+0],
-						_pos_data[f*9+j[k]*3+1],
-						_pos_data[f*9+j[k]*3+2]
-					);
-					uv[k] = Vec2d(
-						_tex_data[f*9+j[k]*3+0],
-						_tex_data[f*9+j[k]*3+1]
-					);
-				}
-
-				Vec3d v0 = p[1] - p[0];
-				Vec3d v1 = p[2] - p[0];
-
-				Vec2d duv0 = uv[1] - uv[0];
-				Vec2d duv1 = uv[2] - uv[0];
-
-				double d = duv0.x()*duv1.y()-duv0.y()*duv1.x();
-				if(d != 0.0f) d = 1.0f/d;
-
-				if(opts.load_tangents)
-				{
-					Vec3f t = (duv1.y()*v0 - duv0.y()*v1)*d;
-					Vec3f nt = Normalized(t);
-
-					for(std::size_t tv=0; tv!=3; ++tv)
-					{
-						_tgt_data[f*9+v*3+0] = nt.x();
-						_tgt_data[f*9+v*3+1] = nt.y();
-						_tgt_data[f*9+v*3+2] = nt.z();
-					}
-				}
+OGLPLUS_LIB_FUNC
+void ObjMesh::_call_load_meshes(
+	std::istream& input,
+	aux::AnyInputIter<const char*> names_begin,
+	aux::AnyInputIter<const char*> names_end,
+	_loading_options opts
+)
+{
+	opts.load_tangents |= opts.load_bitangents;
+	opts.load_bitangents |= opts.load_tangents;
+	opts.load_texcoords |= opts.load_tangents;
 
-				if(opts.load_bitangents)
-				{
-					Vec3f b = (duv0.x()*v1 - duv1.x()*v0)*d;
-					Vec3f nb = Normalized(b);
-
-					for(std::size_t tv=0; tv!=3; ++tv)
-					{
-						_btg_data[f*9+v*3+0] = nb.x();
-						_btg_data[f*9+v*3+1] = nb.y();
-						_btg_data[f*9+v*3+2] = nb.z();
-					}
-				}
-			}
-		}
+	if(!input.good())
+	{
+		throw std::runtime_error("Obj file loader: Unable to read input.");
 	}
+
+	std::vector<char> buffer(
+		(std::istreambuf_iterator<char>(input)),
+		std::istreambuf_iterator<char>()
+	);
+	_load_meshes(
+		opts,
+		names_begin,
+		names_end,
+		buffer.data(),
+		buffer.data()+buffer.size()
+	);
 }
 
 OGLPLUS_LIB_FUNC
 void ObjMesh::_call_load_meshes(
-	std::istream& input,
+	const char* path,
 	aux::AnyInputIter<const char*> names_begin,
 	aux::AnyInputIter<const char*> names_end,
 	_loading_options opts
@@ -434,7 +874,19 @@ void ObjMesh::_call_load_meshes(
 	opts.load_bitangents |= opts.load_tangents;
 	opts.load_texcoords |= opts.load_tangents;
 
-	_load_meshes(opts, names_begin, names_end, input);
+	aux::MappedFile input(path);
+	if(!input.IsOpen())
+	{
+		throw std::runtime_error("Obj file loader: Unable to read input.");
+	}
+
+	_load_meshes(
+		opts,
+		names_begin,
+		names_end,
+		input.Begin(),
+		input.End()
+	);
 }
 
 OGLPLUS_LIB_FUNC
@@ -464,22 +916,9 @@ GLuint ObjMesh::GetMeshIndex(const std::string& name) const
 OGLPLUS_LIB_FUNC
 Spheref ObjMesh::MakeBoundingSphere(void) const
 {
-	GLdouble min_x = _pos_data[3], max_x = _pos_data[3];
-	GLdouble min_y = _pos_data[4], max_y = _pos_data[4];
-	GLdouble min_z = _pos_data[5], max_z = _pos_data[5];
-	for(std::size_t v=0, vn=_pos_data.size()/3; v!=vn; ++v)
-	{
-		GLdouble x = _pos_data[v*3+0];
-		GLdouble y = _pos_data[v*3+1];
-		GLdouble z = _pos_data[v*3+2];
-
-		if(min_x > x) min_x = x;
-		if(min_y > y) min_y = y;
-		if(min_z > z) min_z = z;
-		if(max_x < x) max_x = x;
-		if(max_y < y) max_y = y;
-		if(max_z < z) max_z = z;
-	}
+	const GLdouble min_x = _bbox_min.x(), max_x = _bbox_max.x();
+	const GLdouble min_y = _bbox_min.y(), max_y = _bbox_max.y();
+	const GLdouble min_z = _bbox_min.z(), max_z = _bbox_max.z();
 
 	Vec3d c(
 		(min_x + max_x) * 0.5,
@@ -0,0 +1,137 @@
+/**
+ *  @file oglplus/streaming_buffer.ipp
+ *  @brief Implementation of the StreamingBuffer
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <stdexcept>
+
+namespace oglplus {
+
+#if (GL_VERSION_4_4 || GL_ARB_buffer_storage) && (GL_VERSION_3_2 || GL_ARB_sync)
+
+OGLPLUS_LIB_FUNC
+StreamingBuffer::StreamingBuffer(
+	BufferTarget target,
+	BufferSize region_size,
+	std::size_t region_count
+): _target(target)
+ , _region_size(region_size.Get())
+ , _region_offset(0)
+ , _used(0)
+ , _uniform_alignment(1)
+ , _ptr(nullptr)
+ , _region(0)
+ , _stall_count(0)
+ , _wait_timeout(10000000000ull) // 10 s
+{
+	assert(_region_size > 0);
+	assert(region_count > 0);
+
+	const Bitfield<BufferStorageBit> storage_flags =
+		BufferStorageBit::MapWrite|
+		BufferStorageBit::MapPersistent|
+		BufferStorageBit::MapCoherent;
+
+	const Bitfield<BufferMapAccess> access =
+		BufferMapAccess::Write|
+		BufferMapAccess::Persistent|
+		BufferMapAccess::Coherent;
+
+	const GLsizeiptr total_size = _region_size*GLsizeiptr(region_count);
+
+	_buffer.Bind(_target);
+	Buffer::Storage(_target, BufferSize(total_size), nullptr, storage_flags);
+
+	_ptr = static_cast<GLubyte*>(OGLPLUS_GLFUNC(MapBufferRange)(
+		GLenum(_target),
+		0,
+		total_size,
+		GLbitfield(access)
+	));
+	OGLPLUS_CHECK(
+		MapBufferRange,
+		ObjectError,
+		ObjectBinding(_target)
+	);
+
+	GLint alignment = 1;
+	OGLPLUS_GLFUNC(GetIntegerv)(
+		GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,
+		&alignment
+	);
+	OGLPLUS_VERIFY_SIMPLE(GetIntegerv);
+	if(alignment > 1)
+	{
+		_uniform_alignment = GLsizeiptr(alignment);
+	}
+
+	// the initial fences are signalled as soon as the storage is set up
+	_fences.reserve(region_count);
+	for(std::size_t r=0; r!=region_count; ++r)
+	{
+		_fences.push_back(Sync());
+	}
+}
+
+OGLPLUS_LIB_FUNC
+StreamingBuffer::~StreamingBuffer(void)
+{
+	try
+	{
+		if(_ptr != nullptr)
+		{
+			_buffer.Bind(_target);
+			OGLPLUS_GLFUNC(UnmapBuffer)(GLenum(_target));
+		}
+	}
+	catch(...) { }
+}
+
+OGLPLUS_LIB_FUNC
+GLintptr StreamingBuffer::_allocate(GLsizeiptr size, GLsizeiptr alignment)
+{
+	// the alignment applies to the offset from the start of the buffer
+	GLsizeiptr offset = _align(_region_offset+_used, alignment);
+	if(offset+size > _region_offset+_region_size)
+	{
+		throw std::runtime_error(
+			"StreamingBuffer: Not enough space left in the current region"
+		);
+	}
+	_used = offset+size-_region_offset;
+	return GLintptr(offset);
+}
+
+OGLPLUS_LIB_FUNC
+void StreamingBuffer::FinishFrame(void)
+{
+	_fences[_region] = Sync();
+
+	if(++_region == _fences.size())
+	{
+		_region = 0;
+	}
+	_region_offset = _region_size*GLsizeiptr(_region);
+	_used = 0;
+
+	// most of the time the GL is done with the region already
+	if(aux::SyncWaitFlush(
+		_fences[_region],
+		_wait_timeout,
+		"StreamingBuffer"
+	))
+	{
+		++_stall_count;
+	}
+}
+
+#endif // buffer_storage && sync
+
+} // namespace oglplus
+
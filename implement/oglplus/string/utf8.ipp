@@ -9,8 +9,15 @@
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
 #include <oglplus/config/basic.hpp>
+#include <oglplus/config/simd.hpp>
 #include <oglplus/assert.hpp>
 
+#include <cstring>
+
+#if OGLPLUS_MATH_SSE
+#include <emmintrin.h>
+#endif
+
 namespace oglplus {
 namespace aux {
 
@@ -178,9 +185,9 @@ UnicodeCP ConvertUTF8ToCodePoint(const char* str, std::size_t len, std::size_t&
 	// 1110xxxx
 	else if((bytes[0] & 0xF0) == 0xE0)
 	{
-		// but not 11100000
-		assert(bytes[0] != 0xE0);
 		assert(len >= 3);
+		// but not an overlong 11100000 100xxxxx
+		assert((bytes[0] != 0xE0) || (bytes[1] >= 0xA0));
 		cp_len = 3;
 		return UnicodeCP(
 			(((bytes[0] & ~0xF0u) << 12) & 0x0003F000u)|
@@ -191,9 +198,9 @@ UnicodeCP ConvertUTF8ToCodePoint(const char* str, std::size_t len, std::size_t&
 	// 11110xxx
 	else if((bytes[0] & 0xF8) == 0xF0)
 	{
-		// but not 11110000
-		assert(bytes[0] != 0xF0);
 		assert(len >= 4);
+		// but not an overlong 11110000 1000xxxx
+		assert((bytes[0] != 0xF0) || (bytes[1] >= 0x90));
 		cp_len = 4;
 		return UnicodeCP(
 			(((bytes[0] & ~0xF8u) << 18) & 0x00FC0000u)|
@@ -237,28 +244,177 @@ UnicodeCP ConvertUTF8ToCodePoint(const char* str, std::size_t len, std::size_t&
 	return UnicodeCP();
 }
 
+// Copies the leading ASCII characters from str into cps and returns
+// their count. The characters are tested and widened 16 (or 8) at a time
 OGLPLUS_LIB_FUNC
-void ConvertUTF8ToCodePoints(
+std::size_t DecodeASCII(
+	const unsigned char* str,
+	std::size_t len,
+	UnicodeCP* cps
+)
+{
+	std::size_t i = 0;
+#if OGLPLUS_MATH_SSE
+	const __m128i zero = _mm_setzero_si128();
+	while(i+16 <= len)
+	{
+		const __m128i b = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(str+i)
+		);
+		if(_mm_movemask_epi8(b) != 0) break;
+		const __m128i lo = _mm_unpacklo_epi8(b, zero);
+		const __m128i hi = _mm_unpackhi_epi8(b, zero);
+		__m128i* dst = reinterpret_cast<__m128i*>(cps+i);
+		_mm_storeu_si128(dst+0, _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128(dst+1, _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128(dst+2, _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128(dst+3, _mm_unpackhi_epi16(hi, zero));
+		i += 16;
+	}
+#else
+	while(i+8 <= len)
+	{
+		unsigned long long w;
+		std::memcpy(&w, str+i, sizeof(w));
+		if(w & 0x8080808080808080ull) break;
+		for(std::size_t k=0; k!=8; ++k)
+			cps[i+k] = UnicodeCP(str[i+k]);
+		i += 8;
+	}
+#endif
+	while((i < len) && (str[i] < 0x80))
+	{
+		cps[i] = UnicodeCP(str[i]);
+		++i;
+	}
+	return i;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t DecodeUTF8(
 	const char* str,
 	std::size_t len,
-	std::vector<UnicodeCP>& result
+	UnicodeCP* cps,
+	std::size_t max_cps,
+	std::size_t& cp_count
 )
 {
-	std::size_t ulen = CodePointsRequired(str, len);
-	result.resize(ulen);
-	UnicodeCP* cpptr = result.data();
-	std::size_t cplen = 0;
-	while(len)
+	assert(sizeof(char) == sizeof(unsigned char));
+	const unsigned char* pb=reinterpret_cast<const unsigned char*>(str);
+
+	std::size_t i = 0, n = 0;
+	while((i < len) && (n < max_cps))
 	{
-		*cpptr = ConvertUTF8ToCodePoint(str, len, cplen);
-		++cpptr;
-		assert(cplen > 0);
-		assert(len >= cplen);
-		len -= cplen;
-		str += cplen;
-		ulen -= 1;
+		if(pb[i] < 0x80)
+		{
+			std::size_t run = len-i;
+			if(run > max_cps-n) run = max_cps-n;
+			run = DecodeASCII(pb+i, run, cps+n);
+			assert(run > 0);
+			i += run;
+			n += run;
+			continue;
+		}
+
+		// the lead byte determines the length of the sequence,
+		// 0x80-0xC1 are continuation bytes or overlong 2-byte forms,
+		// 0xF5-0xFF would encode code points beyond U+10FFFF
+		const unsigned b0 = pb[i];
+		std::size_t cp_len;
+		UnicodeCP cp;
+		if(b0 < 0xE0)
+		{
+			if((b0 < 0xC2) || (len-i < 2)) break;
+			const unsigned b1 = pb[i+1];
+			if((b1 & 0xC0) != 0x80) break;
+			cp = ((b0 & 0x1Fu) << 6) | (b1 & 0x3Fu);
+			cp_len = 2;
+		}
+		else if(b0 < 0xF0)
+		{
+			if(len-i < 3) break;
+			const unsigned b1 = pb[i+1];
+			const unsigned b2 = pb[i+2];
+			if(((b1 & 0xC0) != 0x80) || ((b2 & 0xC0) != 0x80)) break;
+			cp =	((b0 & 0x0Fu) << 12)|
+				((b1 & 0x3Fu) <<  6)|
+				((b2 & 0x3Fu) <<  0);
+			// reject the overlong forms and the surrogates
+			if((cp < 0x800u) || ((cp >= 0xD800u) && (cp <= 0xDFFFu)))
+				break;
+			cp_len = 3;
+		}
+		else
+		{
+			if((b0 > 0xF4) || (len-i < 4)) break;
+			const unsigned b1 = pb[i+1];
+			const unsigned b2 = pb[i+2];
+			const unsigned b3 = pb[i+3];
+			if(	((b1 & 0xC0) != 0x80) ||
+				((b2 & 0xC0) != 0x80) ||
+				((b3 & 0xC0) != 0x80)
+			) break;
+			cp =	((b0 & 0x07u) << 18)|
+				((b1 & 0x3Fu) << 12)|
+				((b2 & 0x3Fu) <<  6)|
+				((b3 & 0x3Fu) <<  0);
+			// reject the overlong forms and code points beyond U+10FFFF
+			if((cp < 0x10000u) || (cp > 0x10FFFFu))
+				break;
+			cp_len = 4;
+		}
+
+		cps[n++] = cp;
+		i += cp_len;
+	}
+	cp_count = n;
+	return i;
+}
+
+OGLPLUS_LIB_FUNC
+std::size_t ConvertUTF8ToCodePoints(
+	const char* str,
+	std::size_t len,
+	UnicodeCP* cps,
+	std::size_t max_cps
+)
+{
+	std::size_t result = 0;
+	while((len != 0) && (result < max_cps))
+	{
+		std::size_t cp_count = 0;
+		std::size_t bytes = DecodeUTF8(
+			str, len,
+			cps+result,
+			max_cps-result,
+			cp_count
+		);
+		str += bytes;
+		len -= bytes;
+		result += cp_count;
+
+		// skip one byte of an invalid sequence
+		if((len != 0) && (result < max_cps))
+		{
+			cps[result++] = 0xFFFDu;
+			++str;
+			--len;
+		}
 	}
-	assert(ulen == 0);
+	return result;
+}
+
+OGLPLUS_LIB_FUNC
+void ConvertUTF8ToCodePoints(
+	const char* str,
+	std::size_t len,
+	std::vector<UnicodeCP>& result
+)
+{
+	// each byte yields at most one code point, the storage
+	// is reused if result has the required capacity
+	result.resize(len);
+	result.resize(ConvertUTF8ToCodePoints(str, len, result.data(), len));
 }
 
 OGLPLUS_LIB_FUNC
@@ -303,17 +459,21 @@ const char* UTF8Validator::_validate(const char* _s, const char* _end)
 			// 1110xxxx
 			else if((byte(_s) & 0xF0) == 0xE0)
 			{
-				// but not 11100000
-				if(byte(_s) == 0xE0)
-					return nullptr;
+				// but not an overlong 11100000 100xxxxx
+				if(	(byte(_s) == 0xE0) &&
+					(_s+1 != _end) &&
+					((byte(_s+1) & 0xE0) == 0x80)
+				) return nullptr;
 				bytes = 2;
 			}
 			// 11110xxx
 			else if((byte(_s) & 0xF8) == 0xF0)
 			{
-				// but not 11110000
-				if(byte(_s) == 0xF0)
-					return nullptr;
+				// but not an overlong 11110000 1000xxxx
+				if(	(byte(_s) == 0xF0) &&
+					(_s+1 != _end) &&
+					((byte(_s+1) & 0xF0) == 0x80)
+				) return nullptr;
 				bytes = 3;
 			}
 			// 111110xx
@@ -8,6 +8,8 @@
  *  Software License, Version 1.0. (See accompanying file
  *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
  */
+#include <algorithm>
+#include <iterator>
 #include <cassert>
 
 namespace oglplus {
@@ -16,78 +18,108 @@ namespace text {
 OGLPLUS_LIB_FUNC
 bool BitmapGlyphPager::_frames_consistent(void) const
 {
-	_gpu_page_map.Bind(Buffer::Target::Uniform);
-	BufferTypedMap<gpu_frame_t> page_frame_map(
-		BufferTarget::Uniform,
-		BufferMapAccess::Read
-	);
 	const std::size_t n = _frames.size();
+	std::size_t used = 0;
 	for(std::size_t i=0; i!=n; ++i)
 	{
 		GLint page = _frames[i];
 		if(page >= 0)
 		{
-			for(std::size_t j=0; j!=i; ++j)
-			{
-				if(page == _frames[j])
-				{
-					return false;
-				}
-			}
-
-			assert(!(page < 0));
-
-			gpu_frame_t frame = page_frame_map.At(GLuint(page));
-			if(frame != gpu_frame_t(i))
+			// each page is in a single frame so
+			// the frame in the page map must match
+			if(FrameOfPage(GLuint(page)) != GLint(i))
 			{
 				return false;
 			}
+			++used;
 		}
 	}
-	return true;
+	return used+_free_frames.size() == n;
 }
 
 OGLPLUS_LIB_FUNC
-bool BitmapGlyphPager::_page_in_frames(GLuint page) const
+void BitmapGlyphPager::_lru_unlink(GLuint frame)
 {
-	for(auto i=_frames.begin(), e=_frames.end(); i!=e; ++i)
-	{
-		if(*i == GLint(page))
-		{
-			return true;
-		}
-	}
-	return false;
+	const GLuint prev = _lru_prev[frame];
+	const GLuint next = _lru_next[frame];
+
+	if(prev != _nil()) _lru_next[prev] = next;
+	else _lru_head = next;
+
+	if(next != _nil()) _lru_prev[next] = prev;
+	else _lru_tail = prev;
+
+	_lru_prev[frame] = _nil();
+	_lru_next[frame] = _nil();
+}
+
+OGLPLUS_LIB_FUNC
+void BitmapGlyphPager::_lru_push_front(GLuint frame)
+{
+	_lru_prev[frame] = _nil();
+	_lru_next[frame] = _lru_head;
+	if(_lru_head != _nil()) _lru_prev[_lru_head] = frame;
+	else _lru_tail = frame;
+	_lru_head = frame;
+}
+
+OGLPLUS_LIB_FUNC
+void BitmapGlyphPager::_lru_push_back(GLuint frame)
+{
+	_lru_next[frame] = _nil();
+	_lru_prev[frame] = _lru_tail;
+	if(_lru_tail != _nil()) _lru_next[_lru_tail] = frame;
+	else _lru_head = frame;
+	_lru_tail = frame;
 }
 
 OGLPLUS_LIB_FUNC
-void BitmapGlyphPager::_replace_page(GLuint frame, GLuint page)
+void BitmapGlyphPager::_replace_page(GLuint frame, GLuint page, bool recent)
 {
-	assert(!_page_in_frames(page));
+	assert(frame < _frames.size());
+	assert(FrameOfPage(page) < 0);
 	// the previous page in the frame
 	GLint previous = _frames[frame];
+	if(previous >= 0)
+	{
+		// evict the previous page
+		_set_frame_of_page(GLuint(previous), _invalid_gpu_frame());
+		_lru_unlink(frame);
+		++_eviction_count;
+	}
+	else
+	{
+		// the frame is usually the last free one
+		auto pos = std::find(
+			_free_frames.rbegin(),
+			_free_frames.rend(),
+			frame
+		);
+		assert(pos != _free_frames.rend());
+		_free_frames.erase(std::next(pos).base());
+	}
 	// assign the new page to the frame
 	_frames[frame] = GLint(page);
-	// update the age of the other frames
-	Update();
-	// initialize the age of the frame
-	_ages[frame] = _init_age();
-	//
-	// we'll need to update the page map on gpu
-	_gpu_page_map.Bind(Buffer::Target::Uniform);
-	BufferTypedMap<gpu_frame_t> page_frame_map(
-		BufferTarget::Uniform,
-		BufferMapAccess::Write
-	);
-	if(previous >= 0)
+	_set_frame_of_page(page, gpu_frame_t(frame));
+
+	if(recent) _lru_push_front(frame);
+	else _lru_push_back(frame);
+}
+
+OGLPLUS_LIB_FUNC
+GLuint BitmapGlyphPager::_prefetch_candidate(GLuint page, GLuint offs) const
+{
+	const GLuint pages_per_plane = BitmapGlyphPagesPerPlane(_parent);
+	const GLuint next = page+offs;
+	if(next >= _page_map.size())
 	{
-		// remove the previous page from active list
-		_active_pages.erase(GLuint(previous));
-		page_frame_map.At(GLuint(previous)) = _invalid_gpu_frame();
-		// add the new page into the active list
+		return _nil();
 	}
-	_active_pages[page] = frame;
-	page_frame_map.At(page) = gpu_frame_t(frame);
+	if(next / pages_per_plane != page / pages_per_plane)
+	{
+		return _nil();
+	}
+	return next;
 }
 
 OGLPLUS_LIB_FUNC
@@ -97,16 +129,35 @@ BitmapGlyphPager::BitmapGlyphPager(
 	SizeType frame_count
 ): _parent(parent)
  , _frames(frame_count, GLint(-1))
- , _ages(frame_count, _zero_age())
+ , _free_frames(std::size_t(GLsizei(frame_count)))
+ , _lru_prev(frame_count, _nil())
+ , _lru_next(frame_count, _nil())
+ , _lru_head(_nil())
+ , _lru_tail(_nil())
+ , _page_map(
+	BitmapGlyphPlaneCount(_parent)*
+	BitmapGlyphPagesPerPlane(_parent),
+	_invalid_gpu_frame()
+), _dirty_begin(GLuint(_page_map.size()))
+ , _dirty_end(0)
+ , _prefetch(BitmapGlyphPagePrefetch(_parent))
+ , _hit_count(0)
+ , _miss_count(0)
+ , _eviction_count(0)
+ , _prefetch_count(0)
+ , _upload_count(0)
  , _pg_map_tex_unit(pg_map_tex_unit)
 {
+	// the frame numbers must fit into the page map entries
+	assert(_frames.size() < std::size_t(_invalid_gpu_frame()));
+	// the free frames are used starting with the first one
+	for(std::size_t i=0, n=_free_frames.size(); i!=n; ++i)
+	{
+		_free_frames[i] = GLuint(n-i-1);
+	}
+
 	_gpu_page_map.Bind(Buffer::Target::Uniform);
-	std::vector<gpu_frame_t> data(
-		BitmapGlyphPlaneCount(_parent)*
-		BitmapGlyphPagesPerPlane(_parent),
-		_invalid_gpu_frame()
-	);
-	Buffer::Data(Buffer::Target::Uniform, data);
+	Buffer::Data(Buffer::Target::Uniform, _page_map);
 
 	Texture::Active(_pg_map_tex_unit);
 	_page_map_tex.Bind(Texture::Target::Buffer);
@@ -119,67 +170,49 @@ BitmapGlyphPager::BitmapGlyphPager(
 	assert(_is_ok());
 }
 
-OGLPLUS_LIB_FUNC
-GLuint BitmapGlyphPager::FindFrame(void)
-{
-	assert(_is_ok());
-
-	const std::size_t n = _frames.size();
-
-	for(std::size_t i=0; i!=n; ++i)
-	{
-		if(_frames[i] < 0)
-		{
-			return GLuint(i);
-		}
-	}
-
-	age_t min = _full_age();
-	std::size_t m = 0;
-	for(std::size_t i=0; i!=n; ++i)
-	{
-		if(min > _ages[i])
-		{
-			min = _ages[i];
-			m = i;
-		}
-	}
-	return GLuint(m);
-}
-
 OGLPLUS_LIB_FUNC
 bool BitmapGlyphPager::UsePage(GLuint page)
 {
 	assert(_is_ok());
 
-	auto pos = _active_pages.find(page);
+	GLint frame = FrameOfPage(page);
 	// if this is a page miss
-	if(pos == _active_pages.end())
+	if(frame < 0)
 	{
-		assert(!_page_in_frames(page));
+		++_miss_count;
 		return false;
 	}
 	// if this is a page hit
-	else
+	++_hit_count;
+	assert(_frames[GLuint(frame)] == GLint(page));
+	// note frame usage
+	if(_lru_head != GLuint(frame))
 	{
-		assert(_page_in_frames(page));
-		// note frame usage
-		_touch_frame(pos->second);
+		_lru_unlink(GLuint(frame));
+		_lru_push_front(GLuint(frame));
 	}
 	return true;
 }
 
 OGLPLUS_LIB_FUNC
-GLint BitmapGlyphPager::FrameOfPage(GLuint page) const
+void BitmapGlyphPager::Flush(void)
 {
-	auto pos = _active_pages.find(page);
-	if(pos != _active_pages.end())
+	if(_dirty_begin < _dirty_end)
 	{
-		return GLint(pos->second);
+		// upload only the range of changed entries
+		// instead of the whole page map
+		_gpu_page_map.Bind(Buffer::Target::Uniform);
+		Buffer::SubData(
+			Buffer::Target::Uniform,
+			BufferSize(GLsizeiptr(_dirty_begin*sizeof(gpu_frame_t))),
+			GLsizei(_dirty_end-_dirty_begin),
+			_page_map.data()+_dirty_begin
+		);
+		++_upload_count;
+		_dirty_begin = GLuint(_page_map.size());
+		_dirty_end = 0;
 	}
-	else return GLint(-1);
 }
 
 } // namespace text
 } // namespace oglplus
-
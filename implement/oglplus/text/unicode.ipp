@@ -41,6 +41,16 @@ OGLPLUS_LIB_FUNC void UTF8ToCodePoints(
 	aux::ConvertUTF8ToCodePoints(c_str, length, result);
 }
 
+OGLPLUS_LIB_FUNC std::size_t UTF8ToCodePoints(
+	const char* c_str,
+	std::size_t length,
+	CodePoint* cps,
+	std::size_t max_cps
+)
+{
+	return aux::ConvertUTF8ToCodePoints(c_str, length, cps, max_cps);
+}
+
 OGLPLUS_LIB_FUNC void CodePointsToUTF8(
 	const CodePoint* begin,
 	const CodePoint* end,
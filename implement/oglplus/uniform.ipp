@@ -13,6 +13,7 @@
 #include <oglplus/error/prog_var.hpp>
 #include <oglplus/object/tags.hpp>
 #include <oglplus/object/desc.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/lib/incl_end.ipp>
 #include <cstring>
 
@@ -36,6 +37,11 @@ OGLPLUS_LIB_FUNC
 GLenum ProgVarTypeOps<tag::Uniform>::
 GetType(ProgramName program, GLint /*location*/, StrCRef identifier)
 {
+	ProgramReflection::VariableInfo info;
+	if(ProgramReflection::QueryUniform(program, identifier, info))
+	{
+		return info.type;
+	}
 
 	GLenum type, result = GL_NONE;
 	GLint size;
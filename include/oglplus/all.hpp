@@ -21,6 +21,7 @@
 #include <oglplus/math/vector.hpp>
 #include <oglplus/math/quaternion.hpp>
 #include <oglplus/math/matrix.hpp>
+#include <oglplus/math/batch.hpp>
 #include <oglplus/math/plane.hpp>
 #include <oglplus/math/curve.hpp>
 #include <oglplus/math/sphere.hpp>
@@ -28,6 +29,7 @@
 #include <oglplus/error/object.hpp>
 #include <oglplus/error/prog_var.hpp>
 #include <oglplus/error/program.hpp>
+#include <oglplus/error/check_policy.hpp>
 
 #include <oglplus/context.hpp>
 
@@ -53,8 +55,11 @@
 #include <oglplus/program_pipeline.hpp>
 #include <oglplus/query.hpp>
 #include <oglplus/program.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/shader.hpp>
 #include <oglplus/sync.hpp>
+#include <oglplus/streaming_buffer.hpp>
+#include <oglplus/pixel_readback.hpp>
 
 #include <oglplus/named_string.hpp>
 
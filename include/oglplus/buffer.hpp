@@ -28,6 +28,7 @@
 #include <oglplus/access_specifier.hpp>
 #include <oglplus/data_type.hpp>
 #include <oglplus/pixel_data.hpp>
+#include <oglplus/state_cache.hpp>
 
 #include <vector>
 #include <cassert>
@@ -79,6 +80,30 @@ protected:
 	}
 };
 
+#if GL_VERSION_4_3 || GL_ARB_invalidate_subdata
+namespace aux {
+
+// Invalidates the data of buffers released to a NamePool
+template <>
+struct NamePoolOrphan<tag::Buffer>
+{
+	static void Apply(GLsizei count, const GLuint* names)
+	{
+		for(GLsizei i=0; i!=count; ++i)
+		{
+			// skip names that were never bound
+			if(OGLPLUS_GLFUNC(IsBuffer)(names[i]) == GL_TRUE)
+			{
+				OGLPLUS_GLFUNC(InvalidateBufferData)(names[i]);
+				OGLPLUS_VERIFY_SIMPLE(InvalidateBufferData);
+			}
+		}
+	}
+};
+
+} // namespace aux
+#endif
+
 /// Buffer binding operations
 template <>
 class ObjBindingOps<tag::Buffer>
@@ -116,6 +141,13 @@ public:
 		BufferName buffer
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GLenum(target), 0,
+			GetGLName(buffer)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindBuffer)(
 			GLenum(target),
 			GetGLName(buffer)
@@ -126,6 +158,7 @@ public:
 			Object(buffer).
 			BindTarget(target)
 		);
+		cached.Update();
 	}
 
 	/// Returns the current Buffer bound to specified indexed @p target
@@ -148,6 +181,13 @@ public:
 		BufferName buffer
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::IndexedBinding,
+			GLenum(target), index,
+			GetGLName(buffer)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindBufferBase)(
 			GLenum(target),
 			index,
@@ -159,6 +199,13 @@ public:
 			Object(buffer).
 			BindTarget(target)
 		);
+		cached.Update();
+		// binds also the generic binding point
+		aux::StateCacheEntry(
+			aux::StateCacheGroup::Binding,
+			GLenum(target), 0,
+			GetGLName(buffer)
+		).Update();
 	}
 
 	/// Bind a range the specified buffer to the specified indexed @p target
@@ -173,6 +220,15 @@ public:
 		BufferSize size
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::IndexedBinding,
+			GLenum(target), index,
+			GetGLName(buffer),
+			GLuint64(offset.Get()),
+			GLuint64(size.Get())
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindBufferRange)(
 			GLenum(target),
 			index,
@@ -186,6 +242,12 @@ public:
 			Object(buffer).
 			BindTarget(target)
 		);
+		cached.Update();
+		aux::StateCacheEntry(
+			aux::StateCacheGroup::Binding,
+			GLenum(target), 0,
+			GetGLName(buffer)
+		).Update();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_multi_bind
@@ -207,6 +269,14 @@ public:
 			ObjectError,
 			BindTarget(target)
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::IndexedBinding,
+			GLenum(target)
+		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Binding,
+			GLenum(target)
+		);
 	}
 
 	/// Sequentially binds @p buffers to @p target starting at @p first index
@@ -251,6 +321,14 @@ public:
 			ObjectError,
 			BindTarget(target)
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::IndexedBinding,
+			GLenum(target)
+		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Binding,
+			GLenum(target)
+		);
 	}
 
 	static void BindRange(
@@ -13,9 +13,11 @@
 #ifndef OGLPLUS_CAPABILITY_1107121519_HPP
 #define OGLPLUS_CAPABILITY_1107121519_HPP
 
+#include <oglplus/glfunc.hpp>
 #include <oglplus/error/basic.hpp>
 #include <oglplus/enums/capability.hpp>
 #include <oglplus/enums/functionality.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 
@@ -23,30 +25,45 @@ namespace oglplus {
 #include <oglplus/enums/capability_class.ipp>
 #endif
 
-inline void operator << (Capability capability, bool enable)
+namespace aux {
+
+inline void EnableCapability(GLenum code, bool enable)
 {
+	const StateCacheEntry cached(
+		StateCacheGroup::Capability,
+		code, 0,
+		enable?GL_TRUE:GL_FALSE
+	);
+	if(cached.Current()) return;
+
 	if(enable)
 	{
-		OGLPLUS_GLFUNC(Enable)(GLenum(capability));
+		OGLPLUS_GLFUNC(Enable)(code);
 		OGLPLUS_VERIFY_SIMPLE(Enable);
 	}
 	else
 	{
-		OGLPLUS_GLFUNC(Disable)(GLenum(capability));
+		OGLPLUS_GLFUNC(Disable)(code);
 		OGLPLUS_VERIFY_SIMPLE(Disable);
 	}
+	cached.Update();
+}
+
+} // namespace aux
+
+inline void operator << (Capability capability, bool enable)
+{
+	aux::EnableCapability(GLenum(capability), enable);
 }
 
 inline void operator + (Capability capability)
 {
-	OGLPLUS_GLFUNC(Enable)(GLenum(capability));
-	OGLPLUS_VERIFY_SIMPLE(Enable);
+	aux::EnableCapability(GLenum(capability), true);
 }
 
 inline void operator - (Capability capability)
 {
-	OGLPLUS_GLFUNC(Disable)(GLenum(capability));
-	OGLPLUS_VERIFY_SIMPLE(Disable);
+	aux::EnableCapability(GLenum(capability), false);
 }
 
 struct FunctionalityAndNumber
@@ -62,28 +79,17 @@ inline FunctionalityAndNumber operator | (Functionality func, GLuint number)
 
 inline void operator << (FunctionalityAndNumber func_and_num, bool enable)
 {
-	if(enable)
-	{
-		OGLPLUS_GLFUNC(Enable)(func_and_num._code);
-		OGLPLUS_VERIFY_SIMPLE(Enable);
-	}
-	else
-	{
-		OGLPLUS_GLFUNC(Disable)(func_and_num._code);
-		OGLPLUS_VERIFY_SIMPLE(Disable);
-	}
+	aux::EnableCapability(func_and_num._code, enable);
 }
 
 inline void operator + (FunctionalityAndNumber func_and_num)
 {
-	OGLPLUS_GLFUNC(Enable)(func_and_num._code);
-	OGLPLUS_VERIFY_SIMPLE(Enable);
+	aux::EnableCapability(func_and_num._code, true);
 }
 
 inline void operator - (FunctionalityAndNumber func_and_num)
 {
-	OGLPLUS_GLFUNC(Disable)(func_and_num._code);
-	OGLPLUS_VERIFY_SIMPLE(Disable);
+	aux::EnableCapability(func_and_num._code, false);
 }
 
 } // namespace oglplus
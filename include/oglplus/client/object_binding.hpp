@@ -311,6 +311,11 @@ private:
 			Error,
 			Index(tex_unit)
 		);
+		oglplus::aux::StateCacheEntry(
+			oglplus::aux::StateCacheGroup::ActiveTexture,
+			GL_ACTIVE_TEXTURE, 0,
+			tex_unit
+		).Update();
 	}
 
 	static
@@ -0,0 +1,18 @@
+/**
+ *  @file oglplus/conditional_render_mode.hpp
+ *  @brief OpenGL conditional render mode enumeration
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_CONDITIONAL_RENDER_MODE_1509251140_HPP
+#define OGLPLUS_CONDITIONAL_RENDER_MODE_1509251140_HPP
+
+#include <oglplus/enums/conditional_render_mode.hpp>
+
+#endif // include guard
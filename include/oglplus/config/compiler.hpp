@@ -199,6 +199,14 @@
 #endif
 #endif
 
+#ifndef OGLPLUS_NO_THREADS
+#if	defined(BOOST_NO_CXX11_HDR_THREAD)
+#define OGLPLUS_NO_THREADS 1
+#else
+#define OGLPLUS_NO_THREADS 0
+#endif
+#endif
+
 #ifndef OGLPLUS_NO_SCOPED_ENUM_TEMPLATE_PARAMS
 #ifdef _MSC_VER // TODO < specific version
 #define OGLPLUS_NO_SCOPED_ENUM_TEMPLATE_PARAMS 1
@@ -40,6 +40,25 @@
 # endif
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the run-time selectable error check policy
+/** If set to a nonzero value, then @c glGetError is always called right
+ *  after every wrapped GL function call and the ErrorCheckPolicy
+ *  set by SetErrorCheckPolicy is ignored.
+ *
+ *  By default this option is set to 0, i.e. the policy can be selected.
+ *
+ *  @see ErrorCheckPolicy
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_ERROR_NO_CHECK_POLICY
+#else
+# ifndef OGLPLUS_ERROR_NO_CHECK_POLICY
+#  define OGLPLUS_ERROR_NO_CHECK_POLICY 0
+# endif
+#endif
+
 #if OGLPLUS_DOCUMENTATION_ONLY
 /// Compile-time switch disabling the ErrorFile attribute of ErrorInfo
 /**
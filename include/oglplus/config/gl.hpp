@@ -83,4 +83,26 @@
 # endif
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch enabling the swappable GL dispatch table
+/** Setting this preprocessor symbol to a nonzero value causes that
+ *  the GL functions wrapped by OGLplus are called through a dispatch
+ *  table, where the native GL functions can be replaced by the null
+ *  backend (see GLNullBackend) or by individual overrides, and where
+ *  the calls can be counted and timed (see GLCallRecorder).
+ *  This allows to test and benchmark the wrappers without a GL context.
+ *
+ *  When no backend, override or recorder is active, the native functions
+ *  are called directly after a single additional check.
+ *  This option requires variadic templates and is disabled by default.
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_GL_DISPATCH
+#else
+# ifndef OGLPLUS_GL_DISPATCH
+#  define OGLPLUS_GL_DISPATCH 0
+# endif
+#endif
+
 #endif // include guard
@@ -45,4 +45,45 @@
 # endif
 #endif
 
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the StateCache
+/** Setting this preprocessor option to a non-zero integer value
+ *  removes the checks of the StateCache from the binding, capability,
+ *  blending, depth and viewport functions, so they always call GL
+ *  even if a StateCache was made current.
+ *
+ *  By default this option is set to the same value as #OGLPLUS_LOW_PROFILE,
+ *  i.e. the state cache can be used when not in low-profile mode.
+ *
+ *  @see StateCache
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_STATE_CACHE
+#else
+# ifndef OGLPLUS_NO_STATE_CACHE
+#  define OGLPLUS_NO_STATE_CACHE OGLPLUS_LOW_PROFILE
+# endif
+#endif
+
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the NamePool
+/** Setting this preprocessor option to a non-zero integer value
+ *  makes the objects always generate and delete their names directly
+ *  even if a NamePool was made current.
+ *
+ *  By default this option is set to the same value as #OGLPLUS_LOW_PROFILE,
+ *  i.e. the name pools can be used when not in low-profile mode.
+ *
+ *  @see NamePool
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_NAME_POOL
+#else
+# ifndef OGLPLUS_NO_NAME_POOL
+#  define OGLPLUS_NO_NAME_POOL OGLPLUS_LOW_PROFILE
+# endif
+#endif
+
 #endif // include guard
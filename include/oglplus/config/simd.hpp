@@ -0,0 +1,55 @@
+/**
+ *  @file oglplus/config/simd.hpp
+ *  @brief SIMD-related compile-time configuration options
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_CONFIG_SIMD_1510181200_HPP
+#define OGLPLUS_CONFIG_SIMD_1510181200_HPP
+
+#include <oglplus/config/compiler.hpp>
+
+#if OGLPLUS_DOCUMENTATION_ONLY
+/// Compile-time switch disabling the SIMD code paths
+/** Setting this preprocessor symbol to a nonzero value disables
+ *  the SSE and NEON specializations of the math kernels and the
+ *  vectorized parts of the UTF-8 decoder, which then use only
+ *  the portable implementation.
+ *
+ *  By default this option is set to zero and the SIMD instruction
+ *  set is detected from the compiler's predefined macros.
+ *
+ *  @ingroup compile_time_config
+ */
+#define OGLPLUS_NO_SIMD
+#else
+# ifndef OGLPLUS_NO_SIMD
+#  define OGLPLUS_NO_SIMD 0
+# endif
+#endif
+
+// OGLPLUS_MATH_SSE is nonzero if the SSE2 instructions can be used
+#if	!OGLPLUS_NO_SIMD && (\
+	defined(__SSE2__) ||\
+	defined(_M_X64) ||\
+	(defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define OGLPLUS_MATH_SSE 1
+#else
+#define OGLPLUS_MATH_SSE 0
+#endif
+
+// OGLPLUS_MATH_NEON is nonzero if the AArch64 NEON instructions can be used
+#if	!OGLPLUS_NO_SIMD && !OGLPLUS_MATH_SSE &&\
+	defined(__ARM_NEON) && defined(__aarch64__)
+#define OGLPLUS_MATH_NEON 1
+#else
+#define OGLPLUS_MATH_NEON 0
+#endif
+
+#endif // include guard
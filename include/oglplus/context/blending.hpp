@@ -17,6 +17,7 @@
 #include <oglplus/blend_function.hpp>
 #include <oglplus/draw_buffer_index.hpp>
 #include <oglplus/context/color.hpp>
+#include <oglplus/state_cache.hpp>
 
 #ifdef RGB
 #undef RGB
@@ -199,8 +200,17 @@ public:
 		> eq
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_EQUATION_RGB, 0,
+			GLenum(eq),
+			GLenum(eq)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendEquation)(GLenum(eq));
 		OGLPLUS_VERIFY_SIMPLE(BlendEquation);
+		cached.Update();
 	}
 
 	/// Sets the blend equation separate for RGB and alpha
@@ -213,22 +223,40 @@ public:
 		oglplus::BlendEquation eq_alpha
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_EQUATION_RGB, 0,
+			GLenum(eq_rgb),
+			GLenum(eq_alpha)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendEquationSeparate)(
 			GLenum(eq_rgb),
 			GLenum(eq_alpha)
 		);
 		OGLPLUS_VERIFY_SIMPLE(BlendEquationSeparate);
+		cached.Update();
 	}
 
 	static void BlendEquationSeparate(
 		const oglplus::context::BlendEquationSeparate& eq
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_EQUATION_RGB, 0,
+			GLenum(eq._v[0]),
+			GLenum(eq._v[1])
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendEquationSeparate)(
 			GLenum(eq._v[0]),
 			GLenum(eq._v[1])
 		);
 		OGLPLUS_VERIFY_SIMPLE(BlendEquationSeparate);
+		cached.Update();
 	}
 
 	static oglplus::context::BlendEquationSeparate BlendEquationSeparate(void)
@@ -287,6 +315,10 @@ public:
 			Error,
 			Index(GLuint(buffer))
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_EQUATION_RGB
+		);
 	}
 
 	/// Sets the blend equation separate for RGB and alpha for a @p buffer
@@ -311,6 +343,10 @@ public:
 			Error,
 			Index(GLuint(buffer))
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_EQUATION_RGB
+		);
 	}
 
 	static void BlendEquationSeparate(
@@ -328,6 +364,10 @@ public:
 			Error,
 			Index(GLuint(buffer))
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_EQUATION_RGB
+		);
 	}
 
 	static oglplus::context::BlendEquationSeparate
@@ -397,8 +437,19 @@ public:
 	 */
 	static void BlendFunc(BlendFunction src, BlendFunction dst)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_SRC_RGB, 0,
+			GLenum(src),
+			GLenum(dst),
+			GLenum(src),
+			GLenum(dst)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendFunc)(GLenum(src), GLenum(dst));
 		OGLPLUS_VERIFY_SIMPLE(BlendFunc);
+		cached.Update();
 	}
 
 	/// Sets the blend function separate for RGB and alpha
@@ -413,6 +464,16 @@ public:
 		BlendFunction dst_alpha
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_SRC_RGB, 0,
+			GLenum(src_rgb),
+			GLenum(dst_rgb),
+			GLenum(src_alpha),
+			GLenum(dst_alpha)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendFuncSeparate)(
 			GLenum(src_rgb),
 			GLenum(dst_rgb),
@@ -420,12 +481,23 @@ public:
 			GLenum(dst_alpha)
 		);
 		OGLPLUS_VERIFY_SIMPLE(BlendFuncSeparate);
+		cached.Update();
 	}
 
 	static void BlendFuncSeparate(
 		const oglplus::context::BlendFunctionSeparate& fn
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_SRC_RGB, 0,
+			GLenum(fn._v[0]),
+			GLenum(fn._v[1]),
+			GLenum(fn._v[2]),
+			GLenum(fn._v[3])
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendFuncSeparate)(
 			GLenum(fn._v[0]),
 			GLenum(fn._v[1]),
@@ -433,6 +505,7 @@ public:
 			GLenum(fn._v[3])
 		);
 		OGLPLUS_VERIFY_SIMPLE(BlendFuncSeparate);
+		cached.Update();
 	}
 
 	static oglplus::context::BlendFunctionSeparate BlendFuncSeparate(void)
@@ -516,6 +589,10 @@ public:
 			Error,
 			Index(GLuint(buffer))
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_SRC_RGB
+		);
 	}
 
 	/// Sets the blend function separate for RGB and alpha for a @p buffer
@@ -544,6 +621,10 @@ public:
 			Error,
 			Index(GLuint(buffer))
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_SRC_RGB
+		);
 	}
 
 	static void BlendFuncSeparate(
@@ -563,6 +644,10 @@ public:
 			Error,
 			Index(GLuint(buffer))
 		);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_SRC_RGB
+		);
 	}
 
 	static oglplus::context::BlendFunctionSeparate
@@ -684,12 +769,33 @@ public:
 	 */
 	static void BlendColor(GLclampf r, GLclampf g, GLclampf b, GLclampf a)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_COLOR, 0,
+			aux::StateCacheBits(r),
+			aux::StateCacheBits(g),
+			aux::StateCacheBits(b),
+			aux::StateCacheBits(a)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendColor)(r, g, b, a);
 		OGLPLUS_VERIFY_SIMPLE(BlendColor);
+		cached.Update();
 	}
 
 	static void BlendColor(const oglplus::context::RGBAValue& rgba)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Blending,
+			GL_BLEND_COLOR, 0,
+			aux::StateCacheBits(rgba._v[0]),
+			aux::StateCacheBits(rgba._v[1]),
+			aux::StateCacheBits(rgba._v[2]),
+			aux::StateCacheBits(rgba._v[3])
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BlendColor)(
 			rgba._v[0],
 			rgba._v[1],
@@ -697,6 +803,7 @@ public:
 			rgba._v[3]
 		);
 		OGLPLUS_VERIFY_SIMPLE(BlendColor);
+		cached.Update();
 	}
 
 	static oglplus::context::RGBAValue BlendColor(void)
@@ -18,6 +18,7 @@
 #include <oglplus/face_mode.hpp>
 #include <oglplus/context/color.hpp>
 #include <oglplus/draw_buffer_index.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 namespace context {
@@ -108,8 +109,16 @@ public:
 	 */
 	static void DepthMask(Boolean mask)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Depth,
+			GL_DEPTH_WRITEMASK, 0,
+			mask._get()
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(DepthMask)(mask._get());
 		OGLPLUS_VERIFY_SIMPLE(DepthMask);
+		cached.Update();
 	}
 
 	/// Sets the stencil @p mask
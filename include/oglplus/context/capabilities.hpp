@@ -16,6 +16,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/boolean.hpp>
 #include <oglplus/capability.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 namespace context {
@@ -34,12 +35,20 @@ public:
 	 */
 	static void Enable(Capability capability)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Capability,
+			GLenum(capability), 0,
+			GL_TRUE
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Enable)(GLenum(capability));
 		OGLPLUS_VERIFY(
 			Enable,
 			Error,
 			EnumParam(capability)
 		);
+		cached.Update();
 	}
 
 	/// Enable a @p functionality
@@ -49,6 +58,13 @@ public:
 	 */
 	static void Enable(Functionality functionality, GLuint number)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Capability,
+			GLenum(functionality)+number, 0,
+			GL_TRUE
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Enable)(GLenum(functionality)+number);
 		OGLPLUS_VERIFY(
 			Enable,
@@ -56,6 +72,7 @@ public:
 			EnumParam(functionality).
 			Index(number)
 		);
+		cached.Update();
 	}
 
 	/// Disable a @p capability
@@ -65,12 +82,20 @@ public:
 	 */
 	static void Disable(Capability capability)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Capability,
+			GLenum(capability), 0,
+			GL_FALSE
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Disable)(GLenum(capability));
 		OGLPLUS_VERIFY(
 			Disable,
 			Error,
 			EnumParam(capability)
 		);
+		cached.Update();
 	}
 
 	/// Disable a @p functionality
@@ -80,6 +105,13 @@ public:
 	 */
 	static void Disable(Functionality functionality, GLuint number)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Capability,
+			GLenum(functionality)+number, 0,
+			GL_FALSE
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Disable)(GLenum(functionality)+number);
 		OGLPLUS_VERIFY(
 			Disable,
@@ -87,6 +119,7 @@ public:
 			EnumParam(functionality).
 			Index(number)
 		);
+		cached.Update();
 	}
 
 	/// Checks if a @p capability is enabled
@@ -145,6 +178,11 @@ public:
 			EnumParam(capability).
 			Index(index)
 		);
+		// the cached value is not valid for all indices anymore
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Capability,
+			GLenum(capability)
+		);
 	}
 
 	/// Disable a @p capability for an indexed target
@@ -161,6 +199,11 @@ public:
 			EnumParam(capability).
 			Index(index)
 		);
+		// the cached value is not valid for all indices anymore
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Capability,
+			GLenum(capability)
+		);
 	}
 
 	/// Check if a @p capability is enabled for indexed target
@@ -15,6 +15,7 @@
 
 #include <oglplus/glfunc.hpp>
 #include <oglplus/compare_function.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 namespace context {
@@ -33,8 +34,16 @@ public:
 	 */
 	static void DepthFunc(CompareFunction function)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Depth,
+			GL_DEPTH_FUNC, 0,
+			GLenum(function)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(DepthFunc)(GLenum(function));
 		OGLPLUS_VERIFY_SIMPLE(DepthFunc);
+		cached.Update();
 	}
 
 	/// Returns the depth comparison function
@@ -16,6 +16,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/size_type.hpp>
 #include <oglplus/viewport_index.hpp>
+#include <oglplus/state_cache.hpp>
 
 namespace oglplus {
 namespace context {
@@ -210,8 +211,19 @@ public:
 	 */
 	static void Viewport(GLint x, GLint y, SizeType w, SizeType h)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT, 0,
+			GLuint64(GLint64(x)),
+			GLuint64(GLint64(y)),
+			GLuint64(GLsizei(w)),
+			GLuint64(GLsizei(h))
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Viewport)(x, y, w, h);
 		OGLPLUS_CHECK_SIMPLE(Viewport);
+		cached.Update();
 	}
 
 	/// Sets the size of the current viewport starting at (0,0)
@@ -223,8 +235,19 @@ public:
 	 */
 	static void Viewport(SizeType w, SizeType h)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT, 0,
+			0,
+			0,
+			GLuint64(GLsizei(w)),
+			GLuint64(GLsizei(h))
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Viewport)(0, 0, w, h);
 		OGLPLUS_CHECK_SIMPLE(Viewport);
+		cached.Update();
 	}
 
 	/// Sets the extents of the current viewport
@@ -236,6 +259,16 @@ public:
 	 */
 	static void Viewport(const ViewportExtents& vp)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT, 0,
+			GLuint64(GLint64(vp.X())),
+			GLuint64(GLint64(vp.Y())),
+			GLuint64(vp.Width()),
+			GLuint64(vp.Height())
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(Viewport)(
 			vp.X(),
 			vp.Y(),
@@ -243,6 +276,7 @@ public:
 			vp.Height()
 		);
 		OGLPLUS_CHECK_SIMPLE(Viewport);
+		cached.Update();
 	}
 
 	/// Returns the extents of the current viewport
@@ -330,6 +364,10 @@ public:
 		GLfloat height
 	)
 	{
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT
+		);
 		OGLPLUS_GLFUNC(ViewportIndexedf)(
 			GLuint(viewport),
 			x, y,
@@ -352,6 +390,10 @@ public:
 	 */
 	static void Viewport(ViewportIndex viewport, const GLfloat* extents)
 	{
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT
+		);
 		OGLPLUS_GLFUNC(ViewportIndexedfv)(GLuint(viewport), extents);
 		OGLPLUS_CHECK(
 			ViewportIndexedfv,
@@ -373,6 +415,10 @@ public:
 		const GLfloat* extents
 	)
 	{
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT
+		);
 		OGLPLUS_GLFUNC(ViewportArrayv)(first, count, extents);
 		OGLPLUS_CHECK_SIMPLE(ViewportArrayv);
 	}
@@ -389,6 +435,10 @@ public:
 		const ViewportExtents& vp
 	)
 	{
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Viewport,
+			GL_VIEWPORT
+		);
 		OGLPLUS_GLFUNC(ViewportIndexedf)(
 			GLuint(viewport),
 			GLfloat(vp.X()),
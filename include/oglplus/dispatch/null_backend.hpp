@@ -0,0 +1,132 @@
+/**
+ *  @file oglplus/dispatch/null_backend.hpp
+ *  @brief GL backend for the dispatch table working without a GL context
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_DISPATCH_NULL_BACKEND_1509141311_HPP
+#define OGLPLUS_DISPATCH_NULL_BACKEND_1509141311_HPP
+
+#include <oglplus/dispatch/table.hpp>
+
+#include <map>
+#include <vector>
+
+namespace oglplus {
+
+/// Null GL backend with fake object names and a minimal state
+/** While an instance of this class is alive, the GL dispatch table
+ *  uses the @c Null backend, so no functions from the GL library
+ *  are called and no GL context is required. The functions that
+ *  do not have an override do nothing and return zero values.
+ *  The null backend overrides the functions which must return valid
+ *  values for the OGLplus wrappers to work:
+ *
+ *  - the @c Gen* and @c Create* functions return unique non-zero names,
+ *  - the @c Bind* functions and @c UseProgram update the values returned
+ *    by @c GetIntegerv for the corresponding binding queries,
+ *  - @c Enable, @c Disable and @c IsEnabled track the capabilities,
+ *  - @c GetIntegerv returns the tracked state, plausible implementation
+ *    limits or values set by SetInteger,
+ *  - the compile, link and validate status queries report success,
+ *  - the uniform and attribute location queries return unique locations,
+ *  - @c MapBuffer and @c MapBufferRange return a pointer to scratch memory,
+ *  - framebuffer status is complete and fences are always signaled.
+ *
+ *  This allows to run rendering code headless on machines without a GPU,
+ *  for example to benchmark the CPU-side overhead of the wrappers
+ *  together with the GLCallRecorder.
+ *
+ *  @note Only one instance can be alive at a time.
+ *
+ *  @see OGLPLUS_GL_DISPATCH
+ *
+ *  @ingroup gl_dispatch
+ */
+class GLNullBackend
+{
+private:
+	GLDispatchBackend _prev_backend;
+	GLuint _next_name;
+	GLint _next_location;
+	std::map<GLenum, GLint> _integers;
+	std::map<GLenum, bool> _capabilities;
+	std::vector<GLubyte> _scratch;
+
+	static GLNullBackend*& _current(void);
+	static GLNullBackend& _self(void);
+
+	static GLenum _binding_query(GLenum target);
+	void _set_binding(GLenum target, GLuint name);
+	void* _scratch_memory(GLsizeiptr size);
+
+	static void GLAPIENTRY _gen_names(GLsizei n, GLuint* names);
+	static GLuint GLAPIENTRY _create_shader(GLenum type);
+	static GLuint GLAPIENTRY _create_program(void);
+	static void GLAPIENTRY _bind(GLenum target, GLuint name);
+	static void GLAPIENTRY _bind_vertex_array(GLuint name);
+	static void GLAPIENTRY _use_program(GLuint name);
+	static void GLAPIENTRY _enable(GLenum cap);
+	static void GLAPIENTRY _disable(GLenum cap);
+	static GLboolean GLAPIENTRY _is_enabled(GLenum cap);
+	static void GLAPIENTRY _get_integer(GLenum pname, GLint* data);
+	static const GLubyte* GLAPIENTRY _get_string(GLenum name);
+	static void GLAPIENTRY _get_object_iv(GLuint, GLenum, GLint*);
+	static GLint GLAPIENTRY _get_location(GLuint, const GLchar*);
+	static void GLAPIENTRY _buffer_data(GLenum, GLsizeiptr, const void*, GLenum);
+	static void* GLAPIENTRY _map_buffer(GLenum target, GLenum access);
+	static void* GLAPIENTRY _map_buffer_range(
+		GLenum target,
+		GLintptr offset,
+		GLsizeiptr length,
+		GLbitfield access
+	);
+	static GLboolean GLAPIENTRY _unmap_buffer(GLenum target);
+	static GLenum GLAPIENTRY _check_framebuffer_status(GLenum target);
+#if GL_VERSION_3_2 || GL_ARB_sync
+	static GLsync GLAPIENTRY _fence_sync(GLenum condition, GLbitfield flags);
+	static GLenum GLAPIENTRY _client_wait_sync(GLsync, GLbitfield, GLuint64);
+#endif
+
+	void _install(bool install);
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	GLNullBackend(const GLNullBackend&) = delete;
+	GLNullBackend& operator = (const GLNullBackend&) = delete;
+#else
+	GLNullBackend(const GLNullBackend&);
+	GLNullBackend& operator = (const GLNullBackend&);
+#endif
+public:
+	/// Installs the overrides and switches the dispatch table to Null
+	GLNullBackend(void);
+
+	/// Removes the overrides and restores the previous backend
+	~GLNullBackend(void);
+
+	/// Sets the value returned by GetIntegerv for the specified query
+	void SetInteger(GLenum pname, GLint value)
+	{
+		_integers[pname] = value;
+	}
+
+	/// Returns the number of object names generated so far
+	GLuint NameCount(void) const
+	{
+		return _next_name-1;
+	}
+};
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/dispatch/null_backend.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
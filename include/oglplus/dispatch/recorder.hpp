@@ -0,0 +1,115 @@
+/**
+ *  @file oglplus/dispatch/recorder.hpp
+ *  @brief Recording of the calls made through the GL dispatch table
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_DISPATCH_RECORDER_1509141155_HPP
+#define OGLPLUS_DISPATCH_RECORDER_1509141155_HPP
+
+#include <oglplus/dispatch/table.hpp>
+
+#include <iosfwd>
+#include <vector>
+
+namespace oglplus {
+
+/// The number and the total duration of the calls to a single GL function
+/**
+ *  @ingroup gl_dispatch
+ */
+struct GLCallStats
+{
+	/// The name of the GL function without the gl prefix
+	const char* Name;
+	/// The number of calls
+	unsigned long Count;
+	/// The total time spent in the calls (in seconds)
+	double Time;
+};
+
+/// A single recorded call in the GL call stream
+/**
+ *  @ingroup gl_dispatch
+ */
+struct GLRecordedCall
+{
+	/// The name of the GL function without the gl prefix
+	const char* Name;
+	/// The duration of the call (in seconds)
+	double Time;
+};
+
+/// Records the calls made through the GL dispatch table
+/** While an instance of this class is alive, all wrapped GL functions are
+ *  called through the dispatch table, which counts the calls and measures
+ *  their duration (including the time spent in the backend). Optionally
+ *  the first @c log_limit calls are also logged in the order in which
+ *  they were made.
+ *
+ *  The recording works with both the native and the null backend,
+ *  with the null backend it measures only the CPU-side overhead of
+ *  the wrappers.
+ *
+ *  @note Only one recorder can be active at a time and the GL functions
+ *  should be called from a single thread while recording.
+ *
+ *  @see OGLPLUS_GL_DISPATCH
+ *
+ *  @ingroup gl_dispatch
+ */
+class GLCallRecorder
+{
+private:
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	GLCallRecorder(const GLCallRecorder&) = delete;
+	GLCallRecorder& operator = (const GLCallRecorder&) = delete;
+#else
+	GLCallRecorder(const GLCallRecorder&);
+	GLCallRecorder& operator = (const GLCallRecorder&);
+#endif
+public:
+	/// Resets the statistics and starts recording
+	/**
+	 *  @param log_limit the maximum number of calls to be logged
+	 */
+	GLCallRecorder(std::size_t log_limit = 0);
+
+	/// Stops recording
+	~GLCallRecorder(void);
+
+	/// Clears the statistics and the log of the calls
+	void Reset(void);
+
+	/// Returns the total number of the recorded calls
+	unsigned long TotalCount(void) const;
+
+	/// Returns the total time spent in the recorded calls
+	double TotalTime(void) const;
+
+	/// Returns the statistics of the called functions
+	/** The functions are sorted by the time spent in them,
+	 *  in descending order.
+	 */
+	std::vector<GLCallStats> Statistics(void) const;
+
+	/// Returns the logged calls in the order in which they were made
+	std::vector<GLRecordedCall> Log(void) const;
+
+	/// Writes a table with the statistics to the specified stream
+	void Report(std::ostream& output) const;
+};
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/dispatch/recorder.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
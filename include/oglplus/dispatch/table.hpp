@@ -0,0 +1,366 @@
+/**
+ *  @file oglplus/dispatch/table.hpp
+ *  @brief Swappable dispatch table for the wrapped GL functions
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_DISPATCH_TABLE_1509141012_HPP
+#define OGLPLUS_DISPATCH_TABLE_1509141012_HPP
+
+#include <oglplus/config/basic.hpp>
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/config/gl.hpp>
+
+#include <vector>
+#include <cstddef>
+
+#if !OGLPLUS_NO_CHRONO
+#include <chrono>
+#endif
+
+namespace oglplus {
+
+/// The implementation of the wrapped GL functions used by the dispatch table
+/**
+ *  @see OGLPLUS_GL_DISPATCH
+ *
+ *  @ingroup gl_dispatch
+ */
+enum class GLDispatchBackend
+{
+	/// The functions from the GL library or the GL loader
+	Native,
+	/// Functions that do nothing and return zero values
+	/** The functions overriden for example by the GLNullBackend
+	 *  are called instead, if they are overriden.
+	 */
+	Null
+};
+
+namespace aux {
+
+// The override and statistics of a single wrapped GL function
+struct GLDispatchSlot
+{
+	typedef void (GLAPIENTRY *AnyFunc)(void);
+
+	const char* name;
+	AnyFunc override_func;
+	unsigned long call_count;
+	double call_time;
+	GLDispatchSlot* next;
+
+	// registers the slot in the current table
+	GLDispatchSlot(const char* func_name);
+};
+
+// The entry in the log of the recorded GL calls
+struct GLDispatchCall
+{
+	const GLDispatchSlot* slot;
+	double time;
+};
+
+// The process-wide table of the wrapped GL functions
+// that were called or overriden
+class GLDispatchTable
+{
+private:
+	GLDispatchSlot* _slots;
+	GLDispatchBackend _backend;
+	std::size_t _override_count;
+	std::size_t _log_limit;
+	std::vector<GLDispatchCall> _log;
+	bool _recording;
+	bool _direct;
+
+	void _update(void)
+	{
+		_direct = (_backend == GLDispatchBackend::Native)
+			&& (_override_count == 0)
+			&& (!_recording);
+	}
+
+	GLDispatchTable(void)
+	 : _slots(nullptr)
+	 , _backend(GLDispatchBackend::Native)
+	 , _override_count(0)
+	 , _log_limit(0)
+	 , _recording(false)
+	 , _direct(true)
+	{ }
+public:
+	static GLDispatchTable& Current(void);
+
+	// Returns true if the native functions can be called directly
+	bool Direct(void) const
+	{
+		return _direct;
+	}
+
+	GLDispatchBackend Backend(void) const
+	{
+		return _backend;
+	}
+
+	GLDispatchBackend SetBackend(GLDispatchBackend backend)
+	{
+		GLDispatchBackend result = _backend;
+		_backend = backend;
+		_update();
+		return result;
+	}
+
+	bool Recording(void) const
+	{
+		return _recording;
+	}
+
+	void StartRecording(std::size_t log_limit);
+
+	void StopRecording(void)
+	{
+		_recording = false;
+		_update();
+	}
+
+	void ResetStatistics(void);
+
+	void Register(GLDispatchSlot& slot)
+	{
+		slot.next = _slots;
+		_slots = &slot;
+	}
+
+	const GLDispatchSlot* Slots(void) const
+	{
+		return _slots;
+	}
+
+	const std::vector<GLDispatchCall>& Log(void) const
+	{
+		return _log;
+	}
+
+	GLDispatchSlot::AnyFunc Override(
+		GLDispatchSlot& slot,
+		GLDispatchSlot::AnyFunc func
+	);
+
+	void RecordCall(GLDispatchSlot& slot, double time)
+	{
+		++slot.call_count;
+		slot.call_time += time;
+		if(_log.size() < _log_limit)
+		{
+			GLDispatchCall call = { &slot, time };
+			_log.push_back(call);
+		}
+	}
+};
+
+inline GLDispatchSlot::GLDispatchSlot(const char* func_name)
+ : name(func_name)
+ , override_func(nullptr)
+ , call_count(0)
+ , call_time(0.0)
+ , next(nullptr)
+{
+	GLDispatchTable::Current().Register(*this);
+}
+
+// Records the count and duration of a call through the trampoline
+class GLDispatchCallRecord
+{
+private:
+	GLDispatchTable& _table;
+	GLDispatchSlot& _slot;
+	bool _recording;
+#if !OGLPLUS_NO_CHRONO
+	typedef std::chrono::steady_clock _clock;
+	_clock::time_point _start;
+#endif
+public:
+	GLDispatchCallRecord(GLDispatchTable& table, GLDispatchSlot& slot)
+	 : _table(table)
+	 , _slot(slot)
+	 , _recording(table.Recording())
+	{
+#if !OGLPLUS_NO_CHRONO
+		if(_recording) _start = _clock::now();
+#endif
+	}
+
+	~GLDispatchCallRecord(void)
+	{
+		if(_recording)
+		{
+#if !OGLPLUS_NO_CHRONO
+			std::chrono::duration<double> t = _clock::now() - _start;
+			_table.RecordCall(_slot, t.count());
+#else
+			_table.RecordCall(_slot, 0.0);
+#endif
+		}
+	}
+};
+
+// The dispatch of a single wrapped GL function,
+// the Native parameter provides the address of the native pointer
+template <typename Native, typename RV, typename ... P>
+class GLDispatchEntryImpl
+{
+public:
+	typedef RV (GLAPIENTRY *Func)(P...);
+private:
+	static GLDispatchSlot& _slot(const char* name)
+	{
+		// the name is used only on the first call
+		static GLDispatchSlot slot(name);
+		return slot;
+	}
+
+	static RV GLAPIENTRY _trampoline(P ... p)
+	{
+		GLDispatchTable& table = GLDispatchTable::Current();
+		GLDispatchSlot& slot = _slot(nullptr);
+		GLDispatchCallRecord record(table, slot);
+
+		if(slot.override_func)
+		{
+			return reinterpret_cast<Func>(slot.override_func)(p...);
+		}
+		if(table.Backend() == GLDispatchBackend::Null)
+		{
+			return RV();
+		}
+		return (*Native::Address())(p...);
+	}
+public:
+	// Returns the address of the pointer to the function to be called
+	static Func* Resolve(const char* name)
+	{
+		GLDispatchTable& table = GLDispatchTable::Current();
+		if(table.Direct())
+		{
+			return Native::Address();
+		}
+		GLDispatchSlot& slot = _slot(name);
+		if(	(!slot.override_func) &&
+			(table.Backend() == GLDispatchBackend::Native) &&
+			(!*Native::Address())
+		)
+		{
+			// let the caller report the missing function
+			return Native::Address();
+		}
+		static Func trampoline = &_trampoline;
+		return &trampoline;
+	}
+
+	// Installs (or with nullptr removes) the override of the function
+	static Func Override(const char* name, Func func)
+	{
+		return reinterpret_cast<Func>(
+			GLDispatchTable::Current().Override(
+				_slot(name),
+				reinterpret_cast<GLDispatchSlot::AnyFunc>(func)
+			)
+		);
+	}
+};
+
+template <typename T, T Ptr>
+struct GLDispatchNativeFunc
+{
+	static T* Address(void)
+	{
+		static T func = Ptr;
+		return &func;
+	}
+};
+
+template <typename T, T* PPtr>
+struct GLDispatchNativePtr
+{
+	static T* Address(void)
+	{
+		return PPtr;
+	}
+};
+
+template <typename T, T Ptr>
+class GLDispatchEntry;
+
+// functions declared by the GL headers
+template <typename RV, typename ... P, RV (GLAPIENTRY *Ptr)(P...)>
+class GLDispatchEntry<RV (GLAPIENTRY *)(P...), Ptr>
+ : public GLDispatchEntryImpl<
+	GLDispatchNativeFunc<RV (GLAPIENTRY *)(P...), Ptr>,
+	RV, P...
+>
+{ };
+
+// pointers to functions set by a GL loader (for example GLEW)
+template <typename RV, typename ... P, RV (GLAPIENTRY **PPtr)(P...)>
+class GLDispatchEntry<RV (GLAPIENTRY **)(P...), PPtr>
+ : public GLDispatchEntryImpl<
+	GLDispatchNativePtr<RV (GLAPIENTRY *)(P...), PPtr>,
+	RV, P...
+>
+{ };
+
+} // namespace aux
+
+#define OGLPLUS_GLFUNC_DISPATCH_ENTRY(FUNCNAME) \
+	::oglplus::aux::GLDispatchEntry< \
+		decltype(&::gl##FUNCNAME), \
+		&::gl##FUNCNAME \
+	>
+
+/// Overrides the implementation of a wrapped GL function
+/** Installs the function @p FUNC to be called instead of
+ *  gl@p FUNCNAME by the dispatch table and returns the previous
+ *  override or nullptr. Passing nullptr removes the override.
+ *
+ *  @see OGLPLUS_GL_DISPATCH
+ *
+ *  @ingroup gl_dispatch
+ */
+#define OGLPLUS_GLFUNC_OVERRIDE(FUNCNAME, FUNC) \
+	OGLPLUS_GLFUNC_DISPATCH_ENTRY(FUNCNAME)::Override(#FUNCNAME, FUNC)
+
+#define OGLPLUS_GLFUNC_DISPATCHED(FUNCNAME) \
+	(*OGLPLUS_GLFUNC_DISPATCH_ENTRY(FUNCNAME)::Resolve(#FUNCNAME))
+
+/// Returns the backend currently used by the GL dispatch table
+/**
+ *  @ingroup gl_dispatch
+ */
+inline GLDispatchBackend CurrentGLDispatchBackend(void)
+{
+	return aux::GLDispatchTable::Current().Backend();
+}
+
+/// Sets the backend used by the GL dispatch table, returns the previous one
+/**
+ *  @ingroup gl_dispatch
+ */
+inline GLDispatchBackend SetGLDispatchBackend(GLDispatchBackend backend)
+{
+	return aux::GLDispatchTable::Current().SetBackend(backend);
+}
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/dispatch/table.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
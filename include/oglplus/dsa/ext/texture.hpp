@@ -83,6 +83,13 @@ public:
 	/// Bind this texture to target on the specified texture unit
 	void BindMulti(TextureUnitSelector index, Target tex_target)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GLenum(tex_target), GLuint(index),
+			_obj_name()
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindMultiTextureEXT)(
 			GLenum(GL_TEXTURE0 + GLuint(index)),
 			GLenum(tex_target),
@@ -95,6 +102,7 @@ public:
 			BindTarget(tex_target).
 			Index(GLuint(index))
 		);
+		cached.Update();
 	}
 
 	void BindMulti(TextureUnitSelector index)
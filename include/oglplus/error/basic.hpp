@@ -15,14 +15,23 @@
 
 #include <oglplus/config/error.hpp>
 #include <oglplus/config/compiler.hpp>
+#include <oglplus/config/gl.hpp>
 #include <oglplus/error/code.hpp>
 #include <oglplus/string/def.hpp>
 #include <oglplus/string/ref.hpp>
 #include <oglplus/string/empty.hpp>
 #include <oglplus/size_type.hpp>
 #include <stdexcept>
+#include <cstddef>
 #include <cassert>
 
+#if OGLPLUS_GL_DISPATCH
+#include <oglplus/dispatch/table.hpp>
+#define OGLPLUS_GL_GET_ERROR() OGLPLUS_GLFUNC_DISPATCHED(GetError)()
+#else
+#define OGLPLUS_GL_GET_ERROR() ::glGetError()
+#endif
+
 namespace oglplus {
 
 /** @defgroup error_handling Error handling
@@ -374,6 +383,172 @@ inline void HandleError(ErrorType& error)
 	throw error;
 }
 
+/// The policies for checking of the GL errors after the wrapped GL calls
+/**
+ *  @see SetErrorCheckPolicy
+ *  @see DeferredErrorCheck
+ *  @see DebugOutputErrorCheck
+ *  @see #OGLPLUS_ERROR_NO_CHECK_POLICY
+ *
+ *  @ingroup error_handling
+ */
+enum class ErrorCheckPolicy
+{
+	/// The GL error is queried right after every wrapped GL call
+	Immediate,
+	/// The GL error is queried at the end of a checked scope (or when
+	/// the list of recorded calls gets full)
+	Deferred,
+	/// The GL error is queried only if the debug output reported an error
+	DebugOutput
+};
+
+namespace aux {
+
+// Information about a wrapped GL call remembered by the deferred check
+struct GLCallInfo
+{
+	const char* gl_func;
+	const char* source_file;
+	unsigned source_line;
+};
+
+// The per-thread state of the GL error checking
+class ErrorCheckState
+{
+public:
+	static const std::size_t MaxCalls = 16;
+private:
+	ErrorCheckPolicy _policy;
+	std::size_t _call_count;
+	GLCallInfo _calls[MaxCalls];
+	bool _debug_error;
+public:
+	ErrorCheckState(void)
+	 : _policy(ErrorCheckPolicy::Immediate)
+	 , _call_count(0)
+	 , _debug_error(false)
+	{ }
+
+	ErrorCheckPolicy Policy(void) const
+	{
+		return _policy;
+	}
+
+	void SetPolicy(ErrorCheckPolicy policy)
+	{
+		_policy = policy;
+		_call_count = 0;
+		_debug_error = false;
+	}
+
+	// the calls made since the last check
+	std::size_t CallCount(void) const
+	{
+		return _call_count;
+	}
+
+	const GLCallInfo& Call(std::size_t index) const
+	{
+		assert(index < _call_count);
+		return _calls[index];
+	}
+
+	void Record(const char* gl_func, const char* file, unsigned line)
+	{
+		if(_call_count == MaxCalls)
+		{
+			// check the full window so that the failed call
+			// is not lost from the recent calls
+			CheckRecent();
+		}
+		GLCallInfo& call = _calls[_call_count++];
+		call.gl_func = gl_func;
+		call.source_file = file;
+		call.source_line = line;
+	}
+
+	// checks the GL error and reports the recent calls if it failed
+	void CheckRecent(void);
+
+	void NoteDebugError(void)
+	{
+		_debug_error = true;
+	}
+
+	bool TakeDebugError(void)
+	{
+		bool result = _debug_error;
+		_debug_error = false;
+		return result;
+	}
+};
+
+// Returns the GL error checking state of the current thread
+ErrorCheckState& CurrentErrorCheckState(void);
+
+// Returns the GL error code after a wrapped GL call
+// as required by the current error check policy
+inline GLenum GLErrorCheck(
+	const char* gl_func,
+	const char* file,
+	unsigned line
+)
+{
+	ErrorCheckState& state = CurrentErrorCheckState();
+	switch(state.Policy())
+	{
+		case ErrorCheckPolicy::Immediate:
+			break;
+		case ErrorCheckPolicy::Deferred:
+			state.Record(gl_func, file, line);
+			return GL_NO_ERROR;
+		case ErrorCheckPolicy::DebugOutput:
+			if(!state.TakeDebugError())
+			{
+				return GL_NO_ERROR;
+			}
+			break;
+	}
+	return OGLPLUS_GL_GET_ERROR();
+}
+
+// Discards the GL error of a wrapped GL call whose errors are ignored
+// without clearing the errors of the preceding calls which were not
+// checked yet by the current error check policy
+inline void GLErrorIgnore(
+	const char* gl_func,
+	const char* file,
+	unsigned line
+)
+{
+	ErrorCheckState& state = CurrentErrorCheckState();
+	switch(state.Policy())
+	{
+		case ErrorCheckPolicy::Immediate:
+			break;
+		case ErrorCheckPolicy::Deferred:
+			// the error flags cannot be attributed to a single
+			// call, so if there are unchecked calls, the error
+			// is left for the deferred check
+			if(state.CallCount() != 0)
+			{
+				state.Record(gl_func, file, line);
+				return;
+			}
+			break;
+		case ErrorCheckPolicy::DebugOutput:
+			if(!state.TakeDebugError())
+			{
+				return;
+			}
+			break;
+	}
+	OGLPLUS_GL_GET_ERROR();
+}
+
+} // namespace aux
+
 #define OGLPLUS_ERROR_CONTEXT(GLFUNC, CLASS) \
 	static const char* _errinf_glfn(void) \
 	{ \
@@ -475,6 +650,13 @@ inline void HandleError(ErrorType& error)
 	OGLPLUS_RETURN_HANDLER\
 )
 
+#if !OGLPLUS_ERROR_NO_CHECK_POLICY
+#define OGLPLUS_GLFUNC_ERROR_CODE(FUNC_NAME) \
+	::oglplus::aux::GLErrorCheck(FUNC_NAME, __FILE__, __LINE__)
+#else
+#define OGLPLUS_GLFUNC_ERROR_CODE(FUNC_NAME) OGLPLUS_GL_GET_ERROR()
+#endif
+
 #define OGLPLUS_GLFUNC_CHECK_WITH_HANDLER(\
 	FUNC_NAME,\
 	ERROR,\
@@ -482,7 +664,7 @@ inline void HandleError(ErrorType& error)
 	HANDLER_MACRO\
 ) OGLPLUS_HANDLE_ERROR_WITH_HANDLER_IF(\
 		error_code != GL_NO_ERROR,\
-		glGetError(),\
+		OGLPLUS_GLFUNC_ERROR_CODE(FUNC_NAME),\
 		ERROR::Message(error_code),\
 		ERROR,\
 		ERROR_INFO.GLFunc(FUNC_NAME),\
@@ -524,7 +706,12 @@ inline void HandleError(ErrorType& error)
 #define OGLPLUS_VERIFY_SIMPLE(GLFUNC) \
 	OGLPLUS_CHECK(GLFUNC, Error, NoInfo())
 
-#define OGLPLUS_IGNORE(PARAM) ::glGetError();
+#if !OGLPLUS_ERROR_NO_CHECK_POLICY
+#define OGLPLUS_IGNORE(GLFUNC) \
+	::oglplus::aux::GLErrorIgnore(#GLFUNC, __FILE__, __LINE__);
+#else
+#define OGLPLUS_IGNORE(GLFUNC) OGLPLUS_GL_GET_ERROR();
+#endif
 
 #define OGLPLUS_DEFERRED_CHECK(GLFUNC, ERROR, ERROR_INFO) \
 	OGLPLUS_GLFUNC_CHECK(#GLFUNC, ERROR, ERROR_INFO)
@@ -0,0 +1,172 @@
+/**
+ *  @file oglplus/error/check_policy.hpp
+ *  @brief Run-time selection of the GL error checking policy
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_ERROR_CHECK_POLICY_1509101043_HPP
+#define OGLPLUS_ERROR_CHECK_POLICY_1509101043_HPP
+
+#include <oglplus/error/basic.hpp>
+#include <oglplus/glfunc.hpp>
+
+#include <exception>
+
+namespace oglplus {
+namespace aux {
+
+// Returns the number of exceptions currently being thrown or re-thrown
+// (only 0 or 1 where std::uncaught_exceptions is not available)
+inline int UncaughtExceptions(void)
+{
+#if	defined(__cpp_lib_uncaught_exceptions) ||\
+	(defined(_MSC_VER) && (_MSC_VER >= 1900))
+	return std::uncaught_exceptions();
+#else
+	return std::uncaught_exception()?1:0;
+#endif
+}
+
+} // namespace aux
+
+/// Returns the error check policy used in the current thread
+/**
+ *  @ingroup error_handling
+ */
+inline ErrorCheckPolicy CurrentErrorCheckPolicy(void)
+{
+	return aux::CurrentErrorCheckState().Policy();
+}
+
+/// Sets the error check policy used in the current thread
+/** Returns the previous policy. The calls recorded under the @c Deferred
+ *  policy that were not checked yet are forgotten, but the GL error flag
+ *  is not cleared, so an error caused by one of them is reported by
+ *  the next check, i.e. after the next wrapped GL call made under
+ *  the @c Immediate policy.
+ *  Use the DeferredErrorCheck and DebugOutputErrorCheck classes
+ *  to switch the policy for a scope.
+ *
+ *  @ingroup error_handling
+ */
+inline ErrorCheckPolicy SetErrorCheckPolicy(ErrorCheckPolicy policy)
+{
+	aux::ErrorCheckState& state = aux::CurrentErrorCheckState();
+	ErrorCheckPolicy result = state.Policy();
+	state.SetPolicy(policy);
+	return result;
+}
+
+/// Defers the checking of GL errors until the end of a scope
+/** Instances of this class switch the error check policy of the current
+ *  thread to @c Deferred when constructed. The wrapped GL calls made while
+ *  the instance is alive do not call @c glGetError, they just remember the
+ *  called function and the source location in a fixed-size list of recent
+ *  calls. @c glGetError is called once when Check is called or when the
+ *  instance is destroyed, and also when the list gets full, in which case
+ *  the recorded calls are checked and the list starts over. If an error
+ *  occured, it is reported through the Error exception, which is attributed
+ *  to the first of the checked calls and lists all of them in its message.
+ *
+ *  @code
+ *  {
+ *    DeferredErrorCheck check;
+ *    // many wrapped GL calls
+ *  } // errors are checked here
+ *  @endcode
+ *
+ *  @ingroup error_handling
+ */
+class DeferredErrorCheck
+{
+private:
+	ErrorCheckPolicy _prev;
+	int _uncaught;
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	DeferredErrorCheck(const DeferredErrorCheck&) = delete;
+	DeferredErrorCheck& operator = (const DeferredErrorCheck&) = delete;
+#else
+	DeferredErrorCheck(const DeferredErrorCheck&);
+	DeferredErrorCheck& operator = (const DeferredErrorCheck&);
+#endif
+public:
+	/// Checks any pending errors and switches to the Deferred policy
+	DeferredErrorCheck(void);
+
+	/// Checks the errors of the calls made since the last check
+	/**
+	 *  @throws Error
+	 */
+	void Check(void);
+
+	/// Checks the errors and restores the previous policy
+	~DeferredErrorCheck(void)
+	OGLPLUS_NOEXCEPT(false);
+};
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_3 || GL_KHR_debug
+
+/// Detects GL errors through the debug output instead of glGetError
+/** Instances of this class install a debug output callback and switch
+ *  the error check policy of the current thread to @c DebugOutput.
+ *  The debug output is made synchronous, and the wrapped GL calls
+ *  call @c glGetError only after the callback received a message
+ *  of the DEBUG_TYPE_ERROR type, so the errors are reported by the
+ *  call that caused them. The messages are passed also to the previously
+ *  installed callback, which is restored on destruction.
+ *
+ *  @glvoereq{4,3,KHR,debug}
+ *  @ingroup error_handling
+ */
+class DebugOutputErrorCheck
+{
+private:
+	static void GLAPIENTRY _gl_debug_proc(
+		GLenum source,
+		GLenum type,
+		GLuint id,
+		GLenum severity,
+		GLsizei length,
+		const GLchar* message,
+		GLvoid* user_param
+	);
+
+	GLDEBUGPROC _prev_callback;
+	void* _prev_context;
+	ErrorCheckPolicy _prev;
+	bool _was_synchronous;
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	DebugOutputErrorCheck(const DebugOutputErrorCheck&) = delete;
+	DebugOutputErrorCheck& operator = (const DebugOutputErrorCheck&) = delete;
+#else
+	DebugOutputErrorCheck(const DebugOutputErrorCheck&);
+	DebugOutputErrorCheck& operator = (const DebugOutputErrorCheck&);
+#endif
+public:
+	/// Installs the callback and switches to the DebugOutput policy
+	/** The debug output must be enabled in the current context,
+	 *  for example by creating a debug context.
+	 */
+	DebugOutputErrorCheck(void);
+
+	/// Restores the previous callback and policy
+	~DebugOutputErrorCheck(void);
+};
+
+#endif // GL_VERSION_4_3 || KHR_debug
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/error/check_policy.ipp>
+#endif
+
+#endif // include guard
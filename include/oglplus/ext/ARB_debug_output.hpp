@@ -15,6 +15,7 @@
 
 #include <oglplus/extension.hpp>
 #include <oglplus/boolean.hpp>
+#include <oglplus/capability.hpp>
 #include <oglplus/config/compiler.hpp>
 #include <oglplus/string/ref.hpp>
 #include <oglplus/string/def.hpp>
@@ -188,16 +189,7 @@ public:
 	/// Enables or disables synchronous debug output
 	static void Synchronous(bool enable)
 	{
-		if(enable)
-		{
-			OGLPLUS_GLFUNC(Enable)(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
-			OGLPLUS_VERIFY_SIMPLE(Enable);
-		}
-		else
-		{
-			OGLPLUS_GLFUNC(Disable)(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
-			OGLPLUS_VERIFY_SIMPLE(Disable);
-		}
+		aux::EnableCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB, enable);
 	}
 
 	/// Inserts a new message into the debug output
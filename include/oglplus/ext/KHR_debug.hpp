@@ -15,6 +15,7 @@
 
 #include <oglplus/extension.hpp>
 #include <oglplus/boolean.hpp>
+#include <oglplus/capability.hpp>
 #include <oglplus/config/compiler.hpp>
 #include <oglplus/string/def.hpp>
 #include <oglplus/string/ref.hpp>
@@ -320,16 +321,7 @@ public:
 	/// Enables or disables synchronous debug output
 	static void Synchronous(bool enable = true)
 	{
-		if(enable)
-		{
-			OGLPLUS_GLFUNC(Enable)(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-			OGLPLUS_VERIFY_SIMPLE(Enable);
-		}
-		else
-		{
-			OGLPLUS_GLFUNC(Disable)(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-			OGLPLUS_VERIFY_SIMPLE(Disable);
-		}
+		aux::EnableCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS, enable);
 	}
 
 	/// Enables or disables asynchronous debug output
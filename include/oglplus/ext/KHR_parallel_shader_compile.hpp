@@ -0,0 +1,101 @@
+/**
+ *  @file oglplus/ext/KHR_parallel_shader_compile.hpp
+ *  @brief Wrapper for the KHR_parallel_shader_compile extension
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_EXT_KHR_PARALLEL_SHADER_COMPILE_1509241330_HPP
+#define OGLPLUS_EXT_KHR_PARALLEL_SHADER_COMPILE_1509241330_HPP
+
+#include <oglplus/extension.hpp>
+#include <oglplus/boolean.hpp>
+#include <oglplus/glfunc.hpp>
+#include <oglplus/error/object.hpp>
+#include <oglplus/object/name.hpp>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_KHR_parallel_shader_compile
+/// Wrapper for the KHR_parallel_shader_compile extension
+/** With this extension the shader compilation and program linking
+ *  can be done by the driver on its own threads and the completion
+ *  of these operations can be queried without blocking.
+ *
+ *  @glsymbols
+ *  @glextref{KHR,parallel_shader_compile}
+ *
+ *  @ingroup gl_extensions
+ */
+class KHR_parallel_shader_compile
+{
+public:
+	OGLPLUS_EXTENSION_CLASS(KHR, parallel_shader_compile)
+
+	/// Sets the number of threads used by the driver for compilation
+	/**
+	 *  @glsymbols
+	 *  @glfunref{MaxShaderCompilerThreadsKHR}
+	 */
+	static void MaxShaderCompilerThreads(GLuint count)
+	{
+		OGLPLUS_GLFUNC(MaxShaderCompilerThreadsKHR)(count);
+		OGLPLUS_VERIFY_SIMPLE(MaxShaderCompilerThreadsKHR);
+	}
+
+	/// Returns true if the compilation of the shader finished
+	/** Unlike the compile status query this does not block.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{GetShader}
+	 *  @gldefref{COMPLETION_STATUS_KHR}
+	 */
+	static Boolean CompletionStatus(ShaderName shader)
+	{
+		Boolean result;
+		OGLPLUS_GLFUNC(GetShaderiv)(
+			GetGLName(shader),
+			GL_COMPLETION_STATUS_KHR,
+			result._ptr()
+		);
+		OGLPLUS_VERIFY(
+			GetShaderiv,
+			ObjectError,
+			Object(shader)
+		);
+		return result;
+	}
+
+	/// Returns true if the linking of the program finished
+	/** Unlike the link status query this does not block.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{GetProgram}
+	 *  @gldefref{COMPLETION_STATUS_KHR}
+	 */
+	static Boolean CompletionStatus(ProgramName program)
+	{
+		Boolean result;
+		OGLPLUS_GLFUNC(GetProgramiv)(
+			GetGLName(program),
+			GL_COMPLETION_STATUS_KHR,
+			result._ptr()
+		);
+		OGLPLUS_VERIFY(
+			GetProgramiv,
+			ObjectError,
+			Object(program)
+		);
+		return result;
+	}
+};
+#endif
+
+} // namespace oglplus
+
+#endif // include guard
@@ -21,6 +21,7 @@
 #include <oglplus/texture_target.hpp>
 #include <oglplus/one_of.hpp>
 #include <oglplus/object/wrapper.hpp>
+#include <oglplus/state_cache.hpp>
 #include <cassert>
 
 namespace oglplus {
@@ -108,6 +109,13 @@ public:
 		FramebufferName framebuffer
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GLenum(target), 0,
+			GetGLName(framebuffer)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindFramebuffer)(
 			GLenum(target),
 			GetGLName(framebuffer)
@@ -117,6 +125,26 @@ public:
 			ObjectError,
 			ObjectBinding(target)
 		);
+		cached.Update();
+		// GL_FRAMEBUFFER binds both the draw and the read framebuffer
+		if(GLenum(target) == GL_FRAMEBUFFER)
+		{
+			aux::StateCacheForget(
+				aux::StateCacheGroup::Binding,
+				GL_DRAW_FRAMEBUFFER
+			);
+			aux::StateCacheForget(
+				aux::StateCacheGroup::Binding,
+				GL_READ_FRAMEBUFFER
+			);
+		}
+		else
+		{
+			aux::StateCacheForget(
+				aux::StateCacheGroup::Binding,
+				GL_FRAMEBUFFER
+			);
+		}
 	}
 };
 
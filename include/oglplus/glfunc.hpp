@@ -20,6 +20,10 @@
 #include <oglplus/error/glfunc.hpp>
 #endif
 
+#if OGLPLUS_GL_DISPATCH
+#include <oglplus/dispatch/table.hpp>
+#endif
+
 namespace oglplus {
 
 #if !OGLPLUS_NO_VARIADIC_TEMPLATES && !OGLPLUS_NO_GLFUNC_CHECKS
@@ -49,9 +53,17 @@ inline auto _checked_glfunc(
 }
 
 #ifndef OGLPLUS_GLFUNC
+#if OGLPLUS_GL_DISPATCH
+#define OGLPLUS_GLFUNC(FUNCNAME) \
+	::oglplus::_checked_glfunc( \
+		OGLPLUS_GLFUNC_DISPATCH_ENTRY(FUNCNAME)::Resolve(#FUNCNAME), \
+		#FUNCNAME \
+	)
+#else
 #define OGLPLUS_GLFUNC(FUNCNAME) \
 	::oglplus::_checked_glfunc(&::gl##FUNCNAME, #FUNCNAME)
 #endif
+#endif
 #ifndef OGLPLUS_GLXFUNC
 #define OGLPLUS_GLXFUNC(FUNCNAME) \
 	::oglplus::_checked_glfunc(&::glX##FUNCNAME, #FUNCNAME)
@@ -64,8 +76,12 @@ inline auto _checked_glfunc(
 #else
 
 #ifndef OGLPLUS_GLFUNC
+#if OGLPLUS_GL_DISPATCH
+#define OGLPLUS_GLFUNC(FUNCNAME) OGLPLUS_GLFUNC_DISPATCHED(FUNCNAME)
+#else
 #define OGLPLUS_GLFUNC(FUNCNAME) ::gl##FUNCNAME
 #endif
+#endif
 #ifndef OGLPLUS_GLXFUNC
 #define OGLPLUS_GLXFUNC(FUNCNAME) ::glX##FUNCNAME
 #endif
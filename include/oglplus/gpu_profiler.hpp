@@ -0,0 +1,275 @@
+/**
+ *  @file oglplus/gpu_profiler.hpp
+ *  @brief Non-blocking GPU profiler based on timestamp queries
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_GPU_PROFILER_1509251015_HPP
+#define OGLPLUS_GPU_PROFILER_1509251015_HPP
+
+#include <oglplus/query.hpp>
+#include <oglplus/string/ref.hpp>
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <cstdint>
+#include <cassert>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_3_3 || GL_ARB_timer_query
+
+/// A named scope measured by the GpuProfiler
+struct GpuProfilerScope
+{
+	/// The name of the scope
+	std::string name;
+
+	/// The index of the enclosing scope in the frame or npos
+	std::size_t parent;
+
+	/// The nesting depth of the scope, top-level scopes have depth 0
+	std::size_t depth;
+
+	/// The GPU timestamps of the beginning and of the end in nanoseconds
+	GLuint64 begin, end;
+
+	/// The duration of the scope in nanoseconds
+	GLuint64 Duration(void) const
+	{
+		return end-begin;
+	}
+
+	static const std::size_t npos = ~std::size_t(0);
+};
+
+/// The resolved timings of a single frame measured by the GpuProfiler
+struct GpuProfilerFrame
+{
+	/// The sequential number of the frame
+	std::uint64_t number;
+
+	/// The GPU timestamps of the beginning and of the end in nanoseconds
+	GLuint64 begin, end;
+
+	/// The scopes of the frame in the order in which they began
+	/** Every scope follows its parent, so the scopes form
+	 *  a depth-first traversal of the tree of nested scopes.
+	 */
+	std::vector<GpuProfilerScope> scopes;
+
+	/// The duration of the frame in nanoseconds
+	GLuint64 Duration(void) const
+	{
+		return end-begin;
+	}
+};
+
+/// Always-on GPU profiler measuring nested scopes without stalls
+/** The profiler records a timestamp query at the beginning and at the end
+ *  of each frame and of each named scope. The queries of a frame are read
+ *  only after the GL made their results available, which is typically
+ *  a few frames later, so the profiling does not wait for the GPU.
+ *
+ *  The queries of the last @c latency frames are kept in a ring and are
+ *  reused. If the results of the oldest frame are still not available when
+ *  its queries are needed for a new frame, the new frame is not measured
+ *  (see DroppedFrameCount) instead of waiting.
+ *
+ *  Example:
+ *  @code
+ *  GpuProfiler profiler;
+ *  while(running)
+ *  {
+ *    profiler.BeginFrame();
+ *    {
+ *      GpuProfiler::Scope scope(profiler, "shadows");
+ *      RenderShadows();
+ *    }
+ *    {
+ *      GpuProfiler::Scope scope(profiler, "scene");
+ *      RenderScene();
+ *    }
+ *    profiler.EndFrame();
+ *  }
+ *  std::ofstream trace("gpu.json");
+ *  profiler.Flush();
+ *  profiler.WriteChromeTrace(trace);
+ *  @endcode
+ *
+ *  @glvoereq{3,3,ARB,timer_query}
+ */
+class GpuProfiler
+{
+private:
+	// the recorded but not yet resolved scope
+	struct _record
+	{
+		std::string name;
+		std::size_t parent;
+		std::size_t depth;
+		std::size_t begin_query, end_query;
+	};
+
+	// the queries and records of a single frame in the ring
+	struct _slot
+	{
+		std::vector<Query> queries;
+		std::vector<_record> records;
+		std::size_t query_count;
+		std::size_t record_count;
+		std::size_t end_query;
+		std::uint64_t number;
+		bool pending;
+
+		_slot(void)
+		 : query_count(0)
+		 , record_count(0)
+		 , end_query(0)
+		 , number(0)
+		 , pending(false)
+		{ }
+	};
+
+	std::vector<_slot> _ring;
+	std::size_t _current;
+	std::uint64_t _frame_number;
+	bool _in_frame, _measuring;
+	std::vector<std::size_t> _open;
+
+	std::deque<GpuProfilerFrame> _frames;
+	std::size_t _history;
+	unsigned long _dropped;
+
+	std::size_t _timestamp(_slot& slot);
+
+	bool _resolve(_slot& slot);
+public:
+	/// Creates a profiler with the specified latency and history size
+	/**
+	 *  @param latency the number of frames whose queries may be in flight
+	 *  @param history the maximum number of kept resolved frames
+	 */
+	GpuProfiler(std::size_t latency = 4, std::size_t history = 256);
+
+	/// Begins a new frame
+	/** Resolves the frames whose results are available.
+	 *
+	 *  @pre !InFrame()
+	 */
+	void BeginFrame(void);
+
+	/// Ends the current frame
+	/**
+	 *  @pre InFrame()
+	 *  @pre all scopes of the frame are ended
+	 */
+	void EndFrame(void);
+
+	/// Returns true between BeginFrame and EndFrame
+	bool InFrame(void) const
+	{
+		return _in_frame;
+	}
+
+	/// Returns true if the current frame is being measured
+	bool Measuring(void) const
+	{
+		return _measuring;
+	}
+
+	/// Begins a named scope nested in the currently open scope
+	/**
+	 *  @pre InFrame()
+	 */
+	void BeginScope(const StrCRef& name);
+
+	/// Ends the innermost open scope
+	void EndScope(void);
+
+	/// Begins a scope on construction and ends it on destruction
+	class Scope
+	{
+	private:
+		GpuProfiler& _profiler;
+	public:
+		Scope(GpuProfiler& profiler, const StrCRef& name)
+		 : _profiler(profiler)
+		{
+			_profiler.BeginScope(name);
+		}
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+		Scope(const Scope&) = delete;
+		Scope& operator = (const Scope&) = delete;
+#else
+	private:
+		Scope(const Scope&);
+		Scope& operator = (const Scope&);
+	public:
+#endif
+
+		~Scope(void)
+		{
+			_profiler.EndScope();
+		}
+	};
+
+	/// Resolves the frames whose results are available without blocking
+	/**
+	 *  @returns the number of newly resolved frames.
+	 */
+	std::size_t Resolve(void);
+
+	/// Waits for and resolves the results of all measured frames
+	/** This blocks until the GPU finishes the measured frames, it is
+	 *  intended to be used when the profiling ends.
+	 *
+	 *  @pre !InFrame()
+	 */
+	void Flush(void);
+
+	/// The resolved frames ordered from the oldest to the newest
+	const std::deque<GpuProfilerFrame>& Frames(void) const
+	{
+		return _frames;
+	}
+
+	/// Removes all resolved frames
+	void ClearFrames(void)
+	{
+		_frames.clear();
+	}
+
+	/// The number of frames that were not measured
+	unsigned long DroppedFrameCount(void) const
+	{
+		return _dropped;
+	}
+
+	/// Writes the resolved frames in the Chrome trace-event JSON format
+	/** The output can be loaded in chrome://tracing or in other viewers
+	 *  supporting this format. Frames and scopes are written as complete
+	 *  events with times in microseconds relative to the beginning
+	 *  of the oldest resolved frame.
+	 */
+	void WriteChromeTrace(std::ostream& output) const;
+};
+
+#endif // GL_VERSION_3_3 || GL_ARB_timer_query
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/gpu_profiler.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -0,0 +1,164 @@
+/**
+ *  @file oglplus/images/async_load.hpp
+ *  @brief Asynchronous loading of multiple images on worker threads
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_IMAGES_ASYNC_LOAD_1509181410_HPP
+#define OGLPLUS_IMAGES_ASYNC_LOAD_1509181410_HPP
+
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/images/image.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <exception>
+#include <cstddef>
+
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace oglplus {
+namespace images {
+
+/// Loads images by name asynchronously on a pool of worker threads
+/** The images are looked up with FindResourceFile, just like with
+ *  LoadByName, and decoded by the PNG or XPM loaders on worker threads.
+ *  Loaded images are put into a completion queue from which they are
+ *  taken, in the order in which they finish loading, by Next().
+ *
+ *  The total size of images being decoded or waiting in the completion
+ *  queue is limited by a byte budget. A worker that would exceed the budget
+ *  waits until previously loaded images are taken from the queue.
+ *  A single image larger than the budget is loaded only if no other
+ *  images are in flight.
+ *
+ *  If threads are not available (OGLPLUS_NO_THREADS) the images are
+ *  loaded synchronously by Next().
+ *
+ *  @ingroup image_load_gen
+ */
+class AsyncImageLoader
+{
+private:
+	struct _request
+	{
+		std::size_t ticket;
+		std::string category;
+		std::string name;
+		bool y_is_up;
+		bool x_is_right;
+	};
+
+	struct _result
+	{
+		std::size_t ticket;
+		std::size_t bytes;
+		// empty if the loading failed
+		std::vector<Image> image;
+		std::exception_ptr error;
+	};
+
+	std::size_t _max_bytes;
+	std::size_t _bytes_in_flight;
+	std::size_t _next_ticket;
+	std::size_t _pending;
+
+	std::deque<_request> _requests;
+	std::deque<_result> _results;
+
+#if !OGLPLUS_NO_THREADS
+	mutable std::mutex _mutex;
+	std::condition_variable _request_cond;
+	std::condition_variable _result_cond;
+	std::condition_variable _budget_cond;
+	std::vector<std::thread> _workers;
+	bool _stop;
+
+	void _work(void);
+#endif
+
+	bool _acquire(std::size_t bytes);
+	void _adjust(std::size_t estimate, std::size_t bytes);
+
+	_result _load(const _request& request);
+
+	AsyncImageLoader(const AsyncImageLoader&);
+public:
+	/// Creates a loader with the specified budget and number of threads
+	/** The @p max_bytes_in_flight limits the size of decoded images
+	 *  that are not yet taken by Next(). If @p threads is zero, then
+	 *  the number of hardware threads is used.
+	 */
+	AsyncImageLoader(
+		std::size_t max_bytes_in_flight,
+		unsigned threads = 0
+	);
+
+	/// Cancels the pending requests and waits for the workers to finish
+	~AsyncImageLoader(void);
+
+	/// Enqueues an image with the specified @p category and @p name
+	/** Returns a ticket identifying the image, which is returned
+	 *  together with the loaded image by Next(). Tickets of subsequently
+	 *  enqueued images are consecutive integers.
+	 */
+	std::size_t Enqueue(
+		std::string category,
+		std::string name,
+		bool y_is_up = true,
+		bool x_is_right = true
+	);
+
+	/// Enqueues a texture that comes with @OGLplus
+	std::size_t EnqueueTexture(
+		std::string name,
+		bool y_is_up = true,
+		bool x_is_right = true
+	)
+	{
+		return Enqueue("textures", name, y_is_up, x_is_right);
+	}
+
+	/// Enqueues a list of textures, returns the ticket of the first one
+	std::size_t EnqueueTextures(
+		const std::vector<std::string>& names,
+		bool y_is_up = true,
+		bool x_is_right = true
+	);
+
+	/// Returns the number of enqueued images not yet taken by Next()
+	std::size_t Pending(void) const;
+
+	/// Returns true if a loaded image is waiting in the completion queue
+	bool Ready(void) const;
+
+	/// Waits for the next loaded image and removes it from the queue
+	/** The @p ticket is set to the ticket of the returned image.
+	 *  If the loading of the image failed then the @p ticket is set
+	 *  and the exception thrown by the loader is re-thrown.
+	 *
+	 *  @throws std::runtime_error if there are no pending images
+	 *  (i.e. if Pending() == 0), since the call would block forever.
+	 */
+	Image Next(std::size_t& ticket);
+};
+
+} // images
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/images/async_load.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -26,6 +26,19 @@ class BrushedMetalUByte
  : public Image
 {
 private:
+	// a straight part of a scratch
+	struct _segment
+	{
+		GLint x, y, dx, dy;
+	};
+
+	static bool _segment_in_rows(
+		const _segment& s,
+		GLsizei h,
+		GLint y_begin,
+		GLint y_end
+	);
+
 	static void _make_pixel(
 		GLubyte* b,
 		GLubyte *e,
@@ -35,7 +48,9 @@ private:
 		GLint y,
 		GLdouble /*c*/,
 		GLubyte r,
-		GLubyte g
+		GLubyte g,
+		GLint y_begin,
+		GLint y_end
 	);
 
 	static void _make_scratch(
@@ -46,9 +61,23 @@ private:
 		GLint x,
 		GLint y,
 		GLint dx,
-		GLint dy
+		GLint dy,
+		GLint y_begin,
+		GLint y_end
+	);
+
+	void _make(
+		GLsizei width,
+		GLsizei height,
+		unsigned n_scratches,
+		int s_disp_min,
+		int s_disp_max,
+		int t_disp_min,
+		int t_disp_max,
+		GLuint seed
 	);
 public:
+	/// Creates an image seeded by a value from std::rand
 	BrushedMetalUByte(
 		SizeType width,
 		SizeType height,
@@ -58,6 +87,18 @@ public:
 		int t_disp_min,
 		int t_disp_max
 	);
+
+	/// Creates an image with the scratches determined by the specified seed
+	BrushedMetalUByte(
+		SizeType width,
+		SizeType height,
+		unsigned n_scratches,
+		int s_disp_min,
+		int s_disp_max,
+		int t_disp_min,
+		int t_disp_max,
+		GLuint seed
+	);
 };
 
 } // images
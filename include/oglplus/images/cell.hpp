@@ -14,9 +14,12 @@
 #define OGLPLUS_IMAGES_CELL_1107121519_HPP
 
 #include <oglplus/images/image.hpp>
+#include <oglplus/images/tiled.hpp>
+#include <oglplus/config/compiler.hpp>
 #include <oglplus/assert.hpp>
 
 #include <vector>
+#include <cmath>
 
 namespace oglplus {
 namespace images {
@@ -54,6 +57,227 @@ private:
 		OGLPLUS_ABORT("Invalid number of channels!");
 		return PixelDataInternalFormat();
 	}
+
+	// The points and colors of a cell and of its neighbours
+	struct _neighbourhood
+	{
+		GLsizei count;
+		Vec3d centers[27];
+		Vec3d colors[27];
+		// the neighbour points in SoA layout (for the distance kernel)
+		GLdouble dpos[3][27];
+		GLfloat fpos[3][27];
+	};
+
+	// Parameters of the generator shared by all workers
+	struct _params
+	{
+		GLsizei cell_w, cell_h, cell_d;
+		GLsizei iw, ih, id;
+		GLsizei width, height, depth;
+		GLdouble i_w, i_h, i_d;
+		std::size_t dims;
+	};
+
+	// Calculates the neighbourhood of the cell at [cx, cy, cz]
+	static void _make_neighbourhood(
+		const _params& p,
+		const Image& input,
+		GLsizei cx,
+		GLsizei cy,
+		GLsizei cz,
+		_neighbourhood& nh
+	)
+	{
+		const GLsizei kmin = (p.dims == 3)?-1:0;
+		const GLsizei kmax = (p.dims == 3)?+2:1;
+		const GLsizei jmin = (p.dims >= 2)?-1:0;
+		const GLsizei jmax = (p.dims >= 2)?+2:1;
+		const GLsizei imin = -1;
+		const GLsizei imax = +2;
+
+		const Vec3d is(p.iw, p.ih, p.id);
+
+		GLsizei l=0;
+
+		for(GLsizei k=kmin; k<kmax; ++k)
+		for(GLsizei j=jmin; j<jmax; ++j)
+		for(GLsizei i=imin; i<imax; ++i)
+		{
+			GLsizei ccz = cz+k;
+			GLsizei ccy = cy+j;
+			GLsizei ccx = cx+i;
+
+			const Vec3d cc(
+				ccx*p.cell_w*p.i_w,
+				ccy*p.cell_h*p.i_h,
+				ccz*p.cell_d*p.i_d
+			);
+
+			ccz = (ccz+p.id)%p.id;
+			ccy = (ccy+p.ih)%p.ih;
+			ccx = (ccx+p.iw)%p.iw;
+
+			const Vec3d co = input.Pixel(ccx, ccy, ccz).xyz();
+
+			nh.centers[l] = cc;
+			nh.colors[l] = co;
+
+			for(std::size_t d=0; d!=3; ++d)
+			{
+				GLdouble pd = cc[d]+co[d]/is[d];
+				nh.dpos[d][l] = pd;
+				nh.fpos[d][l] = GLfloat(pd);
+			}
+			++l;
+		}
+		nh.count = l;
+	}
+
+	// SoA distance kernel calculating the distances from the texel
+	// to all the points in a neighbourhood at once
+	template <typename S>
+	static void _soa_distances(
+		std::size_t dims,
+		const S tc[3],
+		const S is[3],
+		const S (&pos)[3][27],
+		GLsizei count,
+		GLdouble* dists
+	)
+	{
+		S acc[27];
+		for(GLsizei l=0; l<count; ++l)
+		{
+			S dist = (tc[0]-pos[0][l])*is[0];
+			acc[l] = dist*dist;
+		}
+		for(std::size_t d=1; d<dims; ++d)
+		{
+			for(GLsizei l=0; l<count; ++l)
+			{
+				S dist = (tc[d]-pos[d][l])*is[d];
+				acc[l] += dist*dist;
+			}
+		}
+		for(GLsizei l=0; l<count; ++l)
+		{
+			dists[l] = GLdouble(std::sqrt(acc[l]));
+		}
+	}
+
+	// Distance calculation using a generic distance function
+	template <typename GetDistance>
+	static void _calc_distances(
+		GetDistance& get_distance,
+		std::size_t dims,
+		const Vec3d& tc,
+		const Vec3d& is,
+		const _neighbourhood& nh,
+		GLdouble* dists
+	)
+	{
+		for(GLsizei l=0; l<nh.count; ++l)
+		{
+			dists[l] = get_distance(
+				dims,
+				tc,
+				nh.centers[l],
+				nh.colors[l],
+				is
+			);
+		}
+	}
+
+	template <typename X>
+	struct _euler_distance_tag { };
+
+	template <typename S>
+	static void _calc_distances(
+		_euler_distance_tag<S>,
+		std::size_t dims,
+		const Vec3d& tc,
+		const Vec3d& is,
+		const S (&pos)[3][27],
+		GLsizei count,
+		GLdouble* dists
+	)
+	{
+		const S stc[3] = { S(tc[0]), S(tc[1]), S(tc[2]) };
+		const S sis[3] = { S(is[0]), S(is[1]), S(is[2]) };
+		_soa_distances(dims, stc, sis, pos, count, dists);
+	}
+
+	// Generates the rows [row_begin, row_end) of the image
+	template <typename GetDistance, typename GetValue>
+	static void _make_rows(
+		const _params& p,
+		const Image& input,
+		GetDistance get_distance,
+		GetValue get_value,
+		T* data,
+		GLsizei row_begin,
+		GLsizei row_end
+	)
+	{
+		const T one = _one(TypeTag<T>());
+		const Vec3d is(p.iw, p.ih, p.id);
+
+		std::vector<_neighbourhood> cells(std::size_t(p.iw));
+		GLsizei cur_cy = -1, cur_cz = -1;
+
+		GLdouble dists[27];
+
+		T* pos = data + std::size_t(row_begin)*std::size_t(p.width)*CH;
+
+		for(GLsizei row=row_begin; row!=row_end; ++row)
+		{
+			const GLsizei z = row / p.height;
+			const GLsizei y = row % p.height;
+			const GLsizei cz = z/p.cell_d;
+			const GLsizei cy = y/p.cell_h;
+
+			// the neighbourhoods are shared by all rows of a cell row
+			if((cy != cur_cy) || (cz != cur_cz))
+			{
+				for(GLsizei cx=0; cx<p.iw; ++cx)
+				{
+					_make_neighbourhood(
+						p, input,
+						cx, cy, cz,
+						cells[std::size_t(cx)]
+					);
+				}
+				cur_cy = cy;
+				cur_cz = cz;
+			}
+
+			for(GLsizei x=0; x<p.width; ++x)
+			{
+				const GLsizei cx = x/p.cell_w;
+				const _neighbourhood& nh = cells[std::size_t(cx)];
+
+				Vec3d tc = Vec3d(x*p.i_w, y*p.i_h, z*p.i_d);
+
+				_dispatch_distances(
+					get_distance,
+					p.dims,
+					tc, is,
+					nh,
+					dists
+				);
+
+				Vector<GLdouble, CH> value =
+					get_value(dists, nh.colors, nh.count);
+
+				for(std::size_t c=0; c!=CH; ++c)
+				{
+					GLdouble vc = value.At(c);
+					*pos++ = T(one*vc);
+				}
+			}
+		}
+	}
 public:
 	struct EulerDistance
 	{
@@ -75,6 +299,80 @@ public:
 		}
 	};
 
+	/// Euclidean distance calculated in single precision
+	/** When used with the parallel generator, the distances are calculated
+	 *  by the single-precision SoA kernel, which is faster than the
+	 *  EulerDistance, but its results may differ in the last bits.
+	 */
+	struct FastEulerDistance
+	{
+		GLdouble operator()(
+			std::size_t dims,
+			const Vec3d& tc,
+			const Vec3d& cc,
+			const Vec3d& co,
+			const Vec3d& is
+		) const
+		{
+			GLfloat result = 0.0f;
+			for(std::size_t d=0; d!=dims; ++d)
+			{
+				GLfloat pos = GLfloat(cc[d]+co[d]/is[d]);
+				GLfloat dist = (GLfloat(tc[d])-pos)*GLfloat(is[d]);
+				result += dist*dist;
+			}
+			return GLdouble(std::sqrt(result));
+		}
+	};
+private:
+	template <typename GetDistance>
+	static void _dispatch_distances(
+		GetDistance& get_distance,
+		std::size_t dims,
+		const Vec3d& tc,
+		const Vec3d& is,
+		const _neighbourhood& nh,
+		GLdouble* dists
+	)
+	{
+		_calc_distances(get_distance, dims, tc, is, nh, dists);
+	}
+
+	static void _dispatch_distances(
+		EulerDistance&,
+		std::size_t dims,
+		const Vec3d& tc,
+		const Vec3d& is,
+		const _neighbourhood& nh,
+		GLdouble* dists
+	)
+	{
+		_calc_distances(
+			_euler_distance_tag<GLdouble>(),
+			dims, tc, is,
+			nh.dpos, nh.count,
+			dists
+		);
+	}
+
+	static void _dispatch_distances(
+		FastEulerDistance&,
+		std::size_t dims,
+		const Vec3d& tc,
+		const Vec3d& is,
+		const _neighbourhood& nh,
+		GLdouble* dists
+	)
+	{
+		_calc_distances(
+			_euler_distance_tag<GLfloat>(),
+			dims, tc, is,
+			nh.fpos, nh.count,
+			dists
+		);
+	}
+public:
+	/// Generates the image texel by texel (reference implementation)
 	template <typename GetDistance, typename GetValue>
 	CellImageGen(
 		SizeType cell_w,
@@ -144,9 +442,9 @@ public:
 						GLsizei ccx = cx+i;
 
 						Vec3d cc(
-							ccx*cell_w*i_w,
-							ccy*cell_h*i_h,
-							ccz*cell_d*i_d
+							ccx*GLsizei(cell_w)*i_w,
+							ccy*GLsizei(cell_h)*i_h,
+							ccz*GLsizei(cell_d)*i_d
 						);
 
 						ccz = (ccz+id)%id;
@@ -174,6 +472,80 @@ public:
 		}
 		assert(pos == this->_end<T>());
 	}
+
+	/// Generates the image in parallel, by rows of cells
+	/** The output image is split into rows of cells which are processed
+	 *  by an ImageTileExecutor with @p threads worker threads
+	 *  (if @p threads is zero then ImageTileExecutor::DefaultThreads
+	 *  or the hardware concurrency is used). The points and colors of the neighbouring cells are calculated
+	 *  once per cell row instead of once for every texel and if
+	 *  @p get_distance is EulerDistance or FastEulerDistance then the
+	 *  distances are calculated by a SoA kernel.
+	 *
+	 *  With EulerDistance the output is bit-identical to the image
+	 *  generated by the reference constructor.
+	 *
+	 *  @note Each row of cells uses its own copy of @p get_distance and
+	 *  @p get_value, the copies must be safe to call concurrently.
+	 */
+	template <typename GetDistance, typename GetValue>
+	CellImageGen(
+		SizeType cell_w,
+		SizeType cell_h,
+		SizeType cell_d,
+		const Image& input,
+		GetDistance get_distance,
+		GetValue get_value,
+		unsigned threads
+	): Image(
+		input.Width() *cell_w,
+		input.Height()*cell_h,
+		input.Depth() *cell_d,
+		CH, &TypeTag<T>(),
+		_fmt(CH), _ifmt(TypeTag<T>(), CH)
+	)
+	{
+		_params p;
+		p.cell_w = cell_w;
+		p.cell_h = cell_h;
+		p.cell_d = cell_d;
+		p.iw = input.Width();
+		p.ih = input.Height();
+		p.id = input.Depth();
+		p.width = Width();
+		p.height = Height();
+		p.depth = Depth();
+		p.i_w = 1.0/GLsizei(Width());
+		p.i_h = 1.0/GLsizei(Height());
+		p.i_d = 1.0/GLsizei(Depth());
+
+		p.dims = 1;
+		if(p.ih*cell_h > 1) p.dims = 2;
+		if(p.id*cell_d > 1) p.dims = 3;
+
+		T* data = this->_begin<T>();
+
+		// each tile is a single row of cells, so that the neighbourhoods
+		// are calculated once per cell row also by the parallel workers
+		ImageTileExecutor executor(p.width, p.cell_h, threads);
+		executor.Execute(
+			p.width,
+			p.height,
+			p.depth,
+			[&](const ImageTile& tile)
+			{
+				const GLsizei row_begin = tile.z*p.height+tile.y;
+				_make_rows(
+					p, input,
+					get_distance,
+					get_value,
+					data,
+					row_begin,
+					row_begin+tile.height
+				);
+			}
+		);
+	}
 };
 
 class WorleyCellGen
@@ -240,6 +612,23 @@ public:
 		Base::EulerDistance(),
 		DistanceValue<ValueCalc>(calc_value, order)
 	){ }
+
+	template <typename ValueCalc>
+	WorleyCellGen(
+		SizeType cell_w,
+		SizeType cell_h,
+		SizeType cell_d,
+		const Image& input,
+		ValueCalc calc_value,
+		unsigned order,
+		unsigned threads
+	): CellImageGen<GLubyte, 1>(
+		cell_w, cell_h, cell_d,
+		input,
+		Base::EulerDistance(),
+		DistanceValue<ValueCalc>(calc_value, order),
+		threads
+	){ }
 };
 
 } // images
@@ -0,0 +1,168 @@
+/**
+ *  @file oglplus/images/frame_writer.hpp
+ *  @brief Writing of frames into image files on a background thread
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_IMAGES_FRAME_WRITER_1509281315_HPP
+#define OGLPLUS_IMAGES_FRAME_WRITER_1509281315_HPP
+
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/size_type.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <exception>
+#include <cstddef>
+
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace oglplus {
+namespace images {
+
+/// The format of the files written by the FrameWriter
+enum class FrameFileFormat
+{
+	/// The pixel data as they are, without any header
+	Raw,
+	/// Portable network graphics (requires libpng)
+	PNG
+};
+
+/// Writes frames into files in the order of submission on a worker thread
+/** Writing a frame into a file, and especially encoding it into an image
+ *  format, takes time that should not be spent on the rendering thread.
+ *  The FrameWriter takes the pixel data by value, so that they can be
+ *  moved in without copying, and writes them on a worker thread.
+ *  The paths of the written files are reported by Poll in the order
+ *  in which the frames were enqueued.
+ *
+ *  The number of enqueued frames not written yet is limited;
+ *  when the limit is reached Enqueue waits for the worker.
+ *
+ *  The pixel rows are expected to be ordered bottom to top, as they are
+ *  returned by ReadPixels, unless @c y_is_up is false. Raw files contain
+ *  the rows in the original order, PNG images are written top to bottom.
+ *  PNG frames must have one to four unsigned byte components per pixel.
+ *
+ *  If threads are not available (OGLPLUS_NO_THREADS) the frames are
+ *  written synchronously by Enqueue.
+ *
+ *  @see PixelReadback
+ *
+ *  @ingroup image_load_gen
+ */
+class FrameWriter
+{
+private:
+	struct _job
+	{
+		std::string path;
+		GLsizei width, height, channels;
+		std::vector<GLubyte> pixels;
+	};
+
+	struct _result
+	{
+		std::string path;
+		std::exception_ptr error;
+	};
+
+	FrameFileFormat _format;
+	bool _y_is_up;
+	std::size_t _max_queued;
+
+	std::deque<_job> _jobs;
+	std::deque<_result> _results;
+	std::size_t _queued;
+
+#if !OGLPLUS_NO_THREADS
+	mutable std::mutex _mutex;
+	std::condition_variable _job_cond;
+	std::condition_variable _done_cond;
+	std::thread _worker;
+	bool _stop;
+
+	void _work(void);
+#endif
+
+	_result _write(const _job& job) const;
+
+	FrameWriter(const FrameWriter&);
+public:
+	/// Creates a writer of files in the specified @p format
+	/**
+	 *  @param format the format of the written files
+	 *  @param max_queued the maximum number of frames waiting for the worker
+	 *  @param y_is_up true if the rows are ordered bottom to top
+	 *
+	 *  @throws std::runtime_error if PNG is requested but not supported
+	 */
+	FrameWriter(
+		FrameFileFormat format = FrameFileFormat::Raw,
+		std::size_t max_queued = 8,
+		bool y_is_up = true
+	);
+
+	/// Writes the remaining frames and waits for the worker to finish
+	~FrameWriter(void);
+
+	/// Returns the format of the written files
+	FrameFileFormat Format(void) const
+	{
+		return _format;
+	}
+
+	/// Enqueues the pixels of a frame to be written to the specified @p path
+	/** The @p channels is the number of unsigned byte components
+	 *  per pixel, for raw files it is the size of a pixel in bytes.
+	 *  Waits if the maximum number of frames is queued.
+	 *
+	 *  @pre pixels.size() >= width*height*channels
+	 */
+	void Enqueue(
+		std::string path,
+		SizeType width,
+		SizeType height,
+		SizeType channels,
+		std::vector<GLubyte> pixels
+	);
+
+	/// Returns the number of enqueued frames not yet reported by Poll
+	std::size_t Pending(void) const;
+
+	/// Appends the paths of the files written since the last call
+	/** Does not block. If the writing of a file failed then the paths
+	 *  of the files written before it are appended and the exception
+	 *  is re-thrown.
+	 *
+	 *  @returns the number of the appended paths.
+	 */
+	std::size_t Poll(std::vector<std::string>& written);
+
+	/// Waits until all enqueued frames are written and appends their paths
+	/**
+	 *  @see Poll
+	 */
+	std::size_t Wait(std::vector<std::string>& written);
+};
+
+} // images
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/images/frame_writer.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -14,6 +14,7 @@
 #define OGLPLUS_IMAGES_NEWTON_1107121519_HPP
 
 #include <oglplus/images/image.hpp>
+#include <oglplus/images/tiled.hpp>
 #include <oglplus/math/vector.hpp>
 
 #include <cassert>
@@ -63,11 +64,42 @@ private:
 		return a*(1.0f - coef) + b*coef;
 	}
 
+	template <typename Function, typename Mixer, std::size_t N>
+	static void _make_pixel(
+		GLfloat* p,
+		Vec2f z,
+		Function,
+		const Mixer& mixer,
+		const Vector<float, N>& c1,
+		const Vector<float, N>& c2
+	)
+	{
+		std::size_t n, max = 256;
+		for(n = 0; n != max; ++n)
+		{
+			Vec2f zn = z - _cdiv(
+				Function::f(z),
+				Function::df(z)
+			);
+			if(Distance(zn, z) < 0.00001f) break;
+			z = zn;
+		}
+		Vector<float, N> c = _mix(
+			c1,
+			c2,
+			float(mixer(float(n) / float(max-1)))
+		);
+		for(n=0; n!=N; ++n)
+		{
+			p[n] = c.At(n);
+		}
+	}
+
 	template <typename Function, typename Mixer, std::size_t N>
 	void _make(
 		GLsizei width,
 		GLsizei height,
-		Function,
+		Function func,
 		Mixer mixer,
 		Vec2f lb,
 		Vec2f rt,
@@ -75,38 +107,33 @@ private:
 		Vector<float, N> c2
 	)
 	{
-		auto p = this->_begin<GLfloat>();
+		GLfloat* data = this->_begin<GLfloat>();
+		assert(data+width*height*GLsizei(N) == this->_end<GLfloat>());
 
-		for(GLsizei i=0; i!=width; ++i)
-		for(GLsizei j=0; j!=height; ++j)
-		{
-			Vec2f z(
-				_mix(lb.x(), rt.x(), float(i)/float(width-1)),
-				_mix(lb.y(), rt.y(), float(j)/float(height-1))
-			);
-			std::size_t n, max = 256;
-			for(n = 0; n != max; ++n)
+		ImageTileExecutor().Execute(
+			width, height, 1,
+			[=, &mixer, &c1, &c2](const ImageTile& tile)
 			{
-				Vec2f zn = z - _cdiv(
-					Function::f(z),
-					Function::df(z)
-				);
-				if(Distance(zn, z) < 0.00001f) break;
-				z = zn;
+				for(GLsizei i=tile.x; i!=tile.x+tile.width; ++i)
+				{
+					const float x = _mix(
+						lb.x(), rt.x(),
+						float(i)/float(width-1)
+					);
+					// the pixels are stored column by column
+					GLfloat* p = data+(i*height+tile.y)*GLsizei(N);
+					for(GLsizei j=tile.y; j!=tile.y+tile.height; ++j)
+					{
+						Vec2f z(x, _mix(
+							lb.y(), rt.y(),
+							float(j)/float(height-1)
+						));
+						_make_pixel(p, z, func, mixer, c1, c2);
+						p += N;
+					}
+				}
 			}
-			Vector<float, N> c = _mix(
-				c1,
-				c2,
-				float(mixer(float(n) / float(max-1)))
-			);
-			for(n=0; n!=N; ++n)
-			{
-				assert(p != this->_end<GLfloat>());
-				*p = c.At(n);
-				++p;
-			}
-		}
-		assert(p == this->_end<GLfloat>());
+		);
 	}
 public:
 	/// The X^3-1 function and its derivation
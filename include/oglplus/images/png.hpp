@@ -16,9 +16,126 @@
 #include <oglplus/images/image.hpp>
 
 #include <istream>
+#include <fstream>
+#include <memory>
+#include <cstddef>
 
 namespace oglplus {
 namespace images {
+namespace aux {
+
+class PNGLoader;
+
+} // namespace aux
+
+/// Streaming decoder of images in the PNG (Portable network graphics) format
+/** The PNGDecoder reads the PNG header on construction and makes
+ *  the dimensions and the pixel format of the image available before
+ *  any pixel data is decoded. The image rows are then decoded one by one
+ *  directly into a caller-provided destination, for example into
+ *  the storage of a mapped pixel-unpack buffer (BufferTypedMap::Data())
+ *  or into a preallocated AlignedPODArray, so that the decoded image
+ *  does not need to be held in an intermediate buffer.
+ *
+ *  The decoded pixels are always unsigned bytes, palette and low bit-depth
+ *  images are expanded to 8 bits per channel, 16-bit images are stripped
+ *  to 8 bits and transparency information is converted to an alpha channel.
+ *
+ *  @ingroup image_load_gen
+ */
+class PNGDecoder
+{
+private:
+	std::ifstream _file;
+	std::unique_ptr<aux::PNGLoader> _loader;
+
+	PNGDecoder(const PNGDecoder&);
+public:
+	/// Reads the header of a PNG file with the specified @p file_path
+	PNGDecoder(const char* file_path);
+
+	/// Reads the header of a PNG image from the specified @p input stream
+	/** The @p input stream must remain valid until the image is decoded.
+	 */
+	PNGDecoder(std::istream& input);
+
+	~PNGDecoder(void);
+
+	/// Returns the width of the image
+	SizeType Width(void) const;
+
+	/// Returns the height of the image
+	SizeType Height(void) const;
+
+	/// Returns the number of channels of the decoded pixels
+	SizeType Channels(void) const;
+
+	/// Returns the pixel data type of the decoded pixels
+	PixelDataType Type(void) const
+	{
+		return PixelDataType::UnsignedByte;
+	}
+
+	/// Returns the pixel data format of the decoded pixels
+	PixelDataFormat Format(void) const;
+
+	/// Returns a suitable pixel data internal format
+	PixelDataInternalFormat InternalFormat(void) const;
+
+	/// Returns the size of a single tightly packed decoded row in bytes
+	std::size_t RowSize(void) const;
+
+	/// Returns the size of the whole tightly packed decoded image in bytes
+	std::size_t DataSize(void) const;
+
+	/// Returns true if the image data were already decoded
+	bool Decoded(void) const;
+
+	/// Decodes the image rows into the specified destination
+	/** The rows are written into @p dest, which must point to a block
+	 *  of at least @p dest_size bytes, with @p row_stride bytes between
+	 *  the starts of subsequent rows. The @p row_stride must not be
+	 *  smaller than RowSize(); larger values can be used to satisfy
+	 *  the unpack alignment of the destination.
+	 *  If @p y_is_up is true then the rows are stored bottom-to-top
+	 *  as expected by OpenGL, if @p x_is_right is false then the rows
+	 *  are mirrored horizontally.
+	 *
+	 *  The image can be decoded only once, since the PNG data is read
+	 *  sequentially from the input.
+	 *
+	 *  @throws std::runtime_error if the destination is too small,
+	 *  if the image was already decoded or on decoding errors.
+	 */
+	void DecodeStrided(
+		void* dest,
+		std::size_t dest_size,
+		std::size_t row_stride,
+		bool y_is_up = true,
+		bool x_is_right = true
+	);
+
+	/// Decodes the tightly packed image rows into the specified destination
+	void Decode(
+		void* dest,
+		std::size_t dest_size,
+		bool y_is_up = true,
+		bool x_is_right = true
+	)
+	{
+		DecodeStrided(dest, dest_size, RowSize(), y_is_up, x_is_right);
+	}
+
+	/// Decodes the tightly packed image rows into the specified array
+	void Decode(
+		oglplus::aux::AlignedPODArray& dest,
+		bool y_is_up = true,
+		bool x_is_right = true
+	)
+	{
+		Decode(dest.begin(), dest.size(), y_is_up, x_is_right);
+	}
+};
 
 /// Loader of images in the PNG (Portable network graphics) format
 /**
@@ -27,6 +144,8 @@ namespace images {
 class PNGImage
  : public Image
 {
+private:
+	void _decode(PNGDecoder& decoder, bool y_is_up, bool x_is_right);
 public:
 	/// Load the image from a file with the specified @p file_path
 	PNGImage(
@@ -41,6 +160,13 @@ public:
 		bool y_is_up = true,
 		bool x_is_right = true
 	);
+
+	/// Load the image using a @p decoder which was not used yet
+	PNGImage(
+		PNGDecoder& decoder,
+		bool y_is_up = true,
+		bool x_is_right = true
+	);
 };
 
 } // images
@@ -25,8 +25,19 @@ namespace images {
 class RandomRedUByte
  : public Image
 {
+private:
+	void _make(GLuint seed);
 public:
+	/// Creates an image seeded by a value from std::rand
 	RandomRedUByte(SizeType width, SizeType height = 1, SizeType depth = 1);
+
+	/// Creates an image with the noise determined by the specified seed
+	RandomRedUByte(
+		SizeType width,
+		SizeType height,
+		SizeType depth,
+		GLuint seed
+	);
 };
 
 
@@ -37,8 +48,19 @@ public:
 class RandomRGBUByte
  : public Image
 {
+private:
+	void _make(GLuint seed);
 public:
+	/// Creates an image seeded by a value from std::rand
 	RandomRGBUByte(SizeType width, SizeType height = 1, SizeType depth = 1);
+
+	/// Creates an image with the noise determined by the specified seed
+	RandomRGBUByte(
+		SizeType width,
+		SizeType height,
+		SizeType depth,
+		GLuint seed
+	);
 };
 
 } // images
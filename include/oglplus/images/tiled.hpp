@@ -0,0 +1,306 @@
+/**
+ *  @file oglplus/images/tiled.hpp
+ *  @brief Tile-parallel execution of image generators
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_IMAGES_TILED_1509221122_HPP
+#define OGLPLUS_IMAGES_TILED_1509221122_HPP
+
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/size_type.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#if !OGLPLUS_NO_THREADS
+#include <thread>
+#include <atomic>
+#include <exception>
+#endif
+
+namespace oglplus {
+namespace images {
+
+/// A rectangular part of an image processed by the ImageTileExecutor
+/**
+ *  @ingroup image_load_gen
+ */
+struct ImageTile
+{
+	/// The coordinates of the first pixel of the tile
+	GLsizei x, y, z;
+
+	/// The size of the tile in pixels
+	GLsizei width, height;
+
+	/// The column and the row of the tile in the grid of tiles
+	GLsizei column, row;
+
+	/// The index of the tile in the grid of tiles
+	std::size_t index;
+};
+
+/// Pseudo-random number generator for the pixels of a single image tile
+/** The sequence of generated values depends only on the seed and
+ *  on the coordinates of the tile in the grid of tiles, so the generated
+ *  images are the same regardless of the number of threads used.
+ *
+ *  @ingroup image_load_gen
+ */
+class ImageTileRandom
+{
+private:
+	std::uint64_t _state;
+
+	// the splitmix64 output function
+	static std::uint64_t _mix(std::uint64_t z)
+	OGLPLUS_NOEXCEPT(true)
+	{
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+public:
+	/// Initializes the generator from a seed and a sequence number
+	ImageTileRandom(GLuint seed, std::uint64_t sequence)
+	OGLPLUS_NOEXCEPT(true)
+	 : _state(_mix(_mix(seed)+sequence))
+	{ }
+
+	/// Initializes the generator from a seed and the tile coordinates
+	ImageTileRandom(GLuint seed, const ImageTile& tile)
+	OGLPLUS_NOEXCEPT(true)
+	 : _state(_mix(_mix(seed)+(
+		(std::uint64_t(tile.z) << 42)^
+		(std::uint64_t(tile.row) << 21)^
+		(std::uint64_t(tile.column))
+	)))
+	{ }
+
+	/// Returns the next 32-bit pseudo-random value
+	GLuint operator()(void)
+	OGLPLUS_NOEXCEPT(true)
+	{
+		_state += 0x9E3779B97F4A7C15ull;
+		return GLuint(_mix(_state) >> 32);
+	}
+
+	/// Returns the next pseudo-random value in the range [0, 1)
+	GLfloat Real(void)
+	OGLPLUS_NOEXCEPT(true)
+	{
+		return GLfloat((*this)() >> 8)*(1.0f/16777216.0f);
+	}
+};
+
+/// Splits images into tiles and processes the tiles in parallel
+/** The tiles are handed out to the worker threads one at a time,
+ *  so uneven per-pixel costs are balanced. Each tile is processed
+ *  by a single thread and the order of processing is unspecified.
+ *
+ *  @ingroup image_load_gen
+ */
+class ImageTileExecutor
+{
+private:
+	GLsizei _tile_width, _tile_height;
+	unsigned _threads;
+
+	static GLsizei _tile_count(GLsizei size, GLsizei tile_size)
+	{
+		return (size+tile_size-1)/tile_size;
+	}
+
+	static unsigned& _default_threads(void)
+	{
+		static unsigned threads = 0;
+		return threads;
+	}
+public:
+	/// Creates an executor using tiles of the specified size
+	/**
+	 *  @param tile_width the width of a tile in pixels
+	 *  @param tile_height the height of a tile in pixels
+	 *  @param threads the maximum number of threads (0 = the value
+	 *  of DefaultThreads or the number of hardware threads)
+	 */
+	ImageTileExecutor(
+		GLsizei tile_width = 64,
+		GLsizei tile_height = 64,
+		unsigned threads = 0
+	): _tile_width(tile_width)
+	 , _tile_height(tile_height)
+	 , _threads(threads)
+	{
+		assert(_tile_width > 0);
+		assert(_tile_height > 0);
+	}
+
+	/// Returns the number of threads used if none is specified
+	static unsigned DefaultThreads(void)
+	{
+		return _default_threads();
+	}
+
+	/// Sets the number of threads used if none is specified
+	/** This affects the image generators using the executor internally.
+	 *  If @p threads is zero then the number of hardware threads is used.
+	 *  The value should not be changed while images are being generated.
+	 */
+	static void DefaultThreads(unsigned threads)
+	{
+		_default_threads() = threads;
+	}
+
+	/// The width of the tiles
+	GLsizei TileWidth(void) const
+	{
+		return _tile_width;
+	}
+
+	/// The height of the tiles
+	GLsizei TileHeight(void) const
+	{
+		return _tile_height;
+	}
+
+	/// The number of tiles of an image with the specified dimensions
+	std::size_t TileCount(
+		GLsizei width,
+		GLsizei height,
+		GLsizei depth = 1
+	) const
+	{
+		return	std::size_t(_tile_count(width, _tile_width))*
+			std::size_t(_tile_count(height, _tile_height))*
+			std::size_t(depth);
+	}
+
+	/// Returns the tile with the specified index
+	ImageTile Tile(
+		std::size_t index,
+		GLsizei width,
+		GLsizei height
+	) const
+	{
+		const GLsizei columns = _tile_count(width, _tile_width);
+		const GLsizei rows = _tile_count(height, _tile_height);
+
+		ImageTile tile;
+		tile.index = index;
+		tile.column = GLsizei(index % std::size_t(columns));
+		index /= std::size_t(columns);
+		tile.row = GLsizei(index % std::size_t(rows));
+		tile.z = GLsizei(index / std::size_t(rows));
+
+		tile.x = tile.column*_tile_width;
+		tile.y = tile.row*_tile_height;
+		tile.width = std::min(_tile_width, width-tile.x);
+		tile.height = std::min(_tile_height, height-tile.y);
+		return tile;
+	}
+
+	/// Calls @p func for each tile of an image with the specified size
+	/** The function is called with a const reference to an ImageTile
+	 *  possibly from multiple threads concurrently. The first exception
+	 *  thrown by the function is re-thrown after all threads finish.
+	 *  If a worker thread cannot be started, then the already started
+	 *  threads are stopped and joined and the exception is propagated.
+	 */
+	template <typename Function>
+	void Execute(
+		GLsizei width,
+		GLsizei height,
+		GLsizei depth,
+		Function func
+	) const
+	{
+		const std::size_t count = TileCount(width, height, depth);
+#if !OGLPLUS_NO_THREADS
+		unsigned threads = _threads;
+		if(threads == 0)
+		{
+			threads = DefaultThreads();
+		}
+		if(threads == 0)
+		{
+			threads = std::thread::hardware_concurrency();
+		}
+		if(threads > count)
+		{
+			threads = unsigned(count);
+		}
+		if(threads > 1)
+		{
+			std::atomic<std::size_t> next(0);
+			std::vector<std::thread> workers;
+			std::vector<std::exception_ptr> errors(threads);
+			workers.reserve(threads);
+
+			try
+			{
+				for(unsigned t=0; t!=threads; ++t)
+				{
+					std::exception_ptr& error = errors[t];
+
+					workers.push_back(std::thread(
+						[=, &func, &next, &error](void)
+						{
+							try
+							{
+								std::size_t i;
+								while((i = next++) < count)
+								{
+									func(Tile(i, width, height));
+								}
+							}
+							catch(...)
+							{
+								error = std::current_exception();
+								next = count;
+							}
+						}
+					));
+				}
+			}
+			catch(...)
+			{
+				// starting a thread failed, stop and join
+				// the already started workers before leaving
+				next = count;
+				for(std::thread& worker : workers)
+				{
+					worker.join();
+				}
+				throw;
+			}
+			for(std::thread& worker : workers)
+			{
+				worker.join();
+			}
+			for(std::exception_ptr& error : errors)
+			{
+				if(error) std::rethrow_exception(error);
+			}
+			return;
+		}
+#endif
+		for(std::size_t i=0; i!=count; ++i)
+		{
+			func(Tile(i, width, height));
+		}
+	}
+};
+
+} // images
+} // oglplus
+
+#endif // include guard
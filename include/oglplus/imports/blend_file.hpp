@@ -25,6 +25,10 @@
 #include <oglplus/imports/blend_file/flattened.hpp>
 #include <oglplus/imports/blend_file/block_data.hpp>
 #include <oglplus/imports/blend_file/struct_block_data.hpp>
+#include <oglplus/imports/blend_file/mapped_input.hpp>
+#include <memory>
+#include <vector>
+#include <utility>
 #include <cstring>
 
 namespace oglplus {
@@ -49,6 +53,12 @@ public:
 
 /// Represents and allows access to the structures and data of a .blend file
 /**
+ *  A BlendFile can either parse a .blend file from an input stream,
+ *  in which case the data of the blocks are read from the stream (and copied)
+ *  each time they are accessed, or it can memory-map the file. In the latter
+ *  case the block data are non-owning views of the mapped file and only
+ *  the values which are actually used are byte-swapped if necessary.
+ *
  *  @note The objects representing blocks, structures, structure fields, etc.
  *  created directly or indirectly from a BlendFile instance must not be used
  *  after their "parent" BlendFile is destroyed. Doing so results in undefined
@@ -58,12 +68,31 @@ class BlendFile
  : public BlendFileReaderClient
 {
 private:
+	std::unique_ptr<BlendFileMappedInput> _mapped;
+
 	BlendFileReader _reader;
 
 	BlendFileInfo _info;
 
 	std::vector<BlendFileBlock> _blocks;
-	std::map<BlendFilePointer::ValueType, std::size_t> _block_map;
+
+	// (pointer, block index) pairs sorted by the pointer value
+	typedef std::pair<BlendFilePointer::ValueType, std::size_t> _block_ref;
+	std::vector<_block_ref> _block_index;
+
+	struct _block_ref_less
+	{
+		bool operator()(
+			const _block_ref& a,
+			const _block_ref& b
+		) const
+		{
+			return a.first < b.first;
+		}
+	};
+
+	void _load(void);
+	void _make_block_index(void);
 
 	std::size_t _glob_block_index;
 
@@ -84,6 +113,21 @@ public:
 	 */
 	BlendFile(std::istream& input);
 
+	/// Memory-maps and parses the file at the specified path
+	/**
+	 *  On systems where memory-mapping is not supported the whole file
+	 *  is read into memory.
+	 *
+	 *  @throws std::runtime_error if the file cannot be opened or parsed.
+	 */
+	BlendFile(const char* path);
+
+	/// Returns true if the block data are accessed in the mapped file
+	bool IsMapped(void) const
+	{
+		return bool(_mapped);
+	}
+
 	/// Returns the basic file-level information
 	const BlendFileInfo& Info(void) const
 	{
@@ -14,6 +14,7 @@
 #define OGLPLUS_IMPORTS_BLEND_FILE_BLOCK_DATA_1107121519_HPP
 
 #include <oglplus/imports/blend_file/visitor.hpp>
+#include <cstring>
 
 namespace oglplus {
 namespace imports {
@@ -22,10 +23,12 @@ namespace imports {
 class BlendFileBlockData
 {
 private:
-	// TODO: some kind of caching in BlendFile or BlendFileBlock
-	// and only a reference to the buffer here
-	// to make this class more lightweight
+	// the block data owned by this object if they were read from a stream
 	std::vector<char> _block_data;
+	// the start and the size of the data (either in _block_data
+	// or a non-owning view of a memory-mapped file)
+	const char* _data;
+	std::size_t _size;
 	Endian _byte_order;
 	std::size_t _ptr_size;
 	std::size_t _struct_size;
@@ -37,12 +40,37 @@ private:
 		Endian byte_order,
 		std::size_t ptr_size,
 		std::size_t struct_size
-	): _block_data(block_data)
+	): _block_data(std::move(block_data))
+	 , _data(_block_data.data())
+	 , _size(_block_data.size())
 	 , _byte_order(byte_order)
 	 , _ptr_size(ptr_size)
 	 , _struct_size(struct_size)
 	{ }
 
+	BlendFileBlockData(
+		const char* data,
+		std::size_t size,
+		Endian byte_order,
+		std::size_t ptr_size,
+		std::size_t struct_size
+	): _data(data)
+	 , _size(size)
+	 , _byte_order(byte_order)
+	 , _ptr_size(ptr_size)
+	 , _struct_size(struct_size)
+	{ }
+
+	// reads a value of the specified type from the data
+	// (the data are not necessarily aligned)
+	template <typename T>
+	static T _read(const char* pos)
+	{
+		T result;
+		std::memcpy(&result, pos, sizeof(T));
+		return result;
+	}
+
 	template <unsigned Level>
 	BlendFilePointerTpl<Level> _do_make_pointer(
 		const char* pos,
@@ -67,7 +95,9 @@ private:
 	) const;
 public:
 	BlendFileBlockData(BlendFileBlockData&& tmp)
-	 : _block_data(tmp._block_data)
+	 : _block_data(std::move(tmp._block_data))
+	 , _data(tmp._data)
+	 , _size(tmp._size)
 	 , _byte_order(tmp._byte_order)
 	 , _ptr_size(tmp._ptr_size)
 	 , _struct_size(tmp._struct_size)
@@ -76,20 +106,20 @@ public:
 	/// Returns the raw data of the block
 	const char* RawData(void) const
 	{
-		return _block_data.data();
+		return _data;
 	}
 
 	/// Returns the i-th byte in the block
 	char RawByte(std::size_t i) const
 	{
-		assert(i < _block_data.size());
-		return _block_data[i];
+		assert(i < _size);
+		return _data[i];
 	}
 
 	/// returns the size (in bytes) of the raw data
 	std::size_t DataSize(void) const
 	{
-		return _block_data.size();
+		return _size;
 	}
 
 	/// Returns a pointer at the specified index
@@ -125,15 +155,12 @@ public:
 	) const
 	{
 		const char* pos =
-			_block_data.data() +
+			_data +
 			data_offset +
 			block_element * _struct_size +
 			field_element * sizeof(Int) +
 			field_offset;
-		return aux::ReorderToNative(
-			_byte_order,
-			*reinterpret_cast<const Int*>(pos)
-		);
+		return aux::ReorderToNative(_byte_order, _read<Int>(pos));
 	}
 
 	/// Returns the value of the specified field as an integer
@@ -164,12 +191,12 @@ public:
 	) const
 	{
 		const char* pos =
-			_block_data.data() +
+			_data +
 			data_offset +
 			block_element * _struct_size +
 			field_element * sizeof(Float) +
 			field_offset;
-		return *reinterpret_cast<const Float*>(pos);
+		return aux::ReorderToNative(_byte_order, _read<Float>(pos));
 	}
 
 	/// Returns the value of the specified field as a floating point value
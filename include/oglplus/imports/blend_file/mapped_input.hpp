@@ -0,0 +1,113 @@
+/**
+ *  @file oglplus/imports/blend_file/mapped_input.hpp
+ *  @brief Helper class for reading memory-mapped .blend files
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_IMPORTS_BLEND_FILE_MAPPED_INPUT_1509181207_HPP
+#define OGLPLUS_IMPORTS_BLEND_FILE_MAPPED_INPUT_1509181207_HPP
+
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/utils/mapped_file.hpp>
+
+#include <streambuf>
+#include <istream>
+#include <stdexcept>
+#include <cstddef>
+
+namespace oglplus {
+namespace imports {
+
+// Internal helper class used for .blend file read operations
+// Maps a file into memory and provides a seekable input stream
+// reading from the mapped memory, so that the parser can be used
+// unchanged while the block data are accessed directly
+// NOTE: implementation detail, do not use
+class BlendFileMappedInput
+ : public std::streambuf
+{
+private:
+	aux::MappedFile _file;
+	std::istream _input;
+
+	BlendFileMappedInput(const BlendFileMappedInput&);
+protected:
+	pos_type seekoff(
+		off_type off,
+		std::ios_base::seekdir dir,
+		std::ios_base::openmode which
+	) OGLPLUS_OVERRIDE
+	{
+		if(!(which & std::ios_base::in))
+		{
+			return pos_type(off_type(-1));
+		}
+		const off_type size = egptr()-eback();
+		off_type pos = off;
+		if(dir == std::ios_base::cur) pos += gptr()-eback();
+		else if(dir == std::ios_base::end) pos += size;
+
+		if((pos < 0) || (pos > size))
+		{
+			return pos_type(off_type(-1));
+		}
+		setg(eback(), eback()+pos, egptr());
+		return pos_type(pos);
+	}
+
+	pos_type seekpos(
+		pos_type pos,
+		std::ios_base::openmode which
+	) OGLPLUS_OVERRIDE
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	}
+public:
+	BlendFileMappedInput(const char* path)
+	 : _file(path)
+	 , _input(this)
+	{
+		if(!_file.IsOpen())
+		{
+			throw std::runtime_error("Failed to open blend file");
+		}
+		// the get area is only read from
+		char* begin = const_cast<char*>(_file.Begin());
+		setg(begin, begin, begin+_file.Size());
+	}
+
+	// the input stream reading the mapped file
+	std::istream& Input(void)
+	{
+		return _input;
+	}
+
+	// returns true if the file is actually memory-mapped
+	bool IsMapped(void) const
+	{
+		return _file.IsMapped();
+	}
+
+	// pointer to the start of the file content
+	const char* Data(void) const
+	{
+		return _file.Begin();
+	}
+
+	// the size of the file in bytes
+	std::size_t Size(void) const
+	{
+		return _file.Size();
+	}
+};
+
+} // imports
+} // oglplus
+
+#endif // include guard
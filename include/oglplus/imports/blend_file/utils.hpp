@@ -13,6 +13,7 @@
 #ifndef OGLPLUS_IMPORTS_BLEND_FILE_UTILS_1107121519_HPP
 #define OGLPLUS_IMPORTS_BLEND_FILE_UTILS_1107121519_HPP
 
+#include <ios>
 #include <cstddef>
 
 namespace oglplus {
@@ -18,6 +18,8 @@
 #endif
 
 #include <oglplus/images/load.hpp>
+#include <oglplus/images/async_load.hpp>
+#include <oglplus/images/frame_writer.hpp>
 
 #undef OGLPLUS_IMPLEMENTING_LIBRARY
 
@@ -0,0 +1,455 @@
+/**
+ *  @file oglplus/math/batch.hpp
+ *  @brief Functions transforming arrays of vectors and matrices
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_MATH_BATCH_1509231127_HPP
+#define OGLPLUS_MATH_BATCH_1509231127_HPP
+
+#include <oglplus/math/matrix.hpp>
+#include <oglplus/math/kernels.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace oglplus {
+namespace aux {
+
+// The batch functions write the results directly into the storage
+// of the output matrices, which is a plain array of Rows*Cols values
+template <typename T, std::size_t R, std::size_t C>
+inline T* MatrixBatchData(Matrix<T, R, C>* m)
+{
+	static_assert(
+		sizeof(Matrix<T, R, C>) == sizeof(T[R*C]),
+		"Unexpected matrix storage layout"
+	);
+	return reinterpret_cast<T*>(m);
+}
+
+// The number of vectors transformed at once by the batch functions
+static const std::size_t VectorBatchBlockSize = 64;
+
+} // namespace aux
+
+/// A batch of N-component vectors stored in structure-of-arrays layout
+/** The components are stored in a single contiguous array, all
+ *  x components first, then all y components, etc. This layout allows
+ *  to process several vectors at once and the storage can be passed
+ *  directly to Buffer::Data and used as several vertex attribute arrays
+ *  (see ComponentOffset).
+ *
+ *  @ingroup math_utils
+ */
+template <typename T, std::size_t N>
+class VectorBatch
+{
+private:
+	std::vector<T> _data;
+	std::size_t _count;
+public:
+	/// Constructs a batch of @p count zero vectors
+	VectorBatch(std::size_t count)
+	 : _data(count*N, T(0))
+	 , _count(count)
+	{ }
+
+	/// Constructs a batch from @p count vectors at @p v
+	VectorBatch(const Vector<T, N>* v, std::size_t count)
+	 : _data(count*N)
+	 , _count(count)
+	{
+		Scatter(v);
+	}
+
+	/// Constructs a batch from a vector of Vectors
+	VectorBatch(const std::vector<Vector<T, N>>& v)
+	 : _data(v.size()*N)
+	 , _count(v.size())
+	{
+		Scatter(v.data());
+	}
+
+	/// Returns the number of vectors in this batch
+	std::size_t Count(void) const
+	{
+		return _count;
+	}
+
+	/// Returns a pointer to the c-th components of all vectors
+	T* Component(std::size_t c)
+	{
+		assert(c < N);
+		return _data.data()+c*_count;
+	}
+
+	/// Returns a const pointer to the c-th components of all vectors
+	const T* Component(std::size_t c) const
+	{
+		assert(c < N);
+		return _data.data()+c*_count;
+	}
+
+	/// The offset of the c-th component array in bytes
+	std::size_t ComponentOffset(std::size_t c) const
+	{
+		assert(c < N);
+		return c*_count*sizeof(T);
+	}
+
+	/// Returns the whole storage (e.g. for Buffer::Data)
+	const std::vector<T>& Storage(void) const
+	{
+		return _data;
+	}
+
+	/// Returns the i-th vector
+	Vector<T, N> At(std::size_t i) const
+	{
+		assert(i < _count);
+		T v[N];
+		for(std::size_t c=0; c!=N; ++c)
+			v[c] = _data[c*_count+i];
+		return Vector<T, N>(v);
+	}
+
+	/// Sets the i-th vector
+	void Set(std::size_t i, const Vector<T, N>& v)
+	{
+		assert(i < _count);
+		for(std::size_t c=0; c!=N; ++c)
+			_data[c*_count+i] = v.At(c);
+	}
+
+	/// Copies Count() vectors from @p v into this batch
+	void Scatter(const Vector<T, N>* v)
+	{
+		for(std::size_t c=0; c!=N; ++c)
+		{
+			T* d = Component(c);
+			for(std::size_t i=0; i!=_count; ++i)
+				d[i] = v[i].At(c);
+		}
+	}
+
+	/// Copies the vectors from this batch into Count() vectors at @p v
+	void Gather(Vector<T, N>* v) const
+	{
+		for(std::size_t i=0; i!=_count; ++i)
+			v[i] = At(i);
+	}
+};
+
+/// Transforms @p count vectors at @p in by @p m (out[i] = m*in[i])
+/** The input and output arrays may be the same.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformBatch(
+	const Matrix<T, 4, 4>& m,
+	const Vector<T, 4>* in,
+	Vector<T, 4>* out,
+	std::size_t count
+)
+{
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		T t[4];
+		aux::MatrixKernels<T, 4, 4>::Transform(t, m.Data(), in[i].Data());
+		out[i] = Vector<T, 4>(t);
+	}
+}
+
+/// Transforms @p count points at @p in by @p m
+/** The points are extended with a homogeneous coordinate of 1 and
+ *  the transformed x, y, z coordinates are stored in @p out,
+ *  the same as with TransformPoint. The input and output arrays
+ *  may be the same.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformPointBatch(
+	const Matrix<T, 4, 4>& m,
+	const Vector<T, 3>* in,
+	Vector<T, 3>* out,
+	std::size_t count
+)
+{
+	const T* a = m.Data();
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		const T x = in[i].x(), y = in[i].y(), z = in[i].z();
+		out[i] = Vector<T, 3>(
+			a[0]*x + a[1]*y + a[ 2]*z + a[ 3],
+			a[4]*x + a[5]*y + a[ 6]*z + a[ 7],
+			a[8]*x + a[9]*y + a[10]*z + a[11]
+		);
+	}
+}
+
+/// Transforms a batch of points and stores the result at @p out
+/** The @p out array must have room for 3*in.Count() values, which
+ *  are stored in the same layout as in VectorBatch. This can be
+ *  for example the mapped storage of a buffer.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformPointBatch(
+	const Matrix<T, 4, 4>& m,
+	const VectorBatch<T, 3>& in,
+	T* out
+)
+{
+	const std::size_t n = in.Count();
+	const T* a = m.Data();
+	const T* x = in.Component(0);
+	const T* y = in.Component(1);
+	const T* z = in.Component(2);
+	T* ox = out+0*n;
+	T* oy = out+1*n;
+	T* oz = out+2*n;
+
+	const T
+		m00 = a[0], m01 = a[1], m02 = a[ 2], m03 = a[ 3],
+		m10 = a[4], m11 = a[5], m12 = a[ 6], m13 = a[ 7],
+		m20 = a[8], m21 = a[9], m22 = a[10], m23 = a[11];
+
+	// the results are computed into small local blocks which cannot
+	// alias the input, so that the compiler can vectorize the loop,
+	// and copied to the output afterwards (this also allows in==out)
+	const std::size_t bs = aux::VectorBatchBlockSize;
+	T rx[bs], ry[bs], rz[bs];
+	for(std::size_t b=0; b<n; b+=bs)
+	{
+		const std::size_t k = (n-b < bs)?n-b:bs;
+		for(std::size_t i=0; i!=k; ++i)
+		{
+			const T vx = x[b+i], vy = y[b+i], vz = z[b+i];
+			rx[i] = m00*vx + m01*vy + m02*vz + m03;
+			ry[i] = m10*vx + m11*vy + m12*vz + m13;
+			rz[i] = m20*vx + m21*vy + m22*vz + m23;
+		}
+		std::copy(rx, rx+k, ox+b);
+		std::copy(ry, ry+k, oy+b);
+		std::copy(rz, rz+k, oz+b);
+	}
+}
+
+/// Transforms a batch of points by @p m
+/**
+ *  @pre in.Count() == out.Count()
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformPointBatch(
+	const Matrix<T, 4, 4>& m,
+	const VectorBatch<T, 3>& in,
+	VectorBatch<T, 3>& out
+)
+{
+	assert(in.Count() == out.Count());
+	TransformPointBatch(m, in, out.Component(0));
+}
+
+/// Transforms a batch of 4-component vectors by @p m
+/**
+ *  @pre in.Count() == out.Count()
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransformBatch(
+	const Matrix<T, 4, 4>& m,
+	const VectorBatch<T, 4>& in,
+	VectorBatch<T, 4>& out
+)
+{
+	assert(in.Count() == out.Count());
+	const std::size_t n = in.Count();
+	const T* a = m.Data();
+	const T* x = in.Component(0);
+	const T* y = in.Component(1);
+	const T* z = in.Component(2);
+	const T* w = in.Component(3);
+	T* ox = out.Component(0);
+	T* oy = out.Component(1);
+	T* oz = out.Component(2);
+	T* ow = out.Component(3);
+
+	const T
+		m00 = a[ 0], m01 = a[ 1], m02 = a[ 2], m03 = a[ 3],
+		m10 = a[ 4], m11 = a[ 5], m12 = a[ 6], m13 = a[ 7],
+		m20 = a[ 8], m21 = a[ 9], m22 = a[10], m23 = a[11],
+		m30 = a[12], m31 = a[13], m32 = a[14], m33 = a[15];
+
+	const std::size_t bs = aux::VectorBatchBlockSize;
+	T rx[bs], ry[bs], rz[bs], rw[bs];
+	for(std::size_t b=0; b<n; b+=bs)
+	{
+		const std::size_t k = (n-b < bs)?n-b:bs;
+		for(std::size_t i=0; i!=k; ++i)
+		{
+			const T vx = x[b+i], vy = y[b+i], vz = z[b+i], vw = w[b+i];
+			rx[i] = m00*vx + m01*vy + m02*vz + m03*vw;
+			ry[i] = m10*vx + m11*vy + m12*vz + m13*vw;
+			rz[i] = m20*vx + m21*vy + m22*vz + m23*vw;
+			rw[i] = m30*vx + m31*vy + m32*vz + m33*vw;
+		}
+		std::copy(rx, rx+k, ox+b);
+		std::copy(ry, ry+k, oy+b);
+		std::copy(rz, rz+k, oz+b);
+		std::copy(rw, rw+k, ow+b);
+	}
+}
+
+/// Multiplies @p count pairs of matrices (out[i] = a[i]*b[i])
+/** The output array must not overlap with the input arrays.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void MultiplyBatch(
+	const Matrix<T, 4, 4>* a,
+	const Matrix<T, 4, 4>* b,
+	Matrix<T, 4, 4>* out,
+	std::size_t count
+)
+{
+	assert(out != a && out != b);
+	T* t = aux::MatrixBatchData(out);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		aux::MatrixMultiplyKernel<T, 4, 4, 4>::Apply(
+			t+i*16,
+			a[i].Data(),
+			b[i].Data()
+		);
+	}
+}
+
+/// Multiplies @p count matrices from the left by @p a (out[i] = a*b[i])
+/** The output array must not overlap with the input array.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void MultiplyBatch(
+	const Matrix<T, 4, 4>& a,
+	const Matrix<T, 4, 4>* b,
+	Matrix<T, 4, 4>* out,
+	std::size_t count
+)
+{
+	assert(out != b);
+	T* t = aux::MatrixBatchData(out);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		aux::MatrixMultiplyKernel<T, 4, 4, 4>::Apply(
+			t+i*16,
+			a.Data(),
+			b[i].Data()
+		);
+	}
+}
+
+/// Multiplies @p count matrices from the right by @p b (out[i] = a[i]*b)
+/** The output array must not overlap with the input array.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void MultiplyBatch(
+	const Matrix<T, 4, 4>* a,
+	const Matrix<T, 4, 4>& b,
+	Matrix<T, 4, 4>* out,
+	std::size_t count
+)
+{
+	assert(out != a);
+	T* t = aux::MatrixBatchData(out);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		aux::MatrixMultiplyKernel<T, 4, 4, 4>::Apply(
+			t+i*16,
+			a[i].Data(),
+			b.Data()
+		);
+	}
+}
+
+/// Transposes @p count matrices at @p in (out[i] = Transposed(in[i]))
+/** This is useful for converting the row-major matrices into
+ *  the column-major layout expected by GLSL before uploading them
+ *  into a buffer. The output array must not overlap with the input.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void TransposeBatch(
+	const Matrix<T, 4, 4>* in,
+	Matrix<T, 4, 4>* out,
+	std::size_t count
+)
+{
+	assert(out != in);
+	T* t = aux::MatrixBatchData(out);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		aux::MatrixKernels<T, 4, 4>::Transpose(t+i*16, in[i].Data());
+	}
+}
+
+/// Composes the local transformations of a hierarchy into world transforms
+/** The nodes of the hierarchy must be ordered so that each parent precedes
+ *  its children, i.e. @c parent[i] @c <= @c i. The root nodes are
+ *  their own parents (@c parent[i] @c == @c i). For the root nodes
+ *  @c world[i] is @c local[i], for the other nodes it is
+ *  @c world[parent[i]]*local[i]. The @p world array must not overlap
+ *  with @p local.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline void ComposeHierarchy(
+	const Matrix<T, 4, 4>* local,
+	const std::size_t* parent,
+	Matrix<T, 4, 4>* world,
+	std::size_t count
+)
+{
+	assert(world != local);
+	T* t = aux::MatrixBatchData(world);
+	for(std::size_t i=0; i!=count; ++i)
+	{
+		assert(parent[i] <= i);
+		if(parent[i] == i)
+		{
+			world[i] = local[i];
+		}
+		else
+		{
+			aux::MatrixMultiplyKernel<T, 4, 4, 4>::Apply(
+				t+i*16,
+				t+parent[i]*16,
+				local[i].Data()
+			);
+		}
+	}
+}
+
+} // namespace oglplus
+
+#endif // include guard
@@ -0,0 +1,188 @@
+/**
+ *  @file oglplus/math/kernels.hpp
+ *  @brief Computational kernels of the vector, matrix and quaternion classes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_MATH_KERNELS_1509211032_HPP
+#define OGLPLUS_MATH_KERNELS_1509211032_HPP
+
+#include <oglplus/config/simd.hpp>
+
+#include <cstddef>
+
+namespace oglplus {
+namespace aux {
+
+// Generic multiplication of a RxN and a NxC matrix in row-major order
+template <typename T, std::size_t R, std::size_t N, std::size_t C>
+struct MatrixMultiplyKernel
+{
+	static void Apply(T* t, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=R; ++i)
+		for(std::size_t j=0; j!=C; ++j)
+		{
+			t[i*C+j] = a[i*N+0]*b[0*C+j];
+			for(std::size_t k=1; k!=N; ++k)
+			{
+				t[i*C+j] += a[i*N+k]*b[k*C+j];
+			}
+		}
+	}
+};
+
+// Generic matrix kernels operating on RxC matrices in row-major order
+template <typename T, std::size_t R, std::size_t C>
+struct MatrixKernels
+{
+	// t(RxC) = transposed a(CxR)
+	static void Transpose(T* t, const T* a)
+	{
+		for(std::size_t i=0; i!=R; ++i)
+		for(std::size_t j=0; j!=C; ++j)
+			t[i*C+j] = a[j*R+i];
+	}
+
+	// t(R) = m(RxC) * v(C)
+	static void Transform(T* t, const T* m, const T* v)
+	{
+		for(std::size_t i=0; i!=R; ++i)
+		{
+			t[i] = T(0);
+			for(std::size_t j=0; j!=C; ++j)
+			{
+				t[i] += m[i*C+j] * v[j];
+			}
+		}
+	}
+
+	// t(C) = v(R) * m(RxC)
+	static void TransformRow(T* t, const T* v, const T* m)
+	{
+		for(std::size_t j=0; j!=C; ++j)
+		{
+			t[j] = T(0);
+			for(std::size_t i=0; i!=R; ++i)
+			{
+				t[j] += v[i] * m[i*C+j];
+			}
+		}
+	}
+};
+
+// Generic kernels operating on 4-component vectors
+template <typename T>
+struct Vector4Kernels
+{
+	static void Negate(T* t, const T* a)
+	{
+		for(std::size_t i=0; i!=4; ++i) t[i] = -a[i];
+	}
+
+	static void Add(T* t, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=4; ++i) t[i] = a[i]+b[i];
+	}
+
+	static void Subtract(T* t, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=4; ++i) t[i] = a[i]-b[i];
+	}
+
+	static void Multiply(T* t, const T* a, const T* b)
+	{
+		for(std::size_t i=0; i!=4; ++i) t[i] = a[i]*b[i];
+	}
+
+	static void Multiply(T* t, const T* a, T v)
+	{
+		for(std::size_t i=0; i!=4; ++i) t[i] = a[i]*v;
+	}
+
+	static void Divide(T* t, const T* a, T v)
+	{
+		for(std::size_t i=0; i!=4; ++i) t[i] = a[i]/v;
+	}
+
+	static T Dot(const T* a, const T* b)
+	{
+		return a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+	}
+};
+
+// Generic multiplication of quaternions stored as (a, x, y, z)
+template <typename T>
+struct QuaternionKernels
+{
+	static void Multiply(T* t, const T* p, const T* q)
+	{
+		t[0] = p[0]*q[0] - p[1]*q[1] - p[2]*q[2] - p[3]*q[3];
+		t[1] = p[0]*q[1] + p[1]*q[0] + p[2]*q[3] - p[3]*q[2];
+		t[2] = p[0]*q[2] - p[1]*q[3] + p[2]*q[0] + p[3]*q[1];
+		t[3] = p[0]*q[3] + p[1]*q[2] - p[2]*q[1] + p[3]*q[0];
+	}
+};
+
+// Generic kernels operating on 4x4 matrices in row-major order
+template <typename T>
+struct Matrix4x4Kernels
+{
+	// inverse of an affine transformation with (0, 0, 0, 1) in the last row
+	static bool InverseAffine(T* t, const T* a)
+	{
+		// the columns of the adjugate of the upper-left 3x3 matrix
+		const T c0[3] = {
+			a[5]*a[10]-a[6]*a[9],
+			a[6]*a[8]-a[4]*a[10],
+			a[4]*a[9]-a[5]*a[8]
+		};
+		const T c1[3] = {
+			a[9]*a[2]-a[10]*a[1],
+			a[10]*a[0]-a[8]*a[2],
+			a[8]*a[1]-a[9]*a[0]
+		};
+		const T c2[3] = {
+			a[1]*a[6]-a[2]*a[5],
+			a[2]*a[4]-a[0]*a[6],
+			a[0]*a[5]-a[1]*a[4]
+		};
+		const T det = a[0]*c0[0]+a[1]*c0[1]+a[2]*c0[2];
+		if(det == T(0)) return false;
+		const T id = T(1)/det;
+
+		for(std::size_t i=0; i!=3; ++i)
+		{
+			t[i*4+0] = c0[i]*id;
+			t[i*4+1] = c1[i]*id;
+			t[i*4+2] = c2[i]*id;
+			t[i*4+3] = -(
+				t[i*4+0]*a[3]+
+				t[i*4+1]*a[7]+
+				t[i*4+2]*a[11]
+			);
+		}
+		t[12] = T(0);
+		t[13] = T(0);
+		t[14] = T(0);
+		t[15] = T(1);
+		return true;
+	}
+};
+
+} // namespace aux
+} // namespace oglplus
+
+#if OGLPLUS_MATH_SSE
+#include <oglplus/math/kernels_sse.ipp>
+#elif OGLPLUS_MATH_NEON
+#include <oglplus/math/kernels_neon.ipp>
+#endif
+
+#endif // include guard
@@ -0,0 +1,140 @@
+/**
+ *  .file oglplus/math/kernels_neon.ipp
+ *  .brief NEON (AArch64) specializations of the math kernels for float
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <arm_neon.h>
+
+namespace oglplus {
+namespace aux {
+
+template <>
+struct MatrixMultiplyKernel<float, 4, 4, 4>
+{
+	static void Apply(float* t, const float* a, const float* b)
+	{
+		const float32x4_t b0 = vld1q_f32(b+ 0);
+		const float32x4_t b1 = vld1q_f32(b+ 4);
+		const float32x4_t b2 = vld1q_f32(b+ 8);
+		const float32x4_t b3 = vld1q_f32(b+12);
+
+		for(std::size_t i=0; i!=16; i+=4)
+		{
+			const float32x4_t ai = vld1q_f32(a+i);
+			float32x4_t r = vmulq_laneq_f32(b0, ai, 0);
+			r = vfmaq_laneq_f32(r, b1, ai, 1);
+			r = vfmaq_laneq_f32(r, b2, ai, 2);
+			r = vfmaq_laneq_f32(r, b3, ai, 3);
+			vst1q_f32(t+i, r);
+		}
+	}
+};
+
+template <>
+struct MatrixKernels<float, 4, 4>
+{
+	static void Transpose(float* t, const float* a)
+	{
+		// the de-interleaving load returns the columns
+		const float32x4x4_t c = vld4q_f32(a);
+		vst1q_f32(t+ 0, c.val[0]);
+		vst1q_f32(t+ 4, c.val[1]);
+		vst1q_f32(t+ 8, c.val[2]);
+		vst1q_f32(t+12, c.val[3]);
+	}
+
+	static void Transform(float* t, const float* m, const float* v)
+	{
+		const float32x4x4_t c = vld4q_f32(m);
+		const float32x4_t vv = vld1q_f32(v);
+		float32x4_t r = vmulq_laneq_f32(c.val[0], vv, 0);
+		r = vfmaq_laneq_f32(r, c.val[1], vv, 1);
+		r = vfmaq_laneq_f32(r, c.val[2], vv, 2);
+		r = vfmaq_laneq_f32(r, c.val[3], vv, 3);
+		vst1q_f32(t, r);
+	}
+
+	static void TransformRow(float* t, const float* v, const float* m)
+	{
+		const float32x4_t vv = vld1q_f32(v);
+		float32x4_t r = vmulq_laneq_f32(vld1q_f32(m+ 0), vv, 0);
+		r = vfmaq_laneq_f32(r, vld1q_f32(m+ 4), vv, 1);
+		r = vfmaq_laneq_f32(r, vld1q_f32(m+ 8), vv, 2);
+		r = vfmaq_laneq_f32(r, vld1q_f32(m+12), vv, 3);
+		vst1q_f32(t, r);
+	}
+};
+
+template <>
+struct Vector4Kernels<float>
+{
+	static void Negate(float* t, const float* a)
+	{
+		vst1q_f32(t, vnegq_f32(vld1q_f32(a)));
+	}
+
+	static void Add(float* t, const float* a, const float* b)
+	{
+		vst1q_f32(t, vaddq_f32(vld1q_f32(a), vld1q_f32(b)));
+	}
+
+	static void Subtract(float* t, const float* a, const float* b)
+	{
+		vst1q_f32(t, vsubq_f32(vld1q_f32(a), vld1q_f32(b)));
+	}
+
+	static void Multiply(float* t, const float* a, const float* b)
+	{
+		vst1q_f32(t, vmulq_f32(vld1q_f32(a), vld1q_f32(b)));
+	}
+
+	static void Multiply(float* t, const float* a, float v)
+	{
+		vst1q_f32(t, vmulq_n_f32(vld1q_f32(a), v));
+	}
+
+	static void Divide(float* t, const float* a, float v)
+	{
+		vst1q_f32(t, vdivq_f32(vld1q_f32(a), vdupq_n_f32(v)));
+	}
+
+	static float Dot(const float* a, const float* b)
+	{
+		return vaddvq_f32(vmulq_f32(vld1q_f32(a), vld1q_f32(b)));
+	}
+};
+
+template <>
+struct QuaternionKernels<float>
+{
+	static void Multiply(float* t, const float* p, const float* q)
+	{
+		static const float sx[4] = {-1.f, 1.f,-1.f, 1.f};
+		static const float sy[4] = {-1.f, 1.f, 1.f,-1.f};
+		static const float sz[4] = {-1.f,-1.f, 1.f, 1.f};
+
+		const float32x4_t vp = vld1q_f32(p);
+		const float32x4_t vq = vld1q_f32(q);
+		// (q.x, q.a, q.z, q.y)
+		const float32x4_t qx = vrev64q_f32(vq);
+		// (q.y, q.z, q.a, q.x)
+		const float32x4_t qy = vextq_f32(vq, vq, 2);
+		// (q.z, q.y, q.x, q.a)
+		const float32x4_t qz = vrev64q_f32(qy);
+
+		float32x4_t r = vmulq_laneq_f32(vq, vp, 0);
+		r = vfmaq_laneq_f32(r, vmulq_f32(qx, vld1q_f32(sx)), vp, 1);
+		r = vfmaq_laneq_f32(r, vmulq_f32(qy, vld1q_f32(sy)), vp, 2);
+		r = vfmaq_laneq_f32(r, vmulq_f32(qz, vld1q_f32(sz)), vp, 3);
+		vst1q_f32(t, r);
+	}
+};
+
+} // namespace aux
+} // namespace oglplus
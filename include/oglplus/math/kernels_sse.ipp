@@ -0,0 +1,368 @@
+/**
+ *  .file oglplus/math/kernels_sse.ipp
+ *  .brief SSE specializations of the math kernels for float
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include <xmmintrin.h>
+
+namespace oglplus {
+namespace aux {
+
+// Helper functions for the SSE kernels
+struct SSEKernelUtils
+{
+	// (v[X], v[Y], v[Z], v[W])
+	template <int X, int Y, int Z, int W>
+	static __m128 Swizzle(__m128 v)
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	// (a[X], a[Y], b[Z], b[W])
+	template <int X, int Y, int Z, int W>
+	static __m128 Shuffle(__m128 a, __m128 b)
+	{
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	// (v[I], v[I], v[I], v[I])
+	template <int I>
+	static __m128 Splat(__m128 v)
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+	}
+
+	// the sum of the elements of v in each element
+	static __m128 HorizontalSum(__m128 v)
+	{
+		v = _mm_add_ps(v, Swizzle<2, 3, 0, 1>(v));
+		return _mm_add_ps(v, Swizzle<1, 0, 3, 2>(v));
+	}
+
+	// the linear combination of the rows of a 4x4 matrix
+	static __m128 Combine(
+		__m128 v,
+		__m128 r0,
+		__m128 r1,
+		__m128 r2,
+		__m128 r3
+	)
+	{
+		return _mm_add_ps(
+			_mm_add_ps(
+				_mm_mul_ps(Splat<0>(v), r0),
+				_mm_mul_ps(Splat<1>(v), r1)
+			),
+			_mm_add_ps(
+				_mm_mul_ps(Splat<2>(v), r2),
+				_mm_mul_ps(Splat<3>(v), r3)
+			)
+		);
+	}
+};
+
+template <>
+struct MatrixMultiplyKernel<float, 4, 4, 4>
+{
+	static void Apply(float* t, const float* a, const float* b)
+	{
+		typedef SSEKernelUtils U;
+		const __m128 b0 = _mm_loadu_ps(b+ 0);
+		const __m128 b1 = _mm_loadu_ps(b+ 4);
+		const __m128 b2 = _mm_loadu_ps(b+ 8);
+		const __m128 b3 = _mm_loadu_ps(b+12);
+
+		for(std::size_t i=0; i!=16; i+=4)
+		{
+			const __m128 ai = _mm_loadu_ps(a+i);
+			_mm_storeu_ps(t+i, U::Combine(ai, b0, b1, b2, b3));
+		}
+	}
+};
+
+template <>
+struct MatrixKernels<float, 4, 4>
+{
+	static void Transpose(float* t, const float* a)
+	{
+		__m128 r0 = _mm_loadu_ps(a+ 0);
+		__m128 r1 = _mm_loadu_ps(a+ 4);
+		__m128 r2 = _mm_loadu_ps(a+ 8);
+		__m128 r3 = _mm_loadu_ps(a+12);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(t+ 0, r0);
+		_mm_storeu_ps(t+ 4, r1);
+		_mm_storeu_ps(t+ 8, r2);
+		_mm_storeu_ps(t+12, r3);
+	}
+
+	static void Transform(float* t, const float* m, const float* v)
+	{
+		const __m128 vv = _mm_loadu_ps(v);
+		__m128 p0 = _mm_mul_ps(_mm_loadu_ps(m+ 0), vv);
+		__m128 p1 = _mm_mul_ps(_mm_loadu_ps(m+ 4), vv);
+		__m128 p2 = _mm_mul_ps(_mm_loadu_ps(m+ 8), vv);
+		__m128 p3 = _mm_mul_ps(_mm_loadu_ps(m+12), vv);
+		// the transposition turns the row sums into column sums
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		_mm_storeu_ps(
+			t,
+			_mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3))
+		);
+	}
+
+	static void TransformRow(float* t, const float* v, const float* m)
+	{
+		typedef SSEKernelUtils U;
+		_mm_storeu_ps(t, U::Combine(
+			_mm_loadu_ps(v),
+			_mm_loadu_ps(m+ 0),
+			_mm_loadu_ps(m+ 4),
+			_mm_loadu_ps(m+ 8),
+			_mm_loadu_ps(m+12)
+		));
+	}
+};
+
+template <>
+struct Vector4Kernels<float>
+{
+	static void Negate(float* t, const float* a)
+	{
+		_mm_storeu_ps(t, _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(a)));
+	}
+
+	static void Add(float* t, const float* a, const float* b)
+	{
+		_mm_storeu_ps(t, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void Subtract(float* t, const float* a, const float* b)
+	{
+		_mm_storeu_ps(t, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void Multiply(float* t, const float* a, const float* b)
+	{
+		_mm_storeu_ps(t, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	static void Multiply(float* t, const float* a, float v)
+	{
+		_mm_storeu_ps(t, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(v)));
+	}
+
+	static void Divide(float* t, const float* a, float v)
+	{
+		_mm_storeu_ps(t, _mm_div_ps(_mm_loadu_ps(a), _mm_set1_ps(v)));
+	}
+
+	static float Dot(const float* a, const float* b)
+	{
+		typedef SSEKernelUtils U;
+		return _mm_cvtss_f32(U::HorizontalSum(
+			_mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))
+		));
+	}
+};
+
+template <>
+struct QuaternionKernels<float>
+{
+	static void Multiply(float* t, const float* p, const float* q)
+	{
+		typedef SSEKernelUtils U;
+		const __m128 vp = _mm_loadu_ps(p);
+		const __m128 vq = _mm_loadu_ps(q);
+
+		// p.a*(q.a, q.x, q.y, q.z)
+		__m128 r = _mm_mul_ps(U::Splat<0>(vp), vq);
+		// p.x*(-q.x, q.a, -q.z, q.y)
+		r = _mm_add_ps(r, _mm_mul_ps(
+			_mm_mul_ps(U::Splat<1>(vp), U::Swizzle<1, 0, 3, 2>(vq)),
+			_mm_setr_ps(-1.f, 1.f,-1.f, 1.f)
+		));
+		// p.y*(-q.y, q.z, q.a, -q.x)
+		r = _mm_add_ps(r, _mm_mul_ps(
+			_mm_mul_ps(U::Splat<2>(vp), U::Swizzle<2, 3, 0, 1>(vq)),
+			_mm_setr_ps(-1.f, 1.f, 1.f,-1.f)
+		));
+		// p.z*(-q.z, -q.y, q.x, q.a)
+		r = _mm_add_ps(r, _mm_mul_ps(
+			_mm_mul_ps(U::Splat<3>(vp), U::Swizzle<3, 2, 1, 0>(vq)),
+			_mm_setr_ps(-1.f,-1.f, 1.f, 1.f)
+		));
+		_mm_storeu_ps(t, r);
+	}
+};
+
+template <>
+struct Matrix4x4Kernels<float>
+{
+private:
+	typedef SSEKernelUtils U;
+
+	// 2x2 matrix (stored in a single vector) product a*b
+	static __m128 _mat2_mul(__m128 a, __m128 b)
+	{
+		return _mm_add_ps(
+			_mm_mul_ps(a, U::Swizzle<0, 3, 0, 3>(b)),
+			_mm_mul_ps(
+				U::Swizzle<1, 0, 3, 2>(a),
+				U::Swizzle<2, 1, 2, 1>(b)
+			)
+		);
+	}
+
+	// 2x2 matrix product adj(a)*b
+	static __m128 _mat2_adj_mul(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(U::Swizzle<3, 3, 0, 0>(a), b),
+			_mm_mul_ps(
+				U::Swizzle<1, 1, 2, 2>(a),
+				U::Swizzle<2, 3, 0, 1>(b)
+			)
+		);
+	}
+
+	// 2x2 matrix product a*adj(b)
+	static __m128 _mat2_mul_adj(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(a, U::Swizzle<3, 0, 3, 0>(b)),
+			_mm_mul_ps(
+				U::Swizzle<1, 0, 3, 2>(a),
+				U::Swizzle<2, 1, 2, 1>(b)
+			)
+		);
+	}
+public:
+	// general inverse computed blockwise from the 2x2 submatrices
+	static bool Inverse(float* t, const float* m)
+	{
+		const __m128 r0 = _mm_loadu_ps(m+ 0);
+		const __m128 r1 = _mm_loadu_ps(m+ 4);
+		const __m128 r2 = _mm_loadu_ps(m+ 8);
+		const __m128 r3 = _mm_loadu_ps(m+12);
+
+		// the 2x2 submatrices | A B |
+		//                     | C D |
+		const __m128 A = _mm_movelh_ps(r0, r1);
+		const __m128 B = _mm_movehl_ps(r1, r0);
+		const __m128 C = _mm_movelh_ps(r2, r3);
+		const __m128 D = _mm_movehl_ps(r3, r2);
+
+		// (|A|, |B|, |C|, |D|)
+		const __m128 det_sub = _mm_sub_ps(
+			_mm_mul_ps(
+				U::Shuffle<0, 2, 0, 2>(r0, r2),
+				U::Shuffle<1, 3, 1, 3>(r1, r3)
+			),
+			_mm_mul_ps(
+				U::Shuffle<1, 3, 1, 3>(r0, r2),
+				U::Shuffle<0, 2, 0, 2>(r1, r3)
+			)
+		);
+		const __m128 det_a = U::Splat<0>(det_sub);
+		const __m128 det_b = U::Splat<1>(det_sub);
+		const __m128 det_c = U::Splat<2>(det_sub);
+		const __m128 det_d = U::Splat<3>(det_sub);
+
+		const __m128 d_c = _mat2_adj_mul(D, C);
+		const __m128 a_b = _mat2_adj_mul(A, B);
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, A), _mat2_mul(B, d_c));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, D), _mat2_mul(C, a_b));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, C), _mat2_mul_adj(D, a_b));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, B), _mat2_mul_adj(A, d_c));
+
+		// |M| = |A|*|D| + |B|*|C| - tr(adj(A)*B*adj(D)*C)
+		const __m128 tr = U::HorizontalSum(
+			_mm_mul_ps(a_b, U::Swizzle<0, 2, 1, 3>(d_c))
+		);
+		const __m128 det_m = _mm_sub_ps(
+			_mm_add_ps(
+				_mm_mul_ps(det_a, det_d),
+				_mm_mul_ps(det_b, det_c)
+			),
+			tr
+		);
+		if(_mm_cvtss_f32(det_m) == 0.f) return false;
+
+		const __m128 rdet = _mm_div_ps(
+			_mm_setr_ps(1.f,-1.f,-1.f, 1.f),
+			det_m
+		);
+		x = _mm_mul_ps(x, rdet);
+		y = _mm_mul_ps(y, rdet);
+		z = _mm_mul_ps(z, rdet);
+		w = _mm_mul_ps(w, rdet);
+
+		// apply the adjugate of the 2x2 blocks while storing
+		_mm_storeu_ps(t+ 0, U::Shuffle<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(t+ 4, U::Shuffle<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(t+ 8, U::Shuffle<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(t+12, U::Shuffle<2, 0, 2, 0>(z, w));
+		return true;
+	}
+
+	// inverse of an affine transformation with (0, 0, 0, 1) in the last row
+	static bool InverseAffine(float* t, const float* m)
+	{
+		const __m128 r0 = _mm_loadu_ps(m+ 0);
+		const __m128 r1 = _mm_loadu_ps(m+ 4);
+		const __m128 r2 = _mm_loadu_ps(m+ 8);
+
+		// the columns of the adjugate of the upper-left 3x3 matrix
+		// as cross products of its rows (the last elements are unused)
+		__m128 c0 = _mm_sub_ps(
+			_mm_mul_ps(U::Swizzle<1, 2, 0, 3>(r1), U::Swizzle<2, 0, 1, 3>(r2)),
+			_mm_mul_ps(U::Swizzle<2, 0, 1, 3>(r1), U::Swizzle<1, 2, 0, 3>(r2))
+		);
+		__m128 c1 = _mm_sub_ps(
+			_mm_mul_ps(U::Swizzle<1, 2, 0, 3>(r2), U::Swizzle<2, 0, 1, 3>(r0)),
+			_mm_mul_ps(U::Swizzle<2, 0, 1, 3>(r2), U::Swizzle<1, 2, 0, 3>(r0))
+		);
+		__m128 c2 = _mm_sub_ps(
+			_mm_mul_ps(U::Swizzle<1, 2, 0, 3>(r0), U::Swizzle<2, 0, 1, 3>(r1)),
+			_mm_mul_ps(U::Swizzle<2, 0, 1, 3>(r0), U::Swizzle<1, 2, 0, 3>(r1))
+		);
+
+		const float det =
+			m[0]*_mm_cvtss_f32(c0)+
+			m[1]*_mm_cvtss_f32(U::Splat<1>(c0))+
+			m[2]*_mm_cvtss_f32(U::Splat<2>(c0));
+		if(det == 0.f) return false;
+
+		const __m128 idet = _mm_set1_ps(1.f/det);
+		c0 = _mm_mul_ps(c0, idet);
+		c1 = _mm_mul_ps(c1, idet);
+		c2 = _mm_mul_ps(c2, idet);
+
+		// the negated inverse-transformed translation
+		__m128 c3 = _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(
+			_mm_add_ps(
+				_mm_mul_ps(c0, _mm_set1_ps(m[3])),
+				_mm_mul_ps(c1, _mm_set1_ps(m[7]))
+			),
+			_mm_mul_ps(c2, _mm_set1_ps(m[11]))
+		));
+
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		_mm_storeu_ps(t+ 0, c0);
+		_mm_storeu_ps(t+ 4, c1);
+		_mm_storeu_ps(t+ 8, c2);
+		_mm_storeu_ps(t+12, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+		return true;
+	}
+};
+
+} // namespace aux
+} // namespace oglplus
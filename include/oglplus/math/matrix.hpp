@@ -211,17 +211,11 @@ protected:
 
 		void operator()(Matrix& t) const
 		{
-			for(std::size_t i=0; i!=Rows; ++i)
-			for(std::size_t j=0; j!=Cols; ++j)
-			{
-				t._m._elem[i][j] = a.At(i, 0)* b.At(0, j);
-				for(std::size_t k=1; k!=N; ++k)
-				{
-					t._m._elem[i][j] +=
-						a.At(i, k)*
-						b.At(k, j);
-				}
-			}
+			aux::MatrixMultiplyKernel<T, Rows, N, Cols>::Apply(
+				t._m._data,
+				a.Data(),
+				b.Data()
+			);
 		}
 	};
 
@@ -244,9 +238,10 @@ protected:
 
 		void operator()(Matrix& t) const
 		{
-			for(std::size_t i=0; i!=Rows; ++i)
-			for(std::size_t j=0; j!=Cols; ++j)
-				t._m._elem[i][j] = a._m._elem[j][i];
+			aux::MatrixKernels<T, Rows, Cols>::Transpose(
+				t._m._data,
+				a.Data()
+			);
 		}
 	};
 
@@ -773,6 +768,48 @@ inline Matrix<T, R, C> Inverse(Matrix<T, R, C> m)
 	return i;
 }
 
+#if OGLPLUS_MATH_SSE
+inline Matrix<float, 4, 4> Inverse(const Matrix<float, 4, 4>& m)
+{
+	float i[16];
+	if(!aux::Matrix4x4Kernels<float>::Inverse(i, m.Data()))
+	{
+		std::fill(i, i+16, 0.0f);
+	}
+	return Matrix<float, 4, 4>(i);
+}
+#endif
+
+/// Inverse of an affine transformation matrix
+/** This function is faster than Inverse, but it can be used
+ *  only for matrices with (0, 0, 0, 1) in the last row.
+ *
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline Matrix<T, 4, 4> InverseAffine(const Matrix<T, 4, 4>& m)
+{
+	T i[16];
+	if(!aux::Matrix4x4Kernels<T>::InverseAffine(i, m.Data()))
+	{
+		std::fill(i, i+16, T(0));
+	}
+	return Matrix<T, 4, 4>(i);
+}
+
+/// Transforms the point @p p by the 4x4 matrix @p m
+/**
+ *  @ingroup math_utils
+ */
+template <typename T>
+inline Vector<T, 3> TransformPoint(
+	const Matrix<T, 4, 4>& m,
+	const Vector<T, 3>& p
+)
+{
+	return (m*Vector<T, 4>(p, T(1))).xyz();
+}
+
 /// Class implementing model transformation matrix named constructors
 /** The static member functions of this class can be used to construct
  *  various model transformation matrices.
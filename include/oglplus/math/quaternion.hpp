@@ -222,7 +222,7 @@ public:
 	{
 		T id = DotProduct(q1, q1);
 		assert(id != T(0));
-		id *= T(1)/id;
+		id = T(1)/id;
 		return Quaternion(
 			+q1._a*id,
 			-q1._x*id,
@@ -259,12 +259,11 @@ public:
 
 	static Quaternion Multiplied(const Quaternion& q1, const Quaternion& q2)
 	{
-		return Quaternion(
-			q1._a*q2._a - q1._x*q2._x - q1._y*q2._y - q1._z*q2._z,
-			q1._a*q2._x + q1._x*q2._a + q1._y*q2._z - q1._z*q2._y,
-			q1._a*q2._y - q1._x*q2._z + q1._y*q2._a + q1._z*q2._x,
-			q1._a*q2._z + q1._x*q2._y - q1._y*q2._x + q1._z*q2._a
-		);
+		const T p[4] = {q1._a, q1._x, q1._y, q1._z};
+		const T q[4] = {q2._a, q2._x, q2._y, q2._z};
+		T r[4];
+		aux::QuaternionKernels<T>::Multiply(r, p, q);
+		return Quaternion(r[0], r[1], r[2], r[3]);
 	}
 
 	/// Multiplication operator
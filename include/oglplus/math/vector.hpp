@@ -16,6 +16,7 @@
 #include <oglplus/config/compiler.hpp>
 #include <oglplus/utils/nothing.hpp>
 #include <oglplus/fwd.hpp>
+#include <oglplus/math/kernels.hpp>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -533,14 +534,7 @@ inline Vector<T, Cols> operator * (
 )
 {
 	T tmp[Cols];
-	for(std::size_t c=0; c!=Cols; ++c)
-	{
-		tmp[c] = T(0);
-		for(std::size_t r=0; r!=N; ++r)
-		{
-			tmp[c] += v.At(r) * m.At(r, c);
-		}
-	}
+	aux::MatrixKernels<T, N, Cols>::TransformRow(tmp, v.Data(), m.Data());
 	return Vector<T, Cols>(tmp);
 }
 
@@ -551,14 +545,7 @@ inline Vector<T, Rows> operator * (
 )
 {
 	T tmp[Rows];
-	for(std::size_t r=0; r!=Rows; ++r)
-	{
-		tmp[r] = T(0);
-		for(std::size_t c=0; c!=N; ++c)
-		{
-			tmp[r] += m.At(r, c) * v.At(c);
-		}
-	}
+	aux::MatrixKernels<T, Rows, N>::Transform(tmp, m.Data(), v.Data());
 	return Vector<T, Rows>(tmp);
 }
 
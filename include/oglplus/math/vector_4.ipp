@@ -16,6 +16,12 @@ class Vector<T, 4>
 private:
 	typedef VectorBase<T, 4> Base;
 	typedef typename Base::Unit_ Unit_;
+	typedef aux::Vector4Kernels<T> _kernels;
+
+	// No initialization
+	Vector(oglplus::Nothing)
+	 : Base(oglplus::Nothing())
+	{ }
 public:
 	Vector(void)
 	{ }
@@ -129,58 +135,73 @@ public:
 		return Vector<T, 3>(this->At(0), this->At(1), this->At(2));
 	}
 
+	static T DotProduct(const Vector& a, const Vector& b)
+	{
+		return _kernels::Dot(a._elem, b._elem);
+	}
+
 	friend Vector Negated(const Vector& a)
 	{
-		return Vector(-a[0], -a[1], -a[2], -a[3]);
+		Vector r = oglplus::Nothing();
+		_kernels::Negate(r._elem, a._elem);
+		return r;
 	}
 
 	friend Vector Added(const Vector& a, const Vector& b)
 	{
-		return Vector(a[0]+b[0], a[1]+b[1], a[2]+b[2], a[3]+b[3]);
+		Vector r = oglplus::Nothing();
+		_kernels::Add(r._elem, a._elem, b._elem);
+		return r;
 	}
 
 	Vector& operator += (const Vector& v)
 	{
-		this->Add(v);
+		_kernels::Add(this->_elem, this->_elem, v._elem);
 		return *this;
 	}
 
 	friend Vector Subtracted(const Vector& a, const Vector& b)
 	{
-		return Vector(a[0]-b[0], a[1]-b[1], a[2]-b[2], a[3]-b[3]);
+		Vector r = oglplus::Nothing();
+		_kernels::Subtract(r._elem, a._elem, b._elem);
+		return r;
 	}
 
 	Vector& operator -= (const Vector& v)
 	{
-		this->Subtract(v);
+		_kernels::Subtract(this->_elem, this->_elem, v._elem);
 		return *this;
 	}
 
 	friend Vector Multiplied(const Vector& a, T v)
 	{
-		return Vector(a[0]*v, a[1]*v, a[2]*v, a[3]*v);
+		Vector r = oglplus::Nothing();
+		_kernels::Multiply(r._elem, a._elem, v);
+		return r;
 	}
 
 	Vector& operator *= (T v)
 	{
-		this->Multiply(v);
+		_kernels::Multiply(this->_elem, this->_elem, v);
 		return *this;
 	}
 
 	Vector& operator *= (const Vector& v)
 	{
-		this->Multiply(v);
+		_kernels::Multiply(this->_elem, this->_elem, v._elem);
 		return *this;
 	}
 
 	friend Vector Divided(const Vector& a, T v)
 	{
-		return Vector(a[0]/v, a[1]/v, a[2]/v, a[3]/v);
+		Vector r = oglplus::Nothing();
+		_kernels::Divide(r._elem, a._elem, v);
+		return r;
 	}
 
 	Vector& operator /= (T v)
 	{
-		this->Divide(v);
+		_kernels::Divide(this->_elem, this->_elem, v);
 		return *this;
 	}
 };
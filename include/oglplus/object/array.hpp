@@ -15,8 +15,10 @@
 
 #include <oglplus/object/reference.hpp>
 #include <oglplus/object/seq_tpl.hpp>
+#include <oglplus/object/name_pool.hpp>
 #include <oglplus/utils/nothing.hpp>
 #include <oglplus/detail/size.hpp>
+#include <oglplus/state_cache.hpp>
 
 #include <vector>
 #include <cassert>
@@ -51,9 +53,24 @@ protected:
 	typedef typename ObjTag::NameType NameT;
 	std::vector<NameT> _names;
 
+	template <typename GT>
+	void _gen(GT gen_tag)
+	{
+		GenDelOps::Gen(gen_tag, GLsizei(_names.size()), _names.data());
+	}
+
+	void _gen(tag::Generate gen_tag)
+	{
+		NamePool<ObjTag>::_gen(
+			gen_tag,
+			GLsizei(_names.size()),
+			_names.data()
+		);
+	}
+
 	void _init(Nothing)
 	{
-		GenDelOps::Gen(GenTag(), GLsizei(_names.size()), _names.data());
+		_gen(GenTag());
 	}
 
 	template <typename ObjectSubtype>
@@ -100,10 +117,14 @@ public:
 	{
 		if(!_names.empty())
 		{
-			GenDelOps::Delete(
+			NamePool<ObjTag>::_delete(
 				GLsizei(_names.size()),
 				_names.data()
 			);
+			aux::StateCacheForgetNames(
+				_names.size(),
+				_names.data()
+			);
 		}
 	}
 
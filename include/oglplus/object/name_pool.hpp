@@ -0,0 +1,298 @@
+/**
+ *  @file oglplus/object/name_pool.hpp
+ *  @brief Pool of recycled object names
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_OBJECT_NAME_POOL_1509171015_HPP
+#define OGLPLUS_OBJECT_NAME_POOL_1509171015_HPP
+
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/config/object.hpp>
+#include <oglplus/config/gl.hpp>
+#include <oglplus/object/tags.hpp>
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace oglplus {
+
+template <typename ObjTag>
+class ObjGenDelOps;
+
+namespace aux {
+
+// Discards the storage of released objects of the specified type
+// (specialized for the object types that support it)
+template <typename ObjTag>
+struct NamePoolOrphan
+{
+	static void Apply(GLsizei /*count*/, const GLuint* /*names*/)
+	{ }
+};
+
+} // namespace aux
+
+/// Pool of recycled names of objects of the type specified by ObjTag
+/** When a NamePool is current in the calling thread, the objects
+ *  of the matching type generated with glGen* (for example by the default
+ *  constructor of Object or Array) take their names from the pool,
+ *  and the names of destroyed objects are returned to the pool instead
+ *  of being deleted. The pool generates new names in blocks when it is empty
+ *  and deletes the released names which exceed its capacity.
+ *  Objects created with glCreate* (DSA) get new names but their names
+ *  are recycled on destruction.
+ *
+ *  The recycled objects keep their state (including the storage
+ *  of buffers), unless orphaning is enabled for the pool. Note that
+ *  GL associates the names of textures and queries with the target to
+ *  which they were first bound, so pools of such objects should be used
+ *  only for objects with the same target.
+ *
+ *  The pool is made current in the constructor and the previously current
+ *  pool for the same object type is restored in the destructor,
+ *  which deletes the names remaining in the pool.
+ *
+ *  @code
+ *  NamePool<tag::Buffer> buffer_pool(64);
+ *
+ *  for(...)
+ *  {
+ *    Buffer temp; // name taken from the pool
+ *    ...
+ *  } // name returned to the pool
+ *
+ *  std::cout << buffer_pool.HitCount() << " names recycled" << std::endl;
+ *  @endcode
+ *
+ *  @see OGLPLUS_NO_NAME_POOL
+ */
+template <typename ObjTag>
+class NamePool
+ : public ObjGenDelOps<ObjTag>
+{
+private:
+	typedef ObjGenDelOps<ObjTag> _ops;
+
+	std::vector<GLuint> _free;
+	GLsizei _block_size;
+	std::size_t _capacity;
+	bool _orphan;
+	NamePool* _prev;
+
+	unsigned long _hit_count;
+	unsigned long _miss_count;
+	unsigned long _gen_count;
+	unsigned long _release_count;
+
+	static NamePool*& _current_ref(void)
+	{
+#if !OGLPLUS_NO_THREADS
+		static thread_local NamePool* current = nullptr;
+#else
+		static NamePool* current = nullptr;
+#endif
+		return current;
+	}
+
+	void _refill(std::size_t count)
+	{
+		const std::size_t old_size = _free.size();
+		_free.resize(old_size+count);
+		_ops::Gen(tag::Generate(), GLsizei(count), _free.data()+old_size);
+		_gen_count += count;
+	}
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	NamePool(const NamePool&) = delete;
+	NamePool& operator = (const NamePool&) = delete;
+#else
+	NamePool(const NamePool&);
+	NamePool& operator = (const NamePool&);
+#endif
+public:
+	/// Creates a pool and makes it current in the calling thread
+	/**
+	 *  @param block_size the number of names generated at once
+	 *    when the pool is empty.
+	 *  @param capacity the maximum number of released names kept
+	 *    in the pool.
+	 *  @param orphan discard the storage of the released objects
+	 *    (if supported by the object type).
+	 */
+	NamePool(
+		GLsizei block_size = 32,
+		std::size_t capacity = 1024,
+		bool orphan = false
+	): _block_size(block_size>0?block_size:1)
+	 , _capacity(capacity)
+	 , _orphan(orphan)
+	 , _prev(_current_ref())
+	 , _hit_count(0)
+	 , _miss_count(0)
+	 , _gen_count(0)
+	 , _release_count(0)
+	{
+		_current_ref() = this;
+	}
+
+	/// Deletes the names in the pool and restores the previous pool
+	~NamePool(void)
+	{
+		_current_ref() = _prev;
+		try { Trim(); }
+		catch(...) { }
+	}
+
+	/// Returns the pool current in the calling thread or nullptr
+	static NamePool* Current(void)
+	{
+#if !OGLPLUS_NO_NAME_POOL
+		return _current_ref();
+#else
+		return nullptr;
+#endif
+	}
+
+	/// Stores @p count names taken from the pool into @p names
+	void Acquire(GLsizei count, GLuint* names)
+	{
+		assert(names != nullptr);
+		assert(count >= 0);
+		const std::size_t n = std::size_t(count);
+		if(_free.size() < n)
+		{
+			++_miss_count;
+			const std::size_t need = n-_free.size();
+			const std::size_t block = std::size_t(_block_size);
+			_refill(need>block?need:block);
+		}
+		else ++_hit_count;
+
+		const std::size_t offs = _free.size()-n;
+		for(std::size_t i=0; i!=n; ++i)
+		{
+			names[i] = _free[offs+i];
+		}
+		_free.resize(offs);
+	}
+
+	/// Returns @p count @p names to the pool
+	/** The names exceeding the capacity of the pool are deleted.
+	 */
+	void Release(GLsizei count, GLuint* names)
+	{
+		assert(names != nullptr);
+		assert(count >= 0);
+		std::size_t keep = std::size_t(count);
+		if(_free.size()+keep > _capacity)
+		{
+			keep = (_free.size() < _capacity)?
+				_capacity-_free.size():0;
+			_ops::Delete(GLsizei(count-GLsizei(keep)), names+keep);
+		}
+		if(keep > 0)
+		{
+			if(_orphan)
+			{
+				aux::NamePoolOrphan<ObjTag>::Apply(
+					GLsizei(keep),
+					names
+				);
+			}
+			_free.insert(_free.end(), names, names+keep);
+			_release_count += keep;
+		}
+	}
+
+	/// Makes sure that at least @p count names are in the pool
+	void Reserve(std::size_t count)
+	{
+		if(_free.size() < count)
+		{
+			_refill(count-_free.size());
+		}
+	}
+
+	/// Deletes all names in the pool
+	void Trim(void)
+	{
+		if(!_free.empty())
+		{
+			_ops::Delete(GLsizei(_free.size()), _free.data());
+			_free.clear();
+		}
+	}
+
+	/// The number of names currently available in the pool
+	std::size_t FreeCount(void) const
+	{
+		return _free.size();
+	}
+
+	/// The number of Acquire calls served without generating new names
+	unsigned long HitCount(void) const
+	{
+		return _hit_count;
+	}
+
+	/// The number of Acquire calls which had to generate new names
+	unsigned long MissCount(void) const
+	{
+		return _miss_count;
+	}
+
+	/// The number of names generated by the pool
+	unsigned long GeneratedCount(void) const
+	{
+		return _gen_count;
+	}
+
+	/// The number of names returned to the pool and kept for recycling
+	unsigned long ReleasedCount(void) const
+	{
+		return _release_count;
+	}
+
+	/// Resets the statistics counters
+	void ResetCounters(void)
+	{
+		_hit_count = 0;
+		_miss_count = 0;
+		_gen_count = 0;
+		_release_count = 0;
+	}
+
+	// implementation details
+
+	// generates names through the current pool if there is one
+	static void _gen(tag::Generate gen_tag, GLsizei count, GLuint* names)
+	{
+		if(NamePool* pool = Current())
+		{
+			pool->Acquire(count, names);
+		}
+		else _ops::Gen(gen_tag, count, names);
+	}
+
+	// deletes names or returns them to the current pool
+	static void _delete(GLsizei count, GLuint* names)
+	{
+		if(NamePool* pool = Current())
+		{
+			pool->Release(count, names);
+		}
+		else _ops::Delete(count, names);
+	}
+};
+
+} // namespace oglplus
+
+#endif // include guard
@@ -18,6 +18,9 @@
 namespace oglplus {
 namespace tag {
 
+struct Generate { };
+struct Create { };
+
 #define OGLPLUS_DEFINE_OBJECT_TAG(ID, OBJECT) \
 struct OBJECT \
  : std::integral_constant<int, ID> \
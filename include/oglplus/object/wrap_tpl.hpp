@@ -13,20 +13,17 @@
 #ifndef OGLPLUS_OBJECT_WRAP_TPL_1107121519_HPP
 #define OGLPLUS_OBJECT_WRAP_TPL_1107121519_HPP
 
+#include <oglplus/object/tags.hpp>
 #include <oglplus/object/desc.hpp>
 #include <oglplus/object/name_tpl.hpp>
 #include <oglplus/object/seq_tpl.hpp>
+#include <oglplus/object/name_pool.hpp>
 #include <oglplus/utils/nothing.hpp>
+#include <oglplus/state_cache.hpp>
 #include <type_traits>
 #include <cassert>
 
 namespace oglplus {
-namespace tag {
-
-struct Generate { };
-struct Create { };
-
-} // namespace tag
 
 template <typename ObjTag>
 struct ObjectSubtype : Nothing
@@ -239,6 +236,11 @@ private:
 		ObjGenDelOps<ObjTag>::Gen(gen_tag, 1, this->_name_ptr());
 	}
 
+	void _init(tag::Generate gen_tag, Nothing)
+	{
+		NamePool<ObjTag>::_gen(gen_tag, 1, this->_name_ptr());
+	}
+
 	template <typename GenTag, typename ObjectSubtype>
 	void _init(GenTag gen_tag, ObjectSubtype type)
 	{
@@ -251,7 +253,8 @@ private:
 		if(this->_has_deletable_name())
 		{
 			_undescribe();
-			ObjGenDelOps<ObjTag>::Delete(1, this->_name_ptr());
+			NamePool<ObjTag>::_delete(1, this->_name_ptr());
+			aux::StateCacheForgetNames(1, this->_name_ptr());
 		}
 	}
 protected:
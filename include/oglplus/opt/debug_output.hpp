@@ -17,6 +17,7 @@
 #include <oglplus/string/ref.hpp>
 #include <oglplus/object/wrapper.hpp>
 #include <oglplus/boolean.hpp>
+#include <oglplus/capability.hpp>
 #include <oglplus/enumerations.hpp>
 #include <oglplus/enums/debug_output_severity.hpp>
 #include <oglplus/enums/debug_output_source.hpp>
@@ -304,20 +305,7 @@ public:
 	 */
 	static void Synchronous(bool enable)
 	{
-		if(enable)
-		{
-			OGLPLUS_GLFUNC(Enable)(
-				GL_DEBUG_OUTPUT_SYNCHRONOUS
-			);
-			OGLPLUS_VERIFY_SIMPLE(Enable);
-		}
-		else
-		{
-			OGLPLUS_GLFUNC(Disable)(
-				GL_DEBUG_OUTPUT_SYNCHRONOUS
-			);
-			OGLPLUS_VERIFY_SIMPLE(Disable);
-		}
+		aux::EnableCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS, enable);
 	}
 
 	/// Inserts a new message into the debug output
@@ -0,0 +1,216 @@
+/**
+ *  @file oglplus/pixel_readback.hpp
+ *  @brief Asynchronous reading of pixels through pixel-pack buffers
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PIXEL_READBACK_1509281120_HPP
+#define OGLPLUS_PIXEL_READBACK_1509281120_HPP
+
+#include <oglplus/buffer.hpp>
+#include <oglplus/sync.hpp>
+#include <oglplus/pixel_data.hpp>
+#include <oglplus/size_type.hpp>
+
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_3_2 || GL_ARB_sync
+
+/// A rectangle of pixels read back by the PixelReadback
+struct PixelReadbackFrame
+{
+	/// The value passed to PixelReadback::Read, for example a frame number
+	std::uint64_t tag;
+
+	/// The position of the lower left corner of the rectangle
+	GLint x, y;
+
+	/// The size of the rectangle
+	GLsizei width, height;
+
+	/// The format of the pixels
+	PixelDataFormat format;
+
+	/// The data type of the pixels
+	PixelDataType type;
+
+	/// The size of a single pixel in bytes
+	std::size_t pixel_size;
+
+	/// The pixel data
+	/** The rows are tightly packed (regardless of the pack alignment)
+	 *  and ordered bottom to top, as they are returned by ReadPixels.
+	 */
+	std::vector<GLubyte> data;
+};
+
+/// Reads pixels from the framebuffer without waiting for the GPU
+/** A synchronous ReadPixels into client memory waits until the GPU
+ *  finishes rendering to the read framebuffer and then for the transfer
+ *  of the pixels. The PixelReadback instead issues ReadPixels into one of
+ *  a ring of pixel-pack buffers and places a fence after it. The buffer
+ *  is mapped and its contents copied out only after the fence is signaled,
+ *  which is typically a few frames later, so the rendering does not stall.
+ *
+ *  If all buffers in the ring are still in flight when a new read is issued
+ *  then the oldest one is waited for (see StallCount). Using a larger
+ *  @c latency avoids the stalls at the expense of memory. Read and Flush
+ *  throw if the GPU does not finish a read within the WaitTimeout
+ *  or if waiting for it fails.
+ *
+ *  The pixels are read with the current pack alignment, the other pack
+ *  parameters (row length, skip pixels/rows) are expected to be
+ *  at their default values.
+ *
+ *  Example:
+ *  @code
+ *  PixelReadback readback;
+ *  std::vector<PixelReadbackFrame> frames;
+ *  while(rendering)
+ *  {
+ *    RenderFrame();
+ *    readback.Read(0, 0, w, h, PixelDataFormat::RGBA, PixelDataType::UnsignedByte, frame_no++);
+ *    SwapBuffers();
+ *    readback.Poll(frames);
+ *    for(auto& frame : frames) Save(std::move(frame));
+ *    frames.clear();
+ *  }
+ *  readback.Flush(frames);
+ *  @endcode
+ *
+ *  @glvoereq{3,2,ARB,sync}
+ */
+class PixelReadback
+{
+private:
+	struct _slot
+	{
+		Buffer buffer;
+		GLsizeiptr capacity;
+		GLsizeiptr row_stride;
+		PixelReadbackFrame frame;
+
+		_slot(void)
+		 : capacity(0)
+		 , row_stride(0)
+		{ }
+	};
+
+	std::vector<_slot> _slots;
+	std::vector<Sync> _fences;
+	std::size_t _oldest;
+	std::size_t _pending;
+	std::deque<PixelReadbackFrame> _ready;
+	unsigned long _stall_count;
+	GLuint64 _wait_timeout;
+
+	void _retrieve(void);
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	PixelReadback(const PixelReadback&) = delete;
+	PixelReadback& operator = (const PixelReadback&) = delete;
+#else
+	PixelReadback(const PixelReadback&);
+	PixelReadback& operator = (const PixelReadback&);
+#endif
+public:
+	/// Returns the size of a pixel with the specified format and type
+	/**
+	 *  @throws std::runtime_error if the size cannot be determined.
+	 */
+	static std::size_t PixelSize(PixelDataFormat format, PixelDataType type);
+
+	/// Creates a readback with the specified number of buffers in the ring
+	/**
+	 *  @param latency the number of reads that may be in flight
+	 */
+	PixelReadback(std::size_t latency = 3);
+
+	/// Returns the number of buffers in the ring
+	std::size_t Latency(void) const
+	{
+		return _slots.size();
+	}
+
+	/// Issues the reading of a rectangle from the current read framebuffer
+	/** The @p tag is returned together with the pixels and can be used
+	 *  to identify the frame. Waits for the oldest read only if all buffers
+	 *  are in flight. The binding of the pixel-pack buffer is restored.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{ReadPixels}
+	 *  @glfunref{FenceSync}
+	 *
+	 *  @throws Error
+	 */
+	void Read(
+		GLint x,
+		GLint y,
+		SizeType width,
+		SizeType height,
+		PixelDataFormat format,
+		PixelDataType type,
+		std::uint64_t tag = 0
+	);
+
+	/// Returns the number of reads that are not retrieved yet
+	std::size_t PendingCount(void) const
+	{
+		return _pending+_ready.size();
+	}
+
+	/// Returns the number of times Read had to wait for the GPU
+	unsigned long StallCount(void) const
+	{
+		return _stall_count;
+	}
+
+	/// Returns the maximum time (in nanoseconds) to wait for a single read
+	GLuint64 WaitTimeout(void) const
+	{
+		return _wait_timeout;
+	}
+
+	/// Sets the maximum time (in nanoseconds) to wait for a single read
+	void WaitTimeout(GLuint64 timeout)
+	{
+		_wait_timeout = timeout;
+	}
+
+	/// Appends the frames which were read since the last call
+	/** Does not block. The frames are appended in the order in which
+	 *  they were read.
+	 *
+	 *  @returns the number of the appended frames.
+	 */
+	std::size_t Poll(std::vector<PixelReadbackFrame>& frames);
+
+	/// Waits for all pending reads and appends their frames
+	/** This blocks until the GPU finishes the pending reads, it is
+	 *  intended to be used when the reading ends.
+	 *
+	 *  @returns the number of the appended frames.
+	 */
+	std::size_t Flush(std::vector<PixelReadbackFrame>& frames);
+};
+
+#endif // GL_VERSION_3_2 || GL_ARB_sync
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/pixel_readback.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -23,11 +23,13 @@
 #include <oglplus/data_type.hpp>
 #include <oglplus/transform_feedback_mode.hpp>
 #include <oglplus/program_resource.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/primitive_type.hpp>
 #include <oglplus/face_mode.hpp>
 #include <oglplus/glsl_source.hpp>
 #include <oglplus/vertex_attrib_slot.hpp>
 #include <oglplus/detail/base_range.hpp>
+#include <oglplus/state_cache.hpp>
 
 #include <vector>
 #include <cassert>
@@ -66,6 +68,7 @@ protected:
 		{
 			OGLPLUS_GLFUNC(DeleteProgram)(names[i]);
 			OGLPLUS_VERIFY_SIMPLE(DeleteProgram);
+			ProgramReflection::Disable(ProgramName(names[i]));
 		}
 	}
 
@@ -121,12 +124,20 @@ public:
 	 */
 	static void Bind(ProgramName program)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GL_CURRENT_PROGRAM, 0,
+			GetGLName(program)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(UseProgram)(GetGLName(program));
 		OGLPLUS_VERIFY(
 			UseProgram,
 			ObjectError,
 			Object(program)
 		);
+		cached.Update();
 	}
 };
 
@@ -0,0 +1,226 @@
+/**
+ *  @file oglplus/program_build_queue.hpp
+ *  @brief Non-blocking building of multiple programs
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PROGRAM_BUILD_QUEUE_1509241345_HPP
+#define OGLPLUS_PROGRAM_BUILD_QUEUE_1509241345_HPP
+
+#include <oglplus/program.hpp>
+#include <oglplus/glsl_string.hpp>
+#include <oglplus/ext/KHR_parallel_shader_compile.hpp>
+
+#include <vector>
+#include <set>
+#include <cstddef>
+
+namespace oglplus {
+
+/// Builds multiple programs without waiting for the individual results
+/** Program::Build compiles the attached shaders and links the program
+ *  one after another and queries the result of each step before issuing
+ *  the next one, which blocks until the GL finishes the compilation.
+ *  The build queue issues the compilation of the attached shaders and
+ *  the linking of the program when the program is submitted and queries
+ *  the results only when they are requested, so that the GL can compile
+ *  many shaders in parallel while the application does other work.
+ *
+ *  If the KHR_parallel_shader_compile extension is available then
+ *  Poll checks which programs are finished without blocking. Otherwise
+ *  all submitted programs are considered finished, and the status
+ *  queries in Result may block.
+ *
+ *  Example:
+ *  @code
+ *  ProgramBuildQueue queue;
+ *  for(Program& prog : programs) queue.Submit(prog);
+ *
+ *  std::vector<ProgramBuildQueue::Ticket> finished;
+ *  while(!queue.Empty())
+ *  {
+ *    LoadSomeAssets();
+ *    finished.clear();
+ *    queue.Poll(finished);
+ *    for(auto ticket : finished) queue.Result(ticket).Done();
+ *  }
+ *  @endcode
+ *
+ *  The queue keeps the state of a program only until its result
+ *  is retrieved, so the storage of retrieved entries is reused by
+ *  the programs submitted later.
+ *
+ *  @note A submitted program must outlive its ticket, i.e. it must not
+ *  be moved or destroyed before its result is retrieved or the queue
+ *  is cleared.
+ *
+ *  @ingroup oglplus_objects
+ */
+class ProgramBuildQueue
+{
+public:
+	/// Identifies a program submitted to the queue
+	/** A ticket is valid until the result of the build is retrieved
+	 *  with Result or until the queue is cleared. Afterwards it must
+	 *  not be used with the queue anymore.
+	 */
+	class Ticket
+	{
+	private:
+		friend class ProgramBuildQueue;
+
+		std::size_t _index;
+		std::size_t _generation;
+
+		Ticket(std::size_t index, std::size_t generation)
+		 : _index(index)
+		 , _generation(generation)
+		{ }
+	public:
+		friend bool operator == (const Ticket& a, const Ticket& b)
+		{
+			return	(a._index == b._index) &&
+				(a._generation == b._generation);
+		}
+
+		friend bool operator != (const Ticket& a, const Ticket& b)
+		{
+			return !(a == b);
+		}
+	};
+private:
+	struct _entry
+	{
+		// null if the entry is not used
+		ProgramOps* program;
+		// the shaders compiled by the queue for this program
+		std::vector<ShaderName> shaders;
+		// incremented when the entry is released
+		std::size_t generation;
+		bool finished;
+	};
+
+	std::vector<_entry> _entries;
+	// the indices of the released entries
+	std::vector<std::size_t> _free;
+	std::vector<Ticket> _pending;
+	std::set<GLuint> _compiled;
+	bool _parallel;
+
+	template <typename Compiler>
+	Ticket _submit(ProgramOps& program, Compiler compile);
+
+	bool _is_finished(const _entry& entry) const;
+
+	bool _is_valid(Ticket ticket) const;
+
+	void _release(std::size_t index);
+public:
+	/// Creates an empty queue
+	/** Checks if the KHR_parallel_shader_compile extension is available
+	 *  in the current GL context.
+	 */
+	ProgramBuildQueue(void);
+
+	/// Creates an empty queue possibly ignoring the extension
+	ProgramBuildQueue(bool use_parallel_compile);
+
+	/// Returns true if completion is checked without blocking
+	bool ParallelCompile(void) const
+	{
+		return _parallel;
+	}
+
+	/// Issues the compilation of the attached shaders and the linking
+	/** The shaders which are already compiled or which were compiled
+	 *  by this queue for another program are not compiled again.
+	 *  The @p program must outlive the returned ticket.
+	 *
+	 *  @see Program::Build
+	 *  @throws Error if the compilation or linking could not be issued
+	 */
+	Ticket Submit(ProgramOps& program);
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_ARB_shading_language_include
+	/// Issues the compilation of the attached shaders and the linking
+	/**
+	 *  @see Program::BuildInclude
+	 *  @throws Error if the compilation or linking could not be issued
+	 */
+	Ticket SubmitInclude(
+		ProgramOps& program,
+		SizeType count,
+		const GLchar* const* paths,
+		const GLint* lengths
+	);
+
+	Ticket SubmitInclude(ProgramOps& program, GLSLString&& incl)
+	{
+		return SubmitInclude(
+			program,
+			incl.Count(),
+			incl.Parts(),
+			incl.Lengths()
+		);
+	}
+
+	Ticket SubmitInclude(ProgramOps& program, GLSLStrings&& incl)
+	{
+		return SubmitInclude(
+			program,
+			incl.Count(),
+			incl.Parts(),
+			incl.Lengths()
+		);
+	}
+#endif
+
+	/// Appends the tickets of the programs finished since the last call
+	/** Does not block if ParallelCompile() is true.
+	 *
+	 *  @returns the number of the appended tickets.
+	 */
+	std::size_t Poll(std::vector<Ticket>& finished);
+
+	/// Returns true if the build of the specified program finished
+	/** Does not block if ParallelCompile() is true.
+	 */
+	bool Finished(Ticket ticket) const;
+
+	/// Returns the number of programs that are not finished yet
+	std::size_t PendingCount(void) const
+	{
+		return _pending.size();
+	}
+
+	/// Returns true if there are no unfinished programs
+	bool Empty(void) const
+	{
+		return _pending.empty();
+	}
+
+	/// Returns the result of the build of the specified program
+	/** If the program is not finished yet then this function blocks.
+	 *  The result is the same as if the program was built with
+	 *  Program::Build. The program is removed from the queue and
+	 *  the @p ticket is invalidated.
+	 */
+	Outcome<ProgramOps&> Result(Ticket ticket);
+
+	/// Removes all programs from the queue and invalidates the tickets
+	void Clear(void);
+};
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/program_build_queue.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -0,0 +1,234 @@
+/**
+ *  @file oglplus/program_cache.hpp
+ *  @brief Persistent on-disk cache of linked program binaries
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PROGRAM_CACHE_1509231012_HPP
+#define OGLPLUS_PROGRAM_CACHE_1509231012_HPP
+
+#include <oglplus/program.hpp>
+#include <oglplus/glsl_string.hpp>
+#include <oglplus/string/ref.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+/// Persistent on-disk cache of linked program binaries
+/** The cache builds programs with attached shaders like Program::Build,
+ *  but first it looks up a previously stored binary of the linked program
+ *  and if there is one it is loaded with ProgramBinary instead of compiling
+ *  the shaders and linking the program. On a cache miss the program
+ *  is built normally and its binary is stored in the cache directory.
+ *
+ *  The cache entries are keyed by a hash of the types and the sources
+ *  of the attached shaders, the named strings included by the sources
+ *  (if ARB_shading_language_include is available), the include search
+ *  paths, the GL vendor, renderer and version strings and an optional
+ *  user-specified variant string. The variant should describe the state
+ *  affecting linking which is not part of the sources, for example
+ *  the attribute locations bound before linking or the transform
+ *  feedback varyings.
+ *
+ *  The entries are written into a temporary file which is then renamed,
+ *  so that concurrently running applications never see partially written
+ *  entries. Each entry contains a checksum of the binary, entries which
+ *  are truncated, corrupted or rejected by the GL are discarded and
+ *  the program is rebuilt.
+ *
+ *  @note The cache directory must exist. The cache never removes
+ *  entries which are not used anymore.
+ *
+ *  @glvoereq{4,1,ARB,get_program_binary}
+ *  @ingroup oglplus_objects
+ */
+class ProgramCache
+{
+private:
+	std::string _directory;
+	std::string _driver;
+	bool _enabled;
+
+	unsigned long _hit_count;
+	unsigned long _miss_count;
+	unsigned long _store_count;
+	unsigned long _discard_count;
+
+	// 128-bit key, the first half names the entry file
+	// the second half is stored in the entry and verified
+	struct _key_t
+	{
+		std::uint64_t name;
+		std::uint64_t check;
+	};
+
+	_key_t _make_key(
+		const ProgramOps& program,
+		SizeType count,
+		const GLchar* const* paths,
+		const GLint* lengths,
+		const StrCRef& variant
+	) const;
+
+	std::string _entry_path(const _key_t& key) const;
+
+	bool _load(ProgramOps& program, const _key_t& key);
+
+	bool _store(const ProgramOps& program, const _key_t& key);
+
+	template <typename Builder>
+	Outcome<ProgramOps&> _build(
+		ProgramOps& program,
+		const _key_t& key,
+		Builder build
+	);
+
+	void _discard(const std::string& path);
+public:
+	/// Creates a cache storing the entries in the specified directory
+	/** The driver identity is queried from the current GL context,
+	 *  which must be the context where the programs are built.
+	 */
+	ProgramCache(const std::string& directory);
+
+	/// Creates a cache with an explicitly specified driver identity
+	ProgramCache(
+		const std::string& directory,
+		const std::string& driver_identity
+	);
+
+	/// Returns the driver identity string of the current GL context
+	/** The identity consists of the GL vendor, renderer and version
+	 *  strings.
+	 */
+	static std::string DriverIdentity(void);
+
+	/// The directory where the cache entries are stored
+	const std::string& Directory(void) const
+	{
+		return _directory;
+	}
+
+	/// Returns true if the GL supports at least one binary format
+	/** If no binary formats are supported, then the cache just builds
+	 *  the programs.
+	 */
+	bool Enabled(void) const
+	{
+		return _enabled;
+	}
+
+	/// Returns the path of the cache entry of the specified program
+	/** The entry does not need to exist. The @p program and the @p variant
+	 *  are the same as the arguments of Build.
+	 */
+	std::string EntryPath(
+		const ProgramOps& program,
+		const StrCRef& variant = StrCRef()
+	) const;
+
+	/// Builds the program, loading the linked binary from the cache
+	/**
+	 *  @param program the program with the attached shaders
+	 *  @param variant additional data distinguishing the cache entries
+	 *   of programs with the same sources.
+	 *
+	 *  @see Program::Build
+	 */
+	Outcome<ProgramOps&> Build(
+		ProgramOps& program,
+		const StrCRef& variant = StrCRef()
+	);
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_ARB_shading_language_include
+	/// Builds the program, loading the linked binary from the cache
+	/**
+	 *  @param program the program with the attached shaders
+	 *  @param count the number of include search paths
+	 *  @param paths the include search paths
+	 *  @param lengths the lengths of the search paths
+	 *  @param variant additional data distinguishing the cache entries
+	 *   of programs with the same sources.
+	 *
+	 *  @see Program::BuildInclude
+	 */
+	Outcome<ProgramOps&> BuildInclude(
+		ProgramOps& program,
+		SizeType count,
+		const GLchar* const* paths,
+		const GLint* lengths,
+		const StrCRef& variant = StrCRef()
+	);
+
+	Outcome<ProgramOps&> BuildInclude(
+		ProgramOps& program,
+		GLSLString&& incl
+	)
+	{
+		return BuildInclude(
+			program,
+			incl.Count(),
+			incl.Parts(),
+			incl.Lengths()
+		);
+	}
+
+	Outcome<ProgramOps&> BuildInclude(
+		ProgramOps& program,
+		GLSLStrings&& incl
+	)
+	{
+		return BuildInclude(
+			program,
+			incl.Count(),
+			incl.Parts(),
+			incl.Lengths()
+		);
+	}
+#endif
+
+	/// The number of programs loaded from the cache
+	unsigned long HitCount(void) const
+	{
+		return _hit_count;
+	}
+
+	/// The number of programs built because they were not cached
+	unsigned long MissCount(void) const
+	{
+		return _miss_count;
+	}
+
+	/// The number of entries written to the cache
+	unsigned long StoreCount(void) const
+	{
+		return _store_count;
+	}
+
+	/// The number of invalid entries removed from the cache
+	unsigned long DiscardCount(void) const
+	{
+		return _discard_count;
+	}
+};
+
+#endif // GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/program_cache.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
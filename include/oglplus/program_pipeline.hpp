@@ -21,6 +21,7 @@
 #include <oglplus/error/program.hpp>
 #include <oglplus/error/outcome.hpp>
 #include <oglplus/detail/prog_pl_stages.hpp>
+#include <oglplus/state_cache.hpp>
 
 #include <cassert>
 
@@ -113,12 +114,20 @@ public:
 	 */
 	static void Bind(ProgramPipelineName pipeline)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GL_PROGRAM_PIPELINE_BINDING, 0,
+			GetGLName(pipeline)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindProgramPipeline)(GetGLName(pipeline));
 		OGLPLUS_VERIFY(
 			BindProgramPipeline,
 			ObjectError,
 			Object(pipeline)
 		);
+		cached.Update();
 	}
 };
 
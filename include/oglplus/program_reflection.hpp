@@ -0,0 +1,171 @@
+/**
+ *  @file oglplus/program_reflection.hpp
+ *  @brief Cached reflection table of program variables
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_PROGRAM_REFLECTION_1509161200_HPP
+#define OGLPLUS_PROGRAM_REFLECTION_1509161200_HPP
+
+#include <oglplus/fwd.hpp>
+#include <oglplus/string/def.hpp>
+#include <oglplus/string/ref.hpp>
+#include <oglplus/object/name.hpp>
+
+#include <map>
+
+namespace oglplus {
+
+/// Cached table of the active uniforms and vertex attributes of a program
+/** By default every lookup of a program variable location or type
+ *  goes to the GL. For programs with many active variables (and for
+ *  the typechecked Uniform wrappers, which scan all active uniforms
+ *  on construction) this is expensive. When enabled for a program,
+ *  the ProgramReflection table is built once (after the program is
+ *  linked) and ProgVarLoc, ProgVarTypecheck and ProgramResource read
+ *  the variable locations, types and sizes from it.
+ *
+ *  The table is invalidated when the program is (re-)linked and it
+ *  is dropped when the program is deleted.
+ *
+ *  @note The reflection registry is not synchronized and should be
+ *  used from the thread owning the GL context.
+ *
+ *  @code
+ *  Program prog;
+ *  ...
+ *  prog.Link();
+ *  ProgramReflection::Enable(prog);
+ *  // these read from the cached table
+ *  Uniform<Vec3f> light_pos(prog, "LightPos");
+ *  Uniform<Mat4f> camera_matrix(prog, "CameraMatrix");
+ *  @endcode
+ *
+ *  @see Program
+ *  @see ProgVarLoc
+ */
+class ProgramReflection
+{
+public:
+	/// Information about a single active program variable
+	struct VariableInfo
+	{
+		/// The location of the variable (-1 for block members)
+		GLint location;
+		/// The (GLSL) data type of the variable
+		GLenum type;
+		/// The array size of the variable
+		GLint size;
+		/// The index of the uniform block containing the variable or -1
+		GLint block_index;
+	};
+private:
+	typedef std::map<String, VariableInfo> _var_map;
+
+	_var_map _uniforms;
+	_var_map _attribs;
+	bool _valid;
+
+	static std::map<GLuint, ProgramReflection>& _registry(void);
+
+	static ProgramReflection* _find(GLuint prog_name);
+
+	static const VariableInfo* _lookup(
+		const _var_map& vars,
+		StrCRef identifier
+	);
+
+	void _build(GLuint prog_name);
+	void _build_uniforms(GLuint prog_name);
+	void _build_attribs(GLuint prog_name);
+public:
+	ProgramReflection(void)
+	 : _valid(false)
+	{ }
+
+	/// Enables the caching of reflection data for the specified @p program
+	/** The reflection table is built lazily on the first lookup.
+	 */
+	static void Enable(ProgramName program);
+
+	/// Disables the caching and drops the table of the @p program
+	static void Disable(ProgramName program);
+
+	/// Returns true if the caching is enabled for the @p program
+	static bool IsEnabled(ProgramName program);
+
+	/// Invalidates the cached table of the @p program (if enabled)
+	/** This should be called whenever the program is re-linked.
+	 *  Program::Link and Program::Binary call this automatically.
+	 */
+	static void Invalidate(ProgramName program);
+
+	/// Returns the (up-to-date) reflection table of @p program
+	/** Returns nullptr if the caching is not enabled for @p program.
+	 */
+	static const ProgramReflection* Get(ProgramName program);
+
+	/// Finds the uniform with the specified @p identifier in a @p program
+	/** Returns false if the caching is not enabled for the @p program
+	 *  or the identifier was not found in the cached table. In such case
+	 *  the caller should fall back to querying the GL.
+	 */
+	static bool QueryUniform(
+		ProgramName program,
+		StrCRef identifier,
+		VariableInfo& info
+	);
+
+	/// Finds the vertex attrib with the specified @p identifier in a @p program
+	/** Returns false if the caching is not enabled for the @p program
+	 *  or the identifier was not found in the cached table. In such case
+	 *  the caller should fall back to querying the GL.
+	 */
+	static bool QueryAttrib(
+		ProgramName program,
+		StrCRef identifier,
+		VariableInfo& info
+	);
+
+	/// Finds the info about the uniform with the specified @p identifier
+	/** Returns nullptr if not found.
+	 */
+	const VariableInfo* FindUniform(StrCRef identifier) const
+	{
+		return _lookup(_uniforms, identifier);
+	}
+
+	/// Finds the info about the attrib with the specified @p identifier
+	/** Returns nullptr if not found.
+	 */
+	const VariableInfo* FindAttrib(StrCRef identifier) const
+	{
+		return _lookup(_attribs, identifier);
+	}
+
+	/// Returns the number of cached active uniforms
+	std::size_t UniformCount(void) const
+	{
+		return _uniforms.size();
+	}
+
+	/// Returns the number of cached active vertex attributes
+	std::size_t AttribCount(void) const
+	{
+		return _attribs.size();
+	}
+};
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/program_reflection.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
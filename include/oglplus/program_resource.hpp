@@ -18,6 +18,7 @@
 #include <oglplus/data_type.hpp>
 #include <oglplus/shader_type.hpp>
 #include <oglplus/program_interface.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/detail/program.hpp>
 
 namespace oglplus {
@@ -88,6 +89,27 @@ private:
 		QueryParams(GLenum(property), 1, nullptr, &res);
 		return OGLPLUS_GLFUNC(GetError)() == GL_NO_ERROR;
 	}
+
+	bool GetCached(ProgramReflection::VariableInfo& info) const
+	{
+		if(_interface == GL_UNIFORM)
+		{
+			return ProgramReflection::QueryUniform(
+				ProgramName(_prog_name),
+				_res_name,
+				info
+			);
+		}
+		if(_interface == GL_PROGRAM_INPUT)
+		{
+			return ProgramReflection::QueryAttrib(
+				ProgramName(_prog_name),
+				_res_name,
+				info
+			);
+		}
+		return false;
+	}
 public:
 	ProgramResource(
 		aux::ProgramInterfaceContext& context,
@@ -156,13 +178,20 @@ public:
 	}
 
 	/// Returns the data type of the resource (if applicable)
-	/**
+	/** For uniforms and program inputs this is read from the cached
+	 *  ProgramReflection table if it is enabled for the program.
+	 *
 	 *  @glsymbols
 	 *  @glfunref{GetProgramResource}
 	 *  @gldefref{TYPE}
 	 */
 	SLDataType Type(void) const
 	{
+		ProgramReflection::VariableInfo info;
+		if(GetCached(info))
+		{
+			return SLDataType(info.type);
+		}
 		return SLDataType(GetParam(GL_TYPE));
 	}
 
@@ -174,6 +203,11 @@ public:
 	 */
 	GLint Location(void) const
 	{
+		ProgramReflection::VariableInfo info;
+		if(GetCached(info))
+		{
+			return info.location;
+		}
 		return GetParam(GL_LOCATION);
 	}
 
@@ -196,6 +230,11 @@ public:
 	 */
 	GLint ArraySize(void) const
 	{
+		ProgramReflection::VariableInfo info;
+		if(GetCached(info))
+		{
+			return info.size;
+		}
 		return GetParam(GL_ARRAY_SIZE);
 	}
 
@@ -17,8 +17,8 @@
 #include <oglplus/object/wrapper.hpp>
 #include <oglplus/object/reference.hpp>
 #include <oglplus/error/object.hpp>
-#include <oglplus/enums/query_target.hpp>
-#include <oglplus/enums/conditional_render_mode.hpp>
+#include <oglplus/query_target.hpp>
+#include <oglplus/conditional_render_mode.hpp>
 #include <oglplus/boolean.hpp>
 #include <cassert>
 
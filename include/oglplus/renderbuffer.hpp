@@ -20,6 +20,7 @@
 #include <oglplus/size_type.hpp>
 #include <oglplus/object/wrapper.hpp>
 #include <oglplus/images/fwd.hpp>
+#include <oglplus/state_cache.hpp>
 #include <cassert>
 
 namespace oglplus {
@@ -101,6 +102,13 @@ public:
 		RenderbufferName renderbuffer
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GLenum(target), 0,
+			GetGLName(renderbuffer)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindRenderbuffer)(
 			GLenum(target),
 			GetGLName(renderbuffer)
@@ -111,6 +119,7 @@ public:
 			Object(renderbuffer).
 			BindTarget(target)
 		);
+		cached.Update();
 	}
 };
 
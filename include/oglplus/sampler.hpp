@@ -25,6 +25,7 @@
 #include <oglplus/texture_compare.hpp>
 #include <oglplus/texture_filter.hpp>
 #include <oglplus/texture_unit.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/assert.hpp>
 
 namespace oglplus {
@@ -108,6 +109,13 @@ public:
 		SamplerName sampler
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GL_SAMPLER_BINDING, GLuint(target),
+			GetGLName(sampler)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindSampler)(
 			GLuint(target),
 			GetGLName(sampler)
@@ -118,6 +126,7 @@ public:
 			Object(sampler).
 			Index(GLuint(target))
 		);
+		cached.Update();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_4 || GL_ARB_multi_bind
@@ -133,6 +142,10 @@ public:
 			names
 		);
 		OGLPLUS_VERIFY_SIMPLE(BindSamplers);
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Binding,
+			GL_SAMPLER_BINDING
+		);
 	}
 
 	/// Sequentially bind @p samplers to texture units starting with @p first
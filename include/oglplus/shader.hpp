@@ -332,6 +332,17 @@ public:
 	 */
 	String GetInfoLog(void) const;
 
+	/// Returns the source code of the shader
+	/** The returned string is the concatenation of the source strings
+	 *  set by the last call to Source.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{GetShader}
+	 *  @gldefref{SHADER_SOURCE_LENGTH}
+	 *  @glfunref{GetShaderSource}
+	 */
+	String GetSource(void) const;
+
 	/// Compiles the shader
 	/**
 	 *  @post IsCompiled()
@@ -17,6 +17,7 @@
 #include <oglplus/shapes/draw.hpp>
 
 #include <vector>
+#include <cstdint>
 
 namespace oglplus {
 namespace shapes {
@@ -55,6 +56,16 @@ private:
 	void _init_dr_el_triangle_strip(const DrawOperation& draw_op);
 	void _init_dr_el_triangle_fan(const DrawOperation& draw_op);
 
+	static std::uint64_t _hash_cell(std::uint64_t hash, GLdouble cell);
+	static std::uint64_t _hash_edge(std::uint64_t c0, std::uint64_t c1);
+
+	void _vert_cells(
+		GLuint vert,
+		GLdouble cell_size,
+		GLdouble margin,
+		std::vector<std::uint64_t>& cells
+	) const;
+
 	void _detect_adjacent(void);
 	bool _same_va_values(
 		GLuint fa,
@@ -0,0 +1,449 @@
+/**
+ *  @file oglplus/shapes/cached_mesh.hpp
+ *  @brief Binary cache of meshes made by the mesh loaders
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_CACHED_MESH_1509181000_HPP
+#define OGLPLUS_SHAPES_CACHED_MESH_1509181000_HPP
+
+#include <oglplus/face_mode.hpp>
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/shapes/vert_attr_info.hpp>
+#include <oglplus/string/ref.hpp>
+#include <oglplus/utils/mapped_file.hpp>
+#include <oglplus/math/sphere.hpp>
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+namespace oglplus {
+namespace shapes {
+
+/// Shape builder reading meshes from a memory-mapped binary cache file
+/** The cache file stores the vertex attribute arrays, the element indices,
+ *  the drawing instructions, the bounding sphere and the material names
+ *  made by another shape builder (typically ObjMesh or BlenderMesh),
+ *  together with the size and checksum of the source file from which
+ *  the mesh was loaded. The attribute arrays are stored as GLfloat values
+ *  in the native byte order so that they can be passed to Buffer::Data
+ *  directly from the mapped memory (see QueryVertexAttrib and IndexData).
+ *
+ *  @code
+ *  shapes::CachedMesh mesh = shapes::CachedMesh::Load(
+ *  	"model.obj",
+ *  	"model.obj.cache",
+ *  	[](void) { return shapes::ObjMesh("model.obj"); }
+ *  );
+ *  shapes::ShapeWrapper shape({"Position", "Normal"}, mesh, prog);
+ *  @endcode
+ *
+ *  @see ObjMesh
+ *  @see BlenderMesh
+ */
+class CachedMesh
+ : public DrawingInstructionWriter
+ , public DrawMode
+{
+private:
+	enum _section_index
+	{
+		_positions,
+		_normals,
+		_tangents,
+		_bitangents,
+		_texcoords,
+		_material_numbers,
+		_n_attribs,
+		_indices = _n_attribs,
+		_operations,
+		_material_names,
+		_n_sections
+	};
+
+	// the format version, byte order marker and section alignment
+	enum
+	{
+		_version = 1,
+		_byte_order = 0x01020304,
+		_align = 16
+	};
+
+	// the magic number of the cache files (without the terminating null)
+	static const char* _magic(void)
+	{
+		return "OGL+MESH";
+	}
+
+	struct _section
+	{
+		std::uint64_t offset;
+		std::uint64_t count;
+		GLuint values_per_vertex;
+		GLuint reserved;
+	};
+
+	struct _header
+	{
+		char magic[8];
+		GLuint version;
+		GLuint byte_order;
+		std::uint64_t source_size;
+		std::uint64_t source_checksum;
+		std::uint64_t payload_size;
+		std::uint64_t payload_checksum;
+		GLuint face_winding;
+		GLuint reserved;
+		GLfloat bounding_sphere[4];
+		_section sections[_n_sections];
+	};
+
+	// the data of a mesh to be written into a cache file
+	struct _mesh_data
+	{
+		FaceOrientation face_winding;
+		Spheref bounding_sphere;
+		std::vector<GLfloat> attribs[_n_attribs];
+		GLuint values_per_vertex[_n_attribs];
+		std::vector<GLuint> indices;
+		std::vector<DrawOperation> operations;
+		std::vector<std::string> material_names;
+	};
+
+	static const char** _attrib_names(void);
+
+	static std::uint64_t _checksum(const char* begin, const char* end);
+
+	static bool _source_info(
+		const char* source_path,
+		std::uint64_t& size,
+		std::uint64_t& checksum
+	);
+
+	static const _header* _check_header(const aux::MappedFile& file);
+
+	static void _write(
+		const _mesh_data& mesh,
+		const char* cache_path,
+		std::uint64_t source_size,
+		std::uint64_t source_checksum
+	);
+
+	template <typename ShapeBuilder>
+	static auto _get_material_names(
+		const ShapeBuilder& builder,
+		std::vector<std::string>& names,
+		int
+	) -> decltype(builder.MaterialCount(), void())
+	{
+		for(GLuint m=0, n=builder.MaterialCount(); m!=n; ++m)
+		{
+			names.push_back(builder.MaterialName(m));
+		}
+	}
+
+	template <typename ShapeBuilder>
+	static void _get_material_names(
+		const ShapeBuilder&,
+		std::vector<std::string>&,
+		...
+	)
+	{ }
+
+	template <typename ShapeBuilder>
+	static void _get_mesh_data(
+		const ShapeBuilder& builder,
+		_mesh_data& mesh
+	)
+	{
+		mesh.face_winding = builder.FaceWinding();
+		builder.BoundingSphere(mesh.bounding_sphere);
+
+		typename ShapeBuilder::VertexAttribs vert_attr_info;
+		OGLPLUS_FAKE_USE(vert_attr_info);
+
+		for(std::size_t a=0; a!=_n_attribs; ++a)
+		{
+			auto getter = vert_attr_info.VertexAttribGetter(
+				mesh.attribs[a],
+				_attrib_names()[a]
+			);
+			mesh.values_per_vertex[a] = 0;
+			if(getter != nullptr)
+			{
+				mesh.values_per_vertex[a] =
+					getter(builder, mesh.attribs[a]);
+			}
+		}
+
+		typename ShapeBuilder::IndexArray indices = builder.Indices();
+		mesh.indices.assign(indices.begin(), indices.end());
+		mesh.operations = builder.Instructions().Operations();
+
+		_get_material_names(builder, mesh.material_names, 0);
+	}
+
+	aux::MappedFile _file;
+	const _header* _hdr;
+	std::vector<std::string> _mtl_names;
+
+	template <typename T>
+	const T* _data(_section_index s) const
+	{
+		return reinterpret_cast<const T*>(
+			_file.Begin()+_hdr->sections[s].offset
+		);
+	}
+
+	std::size_t _count(_section_index s) const
+	{
+		return std::size_t(_hdr->sections[s].count);
+	}
+
+	template <typename T>
+	GLuint _get_attrib(_section_index s, std::vector<T>& dest) const
+	{
+		const GLfloat* values = _data<GLfloat>(s);
+		dest.clear();
+		dest.insert(dest.end(), values, values+_count(s));
+		return _hdr->sections[s].values_per_vertex;
+	}
+public:
+	/// Opens and maps the cache file at the specified @p cache_path
+	/** Throws if the file cannot be opened or is not a valid cache file.
+	 */
+	CachedMesh(const char* cache_path);
+
+	CachedMesh(CachedMesh&& temp)
+	 : _file(std::move(temp._file))
+	 , _hdr(temp._hdr)
+	 , _mtl_names(std::move(temp._mtl_names))
+	{
+		temp._hdr = nullptr;
+	}
+
+	/// Writes the mesh made by a @p builder into a cache file
+	/** The @p source_path is the path to the file from which the
+	 *  mesh was loaded by the builder. Its size and checksum are
+	 *  stored in the cache and checked by IsUpToDate.
+	 *  Throws if the source file cannot be read or if the cache
+	 *  file cannot be written. The cache is written into a temporary
+	 *  file which then replaces the @p cache_path, so a failed write
+	 *  does not leave a partially written cache behind.
+	 */
+	template <typename ShapeBuilder>
+	static void Write(
+		const ShapeBuilder& builder,
+		const char* cache_path,
+		const char* source_path
+	)
+	{
+		std::uint64_t source_size = 0, source_checksum = 0;
+		if(!_source_info(source_path, source_size, source_checksum))
+		{
+			throw std::runtime_error(
+				"Cached mesh: Unable to read source file: "+
+				std::string(source_path)
+			);
+		}
+
+		_mesh_data mesh;
+		_get_mesh_data(builder, mesh);
+		_write(mesh, cache_path, source_size, source_checksum);
+	}
+
+	/// Returns true if the cache file is valid and made from the source
+	/** Returns false if the cache file does not exist, is not a valid
+	 *  cache file or if the size or the checksum of the source file
+	 *  do not match the ones stored in the cache.
+	 */
+	static bool IsUpToDate(const char* cache_path, const char* source_path);
+
+	/// Loads the cached mesh, (re-)making the cache if it is stale
+	/** If the cache at @p cache_path is not up-to-date with the file
+	 *  at @p source_path then @p make_builder is called to load the
+	 *  mesh from the source and the result is written into the cache.
+	 */
+	template <typename MakeBuilder>
+	static CachedMesh Load(
+		const char* source_path,
+		const char* cache_path,
+		MakeBuilder make_builder
+	)
+	{
+		if(!IsUpToDate(cache_path, source_path))
+		{
+			Write(make_builder(), cache_path, source_path);
+		}
+		return CachedMesh(cache_path);
+	}
+
+	/// Checks the integrity of the cached data
+	/** Calculates the checksum of the whole cached payload and returns
+	 *  true if it matches the checksum stored in the cache file.
+	 */
+	bool VerifyChecksum(void) const;
+
+	/// Returns the winding direction of faces
+	FaceOrientation FaceWinding(void) const
+	{
+		return FaceOrientation(_hdr->face_winding);
+	}
+
+	typedef GLuint (CachedMesh::*VertexAttribFunc)(std::vector<GLfloat>&) const;
+
+	/// Makes the vertex positions and returns the number of values per vertex
+	template <typename T>
+	GLuint Positions(std::vector<T>& dest) const
+	{
+		return _get_attrib(_positions, dest);
+	}
+
+	/// Makes the vertex normals and returns the number of values per vertex
+	template <typename T>
+	GLuint Normals(std::vector<T>& dest) const
+	{
+		return _get_attrib(_normals, dest);
+	}
+
+	/// Makes the vertex tangents and returns the number of values per vertex
+	template <typename T>
+	GLuint Tangents(std::vector<T>& dest) const
+	{
+		return _get_attrib(_tangents, dest);
+	}
+
+	/// Makes the vertex bitangents and returns the number of values per vertex
+	template <typename T>
+	GLuint Bitangents(std::vector<T>& dest) const
+	{
+		return _get_attrib(_bitangents, dest);
+	}
+
+	/// Makes the texture coordinates returns the number of values per vertex
+	template <typename T>
+	GLuint TexCoordinates(std::vector<T>& dest) const
+	{
+		return _get_attrib(_texcoords, dest);
+	}
+
+	/// Makes the material numbers returns the number of values per vertex
+	template <typename T>
+	GLuint MaterialNumbers(std::vector<T>& dest) const
+	{
+		return _get_attrib(_material_numbers, dest);
+	}
+
+	/// Gets the mapped values of the vertex attribute with the specified name
+	/** Returns false if the mesh does not have the specified attribute.
+	 *  The returned @p values point into the mapped cache file and are
+	 *  valid during the lifetime of this CachedMesh.
+	 *
+	 *  @code
+	 *  const GLfloat* values = nullptr;
+	 *  GLuint count = 0, npv = 0;
+	 *  if(mesh.QueryVertexAttrib("Position", values, count, npv))
+	 *  {
+	 *  	Buffer::Data(Buffer::Target::Array, count, values);
+	 *  }
+	 *  @endcode
+	 */
+	bool QueryVertexAttrib(
+		StrCRef name,
+		const GLfloat*& values,
+		GLuint& count,
+		GLuint& values_per_vertex
+	) const;
+
+#if OGLPLUS_DOCUMENTATION_ONLY
+	/// Vertex attribute information for this shape builder
+	/** CachedMesh provides build functions for the following named
+	 *  vertex attributes (if they were made by the original builder):
+	 *  - "Position" the vertex positions
+	 *  - "Normal" the vertex normals
+	 *  - "Tangent" the vertex tangents
+	 *  - "Bitangent" the vertex bi-tangents
+	 *  - "TexCoord" the vertex texture coordinates
+	 *  - "Material" the vertex material numbers
+	 */
+	typedef VertexAttribsInfo<CachedMesh> VertexAttribs;
+#else
+	typedef VertexAttribsInfo<
+		CachedMesh,
+		std::tuple<
+			VertexPositionsTag,
+			VertexNormalsTag,
+			VertexTangentsTag,
+			VertexBitangentsTag,
+			VertexTexCoordinatesTag,
+			VertexMaterialNumbersTag
+		>
+	> VertexAttribs;
+#endif
+
+	/// Returns the number of material names
+	GLuint MaterialCount(void) const
+	{
+		return GLuint(_mtl_names.size());
+	}
+
+	/// Returns the name of the i-th material
+	const std::string& MaterialName(GLuint mat_num) const
+	{
+		return _mtl_names[mat_num];
+	}
+
+	/// Queries the bounding sphere coordinates and dimensions
+	template <typename T>
+	void BoundingSphere(oglplus::Sphere<T>& bounding_sphere) const
+	{
+		bounding_sphere = oglplus::Sphere<T>(
+			_hdr->bounding_sphere[0],
+			_hdr->bounding_sphere[1],
+			_hdr->bounding_sphere[2],
+			_hdr->bounding_sphere[3]
+		);
+	}
+
+	/// The type of the index container returned by Indices()
+	typedef std::vector<GLuint> IndexArray;
+
+	/// Returns element indices that are used with the drawing instructions
+	IndexArray Indices(Default = Default()) const
+	{
+		const GLuint* indices = IndexData();
+		return IndexArray(indices, indices+IndexCount());
+	}
+
+	/// Returns a pointer to the mapped element indices
+	const GLuint* IndexData(void) const
+	{
+		return _data<GLuint>(_indices);
+	}
+
+	/// Returns the number of element indices
+	GLuint IndexCount(void) const
+	{
+		return GLuint(_count(_indices));
+	}
+
+	/// Returns the instructions for rendering of faces
+	DrawingInstructions Instructions(Default = Default()) const;
+};
+
+} // shapes
+} // oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/cached_mesh.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -0,0 +1,266 @@
+/**
+ *  @file oglplus/shapes/draw_indirect.hpp
+ *  @brief Compilation of shape draw instructions into indirect draw commands
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_SHAPES_DRAW_INDIRECT_1509161047_HPP
+#define OGLPLUS_SHAPES_DRAW_INDIRECT_1509161047_HPP
+
+#include <oglplus/config/basic.hpp>
+#include <oglplus/shapes/draw.hpp>
+#include <oglplus/buffer.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace oglplus {
+namespace shapes {
+
+/// The layout of the commands read by MultiDrawArraysIndirect
+struct DrawArraysIndirectCommand
+{
+	GLuint count;
+	GLuint instance_count;
+	GLuint first;
+	GLuint base_instance;
+};
+
+/// The layout of the commands read by MultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+	GLuint count;
+	GLuint instance_count;
+	GLuint first_index;
+	GLint base_vertex;
+	GLuint base_instance;
+};
+
+/// A range of indirect draw commands submitted by a single multi-draw call
+struct DrawCommandBatch
+{
+	/// The draw method of all commands in the batch
+	DrawOperation::Method method;
+	/// The primitive type of all commands in the batch
+	PrimitiveType mode;
+	/// The type of the indices (used only by DrawElements batches)
+	DataType index_type;
+	/// Primitive restart index or DrawOperation::NoRestartIndex()
+	GLuint restart_index;
+	/// The phase of the drawing operations in the batch
+	GLuint phase;
+	/// The offset (in bytes) of the first command in the command data
+	GLintptr offset;
+	/// The number of commands in the batch
+	GLsizei count;
+};
+
+/// Merges the DrawingInstructions of one or many shapes into draw commands
+/** The drawing operations of the added instructions are grouped by their
+ *  draw method, primitive type, index type, primitive restart index and
+ *  phase and each group is compiled into a contiguous range of
+ *  DrawArraysIndirectCommand or DrawElementsIndirectCommand structures,
+ *  which can be submitted with a single MultiDraw*Indirect call.
+ *  The groups are ordered by the first operation added to them,
+ *  the operations inside of a group keep the order in which they
+ *  were added.
+ *
+ *  The vertex attributes and the indices of several shapes are supposed
+ *  to be stored one after another in shared buffers, the offsets of the
+ *  shape's data in these buffers are passed to the Add function.
+ *
+ *  @see DrawCommandBuffer
+ */
+class DrawCommandCompiler
+{
+private:
+	struct _group
+	{
+		DrawCommandBatch batch;
+		std::vector<GLuint> words;
+	};
+	std::vector<_group> _groups;
+	std::size_t _command_count;
+
+	_group& _find_group(
+		const DrawOperation& op,
+		DataType index_type
+	);
+
+	void _add(
+		const DrawingInstructions& instructions,
+		DataType index_type,
+		GLuint base_vertex,
+		GLuint base_index,
+		GLuint inst_count,
+		GLuint base_inst
+	);
+public:
+	DrawCommandCompiler(void)
+	 : _command_count(0)
+	{ }
+
+	/// Adds the operations of a shape to be drawn
+	/**
+	 *  @param instructions the drawing instructions of the shape.
+	 *  @param index_info the type of the shape's indices.
+	 *  @param base_vertex the offset (in vertices) of the shape's vertex
+	 *    attributes in the shared vertex buffers.
+	 *  @param base_index the offset (in indices) of the shape's indices
+	 *    in the shared element array buffer.
+	 *  @param inst_count the number of instances to be drawn.
+	 *  @param base_inst the first instance to be drawn.
+	 */
+	void Add(
+		const DrawingInstructions& instructions,
+		const ElementIndexInfo& index_info,
+		GLuint base_vertex = 0,
+		GLuint base_index = 0,
+		GLuint inst_count = 1,
+		GLuint base_inst = 0
+	)
+	{
+		_add(
+			instructions,
+			index_info.DataType(),
+			base_vertex,
+			base_index,
+			inst_count,
+			base_inst
+		);
+	}
+
+	/// Adds the operations of a shape drawn without indices
+	/**
+	 *  @throws std::runtime_error if the instructions use DrawElements.
+	 */
+	void Add(
+		const DrawingInstructions& instructions,
+		GLuint base_vertex = 0,
+		GLuint inst_count = 1,
+		GLuint base_inst = 0
+	);
+
+	/// Removes all added operations
+	void Clear(void)
+	{
+		_groups.clear();
+		_command_count = 0;
+	}
+
+	/// Returns the number of compiled draw commands
+	std::size_t CommandCount(void) const
+	{
+		return _command_count;
+	}
+
+	/// Returns the number of multi-draw calls needed to draw the commands
+	std::size_t BatchCount(void) const
+	{
+		return _groups.size();
+	}
+
+	/// Returns the batches of commands, in the order of the Data
+	std::vector<DrawCommandBatch> Batches(void) const;
+
+	/// Returns the commands of all batches, to be stored in a buffer
+	std::vector<GLuint> Data(void) const;
+};
+
+#if OGLPLUS_DOCUMENTATION_ONLY || GL_VERSION_4_3 || GL_ARB_multi_draw_indirect
+
+/// Indirect draw commands stored in a buffer and drawn by multi-draw calls
+/** Instances of this class store the commands made by a DrawCommandCompiler
+ *  in a buffer and draw them with one MultiDrawArraysIndirect or
+ *  MultiDrawElementsIndirect call per batch. The vertex array object
+ *  referencing the shared vertex buffers and element array buffer must
+ *  be bound when Draw is called.
+ *
+ *  @code
+ *  shapes::DrawCommandCompiler compiler;
+ *  compiler.Add(cube_instr, cube_index_info, 0, 0);
+ *  compiler.Add(torus_instr, torus_index_info, cube_verts, cube_indices);
+ *
+ *  shapes::DrawCommandBuffer commands(compiler);
+ *  scene_vao.Bind();
+ *  commands.Draw();
+ *  @endcode
+ *
+ *  @glvoereq{4,3,ARB,multi_draw_indirect}
+ */
+class DrawCommandBuffer
+{
+private:
+	Buffer _buffer;
+	std::vector<DrawCommandBatch> _batches;
+	std::size_t _command_count;
+
+	void _begin(void) const;
+	void _draw(const DrawCommandBatch& batch, GLuint& restart) const;
+	void _end(GLuint restart) const;
+
+	struct _default_driver
+	{
+		bool operator()(GLuint /*phase*/) const
+		{
+			return true;
+		}
+	};
+public:
+	/// Stores the commands compiled by the @p compiler into a buffer
+	DrawCommandBuffer(const DrawCommandCompiler& compiler);
+
+	/// Returns the number of draw commands
+	std::size_t CommandCount(void) const
+	{
+		return _command_count;
+	}
+
+	/// Returns the number of multi-draw calls issued by Draw
+	std::size_t BatchCount(void) const
+	{
+		return _batches.size();
+	}
+
+	/// Draws the batches of commands for which the @p driver returns true
+	/** The @p driver is called with the phase of each batch before
+	 *  the batch is drawn, see DrawOperation::phase.
+	 */
+	template <typename Driver>
+	void Draw(Driver driver) const
+	{
+		_begin();
+		GLuint restart = DrawOperation::NoRestartIndex();
+		for(const DrawCommandBatch& batch : _batches)
+		{
+			if(driver(batch.phase))
+			{
+				_draw(batch, restart);
+			}
+		}
+		_end(restart);
+	}
+
+	/// Draws all batches of commands
+	void Draw(void) const
+	{
+		Draw(_default_driver());
+	}
+};
+
+#endif // GL_VERSION_4_3 || GL_ARB_multi_draw_indirect
+
+} // namespace shapes
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/shapes/draw_indirect.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -44,8 +44,10 @@ private:
 		bool load_bitangents;
 		bool load_texcoords;
 		bool load_materials;
+		unsigned chunks;
 
 		_loading_options(bool load_all = true)
+		 : chunks(0)
 		{
 			All(load_all);
 		}
@@ -94,18 +96,27 @@ private:
 			load_materials = load;
 			return *this;
 		}
+
+		// the number of chunks the input is split into and parsed
+		// in parallel, zero selects it from the size of the input
+		// and from the number of hardware threads
+		_loading_options& Chunks(unsigned count)
+		{
+			chunks = count;
+			return *this;
+		}
 	};
 
 	// vertex positions
-	std::vector<double> _pos_data;
+	std::vector<GLfloat> _pos_data;
 	// vertex normals
-	std::vector<double> _nml_data;
+	std::vector<GLfloat> _nml_data;
 	// vertex tangents
-	std::vector<double> _tgt_data;
+	std::vector<GLfloat> _tgt_data;
 	// vertex bitangents
-	std::vector<double> _btg_data;
+	std::vector<GLfloat> _btg_data;
 	// vertex tex coords
-	std::vector<double> _tex_data;
+	std::vector<GLfloat> _tex_data;
 	// material numbers
 	std::vector<GLuint> _mtl_data;
 	// material names
@@ -131,25 +142,48 @@ private:
 	std::vector<GLuint> _mesh_offsets;
 	std::vector<GLuint> _mesh_counts;
 
-	bool _load_index(
+	// the bounding box of the (double precision) vertex positions
+	Vec3d _bbox_min, _bbox_max;
+
+	// a part of the input parsed by a single thread
+	struct _chunk;
+
+	static bool _load_index(
 		GLuint& value,
 		GLuint count,
-		std::string::const_iterator& i,
-		std::string::const_iterator& e
+		const char*& i,
+		const char* e
 	);
 
-	bool _load_indices(
+	static bool _load_indices(
 		_vert_indices& indices,
 		const _vert_indices& counts,
-		std::string::const_iterator& i,
-		std::string::const_iterator& e
+		const char*& i,
+		const char* e
+	);
+
+	static void _count_chunk(_chunk& chunk);
+
+	static void _parse_chunk(
+		_chunk& chunk,
+		double* pos_data,
+		double* nml_data,
+		double* tex_data
+	);
+
+	static void _calc_tangents(
+		const Vec3d* p,
+		const Vec2d* uv,
+		GLfloat* tgt,
+		GLfloat* btg
 	);
 
 	void _load_meshes(
 		const _loading_options& opts,
 		aux::AnyInputIter<const char*> names_begin,
 		aux::AnyInputIter<const char*> names_end,
-		std::istream& input
+		const char* input_begin,
+		const char* input_end
 	);
 
 	void _call_load_meshes(
@@ -158,6 +192,13 @@ private:
 		aux::AnyInputIter<const char*> names_end,
 		_loading_options opts
 	);
+
+	void _call_load_meshes(
+		const char* path,
+		aux::AnyInputIter<const char*> names_begin,
+		aux::AnyInputIter<const char*> names_end,
+		_loading_options opts
+	);
 public:
 	typedef _loading_options LoadingOptions;
 
@@ -185,6 +226,35 @@ public:
 		);
 	}
 
+	/// Loads the meshes from the .obj file at the specified @p path
+	/** This is the preferred way of loading large meshes. The file is
+	 *  memory-mapped (where supported) and its lines are parsed
+	 *  in parallel.
+	 */
+	ObjMesh(
+		const char* path,
+		LoadingOptions opts = LoadingOptions()
+	)
+	{
+		const char** p = nullptr;
+		_call_load_meshes(path, p, p, opts);
+	}
+
+	template <typename NameStr, std::size_t NN>
+	ObjMesh(
+		const char* path,
+		const std::array<NameStr, NN>& names,
+		LoadingOptions opts = LoadingOptions()
+	)
+	{
+		_call_load_meshes(
+			path,
+			names.begin(),
+			names.end(),
+			opts
+		);
+	}
+
 	/// Returns the winding direction of faces
 	FaceOrientation FaceWinding(void) const
 	{
@@ -247,6 +317,12 @@ public:
 		return 1;
 	}
 
+	/// Returns the number of materials (including the unnamed default)
+	GLuint MaterialCount(void) const
+	{
+		return GLuint(_mtl_names.size());
+	}
+
 	/// Returns the name of the i-th material
 	const std::string& MaterialName(GLuint mat_num) const
 	{
@@ -0,0 +1,395 @@
+/**
+ *  @file oglplus/state_cache.hpp
+ *  @brief Context-wide cache eliminating redundant state changes
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_STATE_CACHE_1509151022_HPP
+#define OGLPLUS_STATE_CACHE_1509151022_HPP
+
+#include <oglplus/config/compiler.hpp>
+#include <oglplus/config/object.hpp>
+#include <oglplus/config/gl.hpp>
+
+#include <vector>
+#include <cstring>
+#include <cstddef>
+
+namespace oglplus {
+namespace aux {
+
+enum class StateCacheGroup
+{
+	Binding,
+	IndexedBinding,
+	ActiveTexture,
+	Capability,
+	Blending,
+	Depth,
+	Viewport
+};
+
+struct StateCacheValue
+{
+	GLuint64 v[4];
+
+	friend bool operator == (
+		const StateCacheValue& a,
+		const StateCacheValue& b
+	)
+	{
+		return	(a.v[0] == b.v[0]) &&
+			(a.v[1] == b.v[1]) &&
+			(a.v[2] == b.v[2]) &&
+			(a.v[3] == b.v[3]);
+	}
+};
+
+struct StateCacheSlot
+{
+	StateCacheGroup group;
+	GLenum name;
+	GLuint index;
+	StateCacheValue value;
+};
+
+inline GLuint64 StateCacheBits(GLfloat value)
+{
+	GLuint bits = 0;
+	static_assert(sizeof(bits) == sizeof(value), "Unexpected GLfloat size");
+	std::memcpy(&bits, &value, sizeof(bits));
+	return GLuint64(bits);
+}
+
+} // namespace aux
+
+/// Context-wide cache eliminating redundant state changes
+/** The state cache shadows the values of the object bindings (buffers,
+ *  textures and texture units, samplers, framebuffers, renderbuffers,
+ *  vertex arrays, programs, program pipelines and transform feedbacks),
+ *  of the enabled capabilities, of the blend equation, function and color,
+ *  of the depth function and depth mask and of the viewport.
+ *  When a StateCache is current in the calling thread, the OGLplus
+ *  functions changing these values (like @c Bind, @c Use, @c Texture::Active,
+ *  @c Context::Enable, @c Context::BlendFunc, @c Context::DepthFunc
+ *  or @c Context::Viewport) do not call GL if the new value is the same
+ *  as the cached one. The values are cached after they were successfully
+ *  set through OGLplus, until then the GL is always called.
+ *
+ *  The cache is made current in the constructor and the previously current
+ *  cache is restored in the destructor. There should be one cache per
+ *  GL context, used in the thread where the context is current.
+ *  If the state is changed by GL code not using OGLplus, then
+ *  the Invalidate function must be called afterwards.
+ *
+ *  @code
+ *  StateCache state_cache;
+ *
+ *  // rendering using OGLplus
+ *
+ *  state_cache.Invalidate();
+ *  foreign_library_render();
+ *
+ *  std::cout << state_cache.SavedCount() << " calls saved" << std::endl;
+ *  @endcode
+ *
+ *  @note The cache does not track the changes done by the functions of
+ *  the multi-bind and indexed variants of the covered functions, these
+ *  just drop the affected cached values.
+ *
+ *  @see OGLPLUS_NO_STATE_CACHE
+ */
+class StateCache
+{
+private:
+	typedef aux::StateCacheGroup _group;
+
+	std::vector<aux::StateCacheSlot> _slots;
+	StateCache* _prev;
+	unsigned long _call_count;
+	unsigned long _saved_count;
+
+	static StateCache*& _current_ref(void)
+	{
+#if !OGLPLUS_NO_THREADS
+		static thread_local StateCache* current = nullptr;
+#else
+		static StateCache* current = nullptr;
+#endif
+		return current;
+	}
+
+	aux::StateCacheSlot* _find(_group group, GLenum name, GLuint index)
+	{
+		for(aux::StateCacheSlot& slot : _slots)
+		{
+			if(	(slot.name == name) &&
+				(slot.index == index) &&
+				(slot.group == group)
+			) return &slot;
+		}
+		return nullptr;
+	}
+
+	template <typename Pred>
+	void _forget_if(Pred pred)
+	{
+		std::size_t i = 0;
+		while(i < _slots.size())
+		{
+			if(pred(_slots[i]))
+			{
+				_slots[i] = _slots.back();
+				_slots.pop_back();
+			}
+			else ++i;
+		}
+	}
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	StateCache(const StateCache&) = delete;
+	StateCache& operator = (const StateCache&) = delete;
+#else
+	StateCache(const StateCache&);
+	StateCache& operator = (const StateCache&);
+#endif
+public:
+	/// Creates an empty cache and makes it current in the calling thread
+	StateCache(void)
+	 : _prev(_current_ref())
+	 , _call_count(0)
+	 , _saved_count(0)
+	{
+		_slots.reserve(32);
+		_current_ref() = this;
+	}
+
+	/// Makes the previously current cache current again
+	~StateCache(void)
+	{
+		_current_ref() = _prev;
+	}
+
+	/// Returns the cache current in the calling thread or nullptr
+	static StateCache* Current(void)
+	{
+#if !OGLPLUS_NO_STATE_CACHE
+		return _current_ref();
+#else
+		return nullptr;
+#endif
+	}
+
+	/// Drops all cached values
+	/** This function must be called after the GL state was changed
+	 *  by code not using OGLplus.
+	 */
+	void Invalidate(void)
+	{
+		_slots.clear();
+	}
+
+	/// The number of state changes checked against the cache
+	unsigned long CallCount(void) const
+	{
+		return _call_count;
+	}
+
+	/// The number of redundant state changes that were not sent to GL
+	unsigned long SavedCount(void) const
+	{
+		return _saved_count;
+	}
+
+	/// Resets the call counters
+	void ResetCounters(void)
+	{
+		_call_count = 0;
+		_saved_count = 0;
+	}
+
+	// implementation details
+
+	bool _check(
+		_group group,
+		GLenum name,
+		GLuint index,
+		const aux::StateCacheValue& value
+	)
+	{
+		++_call_count;
+		aux::StateCacheSlot* slot = _find(group, name, index);
+		if(slot && (slot->value == value))
+		{
+			++_saved_count;
+			return true;
+		}
+		return false;
+	}
+
+	void _update(
+		_group group,
+		GLenum name,
+		GLuint index,
+		const aux::StateCacheValue& value
+	)
+	{
+		if(aux::StateCacheSlot* slot = _find(group, name, index))
+		{
+			slot->value = value;
+		}
+		else
+		{
+			aux::StateCacheSlot new_slot = {group, name, index, value};
+			_slots.push_back(new_slot);
+		}
+	}
+
+	bool _active_texture(GLuint& unit)
+	{
+		aux::StateCacheSlot* slot =
+			_find(_group::ActiveTexture, GL_ACTIVE_TEXTURE, 0);
+		if(slot)
+		{
+			unit = GLuint(slot->value.v[0]);
+			return true;
+		}
+		return false;
+	}
+
+	// drops the cached values of the specified name (for all indices)
+	void _forget(_group group, GLenum name)
+	{
+		_forget_if([group, name](const aux::StateCacheSlot& slot) -> bool
+		{
+			return (slot.group == group) && (slot.name == name);
+		});
+	}
+
+	// drops all cached values of the specified group
+	void _forget(_group group)
+	{
+		_forget_if([group](const aux::StateCacheSlot& slot) -> bool
+		{
+			return slot.group == group;
+		});
+	}
+
+	// drops the bindings of objects with the specified names
+	void _forget_names(std::size_t count, const GLuint* names)
+	{
+		_forget_if([count, names](const aux::StateCacheSlot& slot) -> bool
+		{
+			if(	(slot.group != _group::Binding) &&
+				(slot.group != _group::IndexedBinding)
+			) return false;
+			for(std::size_t i=0; i!=count; ++i)
+			{
+				if(slot.value.v[0] == GLuint64(names[i]))
+				{
+					return true;
+				}
+			}
+			return false;
+		});
+	}
+};
+
+namespace aux {
+
+// A state value to be checked against and stored in the current StateCache
+class StateCacheEntry
+{
+private:
+	StateCache* _cache;
+	StateCacheGroup _group;
+	GLenum _name;
+	GLuint _index;
+	StateCacheValue _value;
+public:
+	StateCacheEntry(
+		StateCacheGroup group,
+		GLenum name,
+		GLuint index,
+		GLuint64 v0,
+		GLuint64 v1 = 0,
+		GLuint64 v2 = 0,
+		GLuint64 v3 = 0
+	): _cache(StateCache::Current())
+	 , _group(group)
+	 , _name(name)
+	 , _index(index)
+	{
+		_value.v[0] = v0;
+		_value.v[1] = v1;
+		_value.v[2] = v2;
+		_value.v[3] = v3;
+	}
+
+	// the binding of a texture to the currently active texture unit,
+	// not cached until the active unit is set through OGLplus
+	static StateCacheEntry TextureBinding(GLenum target, GLuint texture)
+	{
+		StateCacheEntry result(
+			StateCacheGroup::Binding,
+			target,
+			0,
+			texture
+		);
+		if(result._cache)
+		{
+			if(!result._cache->_active_texture(result._index))
+			{
+				result._cache = nullptr;
+			}
+		}
+		return result;
+	}
+
+	// returns true if the value is already set and the call can be skipped
+	bool Current(void) const
+	{
+		return _cache && _cache->_check(_group, _name, _index, _value);
+	}
+
+	// stores the value after it was successfully set
+	void Update(void) const
+	{
+		if(_cache) _cache->_update(_group, _name, _index, _value);
+	}
+};
+
+inline void StateCacheForget(StateCacheGroup group, GLenum name)
+{
+	if(StateCache* cache = StateCache::Current())
+	{
+		cache->_forget(group, name);
+	}
+}
+
+inline void StateCacheForget(StateCacheGroup group)
+{
+	if(StateCache* cache = StateCache::Current())
+	{
+		cache->_forget(group);
+	}
+}
+
+inline void StateCacheForgetNames(std::size_t count, const GLuint* names)
+{
+	if(StateCache* cache = StateCache::Current())
+	{
+		cache->_forget_names(count, names);
+	}
+}
+
+} // namespace aux
+} // namespace oglplus
+
+#endif // include guard
@@ -0,0 +1,309 @@
+/**
+ *  @file oglplus/streaming_buffer.hpp
+ *  @brief Persistently mapped ring-buffer for per-frame dynamic data
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#pragma once
+#ifndef OGLPLUS_STREAMING_BUFFER_1509081227_HPP
+#define OGLPLUS_STREAMING_BUFFER_1509081227_HPP
+
+#include <oglplus/buffer.hpp>
+#include <oglplus/sync.hpp>
+
+#include <vector>
+#include <cassert>
+
+namespace oglplus {
+
+#if OGLPLUS_DOCUMENTATION_ONLY || \
+	((GL_VERSION_4_4 || GL_ARB_buffer_storage) && \
+	(GL_VERSION_3_2 || GL_ARB_sync))
+
+/// A typed range of a StreamingBuffer allocated for the current frame
+/** The span points directly into the persistently mapped storage,
+ *  values written through it become visible to the GL without any
+ *  further map, unmap or flush calls.
+ *
+ *  @see StreamingBuffer::Allocate
+ */
+template <typename T>
+class StreamingSpan
+{
+private:
+	T* _ptr;
+	std::size_t _count;
+	GLintptr _offset;
+public:
+	/// Constructs an empty span
+	StreamingSpan(void)
+	 : _ptr(nullptr)
+	 , _count(0)
+	 , _offset(0)
+	{ }
+
+	StreamingSpan(T* ptr, std::size_t count, GLintptr offset)
+	 : _ptr(ptr)
+	 , _count(count)
+	 , _offset(offset)
+	{ }
+
+	/// Returns true if the span is empty
+	bool Empty(void) const
+	{
+		return _count == 0;
+	}
+
+	/// Returns the number of instances of T in the span
+	std::size_t Count(void) const
+	{
+		return _count;
+	}
+
+	/// Returns the size of the span in bytes
+	BufferSize Size(void) const
+	{
+		return BufferSize(GLsizeiptr(sizeof(T)*_count));
+	}
+
+	/// Returns the offset of the span from the start of the buffer
+	/** This is the value to be used as the offset in BindRange,
+	 *  vertex attribute pointers or as the index offset in draw calls.
+	 */
+	BufferSize Offset(void) const
+	{
+		return BufferSize(GLsizeiptr(_offset));
+	}
+
+	/// Returns a pointer to the mapped data
+	T* Data(void) const
+	{
+		return _ptr;
+	}
+
+	/// Returns a reference to the i-th element in the span
+	T& At(std::size_t index) const
+	{
+		assert(index < _count);
+		return _ptr[index];
+	}
+
+	/// Returns a reference to the i-th element in the span
+	T& operator [](std::size_t index) const
+	{
+		return At(index);
+	}
+
+	T* begin(void) const
+	{
+		return _ptr;
+	}
+
+	T* end(void) const
+	{
+		return _ptr+_count;
+	}
+};
+
+/// Persistently mapped ring-buffer for per-frame vertex, index or uniform data
+/** The StreamingBuffer allocates immutable storage for a buffer object
+ *  (with @c BufferStorage), maps it once for writing with the persistent
+ *  and coherent flags and keeps it mapped for its whole lifetime.
+ *  The storage is divided into several (three by default) equally sized
+ *  regions that are used in round-robin fashion, one region per frame.
+ *  The data for the current frame is sub-allocated linearly from
+ *  the current region by the Allocate functions, which just return
+ *  a typed span pointing into the mapped memory.
+ *
+ *  When the frame is finished, a fence is placed into the command stream
+ *  for the current region and the buffer switches to the next region,
+ *  waiting on the fence guarding that region if the GL has not yet
+ *  finished reading from it. If the GL does not finish with the region
+ *  within the WaitTimeout or if the wait fails, FinishFrame throws.
+ *
+ *  The buffer is bound to the target specified in the constructor
+ *  and stays bound to it after the construction.
+ *
+ *  @glvoereq{4,4,ARB,buffer_storage}
+ */
+class StreamingBuffer
+{
+private:
+	Buffer _buffer;
+	BufferTarget _target;
+	GLsizeiptr _region_size;
+	GLsizeiptr _region_offset;
+	GLsizeiptr _used;
+	GLsizeiptr _uniform_alignment;
+	GLubyte* _ptr;
+	std::vector<Sync> _fences;
+	std::size_t _region;
+	unsigned long _stall_count;
+	GLuint64 _wait_timeout;
+
+	static GLsizeiptr _align(GLsizeiptr offset, GLsizeiptr alignment)
+	{
+		assert(alignment > 0);
+		return ((offset+alignment-1)/alignment)*alignment;
+	}
+
+	GLintptr _allocate(GLsizeiptr size, GLsizeiptr alignment);
+
+#if !OGLPLUS_NO_DELETED_FUNCTIONS
+	StreamingBuffer(const StreamingBuffer&) = delete;
+	StreamingBuffer& operator = (const StreamingBuffer&) = delete;
+#else
+	StreamingBuffer(const StreamingBuffer&);
+	StreamingBuffer& operator = (const StreamingBuffer&);
+#endif
+public:
+	/// Creates the storage and persistently maps it
+	/**
+	 *  @param target the target to which the buffer is bound
+	 *  @param region_size the size (in bytes) of the data for one frame
+	 *  @param region_count the number of frames in flight
+	 *
+	 *  @glsymbols
+	 *  @glfunref{BufferStorage}
+	 *  @glfunref{MapBufferRange}
+	 *
+	 *  @throws Error
+	 */
+	StreamingBuffer(
+		BufferTarget target,
+		BufferSize region_size,
+		std::size_t region_count = 3
+	);
+
+	/// Unmaps the buffer
+	~StreamingBuffer(void);
+
+	/// Returns the underlying buffer object
+	const Buffer& Object(void) const
+	{
+		return _buffer;
+	}
+
+	/// Binds the underlying buffer to the target specified in constructor
+	void Bind(void) const
+	{
+		_buffer.Bind(_target);
+	}
+
+	/// Returns the size of a single region (the data for one frame)
+	BufferSize RegionSize(void) const
+	{
+		return BufferSize(_region_size);
+	}
+
+	/// Returns the number of regions in the ring
+	std::size_t RegionCount(void) const
+	{
+		return _fences.size();
+	}
+
+	/// Returns the number of bytes still available in the current region
+	BufferSize Available(void) const
+	{
+		return BufferSize(_region_size-_used);
+	}
+
+	/// Returns the number of times FinishFrame had to wait for the GPU
+	unsigned long StallCount(void) const
+	{
+		return _stall_count;
+	}
+
+	/// Returns the maximum time (in nanoseconds) FinishFrame waits for a region
+	GLuint64 WaitTimeout(void) const
+	{
+		return _wait_timeout;
+	}
+
+	/// Sets the maximum time (in nanoseconds) FinishFrame waits for a region
+	void WaitTimeout(GLuint64 timeout)
+	{
+		_wait_timeout = timeout;
+	}
+
+	/// Allocates @p count instances of T from the current region
+	/**
+	 *  @throws std::runtime_error if the current region does not
+	 *  have enough space left for the requested data.
+	 */
+	template <typename T>
+	StreamingSpan<T> Allocate(
+		std::size_t count,
+		std::size_t alignment = alignof(T)
+	)
+	{
+		GLintptr offset = _allocate(
+			GLsizeiptr(sizeof(T)*count),
+			GLsizeiptr(alignment)
+		);
+		return StreamingSpan<T>(
+			reinterpret_cast<T*>(_ptr+offset),
+			count,
+			offset
+		);
+	}
+
+	/// Allocates @p count instances of T for use as uniform block data
+	/** The offset of the returned span is aligned to the value of
+	 *  @c UNIFORM_BUFFER_OFFSET_ALIGNMENT so that it can be directly
+	 *  used with BindRange.
+	 *
+	 *  @throws std::runtime_error
+	 */
+	template <typename T>
+	StreamingSpan<T> AllocateUniform(std::size_t count = 1)
+	{
+		std::size_t alignment = std::size_t(_uniform_alignment);
+		if(alignment < alignof(T))
+		{
+			alignment = alignof(T);
+		}
+		return Allocate<T>(count, alignment);
+	}
+
+	/// Binds the range of the specified @p span to the indexed @p target
+	template <typename T>
+	void BindRange(
+		BufferIndexedTarget target,
+		GLuint index,
+		const StreamingSpan<T>& span
+	) const
+	{
+		_buffer.BindRange(target, index, span.Offset(), span.Size());
+	}
+
+	/// Finishes the current frame and switches to the next region
+	/** Places a fence guarding the current region and waits until
+	 *  the GL is done with the data in the next region.
+	 *  All spans allocated in the current frame must not be written to
+	 *  after this call.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{FenceSync}
+	 *  @glfunref{ClientWaitSync}
+	 *
+	 *  @throws std::runtime_error if the wait fails or if the GL
+	 *  is not done with the next region within WaitTimeout().
+	 */
+	void FinishFrame(void);
+};
+
+#endif // buffer_storage && sync
+
+} // namespace oglplus
+
+#if !OGLPLUS_LINK_LIBRARY || defined(OGLPLUS_IMPLEMENTING_LIBRARY)
+#include <oglplus/streaming_buffer.ipp>
+#endif // OGLPLUS_LINK_LIBRARY
+
+#endif // include guard
@@ -46,6 +46,29 @@ void ConvertUTF8ToCodePoints(
 	std::vector<UnicodeCP>& result
 );
 
+// Decodes the UTF-8 sequence into at most max_cps code points at cps
+// without allocating any memory. Only the valid (RFC 3629) forms are
+// accepted. Decoding stops at the first invalid or truncated sequence
+// or when the output is full. Returns the number of consumed bytes,
+// the number of written code points is stored into cp_count.
+std::size_t DecodeUTF8(
+	const char* str,
+	std::size_t len,
+	UnicodeCP* cps,
+	std::size_t max_cps,
+	std::size_t& cp_count
+);
+
+// Decodes the UTF-8 sequence into at most max_cps code points at cps
+// replacing the invalid sequences with U+FFFD, returns the number
+// of written code points
+std::size_t ConvertUTF8ToCodePoints(
+	const char* str,
+	std::size_t len,
+	UnicodeCP* cps,
+	std::size_t max_cps
+);
+
 class UTF8Validator
 {
 protected:
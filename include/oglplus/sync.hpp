@@ -20,6 +20,9 @@
 #include <oglplus/enums/sync_status.hpp>
 #include <oglplus/enums/sync_wait_result.hpp>
 
+#include <stdexcept>
+#include <string>
+
 namespace oglplus {
 
 // NOTE: Xlib.h defines this symbol
@@ -88,6 +91,18 @@ public:
 		temp._sync = 0;
 	}
 
+	/// Sync objects are move-assignable
+	Sync& operator = (Sync&& temp)
+	{
+		if(this != &temp)
+		{
+			if(_sync != 0) OGLPLUS_GLFUNC(DeleteSync)(_sync);
+			_sync = temp._sync;
+			temp._sync = 0;
+		}
+		return *this;
+	}
+
 	~Sync(void)
 	{
 		if(_sync != 0) OGLPLUS_GLFUNC(DeleteSync)(_sync);
@@ -186,6 +201,27 @@ public:
 		return SyncWaitResult(result);
 	}
 
+	/// Flush the GL commands and wait for the condition to be satisfied
+	/** Unlike ClientWait this flushes the command stream (including
+	 *  the fence itself) before blocking, so that a wait with a non-zero
+	 *  @p timeout does not expire just because the fence was not yet
+	 *  submitted to the GL server.
+	 *
+	 *  @glsymbols
+	 *  @glfunref{ClientWaitSync}
+	 *  @gldefref{SYNC_FLUSH_COMMANDS_BIT}
+	 */
+	SyncWaitResult ClientWaitFlush(GLuint64 timeout) const
+	{
+		GLenum result = OGLPLUS_GLFUNC(ClientWaitSync)(
+			_sync,
+			GL_SYNC_FLUSH_COMMANDS_BIT,
+			timeout
+		);
+		OGLPLUS_VERIFY_SIMPLE(ClientWaitSync);
+		return SyncWaitResult(result);
+	}
+
 	/// Wait for the condition to be satisfied
 	/**
 	 *  @glsymbols
@@ -198,6 +234,55 @@ public:
 	}
 };
 
+namespace aux {
+
+// Checks without blocking if a fence is signaled.
+// Throws std::runtime_error if the wait fails.
+inline bool SyncSignaled(const Sync& fence, const char* user)
+{
+	SyncWaitResult result = fence.ClientWait(0);
+	if(result == SyncWaitResult::WaitFailed)
+	{
+		throw std::runtime_error(
+			std::string(user)+": Waiting for a fence failed"
+		);
+	}
+	return result != SyncWaitResult::TimeoutExpired;
+}
+
+// Waits until a fence is signaled. If it is not signaled yet then
+// the command stream is flushed by the first (and only) blocking wait
+// which takes at most timeout nanoseconds. Returns true if the wait
+// had to block. Throws std::runtime_error if the wait fails or if
+// the timeout expires.
+inline bool SyncWaitFlush(
+	const Sync& fence,
+	GLuint64 timeout,
+	const char* user
+)
+{
+	if(SyncSignaled(fence, user))
+	{
+		return false;
+	}
+	SyncWaitResult result = fence.ClientWaitFlush(timeout);
+	if(result == SyncWaitResult::TimeoutExpired)
+	{
+		throw std::runtime_error(
+			std::string(user)+": Timeout expired waiting for a fence"
+		);
+	}
+	if(result == SyncWaitResult::WaitFailed)
+	{
+		throw std::runtime_error(
+			std::string(user)+": Waiting for a fence failed"
+		);
+	}
+	return true;
+}
+
+} // namespace aux
+
 #endif // sync
 
 } // namespace oglplus
@@ -69,6 +69,12 @@ public:
 	{
 		return _essence->GetGlyphMetrics(cp, 0);
 	}
+
+	// Returns the pager of the font (providing page hit statistics)
+	const BitmapGlyphPager& Pager(void) const
+	{
+		return _essence->Pager();
+	}
 };
 
 } // namespace text
@@ -51,43 +51,22 @@ private:
 	const GLuint _initial_frame;
 	BitmapGlyphPageStorage _page_storage;
 
-	template <typename PageGetter, typename Element>
-	void _do_load_pages(
-		PageGetter get_page,
-		const Element* elem,
-		GLsizei size
-	)
+	// loads a page into a frame of the page storage
+	struct _page_loader
 	{
-		_page_storage.Bind();
-		// go through the list of code-points
-		for(GLsizei i=0; i!=size; ++i)
-		{
-			// get the page number for the glyph
-			GLuint page = get_page(elem[i]);
-			// check if the page is active
-			if(!_pager.UsePage(page))
-			{
-				// if not let the pager find
-				// a frame for the new page
-				auto frame = _pager.FindFrame();
-				// load the bitmap image
-				_page_storage.LoadPage(
-					frame,
-					_load_page_bitmap(page),
-					_load_page_metric(page)
-				);
-				// tell the pages that the page
-				// is successfully loaded in the frame
-				_pager.SwapPageIn(frame, page);
-			}
-		}
-	}
+		BitmapGlyphFontEssence& _essence;
 
-	struct _page_to_page
-	{
-		GLuint operator()(GLuint page) const
+		_page_loader(BitmapGlyphFontEssence& essence)
+		 : _essence(essence)
+		{ }
+
+		void operator()(GLuint frame, GLuint page) const
 		{
-			return page;
+			_essence._page_storage.LoadPage(
+				frame,
+				_essence._load_page_bitmap(page),
+				_essence._load_page_metric(page)
+			);
 		}
 	};
 public:
@@ -118,6 +97,7 @@ public:
 	)
 	{
 		_pager.SwapPageIn(_initial_frame, default_page);
+		_pager.Flush();
 	}
 
 	void Use(void) const
@@ -144,7 +124,13 @@ public:
 	void LoadPages(const GLuint* pages, SizeType size)
 	{
 		assert(size < GLsizei(_pager.FrameCount()));
-		_do_load_pages(_page_to_page(), pages, size);
+		_page_storage.Bind();
+		_pager.LoadPages(pages, size, _page_loader(*this));
+	}
+
+	const BitmapGlyphPager& Pager(void) const
+	{
+		return _pager;
 	}
 
 	GLfloat QueryXOffsets(
@@ -28,6 +28,9 @@ class BitmapGlyphRenderingTpl;
 // Forward declaration of the renderer
 class BitmapGlyphRenderer;
 
+// Forward declaration of the page manager
+class BitmapGlyphPager;
+
 // Forward declarations of font essences
 class BitmapGlyphFontEssence;
 class STBTTFontEssence;
@@ -56,6 +59,9 @@ unsigned BitmapGlyphPagesPerPlane(const BitmapGlyphRenderingBase&);
 // One plane consists of PagesPerPlane pages of GlyphsPerPage glyphs
 unsigned BitmapGlyphPlaneCount(const BitmapGlyphRenderingBase&);
 
+// Returns the number of pages following a used page that should be prefetched
+unsigned BitmapGlyphPagePrefetch(const BitmapGlyphRenderingBase&);
+
 void BitmapGlyphAllocateLayoutData(
 	BitmapGlyphRenderingBase& parent,
 	BitmapGlyphLayoutData& layout_data
@@ -128,7 +128,8 @@ public:
 
 	void Set(StrCRef str)
 	{
-		Set(UTF8ToCodePoints(str.begin(), str.size()));
+		CodePointBuffer<256> cps(str.begin(), str.size());
+		Set(cps.Data(), cps.Size());
 	}
 };
 
@@ -18,77 +18,101 @@
 #include <oglplus/text/bitmap_glyph/fwd.hpp>
 
 #include <vector>
-#include <unordered_map>
 #include <cassert>
 
 namespace oglplus {
 namespace text {
 
+// Keeps track of the glyph pages loaded in the frames of the page storage
+//
+// The occupied frames are kept in a doubly-linked list ordered from
+// the most to the least recently used one, so finding, touching and
+// evicting frames are constant-time operations. The frame of a page
+// is looked up directly in a CPU-side copy of the page map, which
+// is indexed by the page number (the pages of the individual unicode
+// planes follow each other). The changes of the page map are collected
+// and uploaded to the GPU by a single sub-range update in Flush.
 class BitmapGlyphPager
 {
 private:
 	// reference to the parent rendering system
 	BitmapGlyphRenderingBase& _parent;
 
-	// the frames into which pages are loaded
-	std::vector<GLint> _frames;
+	typedef GLubyte gpu_frame_t;
 
-	// basic logical consistency check
-	bool _is_ok(void) const
+	static gpu_frame_t _invalid_gpu_frame(void)
 	{
-		return (_frames.size() == _ages.size()) &&
-			(_active_pages.size() <= _frames.size());
+		return gpu_frame_t(~gpu_frame_t(0));
 	}
 
-	// checks if the values in _frames and _gpu_page_map
-	// are consistent
-	bool _frames_consistent(void) const;
-
-	// checks if the specified page is in _frames
-	bool _page_in_frames(GLuint page) const;
-
-	typedef unsigned long age_t;
-
-	static age_t _zero_age(void)
+	static GLuint _nil(void)
 	{
-		return age_t(0);
+		return ~GLuint(0);
 	}
 
-	static age_t _full_age(void)
-	{
-		return ~_zero_age();
-	}
+	// the pages loaded into the frames (-1 for free frames)
+	std::vector<GLint> _frames;
 
-	static age_t _init_age(void)
-	{
-		return ~(_full_age() >> 1);
-	}
+	// the free frames
+	std::vector<GLuint> _free_frames;
 
-	std::vector<age_t> _ages;
+	// the list of occupied frames ordered by the time of last usage
+	std::vector<GLuint> _lru_prev;
+	std::vector<GLuint> _lru_next;
+	GLuint _lru_head;
+	GLuint _lru_tail;
 
-	std::unordered_map<GLuint, GLuint> _active_pages;
+	void _lru_unlink(GLuint frame);
+	void _lru_push_front(GLuint frame);
+	void _lru_push_back(GLuint frame);
 
-	typedef GLubyte gpu_frame_t;
+	// copy of the page map stored on the GPU
+	std::vector<gpu_frame_t> _page_map;
 
-	static gpu_frame_t _invalid_gpu_frame(void)
+	// the range of the page map entries not uploaded to the GPU yet
+	GLuint _dirty_begin;
+	GLuint _dirty_end;
+
+	void _set_frame_of_page(GLuint page, gpu_frame_t frame)
 	{
-		return gpu_frame_t(~gpu_frame_t(0));
+		assert(page < _page_map.size());
+		_page_map[page] = frame;
+		if(_dirty_begin > page) _dirty_begin = page;
+		if(_dirty_end <= page) _dirty_end = page+1;
 	}
 
-	// notes frame usage
-	void _touch_frame(std::size_t frame)
+	// the number of pages following a loaded page that are prefetched
+	const GLuint _prefetch;
+
+	// statistics
+	unsigned long _hit_count;
+	unsigned long _miss_count;
+	unsigned long _eviction_count;
+	unsigned long _prefetch_count;
+	unsigned long _upload_count;
+
+	// basic logical consistency check
+	bool _is_ok(void) const
 	{
-		_ages[frame] >>= 1;
-		_ages[frame] |= _init_age();
+		return (_frames.size() == _lru_prev.size()) &&
+			(_frames.size() == _lru_next.size()) &&
+			(_free_frames.size() <= _frames.size());
 	}
 
+	// checks if the values in _frames and _page_map are consistent
+	bool _frames_consistent(void) const;
+
 	Buffer _gpu_page_map;
 	TextureUnitSelector _pg_map_tex_unit;
 	Texture _page_map_tex;
 
-	// replaces the page in the specified frame
-	// with a new one
-	void _replace_page(GLuint frame, GLuint page);
+	// replaces the page in the specified frame with a new one
+	// and puts the frame at the front or at the back of the LRU list
+	void _replace_page(GLuint frame, GLuint page, bool recent);
+
+	// returns a page following after the specified page in the same plane
+	// that should be prefetched or _nil()
+	GLuint _prefetch_candidate(GLuint page, GLuint offs) const;
 public:
 	BitmapGlyphPager(
 		BitmapGlyphRenderingBase& parent,
@@ -98,6 +122,7 @@ public:
 
 	void Bind(void) const
 	{
+		assert(!(_dirty_begin < _dirty_end));
 		Texture::Active(_pg_map_tex_unit);
 		_page_map_tex.Bind(Texture::Target::Buffer);
 	}
@@ -113,31 +138,129 @@ public:
 		return _pg_map_tex_unit;
 	}
 
-	void Update(void)
+	// finds the best frame for a new page
+	// (a free frame or the least recently used one)
+	GLuint FindFrame(void) const
 	{
 		assert(_is_ok());
-		for(auto i=_ages.begin(), e=_ages.end(); i!=e; ++i)
+		if(!_free_frames.empty())
 		{
-			*i >>= 1;
+			return _free_frames.back();
 		}
+		assert(_lru_tail != _nil());
+		return _lru_tail;
 	}
 
-	// finds the best frame for a new page
-	GLuint FindFrame(void);
-
 	// Checks if a page is available for usage
+	// and marks it as the most recently used one
 	bool UsePage(GLuint page);
 
-	GLint FrameOfPage(GLuint page) const;
+	GLint FrameOfPage(GLuint page) const
+	{
+		assert(page < _page_map.size());
+		gpu_frame_t frame = _page_map[page];
+		return (frame != _invalid_gpu_frame())?GLint(frame):GLint(-1);
+	}
 
 	// Swaps the specified page into a frame
-	// Use only if the page is not already swapped in
+	// Use only if the page is not already swapped in.
+	// The change is uploaded to the GPU by the next call to Flush.
 	void SwapPageIn(GLuint frame, GLuint page)
 	{
 		assert(_is_ok());
-		_replace_page(frame, page);
+		_replace_page(frame, page, true);
 		assert(_frames_consistent());
 	}
+
+	// Uploads the changed part of the page map to the GPU
+	void Flush(void);
+
+	// Makes the specified pages available, loading the missing ones
+	//
+	// The loader is called with the frame and the page number
+	// for each page that needs to be loaded into the page storage.
+	// If page prefetching is configured, the pages following
+	// the specified ones are loaded into the free frames. The prefetched
+	// pages are the first to be evicted if they are not used,
+	// so prefetching never evicts the pages in use.
+	template <typename PageLoader>
+	void LoadPages(const GLuint* pages, GLsizei size, PageLoader load)
+	{
+		assert(size <= GLsizei(FrameCount()));
+		for(GLsizei i=0; i!=size; ++i)
+		{
+			if(!UsePage(pages[i]))
+			{
+				GLuint frame = FindFrame();
+				load(frame, pages[i]);
+				SwapPageIn(frame, pages[i]);
+			}
+		}
+		for(GLsizei i=0; i!=size; ++i)
+		{
+			for(GLuint o=1; o<=_prefetch; ++o)
+			{
+				if(_free_frames.empty()) break;
+				GLuint page = _prefetch_candidate(pages[i], o);
+				if(page == _nil()) break;
+				if(FrameOfPage(page) < 0)
+				{
+					GLuint frame = FindFrame();
+					load(frame, page);
+					_replace_page(frame, page, false);
+					++_prefetch_count;
+				}
+			}
+		}
+		Flush();
+	}
+
+	// The number of page requests served by the loaded pages
+	unsigned long HitCount(void) const
+	{
+		return _hit_count;
+	}
+
+	// The number of page requests which required loading of a page
+	unsigned long MissCount(void) const
+	{
+		return _miss_count;
+	}
+
+	// The ratio of the hits to all page requests
+	double HitRate(void) const
+	{
+		const unsigned long total = _hit_count+_miss_count;
+		return total?double(_hit_count)/double(total):1.0;
+	}
+
+	// The number of pages evicted from their frames
+	unsigned long EvictionCount(void) const
+	{
+		return _eviction_count;
+	}
+
+	// The number of prefetched pages
+	unsigned long PrefetchCount(void) const
+	{
+		return _prefetch_count;
+	}
+
+	// The number of page map uploads to the GPU
+	unsigned long UploadCount(void) const
+	{
+		return _upload_count;
+	}
+
+	// Resets the statistics counters
+	void ResetCounters(void)
+	{
+		_hit_count = 0;
+		_miss_count = 0;
+		_eviction_count = 0;
+		_prefetch_count = 0;
+		_upload_count = 0;
+	}
 };
 
 } // namespace text
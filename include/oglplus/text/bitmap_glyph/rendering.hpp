@@ -51,6 +51,9 @@ struct BitmapGlyphRenderingConfig
 	/// Minimal allocation unit for a layout storage unit
 	unsigned layout_storage_unit;
 
+	/// Number of pages following each used page loaded into free frames
+	unsigned page_prefetch;
+
 	BitmapGlyphRenderingConfig(void)
 	 : page_frames(8)
 	 , plane_count(3)
@@ -58,6 +61,7 @@ struct BitmapGlyphRenderingConfig
 	 , glyphs_per_page(256)
 	 , layout_storage_page(1024)
 	 , layout_storage_unit(4)
+	 , page_prefetch(0)
 	{ }
 };
 
@@ -82,6 +86,8 @@ protected:
 
 	friend unsigned BitmapGlyphGlyphsPerPage(const BitmapGlyphRenderingBase&);
 
+	friend unsigned BitmapGlyphPagePrefetch(const BitmapGlyphRenderingBase&);
+
 	std::list<BitmapGlyphLayoutStorage> _layout_storage;
 
 	friend void BitmapGlyphAllocateLayoutData(
@@ -187,6 +193,11 @@ inline unsigned BitmapGlyphGlyphsPerPage(const BitmapGlyphRenderingBase& that)
 	return that._config.glyphs_per_page;
 }
 
+inline unsigned BitmapGlyphPagePrefetch(const BitmapGlyphRenderingBase& that)
+{
+	return that._config.page_prefetch;
+}
+
 inline void BitmapGlyphAllocateLayoutData(
 	BitmapGlyphRenderingBase& that,
 	BitmapGlyphLayoutData& layout_data
@@ -313,11 +324,10 @@ public:
 
 	Layout MakeLayout(const Font& font, StrCRef str)
 	{
-		CodePoints cps;
-		UTF8ToCodePoints(str.begin(), str.size(), cps);
+		CodePointBuffer<256> cps(str.begin(), str.size());
 
-		Layout layout(MakeLayout(font, cps.size()));
-		layout.Set(cps);
+		Layout layout(MakeLayout(font, cps.Size()));
+		layout.Set(cps.Data(), cps.Size());
 		return std::move(layout);
 	}
 };
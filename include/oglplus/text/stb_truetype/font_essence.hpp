@@ -87,10 +87,22 @@ private:
 	const GLuint _initial_frame;
 	BitmapGlyphPageStorage _page_storage;
 
-	void _do_load_pages(
-		const GLuint* elem,
-		GLsizei size
-	);
+	void _do_load_page(GLuint frame, GLuint page);
+
+	// loads a page into a frame of the page storage
+	struct _page_loader
+	{
+		STBTTFontEssence& _essence;
+
+		_page_loader(STBTTFontEssence& essence)
+		 : _essence(essence)
+		{ }
+
+		void operator()(GLuint frame, GLuint page) const
+		{
+			_essence._do_load_page(frame, page);
+		}
+	};
 public:
 	STBTTFontEssence(
 		BitmapGlyphRenderingBase& parent,
@@ -127,7 +139,13 @@ public:
 	void LoadPages(const GLuint* pages, SizeType size)
 	{
 		assert(size < GLsizei(_pager.FrameCount()));
-		_do_load_pages(pages, size);
+		_page_storage.Bind();
+		_pager.LoadPages(pages, size, _page_loader(*this));
+	}
+
+	const BitmapGlyphPager& Pager(void) const
+	{
+		return _pager;
 	}
 
 	GLfloat QueryXOffsets(
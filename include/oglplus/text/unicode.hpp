@@ -14,6 +14,7 @@
 #define OGLPLUS_TEXT_UNICODE_HPP
 
 #include <vector>
+#include <cstddef>
 #include <cassert>
 
 namespace oglplus {
@@ -49,6 +50,71 @@ void UTF8ToCodePoints(
 	CodePoints& result
 );
 
+/// Converts a UTF-8 string to code points stored in a caller-owned buffer
+/** This function does not allocate any memory. At most @p max_cps
+ *  code points are written to @p cps and the output is truncated
+ *  if the buffer is too small. A buffer with room for @p length
+ *  code points is always large enough. Invalid UTF-8 sequences are
+ *  replaced by U+FFFD.
+ *
+ *  @returns the number of code points written to @p cps
+ *
+ *  @ingroup text_rendering
+ */
+std::size_t UTF8ToCodePoints(
+	const char* c_str,
+	std::size_t length,
+	CodePoint* cps,
+	std::size_t max_cps
+);
+
+/// Code points decoded from a UTF-8 string into an internal buffer
+/** Strings with up to @c N code points are decoded into a fixed-size
+ *  buffer inside of this object, so short strings can be decoded
+ *  on the stack without any memory allocation.
+ *
+ *  @ingroup text_rendering
+ */
+template <std::size_t N>
+class CodePointBuffer
+{
+private:
+	CodePoint _buf[N];
+	CodePoints _heap;
+	const CodePoint* _ptr;
+	std::size_t _size;
+
+	CodePointBuffer(const CodePointBuffer&);
+public:
+	/// Decodes @p length bytes of the UTF-8 string at @p c_str
+	CodePointBuffer(const char* c_str, std::size_t length)
+	{
+		if(length <= N)
+		{
+			_size = UTF8ToCodePoints(c_str, length, _buf, N);
+			_ptr = _buf;
+		}
+		else
+		{
+			UTF8ToCodePoints(c_str, length, _heap);
+			_size = _heap.size();
+			_ptr = _heap.data();
+		}
+	}
+
+	/// Returns a pointer to the decoded code points
+	const CodePoint* Data(void) const
+	{
+		return _ptr;
+	}
+
+	/// Returns the number of decoded code points
+	std::size_t Size(void) const
+	{
+		return _size;
+	}
+};
+
 inline CodePoints UTF8ToCodePoints(
 	const char* begin,
 	const char* end
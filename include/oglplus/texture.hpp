@@ -21,6 +21,7 @@
 #include <oglplus/math/vector.hpp>
 #include <oglplus/object/sequence.hpp>
 #include <oglplus/object/wrapper.hpp>
+#include <oglplus/state_cache.hpp>
 #include <oglplus/compare_function.hpp>
 #include <oglplus/data_type.hpp>
 #include <oglplus/pixel_data.hpp>
@@ -136,6 +137,14 @@ public:
 		TextureName texture
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheEntry::TextureBinding(
+				GLenum(target),
+				GetGLName(texture)
+			)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindTexture)(
 			GLenum(target),
 			GetGLName(texture)
@@ -146,6 +155,7 @@ public:
 			Object(texture).
 			BindTarget(target)
 		);
+		cached.Update();
 	}
 
 #if OGLPLUS_DOCUMENTATION_ONLY ||GL_VERSION_4_2 ||GL_ARB_shader_image_load_store
@@ -197,6 +207,7 @@ public:
 			names
 		);
 		OGLPLUS_VERIFY_SIMPLE(BindTextures);
+		aux::StateCacheForget(aux::StateCacheGroup::Binding);
 	}
 
 	static void BindImage(
@@ -318,6 +329,13 @@ public:
 	 */
 	static void Active(TextureUnitSelector index)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::ActiveTexture,
+			GL_ACTIVE_TEXTURE, 0,
+			GLuint(index)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(ActiveTexture)(
 			GLenum(GL_TEXTURE0 + GLuint(index))
 		);
@@ -326,6 +344,7 @@ public:
 			Error,
 			Index(GLuint(index))
 		);
+		cached.Update();
 	}
 
 	/// Returns active texture unit
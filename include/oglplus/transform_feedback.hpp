@@ -20,6 +20,7 @@
 #include <oglplus/transform_feedback_target.hpp>
 #include <oglplus/transform_feedback_mode.hpp>
 #include <oglplus/transform_feedback_type.hpp>
+#include <oglplus/state_cache.hpp>
 #include <cassert>
 
 namespace oglplus {
@@ -103,6 +104,13 @@ public:
 		TransformFeedbackName tfb
 	)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GLenum(target), 0,
+			GetGLName(tfb)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindTransformFeedback)(
 			GLenum(target),
 			GetGLName(tfb)
@@ -113,6 +121,12 @@ public:
 			Object(tfb).
 			BindTarget(target)
 		);
+		cached.Update();
+		// the indexed buffer bindings are a part of the TFB state
+		aux::StateCacheForget(
+			aux::StateCacheGroup::IndexedBinding,
+			GL_TRANSFORM_FEEDBACK_BUFFER
+		);
 	}
 };
 
@@ -16,6 +16,7 @@
 #include <oglplus/glfunc.hpp>
 #include <oglplus/string/ref.hpp>
 #include <oglplus/error/prog_var.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/prog_var/location.hpp>
 #include <oglplus/prog_var/varpara_fns.hpp>
 #include <oglplus/prog_var/set_ops.hpp>
@@ -36,6 +37,8 @@ public:
 	/** Finds the location of the uniform variable specified
 	 *  by @p identifier in a @p program. If active_only is true then
 	 *  throws if no such uniform exists or if it is not active.
+	 *  If the ProgramReflection is enabled for the @p program then
+	 *  the location is taken from the cached reflection table.
 	 *
 	 *  @glsymbols
 	 *  @glfunref{GetUniformLocation}
@@ -46,16 +49,25 @@ public:
 		bool active_only
 	)
 	{
-		GLint result = OGLPLUS_GLFUNC(GetUniformLocation)(
-			GetGLName(program),
-			identifier.c_str()
-		);
-		OGLPLUS_CHECK(
-			GetUniformLocation,
-			ProgVarError,
-			Program(program).
-			Identifier(identifier)
-		);
+		GLint result;
+		ProgramReflection::VariableInfo info;
+		if(ProgramReflection::QueryUniform(program, identifier, info))
+		{
+			result = info.location;
+		}
+		else
+		{
+			result = OGLPLUS_GLFUNC(GetUniformLocation)(
+				GetGLName(program),
+				identifier.c_str()
+			);
+			OGLPLUS_CHECK(
+				GetUniformLocation,
+				ProgVarError,
+				Program(program).
+				Identifier(identifier)
+			);
+		}
 		OGLPLUS_HANDLE_ERROR_IF(
 			active_only && (result < 0),
 			GL_INVALID_OPERATION,
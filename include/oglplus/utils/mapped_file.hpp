@@ -0,0 +1,172 @@
+/**
+ *  .file oglplus/utils/mapped_file.hpp
+ *  .brief Helper read-only memory-mapped file
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef OGLPLUS_UTILS_MAPPED_FILE_1509171130_HPP
+#define OGLPLUS_UTILS_MAPPED_FILE_1509171130_HPP
+
+#include <oglplus/config/compiler.hpp>
+
+#include <fstream>
+#include <vector>
+#include <cstddef>
+
+#if defined(WIN32) || defined(_WIN32) || defined(WIN64) || defined(_WIN64)
+#define OGLPLUS_MAPPED_FILE_POSIX 0
+#elif defined(__unix__) || defined(__unix) || defined(__APPLE__)
+#define OGLPLUS_MAPPED_FILE_POSIX 1
+#else
+#define OGLPLUS_MAPPED_FILE_POSIX 0
+#endif
+
+#if OGLPLUS_MAPPED_FILE_POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace oglplus {
+namespace aux {
+
+/// Read-only view of the whole content of a file
+/** On POSIX systems the file is memory-mapped, on other systems
+ *  its content is read into a buffer owned by the MappedFile.
+ */
+class MappedFile
+{
+private:
+	std::vector<char> _buffer;
+	const char* _addr;
+	std::size_t _size;
+	bool _mapped;
+
+	void _read(const char* path)
+	{
+		std::ifstream input(path, std::ios::in | std::ios::binary);
+		if(!input.good()) return;
+		input.seekg(0, std::ios::end);
+		std::streamoff size = input.tellg();
+		input.seekg(0, std::ios::beg);
+		if(size < 0) return;
+		_buffer.resize(std::size_t(size));
+		if(size > 0)
+		{
+			input.read(_buffer.data(), size);
+			if(input.gcount() != size) return;
+		}
+		static const char empty = '\0';
+		_addr = _buffer.empty()?&empty:_buffer.data();
+		_size = _buffer.size();
+	}
+
+	void _map(const char* path)
+	{
+#if OGLPLUS_MAPPED_FILE_POSIX
+		int fd = ::open(path, O_RDONLY);
+		if(fd < 0) return;
+		struct stat st;
+		if((::fstat(fd, &st) == 0) && (st.st_size > 0))
+		{
+			void* addr = ::mmap(
+				nullptr,
+				std::size_t(st.st_size),
+				PROT_READ,
+				MAP_PRIVATE,
+				fd, 0
+			);
+			if(addr != MAP_FAILED)
+			{
+				_addr = static_cast<const char*>(addr);
+				_size = std::size_t(st.st_size);
+				_mapped = true;
+			}
+		}
+		::close(fd);
+		if(_mapped) return;
+#endif
+		_read(path);
+	}
+
+	void _unmap(void)
+	{
+#if OGLPLUS_MAPPED_FILE_POSIX
+		if(_mapped)
+		{
+			::munmap(const_cast<char*>(_addr), _size);
+		}
+#endif
+		_addr = nullptr;
+		_size = 0;
+		_mapped = false;
+	}
+public:
+	/// Maps the file at the specified @p path
+	/** Use IsOpen() to check if the file was successfully opened.
+	 */
+	MappedFile(const char* path)
+	 : _addr(nullptr)
+	 , _size(0)
+	 , _mapped(false)
+	{
+		_map(path);
+	}
+
+	MappedFile(MappedFile&& temp)
+	 : _buffer(std::move(temp._buffer))
+	 , _addr(temp._addr)
+	 , _size(temp._size)
+	 , _mapped(temp._mapped)
+	{
+		temp._addr = nullptr;
+		temp._size = 0;
+		temp._mapped = false;
+	}
+
+	~MappedFile(void)
+	{
+		_unmap();
+	}
+
+	/// Returns true if the file was opened
+	bool IsOpen(void) const
+	{
+		return _addr != nullptr;
+	}
+
+	/// Returns true if the file is memory-mapped (not buffered)
+	bool IsMapped(void) const
+	{
+		return _mapped;
+	}
+
+	/// Pointer to the start of the file content
+	const char* Begin(void) const
+	{
+		return _addr;
+	}
+
+	/// Pointer past the end of the file content
+	const char* End(void) const
+	{
+		return _addr+_size;
+	}
+
+	/// The size of the file in bytes
+	std::size_t Size(void) const
+	{
+		return _size;
+	}
+};
+
+} // namespace aux
+} // namespace oglplus
+
+#endif
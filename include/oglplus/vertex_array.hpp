@@ -17,6 +17,7 @@
 #include <oglplus/object/wrapper.hpp>
 #include <oglplus/error/object.hpp>
 #include <oglplus/boolean.hpp>
+#include <oglplus/state_cache.hpp>
 #include <cassert>
 
 namespace oglplus {
@@ -101,12 +102,25 @@ public:
 	 */
 	static void Bind(VertexArrayName vertex_array)
 	{
+		const aux::StateCacheEntry cached(
+			aux::StateCacheGroup::Binding,
+			GL_VERTEX_ARRAY_BINDING, 0,
+			GetGLName(vertex_array)
+		);
+		if(cached.Current()) return;
+
 		OGLPLUS_GLFUNC(BindVertexArray)(GetGLName(vertex_array));
 		OGLPLUS_VERIFY(
 			BindVertexArray,
 			ObjectError,
 			Object(vertex_array)
 		);
+		cached.Update();
+		// the element array buffer binding is a part of the VAO state
+		aux::StateCacheForget(
+			aux::StateCacheGroup::Binding,
+			GL_ELEMENT_ARRAY_BUFFER
+		);
 	}
 };
 
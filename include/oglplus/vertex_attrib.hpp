@@ -23,6 +23,7 @@
 #include <oglplus/error/prog_var.hpp>
 #include <oglplus/object/name.hpp>
 #include <oglplus/object/sequence.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/prog_var/location.hpp>
 #include <oglplus/prog_var/varpara_fns.hpp>
 #include <oglplus/prog_var/set_ops.hpp>
@@ -88,16 +89,25 @@ public:
 		bool active_only
 	)
 	{
-		GLint result = OGLPLUS_GLFUNC(GetAttribLocation)(
-			GetGLName(program),
-			identifier.c_str()
-		);
-		OGLPLUS_CHECK(
-			GetAttribLocation,
-			ProgVarError,
-			Program(program).
-			Identifier(identifier)
-		);
+		GLint result;
+		ProgramReflection::VariableInfo info;
+		if(ProgramReflection::QueryAttrib(program, identifier, info))
+		{
+			result = info.location;
+		}
+		else
+		{
+			result = OGLPLUS_GLFUNC(GetAttribLocation)(
+				GetGLName(program),
+				identifier.c_str()
+			);
+			OGLPLUS_CHECK(
+				GetAttribLocation,
+				ProgVarError,
+				Program(program).
+				Identifier(identifier)
+			);
+		}
 		OGLPLUS_HANDLE_ERROR_IF(
 			active_only && (result < 0),
 			GL_INVALID_OPERATION,
@@ -15,6 +15,8 @@
 #include <oglplus/ext/KHR_debug/source.hpp>
 #include <oglplus/ext/KHR_debug/type.hpp>
 #include <oglplus/error/glfunc.hpp>
+// the capability enumerations are implemented in enums.cpp
+#include <oglplus/capability.hpp>
 
 #include "implement.ipp"
 
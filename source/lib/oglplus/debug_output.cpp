@@ -15,6 +15,8 @@
 #include <oglplus/ext/ARB_debug_output/source.hpp>
 #include <oglplus/ext/ARB_debug_output/type.hpp>
 #include <oglplus/error/glfunc.hpp>
+// the capability enumerations are implemented in enums.cpp
+#include <oglplus/capability.hpp>
 
 #include "implement.ipp"
 
@@ -0,0 +1,18 @@
+/**
+ *  .file lib/oglplus/dispatch.cpp
+ *  .brief GL dispatch table, recorder and null backend
+ *
+ *  @author Matus Chochlik
+ *
+ *  Copyright 2010-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "prologue.ipp"
+#include "implement.ipp"
+
+#include <oglplus/dispatch/table.hpp>
+#include <oglplus/dispatch/recorder.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+#include "epilogue.ipp"
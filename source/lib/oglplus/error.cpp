@@ -16,6 +16,10 @@
 #include <oglplus/object/type.hpp>
 #include <oglplus/error/code.hpp>
 #include <oglplus/framebuffer_status.hpp>
+// the dispatch table is implemented in dispatch.cpp
+#if OGLPLUS_GL_DISPATCH
+#include <oglplus/dispatch/table.hpp>
+#endif
 
 #include "implement.ipp"
 
@@ -26,4 +30,5 @@
 #include <oglplus/error/program.hpp>
 #include <oglplus/error/prog_var.hpp>
 #include <oglplus/error/framebuffer.hpp>
+#include <oglplus/error/check_policy.hpp>
 #include "epilogue.ipp"
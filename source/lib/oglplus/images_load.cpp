@@ -24,4 +24,6 @@
 #include <oglplus/images/png.hpp>
 #endif
 #include <oglplus/images/load.hpp>
+#include <oglplus/images/async_load.hpp>
+#include <oglplus/images/frame_writer.hpp>
 #include "epilogue.ipp"
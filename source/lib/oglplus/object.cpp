@@ -39,6 +39,9 @@
 #include <oglplus/transform_feedback_mode.hpp>
 #include <oglplus/transform_feedback_type.hpp>
 #include <oglplus/color_buffer.hpp>
+#include <oglplus/sync.hpp>
+#include <oglplus/query_target.hpp>
+#include <oglplus/conditional_render_mode.hpp>
 
 #include "implement.ipp"
 
@@ -46,9 +49,12 @@
 #include <oglplus/texture.hpp>
 #include <oglplus/sampler.hpp>
 #include <oglplus/buffer.hpp>
+#include <oglplus/streaming_buffer.hpp>
+#include <oglplus/pixel_readback.hpp>
 #include <oglplus/framebuffer.hpp>
 #include <oglplus/renderbuffer.hpp>
 #include <oglplus/transform_feedback.hpp>
+#include <oglplus/gpu_profiler.hpp>
 
 #if GL_EXT_direct_state_access
 
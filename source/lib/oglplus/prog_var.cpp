@@ -20,6 +20,7 @@
 #include <oglplus/data_type.hpp>
 #include <oglplus/shader_type.hpp>
 #include <oglplus/object/type.hpp>
+#include <oglplus/program_reflection.hpp>
 
 #include "implement.ipp"
 
@@ -10,6 +10,7 @@
  */
 
 #include "prologue.ipp"
+#include <oglplus/extension.hpp>
 #include <oglplus/string/def.hpp>
 #include <oglplus/string/empty.hpp>
 #include <oglplus/string/utf8.hpp>
@@ -34,6 +35,9 @@
 #include <oglplus/detail/info_log.hpp>
 #include <oglplus/shader.hpp>
 #include <oglplus/program.hpp>
+#include <oglplus/program_cache.hpp>
+#include <oglplus/program_build_queue.hpp>
 #include <oglplus/program_resource.hpp>
+#include <oglplus/program_reflection.hpp>
 #include <oglplus/program_pipeline.hpp>
 #include "epilogue.ipp"
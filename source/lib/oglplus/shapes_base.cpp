@@ -18,10 +18,13 @@
 #include <oglplus/face_mode.hpp>
 #include <oglplus/data_type.hpp>
 #include <oglplus/primitive_type.hpp>
+#include <oglplus/buffer.hpp>
 #include <oglplus/shapes/draw.hpp>
 
 #include "implement.ipp"
 
+#include <oglplus/shapes/draw_indirect.hpp>
+
 #include <oglplus/shapes/cage.hpp>
 #include <oglplus/shapes/cube.hpp>
 #include <oglplus/shapes/grid.hpp>
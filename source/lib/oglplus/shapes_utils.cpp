@@ -31,4 +31,5 @@
 #include <oglplus/shapes/wrapper.hpp>
 #include <oglplus/shapes/analyzer.hpp>
 #include <oglplus/shapes/analyzer_data.hpp>
+#include <oglplus/shapes/cached_mesh.hpp>
 #include "epilogue.ipp"
@@ -0,0 +1,165 @@
+/**
+ *  .file test/oglplus/batch.cpp
+ *  .brief Test case for the batch vector and matrix transformations.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_Batch
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/math/batch.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(Batch)
+
+typedef oglplus::Matrix<float, 4, 4> Mat4f;
+typedef oglplus::Vector<float, 3> Vec3f;
+typedef oglplus::Vector<float, 4> Vec4f;
+
+static float random_value(void)
+{
+	return float(std::rand())/RAND_MAX-0.5f;
+}
+
+static Mat4f random_matrix(void)
+{
+	float data[16];
+	for(std::size_t i=0; i!=16; ++i)
+		data[i] = random_value();
+	return Mat4f(data);
+}
+
+template <std::size_t N>
+static bool close(
+	const oglplus::Vector<float, N>& a,
+	const oglplus::Vector<float, N>& b,
+	float eps
+)
+{
+	return Distance(a, b) <= eps;
+}
+
+static Vec4f random_vector(void)
+{
+	return Vec4f(random_value(), random_value(), random_value(), 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(Batch_transform)
+{
+	const std::size_t n = 37;
+	Mat4f m = random_matrix();
+	std::vector<Vec4f> v(n), r(n);
+	for(std::size_t i=0; i!=n; ++i)
+		v[i] = random_vector();
+
+	oglplus::TransformBatch(m, v.data(), r.data(), n);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(close(r[i], m*v[i], 1e-5f));
+
+	oglplus::VectorBatch<float, 4> sv(v), sr(n);
+	oglplus::TransformBatch(m, sv, sr);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(close(sr.At(i), m*v[i], 1e-5f));
+}
+
+BOOST_AUTO_TEST_CASE(Batch_transform_point)
+{
+	const std::size_t n = 41;
+	Mat4f m = random_matrix();
+	std::vector<Vec3f> p(n), r(n);
+	for(std::size_t i=0; i!=n; ++i)
+		p[i] = random_vector().xyz();
+
+	oglplus::TransformPointBatch(m, p.data(), r.data(), n);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(close(r[i], TransformPoint(m, p[i]), 1e-5f));
+
+	oglplus::VectorBatch<float, 3> sp(p.data(), n), sr(n);
+	oglplus::TransformPointBatch(m, sp, sr);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(close(sr.At(i), TransformPoint(m, p[i]), 1e-5f));
+
+	// in-place
+	oglplus::TransformPointBatch(m, sp, sp);
+	std::vector<Vec3f> g(n);
+	sp.Gather(g.data());
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(close(g[i], sr.At(i), 0.0f));
+}
+
+BOOST_AUTO_TEST_CASE(Batch_soa_layout)
+{
+	const std::size_t n = 5;
+	oglplus::VectorBatch<float, 3> b(n);
+	for(std::size_t i=0; i!=n; ++i)
+		b.Set(i, Vec3f(float(i), float(10+i), float(20+i)));
+
+	BOOST_CHECK_EQUAL(b.Storage().size(), 3*n);
+	BOOST_CHECK_EQUAL(b.ComponentOffset(2), 2*n*sizeof(float));
+	for(std::size_t i=0; i!=n; ++i)
+	{
+		BOOST_CHECK_EQUAL(b.Storage()[0*n+i], float(i));
+		BOOST_CHECK_EQUAL(b.Storage()[1*n+i], float(10+i));
+		BOOST_CHECK_EQUAL(b.Storage()[2*n+i], float(20+i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Batch_multiply)
+{
+	const std::size_t n = 23;
+	std::vector<Mat4f> a(n), b(n), r(n);
+	for(std::size_t i=0; i!=n; ++i)
+	{
+		a[i] = random_matrix();
+		b[i] = random_matrix();
+	}
+
+	oglplus::MultiplyBatch(a.data(), b.data(), r.data(), n);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(Close(r[i], a[i]*b[i], 1e-5f));
+
+	oglplus::MultiplyBatch(a[0], b.data(), r.data(), n);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(Close(r[i], a[0]*b[i], 1e-5f));
+
+	oglplus::MultiplyBatch(a.data(), b[0], r.data(), n);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(Close(r[i], a[i]*b[0], 1e-5f));
+
+	oglplus::TransposeBatch(a.data(), r.data(), n);
+	for(std::size_t i=0; i!=n; ++i)
+		BOOST_CHECK(r[i] == Transposed(a[i]));
+}
+
+BOOST_AUTO_TEST_CASE(Batch_hierarchy)
+{
+	//      0     4
+	//     / \    |
+	//    1   3   5
+	//    |
+	//    2
+	const std::size_t n = 6;
+	const std::size_t parent[n] = {0, 0, 1, 0, 4, 4};
+	std::vector<Mat4f> local(n), world(n);
+	for(std::size_t i=0; i!=n; ++i)
+		local[i] = random_matrix();
+
+	oglplus::ComposeHierarchy(local.data(), parent, world.data(), n);
+
+	BOOST_CHECK(world[0] == local[0]);
+	BOOST_CHECK(world[4] == local[4]);
+	BOOST_CHECK(Close(world[1], local[0]*local[1], 1e-5f));
+	BOOST_CHECK(Close(world[2], local[0]*local[1]*local[2], 1e-5f));
+	BOOST_CHECK(Close(world[3], local[0]*local[3], 1e-5f));
+	BOOST_CHECK(Close(world[5], local[4]*local[5], 1e-5f));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
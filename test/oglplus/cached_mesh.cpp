@@ -0,0 +1,277 @@
+/**
+ *  .file test/oglplus/cached_mesh.cpp
+ *  .brief Test case for the binary mesh cache.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_CachedMesh
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/obj_mesh.hpp>
+#include <oglplus/shapes/cached_mesh.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+BOOST_AUTO_TEST_SUITE(CachedMesh)
+
+using namespace oglplus;
+
+static const char* test_obj =
+	"o quad\n"
+	"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+	"vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+	"vn 0 0 1\n"
+	"usemtl first\n"
+	"f 1/1/1 2/2/1 3/3/1\n"
+	"usemtl second\n"
+	"f 1/1/1 3/3/1 4/4/1\n";
+
+// removes the source, cache and temporary files at the end of a test
+struct test_files
+{
+	std::string source, cache;
+
+	test_files(const char* name)
+	 : source(std::string(name)+".obj")
+	 , cache(std::string(name)+".obj.cache")
+	{
+		write(source, test_obj);
+	}
+
+	~test_files(void)
+	{
+		std::remove(source.c_str());
+		std::remove(cache.c_str());
+		std::remove((cache+".tmp").c_str());
+	}
+
+	static void write(const std::string& path, const std::string& content)
+	{
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		file.write(content.data(), std::streamsize(content.size()));
+	}
+
+	static std::string read(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		return std::string(
+			std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>()
+		);
+	}
+};
+
+template <typename ObjFunc, typename CachedFunc>
+static void check_attrib(
+	const shapes::ObjMesh& obj,
+	const shapes::CachedMesh& cached,
+	ObjFunc obj_func,
+	CachedFunc cached_func
+)
+{
+	std::vector<GLfloat> a, b;
+	BOOST_CHECK_EQUAL((obj.*obj_func)(a), (cached.*cached_func)(b));
+	BOOST_CHECK(a == b);
+}
+
+BOOST_AUTO_TEST_CASE(CachedMesh_round_trip)
+{
+	test_files files("oglplus_test_cached_mesh_round_trip");
+	shapes::ObjMesh obj(files.source.c_str());
+
+	shapes::CachedMesh::Write(
+		obj,
+		files.cache.c_str(),
+		files.source.c_str()
+	);
+	BOOST_CHECK(shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+
+	shapes::CachedMesh cached(files.cache.c_str());
+	BOOST_CHECK(cached.VerifyChecksum());
+	BOOST_CHECK(obj.FaceWinding() == cached.FaceWinding());
+
+	check_attrib(
+		obj, cached,
+		&shapes::ObjMesh::Positions<GLfloat>,
+		&shapes::CachedMesh::Positions<GLfloat>
+	);
+	check_attrib(
+		obj, cached,
+		&shapes::ObjMesh::Normals<GLfloat>,
+		&shapes::CachedMesh::Normals<GLfloat>
+	);
+	check_attrib(
+		obj, cached,
+		&shapes::ObjMesh::TexCoordinates<GLfloat>,
+		&shapes::CachedMesh::TexCoordinates<GLfloat>
+	);
+	check_attrib(
+		obj, cached,
+		&shapes::ObjMesh::MaterialNumbers<GLfloat>,
+		&shapes::CachedMesh::MaterialNumbers<GLfloat>
+	);
+
+	BOOST_CHECK_EQUAL(obj.MaterialCount(), cached.MaterialCount());
+	for(GLuint m=0, n=obj.MaterialCount(); m!=n; ++m)
+	{
+		BOOST_CHECK_EQUAL(obj.MaterialName(m), cached.MaterialName(m));
+	}
+
+	std::vector<GLuint> obj_indices, cached_indices;
+	auto oi = obj.Indices();
+	obj_indices.assign(oi.begin(), oi.end());
+	cached_indices = cached.Indices();
+	BOOST_CHECK(obj_indices == cached_indices);
+
+	auto obj_ops = obj.Instructions().Operations();
+	auto cached_ops = cached.Instructions().Operations();
+	BOOST_CHECK_EQUAL(obj_ops.size(), cached_ops.size());
+	for(std::size_t o=0; o<obj_ops.size() && o<cached_ops.size(); ++o)
+	{
+		BOOST_CHECK(obj_ops[o].method == cached_ops[o].method);
+		BOOST_CHECK(obj_ops[o].mode == cached_ops[o].mode);
+		BOOST_CHECK_EQUAL(obj_ops[o].first, cached_ops[o].first);
+		BOOST_CHECK_EQUAL(obj_ops[o].count, cached_ops[o].count);
+		BOOST_CHECK_EQUAL(obj_ops[o].phase, cached_ops[o].phase);
+	}
+
+	Spheref obj_bs, cached_bs;
+	obj.BoundingSphere(obj_bs);
+	cached.BoundingSphere(cached_bs);
+	BOOST_CHECK_EQUAL(obj_bs.Radius(), cached_bs.Radius());
+
+	// no temporary file is left behind
+	std::ifstream temp((files.cache+".tmp").c_str());
+	BOOST_CHECK(!temp.is_open());
+}
+
+BOOST_AUTO_TEST_CASE(CachedMesh_stale)
+{
+	test_files files("oglplus_test_cached_mesh_stale");
+	shapes::ObjMesh obj(files.source.c_str());
+
+	shapes::CachedMesh::Write(
+		obj,
+		files.cache.c_str(),
+		files.source.c_str()
+	);
+	BOOST_CHECK(shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+
+	// same size, different content
+	std::string source = test_obj;
+	source[source.find("v 1 1 0")+2] = '2';
+	test_files::write(files.source, source);
+	BOOST_CHECK(!shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+
+	// different size
+	test_files::write(files.source, std::string(test_obj)+"\n");
+	BOOST_CHECK(!shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+
+	// Load re-makes the stale cache
+	bool reloaded = false;
+	shapes::CachedMesh cached = shapes::CachedMesh::Load(
+		files.source.c_str(),
+		files.cache.c_str(),
+		[&files, &reloaded](void)
+		{
+			reloaded = true;
+			return shapes::ObjMesh(files.source.c_str());
+		}
+	);
+	BOOST_CHECK(reloaded);
+	BOOST_CHECK(shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+
+	// the cache is stale if the source is missing
+	std::remove(files.source.c_str());
+	BOOST_CHECK(!shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+}
+
+BOOST_AUTO_TEST_CASE(CachedMesh_corrupt)
+{
+	test_files files("oglplus_test_cached_mesh_corrupt");
+	shapes::ObjMesh obj(files.source.c_str());
+
+	shapes::CachedMesh::Write(
+		obj,
+		files.cache.c_str(),
+		files.source.c_str()
+	);
+	const std::string original = test_files::read(files.cache);
+	BOOST_REQUIRE(!original.empty());
+
+	// a damaged payload is detected by the checksum
+	std::string damaged = original;
+	damaged[damaged.size()-1] ^= 0x5A;
+	test_files::write(files.cache, damaged);
+	{
+		shapes::CachedMesh cached(files.cache.c_str());
+		BOOST_CHECK(!cached.VerifyChecksum());
+	}
+
+	// a truncated file is rejected
+	test_files::write(files.cache, original.substr(0, original.size()/2));
+	BOOST_CHECK_THROW(
+		shapes::CachedMesh(files.cache.c_str()),
+		std::runtime_error
+	);
+	BOOST_CHECK(!shapes::CachedMesh::IsUpToDate(
+		files.cache.c_str(),
+		files.source.c_str()
+	));
+
+	// a damaged header is rejected
+	damaged = original;
+	damaged[0] = 'X';
+	test_files::write(files.cache, damaged);
+	BOOST_CHECK_THROW(
+		shapes::CachedMesh(files.cache.c_str()),
+		std::runtime_error
+	);
+}
+
+BOOST_AUTO_TEST_CASE(CachedMesh_missing_source)
+{
+	test_files files("oglplus_test_cached_mesh_missing_source");
+	shapes::ObjMesh obj(files.source.c_str());
+	std::remove(files.source.c_str());
+
+	BOOST_CHECK_THROW(
+		shapes::CachedMesh::Write(
+			obj,
+			files.cache.c_str(),
+			files.source.c_str()
+		),
+		std::runtime_error
+	);
+	std::ifstream cache(files.cache.c_str());
+	BOOST_CHECK(!cache.is_open());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
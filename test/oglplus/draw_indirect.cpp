@@ -0,0 +1,209 @@
+/**
+ *  .file test/oglplus/draw_indirect.cpp
+ *  .brief Test case for the compilation of shape draw instructions.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_DrawIndirect
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/draw_indirect.hpp>
+#include <oglplus/shapes/cube.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(DrawIndirect)
+
+using namespace oglplus;
+using namespace oglplus::shapes;
+
+// makes drawing instructions from hand-written operations
+struct TestInstructions
+ : public DrawingInstructionWriter
+{
+	static DrawOperation Op(
+		DrawOperation::Method method,
+		PrimitiveType mode,
+		GLuint first,
+		GLuint count,
+		GLuint restart_index = DrawOperation::NoRestartIndex(),
+		GLuint phase = 0
+	)
+	{
+		DrawOperation op;
+		op.method = method;
+		op.mode = mode;
+		op.first = first;
+		op.count = count;
+		op.restart_index = restart_index;
+		op.phase = phase;
+		return op;
+	}
+
+	static DrawingInstructions Make(const std::vector<DrawOperation>& ops)
+	{
+		DrawingInstructions instr = MakeInstructions();
+		for(const DrawOperation& op : ops)
+		{
+			AddInstruction(instr, op);
+		}
+		return instr;
+	}
+};
+
+struct TestIndices
+{
+	typedef std::vector<GLuint> IndexArray;
+};
+
+BOOST_AUTO_TEST_CASE(DrawIndirect_arrays)
+{
+	Cube cube;
+	DrawCommandCompiler compiler;
+	compiler.Add(cube.Instructions(), 0);
+	compiler.Add(cube.Instructions(), 36, 2, 5);
+
+	BOOST_CHECK_EQUAL(compiler.CommandCount(), 2u);
+	BOOST_CHECK_EQUAL(compiler.BatchCount(), 1u);
+
+	std::vector<DrawCommandBatch> batches = compiler.Batches();
+	BOOST_ASSERT(batches.size() == 1);
+	BOOST_CHECK(batches[0].method == DrawOperation::Method::DrawArrays);
+	BOOST_CHECK(batches[0].mode == PrimitiveType::Triangles);
+	BOOST_CHECK_EQUAL(batches[0].offset, 0);
+	BOOST_CHECK_EQUAL(batches[0].count, 2);
+
+	const GLuint expected[8] = {
+		36, 1,  0, 0,
+		36, 2, 36, 5
+	};
+	std::vector<GLuint> data = compiler.Data();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		data.begin(), data.end(),
+		expected, expected+8
+	);
+}
+
+BOOST_AUTO_TEST_CASE(DrawIndirect_elements)
+{
+	Cube cube;
+	ElementIndexInfo index_info(cube);
+	DrawCommandCompiler compiler;
+	compiler.Add(cube.Instructions(Cube::Edges()), index_info, 0, 0);
+	compiler.Add(cube.Instructions(Cube::Edges()), index_info, 36, 24);
+
+	// 2*6 line loops drawn by one call
+	BOOST_CHECK_EQUAL(compiler.CommandCount(), 12u);
+	BOOST_CHECK_EQUAL(compiler.BatchCount(), 1u);
+
+	std::vector<DrawCommandBatch> batches = compiler.Batches();
+	BOOST_ASSERT(batches.size() == 1);
+	BOOST_CHECK(batches[0].method == DrawOperation::Method::DrawElements);
+	BOOST_CHECK(batches[0].mode == PrimitiveType::LineLoop);
+	BOOST_CHECK(batches[0].index_type == DataType::UnsignedShort);
+	BOOST_CHECK_EQUAL(batches[0].count, 12);
+
+	std::vector<GLuint> data = compiler.Data();
+	BOOST_ASSERT(data.size() == 12*5);
+	for(GLuint c=0; c!=12; ++c)
+	{
+		const GLuint* cmd = data.data()+c*5;
+		BOOST_CHECK_EQUAL(cmd[0], 4u);
+		BOOST_CHECK_EQUAL(cmd[1], 1u);
+		BOOST_CHECK_EQUAL(cmd[2], (c<6)?c*4:24+(c-6)*4);
+		BOOST_CHECK_EQUAL(GLint(cmd[3]), (c<6)?0:36);
+		BOOST_CHECK_EQUAL(cmd[4], 0u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(DrawIndirect_grouping)
+{
+	typedef DrawOperation::Method Method;
+	const GLuint none = DrawOperation::NoRestartIndex();
+
+	std::vector<DrawOperation> ops;
+	ops.push_back(TestInstructions::Op(
+		Method::DrawElements, PrimitiveType::TriangleStrip, 0, 10, 99
+	));
+	ops.push_back(TestInstructions::Op(
+		Method::DrawArrays, PrimitiveType::Points, 0, 5
+	));
+	ops.push_back(TestInstructions::Op(
+		Method::DrawElements, PrimitiveType::TriangleStrip, 10, 8, none
+	));
+	ops.push_back(TestInstructions::Op(
+		Method::DrawElements, PrimitiveType::TriangleStrip, 18, 6, 99
+	));
+	ops.push_back(TestInstructions::Op(
+		Method::DrawElements, PrimitiveType::TriangleStrip, 24, 4, 99, 1
+	));
+	// different restart indices for DrawArrays do not matter
+	ops.push_back(TestInstructions::Op(
+		Method::DrawArrays, PrimitiveType::Points, 5, 5, 7
+	));
+
+	DrawingInstructions instr = TestInstructions::Make(ops);
+	DrawCommandCompiler compiler;
+	compiler.Add(instr, ElementIndexInfo(TestIndices()));
+
+	BOOST_CHECK_EQUAL(compiler.CommandCount(), 6u);
+	BOOST_CHECK_EQUAL(compiler.BatchCount(), 4u);
+
+	std::vector<DrawCommandBatch> batches = compiler.Batches();
+	BOOST_ASSERT(batches.size() == 4);
+
+	// the batches are ordered by their first operation
+	BOOST_CHECK(batches[0].method == Method::DrawElements);
+	BOOST_CHECK_EQUAL(batches[0].restart_index, 99u);
+	BOOST_CHECK_EQUAL(batches[0].phase, 0u);
+	BOOST_CHECK_EQUAL(batches[0].count, 2);
+	BOOST_CHECK_EQUAL(batches[0].offset, 0);
+
+	BOOST_CHECK(batches[1].method == Method::DrawArrays);
+	BOOST_CHECK_EQUAL(batches[1].count, 2);
+	BOOST_CHECK_EQUAL(batches[1].offset, 2*5*4);
+
+	BOOST_CHECK(batches[2].method == Method::DrawElements);
+	BOOST_CHECK_EQUAL(batches[2].restart_index, none);
+	BOOST_CHECK_EQUAL(batches[2].count, 1);
+	BOOST_CHECK_EQUAL(batches[2].offset, 2*5*4+2*4*4);
+
+	BOOST_CHECK_EQUAL(batches[3].restart_index, 99u);
+	BOOST_CHECK_EQUAL(batches[3].phase, 1u);
+	BOOST_CHECK_EQUAL(batches[3].count, 1);
+	BOOST_CHECK_EQUAL(batches[3].offset, 3*5*4+2*4*4);
+
+	std::vector<GLuint> data = compiler.Data();
+	BOOST_CHECK_EQUAL(data.size(), 4*5+2*4u);
+	// the second command of the first batch
+	BOOST_CHECK_EQUAL(data[5+0], 6u);
+	BOOST_CHECK_EQUAL(data[5+2], 18u);
+	// the second command of the DrawArrays batch
+	BOOST_CHECK_EQUAL(data[10+4+0], 5u);
+	BOOST_CHECK_EQUAL(data[10+4+2], 5u);
+
+	compiler.Clear();
+	BOOST_CHECK_EQUAL(compiler.CommandCount(), 0u);
+	BOOST_CHECK_EQUAL(compiler.BatchCount(), 0u);
+	BOOST_CHECK(compiler.Data().empty());
+}
+
+BOOST_AUTO_TEST_CASE(DrawIndirect_missing_indices)
+{
+	Cube cube;
+	DrawCommandCompiler compiler;
+	BOOST_CHECK_THROW(
+		compiler.Add(cube.Instructions(Cube::Edges())),
+		std::runtime_error
+	);
+	BOOST_CHECK_EQUAL(compiler.CommandCount(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+/**
+ *  .file test/oglplus/error_check_policy.cpp
+ *  .brief Test case for the GL error check policies.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ErrorCheckPolicy
+#include <boost/test/unit_test.hpp>
+
+#define OGLPLUS_GL_DISPATCH 1
+#include <oglplus/gl.hpp>
+#include <oglplus/error/check_policy.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+
+#include <deque>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(ErrorCheck)
+
+using namespace oglplus;
+
+// the errors returned by the overridden glGetError
+static std::deque<GLenum>& gl_errors(void)
+{
+	static std::deque<GLenum> errors;
+	return errors;
+}
+
+static GLenum GLAPIENTRY get_error(void)
+{
+	if(gl_errors().empty())
+	{
+		return GL_NO_ERROR;
+	}
+	GLenum result = gl_errors().front();
+	gl_errors().pop_front();
+	return result;
+}
+
+// a wrapped GL call, checked by the current error check policy
+static void checked_call(GLenum gl_error = GL_NO_ERROR)
+{
+	OGLPLUS_GLFUNC(Flush)();
+	if(gl_error != GL_NO_ERROR) gl_errors().push_back(gl_error);
+	OGLPLUS_CHECK_SIMPLE(Flush);
+}
+
+// a wrapped GL call whose errors are ignored
+static void ignored_call(GLenum gl_error = GL_NO_ERROR)
+{
+	OGLPLUS_GLFUNC(Finish)();
+	if(gl_error != GL_NO_ERROR) gl_errors().push_back(gl_error);
+	OGLPLUS_IGNORE(Finish);
+}
+
+struct null_gl
+{
+	GLNullBackend backend;
+
+	null_gl(void)
+	{
+		gl_errors().clear();
+		OGLPLUS_GLFUNC_OVERRIDE(GetError, &get_error);
+		SetErrorCheckPolicy(ErrorCheckPolicy::Immediate);
+	}
+
+	~null_gl(void)
+	{
+		OGLPLUS_GLFUNC_OVERRIDE(GetError, nullptr);
+		SetErrorCheckPolicy(ErrorCheckPolicy::Immediate);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(ErrorCheckPolicy_immediate)
+{
+	null_gl gl;
+
+	BOOST_CHECK_NO_THROW(checked_call());
+	BOOST_CHECK_THROW(checked_call(GL_INVALID_ENUM), Error);
+	BOOST_CHECK(gl_errors().empty());
+
+	// the ignored error is cleared and not reported later
+	BOOST_CHECK_NO_THROW(ignored_call(GL_INVALID_OPERATION));
+	BOOST_CHECK(gl_errors().empty());
+	BOOST_CHECK_NO_THROW(checked_call());
+}
+
+BOOST_AUTO_TEST_CASE(ErrorCheckPolicy_deferred)
+{
+	null_gl gl;
+
+	DeferredErrorCheck check;
+	BOOST_CHECK(CurrentErrorCheckPolicy() == ErrorCheckPolicy::Deferred);
+
+	// the errors are not checked after the individual calls
+	BOOST_CHECK_NO_THROW(checked_call(GL_INVALID_VALUE));
+	BOOST_CHECK_EQUAL(gl_errors().size(), 1u);
+
+	// an ignored call does not clear the error of the preceding call
+	BOOST_CHECK_NO_THROW(ignored_call());
+	BOOST_CHECK_EQUAL(gl_errors().size(), 1u);
+
+	try
+	{
+		check.Check();
+		BOOST_ERROR("Deferred error not reported");
+	}
+	catch(Error& error)
+	{
+		BOOST_CHECK(error.Code() == ErrorCode::InvalidValue);
+		BOOST_CHECK_EQUAL(error.GLFunc(), "Flush");
+	}
+	BOOST_CHECK(gl_errors().empty());
+
+	// without unchecked calls the ignored error is just discarded
+	BOOST_CHECK_NO_THROW(ignored_call(GL_INVALID_OPERATION));
+	BOOST_CHECK(gl_errors().empty());
+	BOOST_CHECK_NO_THROW(check.Check());
+
+	// with unchecked calls the ignored error is left for the check
+	checked_call();
+	ignored_call(GL_INVALID_OPERATION);
+	BOOST_CHECK_THROW(check.Check(), Error);
+}
+
+BOOST_AUTO_TEST_CASE(ErrorCheckPolicy_deferred_scope)
+{
+	null_gl gl;
+
+	BOOST_CHECK_THROW(
+		{
+			DeferredErrorCheck check;
+			checked_call(GL_INVALID_ENUM);
+		},
+		Error
+	);
+	BOOST_CHECK(CurrentErrorCheckPolicy() == ErrorCheckPolicy::Immediate);
+
+	// the scope left because of another exception does not throw
+	BOOST_CHECK_THROW(
+		{
+			DeferredErrorCheck check;
+			checked_call(GL_INVALID_ENUM);
+			throw std::runtime_error("scope left");
+		},
+		std::runtime_error
+	);
+	BOOST_CHECK(CurrentErrorCheckPolicy() == ErrorCheckPolicy::Immediate);
+	gl_errors().clear();
+}
+
+// checks the errors in a deferred scope in its destructor
+struct check_in_destructor
+{
+	bool& reported;
+
+	check_in_destructor(bool& r)
+	 : reported(r)
+	{ }
+
+	~check_in_destructor(void)
+	{
+		try
+		{
+			DeferredErrorCheck check;
+			checked_call(GL_INVALID_ENUM);
+		}
+		catch(Error&) { reported = true; }
+	}
+};
+
+BOOST_AUTO_TEST_CASE(ErrorCheckPolicy_deferred_unwinding)
+{
+	null_gl gl;
+
+	// a deferred scope used during stack unwinding still checks errors
+	bool reported = false;
+	try
+	{
+		check_in_destructor guard(reported);
+		throw std::runtime_error("unwinding");
+	}
+	catch(std::runtime_error&) { }
+	BOOST_CHECK(reported);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
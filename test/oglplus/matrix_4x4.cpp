@@ -0,0 +1,222 @@
+/**
+ *  .file test/oglplus/matrix_4x4.cpp
+ *  .brief Test case for the (SIMD) 4x4 float matrix and vector kernels.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_Matrix_4x4
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/math/matrix.hpp>
+
+#include <cstdlib>
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(Matrix_4x4)
+
+typedef oglplus::Matrix<float, 4, 4> Mat4f;
+typedef oglplus::Matrix<double, 4, 4> Mat4d;
+typedef oglplus::Vector<float, 4> Vec4f;
+typedef oglplus::Vector<double, 4> Vec4d;
+
+static float random_value(void)
+{
+	return float(std::rand())/RAND_MAX-0.5f;
+}
+
+static Mat4f random_matrix(void)
+{
+	float data[16];
+	for(std::size_t i=0; i!=16; ++i)
+		data[i] = random_value();
+	return Mat4f(data);
+}
+
+// diagonally dominant, i.e. well-conditioned, matrix
+static Mat4f random_invertible_matrix(void)
+{
+	Mat4f m = random_matrix();
+	for(std::size_t i=0; i!=4; ++i)
+		m.Set(i, i, m.At(i, i)+2.0f);
+	return m;
+}
+
+static Mat4f random_affine_matrix(void)
+{
+	Mat4f m = random_invertible_matrix();
+	m.Set(3, 0, 0.0f);
+	m.Set(3, 1, 0.0f);
+	m.Set(3, 2, 0.0f);
+	m.Set(3, 3, 1.0f);
+	return m;
+}
+
+// compares the matrix to the generic double-precision reference
+template <typename T>
+static bool close_4x4(const oglplus::Matrix<T, 4, 4>& a, const Mat4d& b, double eps)
+{
+	for(std::size_t i=0; i!=4; ++i)
+	for(std::size_t j=0; j!=4; ++j)
+	{
+		if(std::fabs(a.At(i, j)-b.At(i, j)) > eps) return false;
+	}
+	return true;
+}
+
+static bool close_4(const Vec4f& a, const Vec4d& b, double eps)
+{
+	for(std::size_t i=0; i!=4; ++i)
+	{
+		if(std::fabs(a.At(i)-b.At(i)) > eps) return false;
+	}
+	return true;
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_multiplication)
+{
+	for(int i=0; i<1000; ++i)
+	{
+		Mat4f a = random_matrix();
+		Mat4f b = random_matrix();
+
+		BOOST_CHECK(close_4x4(a*b, Mat4d(a)*Mat4d(b), 1e-5));
+		BOOST_CHECK(close_4x4(a*Mat4f(), Mat4d(a), 0.0));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_transposition)
+{
+	for(int i=0; i<100; ++i)
+	{
+		Mat4f a = random_matrix();
+		Mat4f t = Transposed(a);
+
+		for(std::size_t r=0; r!=4; ++r)
+		for(std::size_t c=0; c!=4; ++c)
+			BOOST_CHECK_EQUAL(t.At(r, c), a.At(c, r));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_inverse)
+{
+	for(int i=0; i<1000; ++i)
+	{
+		Mat4f a = random_invertible_matrix();
+		Mat4d id;
+		Mat4d tmp(a);
+		BOOST_CHECK(GaussJordan(tmp, id));
+
+		Mat4f ia = Inverse(a);
+		BOOST_CHECK(close_4x4(ia, id, 1e-5));
+		BOOST_CHECK(close_4x4(a*ia, Mat4d(), 1e-5));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_inverse_singular)
+{
+	float data[16] = {
+		1.0f, 2.0f, 3.0f, 4.0f,
+		2.0f, 4.0f, 6.0f, 8.0f,
+		0.0f, 1.0f, 0.0f, 1.0f,
+		1.0f, 0.0f, 1.0f, 0.0f
+	};
+	Mat4f i = Inverse(Mat4f(data));
+	for(std::size_t r=0; r!=4; ++r)
+	for(std::size_t c=0; c!=4; ++c)
+		BOOST_CHECK_EQUAL(i.At(r, c), 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_inverse_affine)
+{
+	for(int i=0; i<1000; ++i)
+	{
+		Mat4f a = random_affine_matrix();
+		Mat4d ad(a);
+		Mat4d id;
+		Mat4d tmp(ad);
+		BOOST_CHECK(GaussJordan(tmp, id));
+
+		BOOST_CHECK(close_4x4(InverseAffine(a), id, 1e-5));
+		BOOST_CHECK(close_4x4(InverseAffine(ad), id, 1e-12));
+	}
+
+	oglplus::ModelMatrix<float> m =
+		oglplus::ModelMatrixf::Translation(1.0f, 2.0f, 3.0f)*
+		oglplus::ModelMatrixf::RotationY(oglplus::Degrees(30.0f))*
+		oglplus::ModelMatrixf::Scale(2.0f, 2.0f, 2.0f);
+	BOOST_CHECK(close_4x4(m*InverseAffine(m), Mat4d(), 1e-5));
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_transformation)
+{
+	for(int i=0; i<1000; ++i)
+	{
+		Mat4f m = random_matrix();
+		Vec4f v(
+			random_value(),
+			random_value(),
+			random_value(),
+			random_value()
+		);
+		Mat4d md(m);
+		Vec4d vd(v);
+
+		BOOST_CHECK(close_4(m*v, md*vd, 1e-5));
+		BOOST_CHECK(close_4(v*m, vd*md, 1e-5));
+		BOOST_CHECK(close_4(
+			Vec4f(TransformPoint(m, v.xyz()), 0.0f),
+			Vec4d(TransformPoint(md, vd.xyz()), 0.0),
+			1e-5
+		));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_vector_operations)
+{
+	for(int i=0; i<1000; ++i)
+	{
+		Vec4f a(random_value(), random_value(), random_value(), 0.5f);
+		Vec4f b(random_value(), random_value(), random_value(), 2.0f);
+		Vec4d ad(a), bd(b);
+		float c = random_value();
+
+		BOOST_CHECK(close_4(-a, -ad, 0.0));
+		BOOST_CHECK(close_4(a+b, ad+bd, 1e-6));
+		BOOST_CHECK(close_4(a-b, ad-bd, 1e-6));
+		BOOST_CHECK(close_4(a*c, ad*double(c), 1e-6));
+		BOOST_CHECK(close_4(a/2.0f, ad/2.0, 1e-6));
+		BOOST_CHECK_CLOSE(Dot(a, b), float(Dot(ad, bd)), 1e-3);
+
+		Vec4f t = a;
+		t += b;
+		t *= c;
+		t -= a;
+		BOOST_CHECK(close_4(t, (ad+bd)*double(c)-ad, 1e-5));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Matrix_4x4_quaternion_multiplication)
+{
+	typedef oglplus::Quaternion<float> Quatf;
+	typedef oglplus::Quaternion<double> Quatd;
+	for(int i=0; i<1000; ++i)
+	{
+		Quatf p(random_value(), random_value(), random_value(), random_value());
+		Quatf q(random_value(), random_value(), random_value(), random_value());
+		Quatd pd(p.At(0), p.At(1), p.At(2), p.At(3));
+		Quatd qd(q.At(0), q.At(1), q.At(2), q.At(3));
+		Quatf r = p*q;
+		Quatd rd = pd*qd;
+
+		for(std::size_t j=0; j!=4; ++j)
+			BOOST_CHECK(std::fabs(r.At(j)-rd.At(j)) < 1e-6);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
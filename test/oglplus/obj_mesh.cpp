@@ -0,0 +1,547 @@
+/**
+ *  .file test/oglplus/obj_mesh.cpp
+ *  .brief Test case comparing the ObjMesh parser with the original one.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ObjMesh
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/obj_mesh.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+BOOST_AUTO_TEST_SUITE(ObjMesh)
+
+using namespace oglplus;
+
+// The original std::getline and std::stringstream based .obj parser,
+// kept here as the reference for the chunked in-memory parser
+struct ReferenceObjMesh
+{
+	struct vert_indices
+	{
+		GLuint pos, nml, tex, mtl;
+		vert_indices(void)
+		 : pos(0), nml(0), tex(0), mtl(0)
+		{ }
+	};
+
+	std::vector<double> pos_data, nml_data, tex_data;
+	std::vector<double> tgt_data, btg_data;
+	std::vector<GLuint> mtl_data;
+	std::vector<std::string> mtl_names;
+	std::vector<std::string> mesh_names;
+	std::vector<GLuint> mesh_offsets, mesh_counts;
+
+	typedef std::string::const_iterator iter;
+
+	static bool load_index(GLuint& value, GLuint n, iter& i, iter e)
+	{
+		bool neg = false;
+		if((i != e) && (*i == '-'))
+		{
+			neg = true;
+			++i;
+			while((i != e) && (std::isspace(*i))) ++i;
+		}
+		if((i != e) && (*i >= '0') && (*i <= '9'))
+		{
+			value = 0;
+			while((i != e) && (*i >= '0') && (*i <= '9'))
+			{
+				value *= 10;
+				value += GLuint(*i-'0');
+				++i;
+			}
+			if(neg) value = n - value;
+			return true;
+		}
+		return false;
+	}
+
+	static bool load_indices(
+		vert_indices& indices,
+		const vert_indices& counts,
+		iter& i,
+		iter e
+	)
+	{
+		indices = vert_indices();
+
+		while((i != e) && (std::isspace(*i))) ++i;
+		if(load_index(indices.pos, counts.pos, i, e))
+		{
+			if(i == e) return true;
+			if(std::isspace(*i)) return true;
+			if(*i == '/')
+			{
+				++i;
+				if(i == e) return false;
+				if(*i != '/')
+				{
+					if(!load_index(indices.tex, counts.tex, i, e))
+						return false;
+				}
+				if((i != e) && (*i == '/'))
+				{
+					++i;
+					if(i == e) return false;
+					if(std::isspace(*i)) return false;
+					if(!load_index(indices.nml, counts.nml, i, e))
+						return false;
+				}
+				return (i == e) || std::isspace(*i);
+			}
+		}
+		return false;
+	}
+
+	ReferenceObjMesh(std::istream& input)
+	{
+		const double unused[3] = {0.0, 0.0, 0.0};
+		std::vector<double> pos(unused, unused+3);
+		std::vector<double> nml(unused, unused+3);
+		std::vector<double> tex(unused, unused+3);
+		vert_indices n_attr;
+		n_attr.pos = 1;
+		n_attr.nml = 1;
+		n_attr.tex = 1;
+		n_attr.mtl = 1;
+		std::vector<vert_indices> idx_data(1, vert_indices());
+		mtl_names.push_back(std::string());
+
+		GLuint curr_mtl = 0;
+		std::string mtllib;
+
+		const std::string vert_tags(" tnp");
+		std::string line;
+		while(std::getline(input, line))
+		{
+			iter b = line.begin(), i = b, e = line.end();
+			while((b < e) && e[-1] == '\r') --e;
+			while((i != e) && std::isspace(*i)) ++i;
+			if(i == e) continue;
+			if(*i == '#') continue;
+			if((*i == 'm') || (*i == 'u'))
+			{
+				const char t = *i;
+				i += 6;
+				while((i != e) && std::isspace(*i)) ++i;
+				iter f = i;
+				while((f != e) && !std::isspace(*f)) ++f;
+				if(t == 'm')
+				{
+					mtllib = std::string(i, f);
+				}
+				else
+				{
+					std::string material;
+					if(!mtllib.empty()) material = mtllib + '#';
+					material.append(std::string(i, f));
+					curr_mtl = GLuint(mtl_names.size());
+					mtl_names.push_back(material);
+				}
+			}
+			else if(*i == 'v')
+			{
+				++i;
+				char t = *i;
+				++i;
+				std::stringstream str(line.c_str()+std::distance(b, i));
+				if(vert_tags.find(t) != std::string::npos)
+				{
+					double v[3] = {0.0, 0.0, 0.0};
+					str >> v[0];
+					str >> v[1];
+					str >> v[2];
+					if(t == ' ')
+					{
+						pos.insert(pos.end(), v, v+3);
+						++n_attr.pos;
+					}
+					if(t == 'n')
+					{
+						nml.insert(nml.end(), v, v+3);
+						++n_attr.nml;
+					}
+					if(t == 't')
+					{
+						tex.insert(tex.end(), v, v+3);
+						++n_attr.tex;
+					}
+				}
+			}
+			else if(*i == 'f')
+			{
+				++i;
+				while((i != e) && std::isspace(*i)) ++i;
+				vert_indices vi1[3];
+				for(std::size_t n=0; n!=3; ++n)
+				{
+					BOOST_REQUIRE(load_indices(vi1[n], n_attr, i, e));
+					vi1[n].mtl = curr_mtl;
+				}
+				idx_data.insert(idx_data.end(), vi1, vi1+3);
+				vert_indices vi2[3] = {vi1[0], vi1[2], vert_indices()};
+				while(load_indices(vi2[2], n_attr, i, e))
+				{
+					vi2[2].mtl = curr_mtl;
+					idx_data.insert(idx_data.end(), vi2, vi2+3);
+					vi2[1] = vi2[2];
+				}
+			}
+			else if(*i == 'o')
+			{
+				++i;
+				while((i != e) && std::isspace(*i)) ++i;
+				if(!mesh_offsets.empty())
+				{
+					mesh_counts.push_back(
+						GLuint(idx_data.size())-
+						mesh_offsets.back()
+					);
+				}
+				mesh_names.push_back(std::string(i, e));
+				mesh_offsets.push_back(GLuint(idx_data.size()));
+			}
+		}
+		if(mesh_offsets.empty())
+		{
+			mesh_offsets.push_back(1);
+			mesh_counts.push_back(GLuint(idx_data.size()-1));
+		}
+		else
+		{
+			mesh_counts.push_back(
+				GLuint(idx_data.size()-mesh_offsets.back())
+			);
+		}
+		if(mesh_names.empty()) mesh_names.push_back(std::string());
+
+		std::size_t ni = idx_data.size()-1;
+		pos_data.resize(ni*3);
+		nml_data.resize(ni*3);
+		tex_data.resize(ni*3);
+		mtl_data.resize(ni);
+		// the faces before the first object are not loaded
+		for(std::size_t m=0; m!=mesh_offsets.size(); ++m)
+		{
+			std::size_t ii = mesh_offsets[m];
+			for(ni = ii+mesh_counts[m]; ii!=ni; ++ii)
+			{
+				for(std::size_t c=0; c!=3; ++c)
+				{
+					std::size_t oi = (ii-1)*3+c;
+					pos_data[oi] = pos[idx_data[ii].pos*3+c];
+					nml_data[oi] = nml[idx_data[ii].nml*3+c];
+					tex_data[oi] = tex[idx_data[ii].tex*3+c];
+				}
+				mtl_data[ii-1] = idx_data[ii].mtl;
+			}
+		}
+		// the drawing instructions use the accumulated mesh counts
+		GLuint mo = 0;
+		for(std::size_t m=0; m!=mesh_offsets.size(); ++m)
+		{
+			mesh_offsets[m] = mo;
+			mo += mesh_counts[m];
+		}
+
+		tgt_data.resize(pos_data.size());
+		btg_data.resize(pos_data.size());
+		for(std::size_t f=0, nf = pos_data.size()/9; f != nf; ++f)
+		{
+			for(std::size_t v=0; v!=3; ++v)
+			{
+				std::size_t j[3] = { v, (v+1)%3, (v+2)%3 };
+				Vec3d p[3];
+				Vec2d uv[3];
+				for(std::size_t k=0; k<3; ++k)
+				{
+					p[k] = Vec3d(
+						pos_data[f*9+j[k]*3+0],
+						pos_data[f*9+j[k]*3+1],
+						pos_data[f*9+j[k]*3+2]
+					);
+					uv[k] = Vec2d(
+						tex_data[f*9+j[k]*3+0],
+						tex_data[f*9+j[k]*3+1]
+					);
+				}
+				Vec3d v0 = p[1] - p[0];
+				Vec3d v1 = p[2] - p[0];
+				Vec2d duv0 = uv[1] - uv[0];
+				Vec2d duv1 = uv[2] - uv[0];
+
+				double d = duv0.x()*duv1.y()-duv0.y()*duv1.x();
+				if(d != 0.0f) d = 1.0f/d;
+
+				Vec3f nt = Normalized(Vec3f((duv1.y()*v0-duv0.y()*v1)*d));
+				Vec3f nb = Normalized(Vec3f((duv0.x()*v1-duv1.x()*v0)*d));
+				for(std::size_t c=0; c!=3; ++c)
+				{
+					tgt_data[f*9+v*3+c] = nt.At(c);
+					btg_data[f*9+v*3+c] = nb.At(c);
+				}
+			}
+		}
+	}
+};
+
+static std::vector<GLfloat> to_float(const std::vector<double>& v)
+{
+	return std::vector<GLfloat>(v.begin(), v.end());
+}
+
+// exact comparison of float arrays (distinguishes -0.0 and 0.0,
+// the tangents of degenerate faces are NaNs)
+static bool same_floats(
+	const std::vector<GLfloat>& a,
+	const std::vector<GLfloat>& b
+)
+{
+	return	(a.size() == b.size()) &&
+		std::equal(a.begin(), a.end(), b.begin(),
+			[](GLfloat x, GLfloat y)
+			{
+				if(std::isnan(x)) return std::isnan(y);
+				return	(x == y) &&
+					(std::signbit(x) == std::signbit(y));
+			}
+		) ;
+}
+
+// parses the input with both parsers and compares the results
+static void check_same(const std::string& input, unsigned chunks = 0)
+{
+	std::istringstream ref_input(input);
+	ReferenceObjMesh ref(ref_input);
+
+	std::istringstream obj_input(input);
+	shapes::ObjMesh obj(
+		obj_input,
+		shapes::ObjMesh::LoadingOptions().Chunks(chunks)
+	);
+
+	std::vector<GLfloat> data;
+
+	obj.Positions(data);
+	BOOST_CHECK(same_floats(data, to_float(ref.pos_data)));
+	obj.Normals(data);
+	BOOST_CHECK(same_floats(data, to_float(ref.nml_data)));
+	obj.TexCoordinates(data);
+	BOOST_CHECK(same_floats(data, to_float(ref.tex_data)));
+	obj.Tangents(data);
+	BOOST_CHECK(same_floats(data, to_float(ref.tgt_data)));
+	obj.Bitangents(data);
+	BOOST_CHECK(same_floats(data, to_float(ref.btg_data)));
+
+	std::vector<GLuint> mtl;
+	obj.MaterialNumbers(mtl);
+	BOOST_CHECK(mtl == ref.mtl_data);
+	for(GLuint m : ref.mtl_data)
+	{
+		BOOST_CHECK_EQUAL(obj.MaterialName(m), ref.mtl_names[m]);
+	}
+
+	auto instr = obj.Instructions();
+	BOOST_REQUIRE_EQUAL(instr.Operations().size(), ref.mesh_names.size());
+	for(std::size_t m=0; m!=ref.mesh_names.size(); ++m)
+	{
+		BOOST_CHECK_EQUAL(instr.Operations()[m].first, ref.mesh_offsets[m]);
+		BOOST_CHECK_EQUAL(instr.Operations()[m].count, ref.mesh_counts[m]);
+
+		GLuint index = 0;
+		BOOST_CHECK(obj.QueryMeshIndex(ref.mesh_names[m], index));
+		BOOST_CHECK_EQUAL(index, m);
+	}
+}
+
+static std::string to_crlf(const std::string& input)
+{
+	std::string result;
+	for(char c : input)
+	{
+		if(c == '\n') result.push_back('\r');
+		result.push_back(c);
+	}
+	return result;
+}
+
+static const char* small_obj =
+	"# comment\n"
+	"mtllib materials.mtl\n"
+	"o first\n"
+	"v 1 2 3\n"
+	"v -1.5 +2.25 -0\n"
+	"v 1e-3 -2.5E+2 .5\n"
+	"v 3. 1.0e10 -7e-300\n"
+	"v 0.1 0.2 0.3\n"
+	"v 3.14159265358979323846264 2.718281828459045235360287 1e23\n"
+	"vt 0 0\n"
+	"vt 1 0 0.5\n"
+	"vt 0.5 1\n"
+	"vn 0 0 1\n"
+	"vn 0 1 0\n"
+	"vn 0.577350269 -0.577350269 5.77350269e-1\n"
+	"usemtl red\n"
+	"f 1/1/1 2/2/2 3/3/3\n"
+	"f 1//1 3//2 4//3 5//1\n"
+	"f 2/1 4/2 6/3\n"
+	"  f 4 5 6\n"
+	"o second\n"
+	"usemtl green\n"
+	"f -1/-1/-1 -2/-2/-2 -3/-3/-3 -4/-1/-2\n"
+	"v 9 8 7\n"
+	"vt 0.25 0.75\n"
+	"vn -1 0 0\n"
+	"f -1/-1/-1 -3//-2 -5/-2\n"
+	"f 7 -1 1\n"
+	"vp 1 2 3\n"
+	"\n"
+	"o third\n"
+	"usemtl blue\n"
+	"f 1/1/1 2/2/2 7/4/4\n";
+
+// returns true if a nominal chunk boundary falls inside of a line
+static bool straddles(const std::string& input, unsigned chunks)
+{
+	bool result = false;
+	for(unsigned c=1; c<chunks; ++c)
+	{
+		std::size_t boundary = input.size()*c/chunks;
+		if(input[boundary-1] != '\n') result = true;
+	}
+	return result;
+}
+
+BOOST_AUTO_TEST_CASE(ObjMesh_formats)
+{
+	check_same(small_obj);
+}
+
+BOOST_AUTO_TEST_CASE(ObjMesh_crlf)
+{
+	check_same(to_crlf(small_obj));
+}
+
+BOOST_AUTO_TEST_CASE(ObjMesh_no_objects)
+{
+	check_same(
+		"v 0 0 0\n"
+		"v 1 0 0\n"
+		"v 0 1 0\n"
+		"f 1 2 3"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(ObjMesh_small_chunks)
+{
+	// the statements and relative indices are resolved across
+	// the chunk boundaries, regardless of where they fall
+	const std::string lf(small_obj), crlf(to_crlf(small_obj));
+	for(unsigned chunks=2; chunks!=24; ++chunks)
+	{
+		BOOST_CHECK(straddles(lf, chunks));
+		check_same(lf, chunks);
+		check_same(crlf, chunks);
+	}
+}
+
+// generates an input large enough to be split into multiple chunks
+static std::string make_large_obj(void)
+{
+	std::string result;
+	char buf[256];
+	unsigned seed = 12345;
+	auto rnd = [&seed](void) -> unsigned
+	{
+		seed = seed*1103515245u + 12345u;
+		return (seed >> 8) & 0xFFFF;
+	};
+
+	result.append("mtllib big.mtl\n");
+	unsigned obj_no = 0, mtl_no = 0;
+	while(result.size() < 1024*1024)
+	{
+		if(rnd() % 64 == 0)
+		{
+			std::sprintf(buf, "o object_%u\n", obj_no++);
+			result.append(buf);
+		}
+		if(rnd() % 32 == 0)
+		{
+			std::sprintf(buf, "usemtl material_%u\n", mtl_no++);
+			result.append(buf);
+		}
+		for(unsigned v=0; v!=4; ++v)
+		{
+			std::sprintf(
+				buf,
+				"v %d.%03u %de-%u %.9g\n",
+				int(rnd()%2001)-1000, rnd()%1000,
+				int(rnd()%200)-100, rnd()%12,
+				double(rnd())/997.0
+			);
+			result.append(buf);
+			std::sprintf(
+				buf,
+				"vt %.6f %.6f\n",
+				double(rnd())/65536.0,
+				double(rnd())/65536.0
+			);
+			result.append(buf);
+			std::sprintf(
+				buf,
+				"vn %.7e %.7e %.7e\n",
+				double(rnd())/65535.0-0.5,
+				double(rnd())/65535.0-0.5,
+				double(rnd())/65535.0-0.5
+			);
+			result.append(buf);
+		}
+		switch(rnd() % 4)
+		{
+			case 0:
+				result.append("f -1/-1/-1 -2/-2/-2 -3/-3/-3 -4/-4/-4\n");
+				break;
+			case 1:
+				result.append("f -4//-4 -3//-3 -2//-2\n");
+				break;
+			case 2:
+				result.append("f -1/-2 -2/-3 -3/-4\r\n");
+				break;
+			default:
+				result.append("f -3 -2 -1 -4\n");
+				break;
+		}
+	}
+	return result;
+}
+
+BOOST_AUTO_TEST_CASE(ObjMesh_chunks)
+{
+	const std::string input = make_large_obj();
+
+	check_same(input);
+	for(unsigned chunks : {2u, 3u, 7u})
+	{
+		BOOST_CHECK(straddles(input, chunks));
+		check_same(input, chunks);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
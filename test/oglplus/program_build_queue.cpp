@@ -0,0 +1,113 @@
+/**
+ *  .file test/oglplus/program_build_queue.cpp
+ *  .brief Test case for the ProgramBuildQueue.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ProgramBuildQueue
+#include <boost/test/unit_test.hpp>
+
+#define OGLPLUS_GL_DISPATCH 1
+#include <oglplus/gl.hpp>
+#include <oglplus/program_build_queue.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ProgramBuildQueueTests)
+
+using namespace oglplus;
+
+// programs without attached shaders which are always linked
+static void GLAPIENTRY get_programiv(GLuint, GLenum pname, GLint* params)
+{
+	*params = (pname == GL_LINK_STATUS)?GL_TRUE:0;
+}
+
+struct null_gl
+{
+	GLNullBackend backend;
+
+	null_gl(void)
+	{
+		OGLPLUS_GLFUNC_OVERRIDE(GetProgramiv, &get_programiv);
+	}
+
+	~null_gl(void)
+	{
+		OGLPLUS_GLFUNC_OVERRIDE(GetProgramiv, nullptr);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(ProgramBuildQueue_poll_and_result)
+{
+	null_gl gl;
+	Program a, b;
+	ProgramBuildQueue queue(false);
+
+	ProgramBuildQueue::Ticket ta = queue.Submit(a);
+	ProgramBuildQueue::Ticket tb = queue.Submit(b);
+	BOOST_CHECK(ta != tb);
+	BOOST_CHECK_EQUAL(queue.PendingCount(), 2u);
+
+	std::vector<ProgramBuildQueue::Ticket> finished;
+	BOOST_CHECK_EQUAL(queue.Poll(finished), 2u);
+	BOOST_CHECK(queue.Empty());
+	BOOST_CHECK_EQUAL(finished.size(), 2u);
+	BOOST_CHECK(queue.Finished(ta));
+
+	BOOST_CHECK(&queue.Result(ta).Then() == &a);
+	BOOST_CHECK(&queue.Result(tb).Then() == &b);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramBuildQueue_result_without_poll)
+{
+	null_gl gl;
+	Program a, b;
+	ProgramBuildQueue queue(false);
+
+	ProgramBuildQueue::Ticket ta = queue.Submit(a);
+	ProgramBuildQueue::Ticket tb = queue.Submit(b);
+
+	// retrieving the result removes the program from the pending ones
+	BOOST_CHECK(&queue.Result(tb).Then() == &b);
+	BOOST_CHECK_EQUAL(queue.PendingCount(), 1u);
+
+	std::vector<ProgramBuildQueue::Ticket> finished;
+	BOOST_CHECK_EQUAL(queue.Poll(finished), 1u);
+	BOOST_CHECK(finished.front() == ta);
+	BOOST_CHECK(&queue.Result(ta).Then() == &a);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramBuildQueue_ticket_reuse)
+{
+	null_gl gl;
+	Program a, b;
+	ProgramBuildQueue queue(false);
+
+	// the entries of the retrieved results are reused,
+	// but the new tickets differ from the invalidated ones
+	ProgramBuildQueue::Ticket ta = queue.Submit(a);
+	queue.Result(ta).Done();
+
+	ProgramBuildQueue::Ticket tb = queue.Submit(b);
+	BOOST_CHECK(ta != tb);
+	BOOST_CHECK(&queue.Result(tb).Then() == &b);
+
+	// clearing the queue invalidates the pending tickets
+	ProgramBuildQueue::Ticket tc = queue.Submit(a);
+	queue.Clear();
+	BOOST_CHECK(queue.Empty());
+
+	ProgramBuildQueue::Ticket td = queue.Submit(b);
+	BOOST_CHECK(tc != td);
+	BOOST_CHECK(tb != td);
+	BOOST_CHECK(&queue.Result(td).Then() == &b);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,288 @@
+/**
+ *  .file test/oglplus/program_cache.cpp
+ *  .brief Test case for the ProgramCache.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ProgramCache
+#include <boost/test/unit_test.hpp>
+
+#define OGLPLUS_GL_DISPATCH 1
+#include <oglplus/gl.hpp>
+#include <oglplus/program_cache.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+BOOST_AUTO_TEST_SUITE(ProgramCacheTests)
+
+using namespace oglplus;
+
+#if GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+static const GLenum test_format = 0x1234;
+
+// the state of the fake GL program binary implementation
+struct fake_program_state
+{
+	std::vector<GLubyte> binary;
+	bool linked;
+	bool reject;
+	unsigned links;
+	unsigned loads;
+
+	void Reset(void)
+	{
+		binary = {'b', 'i', 'n', 'a', 'r', 'y', 0x00, 0xFF};
+		linked = false;
+		reject = false;
+		links = 0;
+		loads = 0;
+	}
+};
+
+static fake_program_state& fake(void)
+{
+	static fake_program_state state;
+	return state;
+}
+
+static void GLAPIENTRY get_integerv(GLenum pname, GLint* params)
+{
+	*params = (pname == GL_NUM_PROGRAM_BINARY_FORMATS)?1:0;
+}
+
+static void GLAPIENTRY get_programiv(GLuint, GLenum pname, GLint* params)
+{
+	switch(pname)
+	{
+		case GL_LINK_STATUS:
+			*params = fake().linked?GL_TRUE:GL_FALSE;
+			break;
+		case GL_PROGRAM_BINARY_LENGTH:
+			*params = GLint(fake().binary.size());
+			break;
+		default: *params = 0;
+	}
+}
+
+static void GLAPIENTRY link_program(GLuint)
+{
+	fake().linked = true;
+	++fake().links;
+}
+
+static void GLAPIENTRY get_program_binary(
+	GLuint,
+	GLsizei size,
+	GLsizei* length,
+	GLenum* format,
+	void* binary
+)
+{
+	const std::vector<GLubyte>& data = fake().binary;
+	BOOST_REQUIRE(std::size_t(size) >= data.size());
+	std::memcpy(binary, data.data(), data.size());
+	*length = GLsizei(data.size());
+	*format = test_format;
+}
+
+static void GLAPIENTRY program_binary(
+	GLuint,
+	GLenum format,
+	const void* binary,
+	GLsizei length
+)
+{
+	const std::vector<GLubyte>& data = fake().binary;
+	++fake().loads;
+	fake().linked =
+		!fake().reject &&
+		(format == test_format) &&
+		(std::size_t(length) == data.size()) &&
+		(std::memcmp(binary, data.data(), data.size()) == 0);
+}
+
+// installs the fake program binary functions and removes
+// the cache entry at the end of a test
+struct null_gl
+{
+	GLNullBackend backend;
+	std::string entry;
+
+	null_gl(void)
+	{
+		fake().Reset();
+		OGLPLUS_GLFUNC_OVERRIDE(GetIntegerv, &get_integerv);
+		OGLPLUS_GLFUNC_OVERRIDE(GetProgramiv, &get_programiv);
+		OGLPLUS_GLFUNC_OVERRIDE(LinkProgram, &link_program);
+		OGLPLUS_GLFUNC_OVERRIDE(GetProgramBinary, &get_program_binary);
+		OGLPLUS_GLFUNC_OVERRIDE(ProgramBinary, &program_binary);
+	}
+
+	~null_gl(void)
+	{
+		if(!entry.empty()) std::remove(entry.c_str());
+		OGLPLUS_GLFUNC_OVERRIDE(GetIntegerv, nullptr);
+		OGLPLUS_GLFUNC_OVERRIDE(GetProgramiv, nullptr);
+		OGLPLUS_GLFUNC_OVERRIDE(LinkProgram, nullptr);
+		OGLPLUS_GLFUNC_OVERRIDE(GetProgramBinary, nullptr);
+		OGLPLUS_GLFUNC_OVERRIDE(ProgramBinary, nullptr);
+	}
+};
+
+static std::vector<char> read_file(const std::string& path)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	return std::vector<char>(
+		(std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>()
+	);
+}
+
+static void write_file(const std::string& path, const std::vector<char>& data)
+{
+	std::ofstream file(path, std::ios::out | std::ios::binary);
+	file.write(data.data(), std::streamsize(data.size()));
+}
+
+static bool file_exists(const std::string& path)
+{
+	return std::ifstream(path).is_open();
+}
+
+// builds a program with the cache and returns the path of its entry
+static std::string build(ProgramCache& cache, const char* variant = "test")
+{
+	fake().linked = false;
+	Program program;
+	BOOST_CHECK(cache.Build(program, variant).Done());
+	BOOST_CHECK(program.IsLinked());
+	return cache.EntryPath(program, variant);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_miss_and_hit)
+{
+	null_gl gl;
+	ProgramCache cache(".", "vendor\nrenderer\nversion");
+	BOOST_CHECK(cache.Enabled());
+
+	gl.entry = build(cache);
+	BOOST_CHECK_EQUAL(cache.MissCount(), 1u);
+	BOOST_CHECK_EQUAL(cache.StoreCount(), 1u);
+	BOOST_CHECK_EQUAL(fake().links, 1u);
+	BOOST_CHECK(file_exists(gl.entry));
+
+	// the stored binary is loaded instead of linking the program
+	BOOST_CHECK(build(cache) == gl.entry);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 1u);
+	BOOST_CHECK_EQUAL(cache.MissCount(), 1u);
+	BOOST_CHECK_EQUAL(fake().links, 1u);
+	BOOST_CHECK_EQUAL(fake().loads, 1u);
+
+	// a different variant is a different entry
+	Program other;
+	BOOST_CHECK(cache.EntryPath(other, "other") != gl.entry);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_corrupted)
+{
+	null_gl gl;
+	ProgramCache cache(".", "vendor\nrenderer\nversion");
+	gl.entry = build(cache);
+
+	std::vector<char> data = read_file(gl.entry);
+	BOOST_REQUIRE(data.size() > fake().binary.size());
+	data.back() ^= 0x10;
+	write_file(gl.entry, data);
+
+	// the entry with an invalid checksum is discarded and rebuilt
+	build(cache);
+	BOOST_CHECK_EQUAL(cache.DiscardCount(), 1u);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 0u);
+	BOOST_CHECK_EQUAL(cache.MissCount(), 2u);
+	BOOST_CHECK_EQUAL(cache.StoreCount(), 2u);
+	BOOST_CHECK_EQUAL(fake().loads, 0u);
+
+	build(cache);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_truncated)
+{
+	null_gl gl;
+	ProgramCache cache(".", "vendor\nrenderer\nversion");
+	gl.entry = build(cache);
+
+	std::vector<char> data = read_file(gl.entry);
+	data.resize(data.size()-3);
+	write_file(gl.entry, data);
+
+	build(cache);
+	BOOST_CHECK_EQUAL(cache.DiscardCount(), 1u);
+	BOOST_CHECK_EQUAL(cache.MissCount(), 2u);
+	BOOST_CHECK_EQUAL(cache.StoreCount(), 2u);
+
+	// a truncated header is discarded too
+	data.resize(10);
+	write_file(gl.entry, data);
+
+	build(cache);
+	BOOST_CHECK_EQUAL(cache.DiscardCount(), 2u);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 0u);
+	BOOST_CHECK_EQUAL(fake().loads, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_key_check_mismatch)
+{
+	null_gl gl;
+	ProgramCache cache(".", "vendor\nrenderer\nversion");
+	gl.entry = build(cache);
+
+	// an entry of a different program with the same name
+	// is not an error, it is replaced when the program is built
+	std::vector<char> data = read_file(gl.entry);
+	data[8] ^= 0x01;
+	write_file(gl.entry, data);
+
+	build(cache);
+	BOOST_CHECK_EQUAL(cache.DiscardCount(), 0u);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 0u);
+	BOOST_CHECK_EQUAL(cache.MissCount(), 2u);
+	BOOST_CHECK_EQUAL(cache.StoreCount(), 2u);
+	BOOST_CHECK_EQUAL(fake().loads, 0u);
+
+	build(cache);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(ProgramCache_rejected_binary)
+{
+	null_gl gl;
+	ProgramCache cache(".", "vendor\nrenderer\nversion");
+	gl.entry = build(cache);
+
+	// for example after a driver update
+	fake().reject = true;
+	build(cache);
+	BOOST_CHECK_EQUAL(fake().loads, 1u);
+	BOOST_CHECK_EQUAL(fake().links, 2u);
+	BOOST_CHECK_EQUAL(cache.DiscardCount(), 1u);
+	BOOST_CHECK_EQUAL(cache.HitCount(), 0u);
+	BOOST_CHECK_EQUAL(cache.StoreCount(), 2u);
+	BOOST_CHECK(file_exists(gl.entry));
+}
+
+#endif // GL_VERSION_4_1 || GL_ARB_get_program_binary
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+/**
+ *  .file test/oglplus/shape_analyzer.cpp
+ *  .brief Test case for the shape analyzer adjacency detection.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_ShapeAnalyzer
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/shapes/analyzer.hpp>
+#include <oglplus/shapes/cube.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ShapeAnalyzer)
+
+// checks that the adjacency is symmetric and that adjacent
+// edges have the same end points; returns the number of open edges
+static unsigned check_adjacency(oglplus::shapes::ShapeAnalyzer& a)
+{
+	unsigned open_edges = 0;
+	for(GLuint f=0; f!=a.FaceCount(); ++f)
+	{
+		auto face = a.Face(f);
+		for(GLuint e=0; e!=face.Arity(); ++e)
+		{
+			auto edge = face.Edge(e);
+			if(!edge.HasAdjacentEdge())
+			{
+				++open_edges;
+				continue;
+			}
+			auto adj = edge.AdjacentEdge();
+			auto adj_face = adj.Face();
+			BOOST_CHECK(adj_face.Index() != f);
+
+			auto back = adj.AdjacentEdge();
+			BOOST_CHECK_EQUAL(back.Face().Index(), f);
+			BOOST_CHECK_EQUAL(back.Index(), e);
+
+			const GLuint n = face.Arity();
+			const GLuint m = adj_face.Arity();
+			auto a0 = face.Vert(e).MainAttrib();
+			auto a1 = face.Vert((e+1)%n).MainAttrib();
+			auto b0 = adj_face.Vert(adj.Index()).MainAttrib();
+			auto b1 = adj_face.Vert((adj.Index()+1)%m).MainAttrib();
+			BOOST_CHECK(
+				((Distance(a0, b0) < 1e-6) && (Distance(a1, b1) < 1e-6)) ||
+				((Distance(a0, b1) < 1e-6) && (Distance(a1, b0) < 1e-6))
+			);
+		}
+	}
+	return open_edges;
+}
+
+// a flat grid of unindexed triangles, the duplicated vertices
+// are displaced by less than the analyzer's epsilon
+class TriangleSoup
+ : public oglplus::shapes::DrawingInstructionWriter
+{
+private:
+	GLuint _n;
+public:
+	TriangleSoup(GLuint n)
+	 : _n(n)
+	{ }
+
+	GLuint Positions(std::vector<GLdouble>& dest) const
+	{
+		const GLdouble offs[6][2] = {
+			{0, 0}, {1, 0}, {0, 1},
+			{0, 1}, {1, 0}, {1, 1}
+		};
+		dest.clear();
+		for(GLuint i=0; i!=_n; ++i)
+		for(GLuint j=0; j!=_n; ++j)
+		for(GLuint v=0; v!=6; ++v)
+		{
+			GLdouble jitter = GLdouble((i+j+v)%5)*1e-10-2e-10;
+			dest.push_back((i+offs[v][0])*0.25+jitter);
+			dest.push_back((j+offs[v][1])*0.25-jitter);
+			dest.push_back(jitter);
+		}
+		return 3;
+	}
+
+	GLuint Normals(std::vector<GLdouble>& dest) const
+	{
+		dest.clear();
+		for(GLuint v=0; v!=_n*_n*6; ++v)
+		{
+			dest.push_back(0);
+			dest.push_back(0);
+			dest.push_back(1);
+		}
+		return 3;
+	}
+
+	std::vector<GLuint> Indices(void) const
+	{
+		return std::vector<GLuint>();
+	}
+
+	oglplus::shapes::DrawingInstructions Instructions(void) const
+	{
+		oglplus::shapes::DrawOperation operation;
+		operation.method = oglplus::shapes::DrawOperation::Method::DrawArrays;
+		operation.mode = oglplus::PrimitiveType::Triangles;
+		operation.first = 0;
+		operation.count = _n*_n*6;
+		operation.restart_index =
+			oglplus::shapes::DrawOperation::NoRestartIndex();
+		operation.phase = 0;
+		return this->MakeInstructions(operation);
+	}
+};
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_triangle_soup)
+{
+	const GLuint n = 16;
+	TriangleSoup soup(n);
+	oglplus::shapes::ShapeAnalyzer a(soup);
+	BOOST_CHECK_EQUAL(a.FaceCount(), n*n*2);
+	BOOST_CHECK_EQUAL(check_adjacency(a), n*4);
+
+	for(GLuint f=0; f!=a.FaceCount(); ++f)
+	{
+		auto face = a.Face(f);
+		for(GLuint e=0; e!=face.Arity(); ++e)
+		{
+			auto edge = face.Edge(e);
+			BOOST_CHECK(edge.HasAdjacentEdge() == edge.IsSmoothEdge());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_cube)
+{
+	oglplus::shapes::Cube cube;
+	oglplus::shapes::ShapeAnalyzer a(cube);
+	BOOST_CHECK_EQUAL(check_adjacency(a), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(ShapeAnalyzer_smooth_edges)
+{
+	// the faces of the cube meet at sharp edges, so
+	// only the diagonals of the sides are smooth
+	oglplus::shapes::Cube cube;
+	oglplus::shapes::ShapeAnalyzer a(cube);
+	unsigned smooth = 0;
+	for(GLuint f=0; f!=a.FaceCount(); ++f)
+	{
+		auto face = a.Face(f);
+		for(GLuint e=0; e!=face.Arity(); ++e)
+		{
+			if(face.Edge(e).IsSmoothEdge()) ++smooth;
+		}
+	}
+	BOOST_CHECK_EQUAL(smooth, 12u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
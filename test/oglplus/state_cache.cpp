@@ -0,0 +1,231 @@
+/**
+ *  .file test/oglplus/state_cache.cpp
+ *  .brief Test case for the StateCache.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_StateCache
+#include <boost/test/unit_test.hpp>
+
+#define OGLPLUS_GL_DISPATCH 1
+#include <oglplus/gl.hpp>
+#include <oglplus/state_cache.hpp>
+#include <oglplus/buffer.hpp>
+#include <oglplus/vertex_array.hpp>
+#include <oglplus/framebuffer.hpp>
+#include <oglplus/object/array.hpp>
+#include <oglplus/capability.hpp>
+#include <oglplus/ext/KHR_debug.hpp>
+#include <oglplus/dispatch/null_backend.hpp>
+#include <oglplus/dispatch/recorder.hpp>
+
+#include <cstring>
+
+BOOST_AUTO_TEST_SUITE(StateCacheTests)
+
+using namespace oglplus;
+
+// returns the number of the recorded calls of the specified GL function
+static unsigned long calls(const GLCallRecorder& recorder, const char* name)
+{
+	for(const GLCallStats& stats : recorder.Statistics())
+	{
+		if(std::strcmp(stats.Name, name) == 0)
+		{
+			return stats.Count;
+		}
+	}
+	return 0;
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_redundant_binds)
+{
+	GLNullBackend null_gl;
+	StateCache cache;
+	BOOST_CHECK(StateCache::Current() == &cache);
+
+	Buffer a, b;
+	GLCallRecorder recorder;
+
+	a.Bind(BufferTarget::Array);
+	a.Bind(BufferTarget::Array);
+	a.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 1u);
+
+	// different target or name is not redundant
+	a.Bind(BufferTarget::Uniform);
+	b.Bind(BufferTarget::Array);
+	a.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 4u);
+
+	BOOST_CHECK_EQUAL(cache.CallCount(), 6u);
+	BOOST_CHECK_EQUAL(cache.SavedCount(), 2u);
+
+	// the binding query returns the real binding
+	BOOST_CHECK(Buffer::Binding(BufferTarget::Array) == a);
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_no_cache)
+{
+	GLNullBackend null_gl;
+	BOOST_CHECK(StateCache::Current() == nullptr);
+
+	Buffer a;
+	GLCallRecorder recorder;
+
+	a.Bind(BufferTarget::Array);
+	a.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_vertex_array)
+{
+	GLNullBackend null_gl;
+	StateCache cache;
+
+	VertexArray vao1, vao2;
+	Buffer vbo, ibo;
+	GLCallRecorder recorder;
+
+	vao1.Bind();
+	vbo.Bind(BufferTarget::Array);
+	ibo.Bind(BufferTarget::ElementArray);
+	ibo.Bind(BufferTarget::ElementArray);
+	vao1.Bind();
+	BOOST_CHECK_EQUAL(calls(recorder, "BindVertexArray"), 1u);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 2u);
+
+	// the element array buffer binding is a part of the VAO state
+	vao2.Bind();
+	ibo.Bind(BufferTarget::ElementArray);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindVertexArray"), 2u);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 3u);
+
+	// while the array buffer binding is not
+	vbo.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 3u);
+
+	// the element array buffer binding of vao1 is not known
+	vao1.Bind();
+	ibo.Bind(BufferTarget::ElementArray);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_framebuffer)
+{
+	GLNullBackend null_gl;
+	StateCache cache;
+
+	Framebuffer fbo;
+	GLCallRecorder recorder;
+
+	fbo.Bind(FramebufferTarget::Draw);
+	fbo.Bind(FramebufferTarget::Draw);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 1u);
+
+	// GL_FRAMEBUFFER is not cached as the draw binding
+	fbo.Bind(FramebufferTarget(GL_FRAMEBUFFER));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 2u);
+	fbo.Bind(FramebufferTarget(GL_FRAMEBUFFER));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 2u);
+
+	// binding GL_FRAMEBUFFER drops the draw and read bindings
+	fbo.Bind(FramebufferTarget::Draw);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 3u);
+	fbo.Bind(FramebufferTarget::Read);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 4u);
+
+	// binding the draw or read framebuffer drops GL_FRAMEBUFFER
+	fbo.Bind(FramebufferTarget(GL_FRAMEBUFFER));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 5u);
+	fbo.Bind(FramebufferTarget::Read);
+	fbo.Bind(FramebufferTarget(GL_FRAMEBUFFER));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindFramebuffer"), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_invalidate)
+{
+	GLNullBackend null_gl;
+	StateCache cache;
+
+	Buffer buf;
+	GLCallRecorder recorder;
+
+	buf.Bind(BufferTarget::Array);
+	buf.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 1u);
+
+	// the state may have been changed by foreign GL code
+	cache.Invalidate();
+	buf.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 2u);
+	buf.Bind(BufferTarget::Array);
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(StateCache_deleted_names)
+{
+	GLNullBackend null_gl;
+	StateCache cache;
+
+	GLuint name = 0;
+	{
+		Buffer tmp;
+		tmp.Bind(BufferTarget::Array);
+		name = GetGLName(tmp);
+	}
+	GLCallRecorder recorder;
+
+	// deleting the buffer resets its bindings in GL, so if the name
+	// is reused then binding it must not be elided
+	Buffer::Bind(BufferTarget::Array, BufferName(name));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 1u);
+
+	std::vector<GLuint> names;
+	{
+		Array<Buffer> tmps(3);
+		for(std::size_t i=0; i!=tmps.size(); ++i)
+		{
+			tmps[i].Bind(BufferTarget::Uniform);
+			names.push_back(GetGLName(tmps[i]));
+		}
+		VertexArray vao;
+		vao.Bind();
+		tmps[0].Bind(BufferTarget::ElementArray);
+	}
+	recorder.Reset();
+
+	Buffer::Bind(BufferTarget::Uniform, BufferName(names.back()));
+	Buffer::Bind(BufferTarget::ElementArray, BufferName(names.front()));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 2u);
+
+	// other bindings are kept
+	Buffer::Bind(BufferTarget::Array, BufferName(name));
+	BOOST_CHECK_EQUAL(calls(recorder, "BindBuffer"), 2u);
+}
+
+#if GL_KHR_debug
+BOOST_AUTO_TEST_CASE(StateCache_debug_output_synchronous)
+{
+	GLNullBackend null_gl;
+	StateCache cache;
+	GLCallRecorder recorder;
+
+	aux::EnableCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS, true);
+	KHR_debug::Synchronous(true);
+	BOOST_CHECK_EQUAL(calls(recorder, "Enable"), 1u);
+
+	// the extension wrapper updates the cached capability
+	KHR_debug::Synchronous(false);
+	aux::EnableCapability(GL_DEBUG_OUTPUT_SYNCHRONOUS, true);
+	BOOST_CHECK_EQUAL(calls(recorder, "Disable"), 1u);
+	BOOST_CHECK_EQUAL(calls(recorder, "Enable"), 2u);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
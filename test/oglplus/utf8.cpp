@@ -0,0 +1,189 @@
+/**
+ *  .file test/oglplus/utf8.cpp
+ *  .brief Test case for the UTF-8 decoding functions.
+ *
+ *  .author Matus Chochlik
+ *
+ *  Copyright 2011-2015 Matus Chochlik. Distributed under the Boost
+ *  Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OGLPLUS_UTF8
+#include <boost/test/unit_test.hpp>
+
+#include <oglplus/gl.hpp>
+#include <oglplus/string/utf8.hpp>
+#include <oglplus/text/unicode.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(UTF8)
+
+using oglplus::text::CodePoint;
+using oglplus::text::CodePoints;
+
+// straightforward decoder of valid UTF-8 used as the reference
+static CodePoints reference_decode(const std::string& str)
+{
+	CodePoints result;
+	std::size_t i = 0;
+	while(i < str.size())
+	{
+		unsigned char b = static_cast<unsigned char>(str[i]);
+		std::size_t len = (b < 0x80)?1:(b < 0xE0)?2:(b < 0xF0)?3:4;
+		CodePoint cp = (len == 1)?b:(b & (0x7F >> len));
+		for(std::size_t k=1; k!=len; ++k)
+			cp = (cp << 6) | (static_cast<unsigned char>(str[i+k]) & 0x3F);
+		result.push_back(cp);
+		i += len;
+	}
+	return result;
+}
+
+static const char* valid_strings[] = {
+	"",
+	"A",
+	"OGLplus",
+	"The quick brown fox jumps over the lazy dog. 0123456789 !@#$%^&*()",
+	"P\xC5\x99\xC3\xAD\x6C\x69\xC5\xA1 \xC5\xBE\x6C\x75\xC5\xA5ou\xC4\x8Dk\xC3\xBD k\xC5\xAF\xC5\x88",
+	"\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE3\x83\x86\xE3\x82\xAD\xE3\x82\xB9\xE3\x83\x88",
+	"emoji \xF0\x9F\x98\x80 and \xF0\x9F\x8C\x8D in an otherwise plain ASCII sentence",
+	"sixteen ascii ch\xC3\xA9rs then more and more and more ascii characters\xE2\x82\xAC"
+};
+
+BOOST_AUTO_TEST_CASE(UTF8_decode_valid)
+{
+	for(const char* cstr : valid_strings)
+	{
+		std::string str(cstr);
+		CodePoints ref = reference_decode(str);
+
+		CodePoints cps = oglplus::text::UTF8ToCodePoints(str.data(), str.size());
+		BOOST_CHECK(cps == ref);
+
+		std::vector<CodePoint> buf(str.size()+1);
+		std::size_t cp_count = 0;
+		std::size_t bytes = oglplus::aux::DecodeUTF8(
+			str.data(), str.size(),
+			buf.data(), buf.size(),
+			cp_count
+		);
+		BOOST_CHECK_EQUAL(bytes, str.size());
+		BOOST_CHECK_EQUAL(cp_count, ref.size());
+		BOOST_CHECK(std::equal(ref.begin(), ref.end(), buf.begin()));
+
+		BOOST_CHECK(oglplus::aux::ValidUTF8(
+			str.data(),
+			str.data()+str.size()
+		));
+
+		std::vector<char> u8 = oglplus::text::CodePointsToUTF8(
+			cps.data(),
+			cps.size()
+		);
+		BOOST_CHECK(std::string(u8.begin(), u8.end()) == str);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(UTF8_decode_boundaries)
+{
+	// the smallest and largest code points of each sequence length
+	const char str[] =
+		"\x7F"
+		"\xC2\x80\xDF\xBF"
+		"\xE0\xA0\x80\xEF\xBF\xBD"
+		"\xF0\x90\x80\x80\xF4\x8F\xBF\xBF";
+	const CodePoint ref[] = {
+		0x7F,
+		0x80, 0x7FF,
+		0x800, 0xFFFD,
+		0x10000, 0x10FFFF
+	};
+	CodePoints cps = oglplus::text::UTF8ToCodePoints(str);
+	BOOST_CHECK_EQUAL(cps.size(), sizeof(ref)/sizeof(ref[0]));
+	BOOST_CHECK(std::equal(cps.begin(), cps.end(), ref));
+}
+
+BOOST_AUTO_TEST_CASE(UTF8_decode_ascii)
+{
+	std::string str;
+	for(std::size_t i=0; i!=100; ++i)
+	{
+		CodePoints cps = oglplus::text::UTF8ToCodePoints(str.data(), str.size());
+		BOOST_CHECK_EQUAL(cps.size(), str.size());
+		for(std::size_t j=0; j!=str.size(); ++j)
+			BOOST_CHECK_EQUAL(cps[j], CodePoint(str[j]));
+		str.push_back(char(' '+i%90));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(UTF8_decode_invalid)
+{
+	struct { const char* str; std::size_t valid; } cases[] = {
+		{"abc\x80" "def", 3},
+		{"abc\xC0\x80", 3},
+		{"abc\xC1\xBF", 3},
+		{"ab\xE0\x80\x80", 2},
+		{"ab\xED\xA0\x80", 2},
+		{"a\xF0\x80\x80\x80", 1},
+		{"a\xF4\x90\x80\x80", 1},
+		{"\xF5\x80\x80\x80", 0},
+		{"\xF8\x88\x80\x80\x80", 0},
+		{"abcd\xE2\x82", 4},
+		{"abcd\xE2\x28\xA1", 4}
+	};
+	for(auto& c : cases)
+	{
+		std::size_t len = std::strlen(c.str);
+		CodePoint buf[16];
+		std::size_t cp_count = 0;
+		std::size_t bytes = oglplus::aux::DecodeUTF8(
+			c.str, len,
+			buf, 16,
+			cp_count
+		);
+		BOOST_CHECK_EQUAL(bytes, c.valid);
+		BOOST_CHECK_EQUAL(cp_count, c.valid);
+
+		std::size_t n = oglplus::text::UTF8ToCodePoints(c.str, len, buf, 16);
+		BOOST_CHECK(n > c.valid);
+		BOOST_CHECK(n <= len);
+		BOOST_CHECK_EQUAL(buf[c.valid], CodePoint(0xFFFD));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(UTF8_decode_truncated_output)
+{
+	std::string str(valid_strings[4]);
+	CodePoints ref = reference_decode(str);
+
+	for(std::size_t max_cps=0; max_cps<=ref.size(); ++max_cps)
+	{
+		CodePoint buf[64];
+		std::size_t n = oglplus::text::UTF8ToCodePoints(
+			str.data(), str.size(),
+			buf, max_cps
+		);
+		BOOST_CHECK_EQUAL(n, max_cps);
+		BOOST_CHECK(std::equal(buf, buf+n, ref.begin()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(UTF8_code_point_buffer)
+{
+	for(const char* cstr : valid_strings)
+	{
+		std::string str(cstr);
+		CodePoints ref = reference_decode(str);
+
+		oglplus::text::CodePointBuffer<8> cps(str.data(), str.size());
+		BOOST_CHECK_EQUAL(cps.Size(), ref.size());
+		BOOST_CHECK(std::equal(ref.begin(), ref.end(), cps.Data()));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
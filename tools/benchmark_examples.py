@@ -0,0 +1,448 @@
+#!/usr/bin/python
+# coding=utf-8
+# Copyright 2015 Matus Chochlik. Distributed under the Boost
+# Software License, Version 1.0. (See accompanying file
+# LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+import os, sys, json
+
+# the columns of the CSV output
+csv_columns = [
+	("example", "example"),
+	("width", "width"),
+	("height", "height"),
+	("frames", "frames"),
+	("cpu_mean_ms", "cpu_ms.mean"),
+	("cpu_p50_ms", "cpu_ms.p50"),
+	("cpu_p90_ms", "cpu_ms.p90"),
+	("cpu_p99_ms", "cpu_ms.p99"),
+	("cpu_max_ms", "cpu_ms.max"),
+	("frame_mean_ms", "frame_ms.mean"),
+	("frame_p50_ms", "frame_ms.p50"),
+	("frame_p90_ms", "frame_ms.p90"),
+	("frame_p99_ms", "frame_ms.p99"),
+	("frame_max_ms", "frame_ms.max"),
+	("allocations_mean", "allocations_per_frame.mean"),
+	("allocations_max", "allocations_per_frame.max"),
+	("gl_calls_mean", "gl_calls_per_frame.mean"),
+	("gl_calls_max", "gl_calls_per_frame.max")
+]
+
+def parse_args(args):
+	import argparse
+	import datetime
+
+	def FrameDimType(arg):
+
+		try: dims = [int(dim) for dim in arg.split('x')]
+		except: dims = list()
+
+		def valid_coord(dim):
+			return isinstance(dim, int) and dim > 0
+
+		if (len(dims) == 2) and all(valid_coord(dim) for dim in dims):
+			return dims
+		else:
+			msg = "'%s' is not a valid frame dimension specification" % str(arg)
+			raise argparse.ArgumentTypeError(msg)
+
+	argparser = argparse.ArgumentParser(
+		prog=os.path.basename(args[0]),
+		description="""
+			Script for benchmarking the OGLplus examples built
+			with the EGL example harness. By default the examples
+			are rendered off-screen by the Mesa software rasterizer
+			so that the benchmark can run on machines without a GPU.
+		""",
+		epilog="""
+			Copyright (c) 2008 - %(year)d Matúš Chochlík.
+			Permission is granted to copy, distribute and/or modify this document
+			under the terms of the Boost Software License, Version 1.0.
+			(See a copy at http://www.boost.org/LICENSE_1_0.txt)
+		""" % { "year": datetime.datetime.now().year }
+	)
+
+	argparser.add_argument(
+		"--build-dir",
+		help="""The name of the build directory""",
+		default="_build",
+		action="store",
+		dest="build_dir"
+	)
+
+	argparser.add_argument(
+		"--size",
+		help="""
+			The dimensions in pixels of the rendered frames,
+			specified as WxH where W and H are positive integers.
+		""",
+		type=FrameDimType,
+		dest="frame_size",
+		action="store",
+		default="320x240"
+	)
+
+	argparser.add_argument(
+		"--frames",
+		help="""The number of measured frames of each example""",
+		type=int,
+		default="100",
+		action="store",
+		dest="frames"
+	)
+
+	argparser.add_argument(
+		"--samples",
+		help="""Number of multisampling samples""",
+		type=int,
+		default="0",
+		action="store",
+		dest="samples"
+	)
+
+	argparser.add_argument(
+		"--timeout",
+		help="""The time in seconds after which an example is killed""",
+		type=int,
+		default="300",
+		action="store",
+		dest="timeout"
+	)
+
+	argparser.add_argument(
+		"--hardware",
+		help="""
+			Do not force the software rasterizer, use the driver
+			selected by the EGL implementation.
+		""",
+		default=False,
+		action="store_true",
+		dest="hardware"
+	)
+
+	argparser.add_argument(
+		"--count-gl-calls",
+		help="""
+			Re-configure the build directory with the
+			OGLPLUS_EXAMPLES_GL_DISPATCH option enabled and re-build
+			the examples, so that the GL calls per frame are counted.
+			The measured times then include the overhead of the counting.
+			By default the examples are benchmarked as they are built.
+		""",
+		default=False,
+		action="store_true",
+		dest="count_gl_calls"
+	)
+
+	argparser.add_argument(
+		"--output",
+		help="""The path of the combined JSON output""",
+		default="benchmark.json",
+		action="store",
+		dest="json_output"
+	)
+
+	argparser.add_argument(
+		"--csv-output",
+		help="""The path of the combined CSV output""",
+		default=None,
+		action="store",
+		dest="csv_output"
+	)
+
+	argparser.add_argument(
+		"--baseline",
+		help="""
+			The JSON output of a previous run. The script fails
+			if any of the compared metrics of an example is worse
+			than in the baseline by more than the threshold.
+		""",
+		default=None,
+		action="store",
+		dest="baseline"
+	)
+
+	argparser.add_argument(
+		"--threshold",
+		help="""
+			The tolerated regression in percent
+			of the baseline value (default 25).
+		""",
+		type=float,
+		default="25",
+		action="store",
+		dest="threshold"
+	)
+
+	argparser.add_argument(
+		"--min-ms",
+		help="""
+			The smallest difference in milliseconds of a compared
+			time metric that is considered to be a regression
+			(default 0.5). Smaller differences are measurement noise.
+		""",
+		type=float,
+		default="0.5",
+		action="store",
+		dest="min_ms"
+	)
+
+	argparser.add_argument(
+		"--metric",
+		help="""
+			The metric compared with the baseline, for example
+			'cpu_ms.p90'. Can be specified multiple times,
+			by default the median frame time and the mean numbers
+			of allocations and of GL calls per frame are compared.
+		""",
+		default=[],
+		action="append",
+		dest="metrics"
+	)
+
+	argparser.add_argument(
+		"examples",
+		help="""
+		List of the names of the examples to benchmark.
+		If none are specified, all examples listed in the examples.txt
+		file in the build directory are benchmarked.
+		""",
+		nargs="*"
+	)
+
+	return argparser.parse_args()
+
+# enables the counting of the GL calls in the build directory
+# and re-builds the examples if it was not enabled yet
+def enable_gl_dispatch(options):
+	import subprocess
+
+	option = "OGLPLUS_EXAMPLES_GL_DISPATCH"
+	cache_path = os.path.join(options.build_dir, "CMakeCache.txt")
+	try:
+		with open(cache_path) as cache_file:
+			for line in cache_file:
+				name, sep, value = line.strip().partition('=')
+				if name.split(':')[0] == option and sep:
+					if value.upper() in ["1", "ON", "TRUE", "YES"]:
+						return
+	except IOError:
+		msg = "Could not read '%s'." % cache_path
+		raise Exception(msg)
+
+	print("Enabling %s in '%s'" % (option, options.build_dir))
+	subprocess.check_call(["cmake", "-D%s=On" % option, options.build_dir])
+	# re-build only the benchmarked examples if they are specified
+	for target in options.examples or ["oglplus-examples"]:
+		subprocess.check_call([
+			"cmake", "--build", options.build_dir,
+			"--target", target
+		])
+
+# returns the directory containing the example executables
+def get_example_dir(options):
+
+	example_dir = os.path.join(options.build_dir, "example", "oglplus")
+
+	if not os.path.isdir(example_dir):
+		msg = "Could not find directory '%s'." % example_dir
+		raise Exception(msg)
+
+	return os.path.abspath(example_dir)
+
+# returns the names of the examples built in the example directory
+def list_examples(example_dir):
+
+	examples = list()
+	with open(os.path.join(example_dir, "examples.txt")) as examples_txt:
+		for line in examples_txt:
+			name = line.strip()
+			if name and os.path.isfile(os.path.join(example_dir, name)):
+				examples.append(name)
+	return examples
+
+# returns the environment in which the examples are run
+def make_environment(options):
+
+	env = dict(os.environ)
+	if not options.hardware:
+		env["LIBGL_ALWAYS_SOFTWARE"] = "1"
+		env["GALLIUM_DRIVER"] = "llvmpipe"
+		env.setdefault("EGL_PLATFORM", "surfaceless")
+	return env
+
+# runs a single example and returns its results
+def run_benchmark(example_dir, example, work_dir, env, options):
+	import subprocess, threading
+
+	output_path = os.path.join(work_dir, "%s.json" % example)
+	cmd_line = [
+		os.path.join(example_dir, example),
+		'--benchmark', output_path,
+		'--frames', str(options.frames),
+		'--width', str(options.width),
+		'--height', str(options.height),
+		'--samples', str(options.samples)
+	]
+
+	proc = subprocess.Popen(
+		cmd_line,
+		cwd=example_dir,
+		env=env,
+		stdin=subprocess.PIPE,
+		stdout=subprocess.PIPE,
+		stderr=subprocess.STDOUT
+	)
+
+	# kill the example if it does not finish in time
+	timer = threading.Timer(options.timeout, proc.kill)
+	timer.start()
+	try: output = proc.communicate()[0]
+	finally: timer.cancel()
+
+	if proc.returncode != 0:
+		if proc.returncode < 0:
+			msg = "killed by signal %d" % -proc.returncode
+		else:
+			msg = "failed with code %d" % proc.returncode
+		output = output.decode("utf-8", "replace").strip()
+		if output: msg += ": " + output.splitlines()[-1]
+		raise RuntimeError(msg)
+
+	with open(output_path) as result_file:
+		return json.load(result_file)
+
+# returns the value of a metric like 'cpu_ms.p50' or None
+def get_metric(result, metric):
+
+	value = result
+	for key in metric.split('.'):
+		if isinstance(value, dict) and key in value:
+			value = value[key]
+		else: return None
+	return value
+
+def write_csv(path, results):
+
+	with open(path, "w") as csv_file:
+		csv_file.write(",".join(col for col, key in csv_columns)+"\n")
+		for result in results:
+			values = list()
+			for col, key in csv_columns:
+				value = get_metric(result, key)
+				values.append("" if value is None else str(value))
+			csv_file.write(",".join(values)+"\n")
+
+# compares the results with the baseline and returns the regressions
+def find_regressions(results, baseline, options):
+
+	# the CPU times of the simple examples are in the order of microseconds
+	# and dominated by noise, the frame times on the software rasterizer
+	# and the numbers of allocations and of GL calls are stable
+	metrics = options.metrics or [
+		"frame_ms.p50",
+		"allocations_per_frame.mean",
+		"gl_calls_per_frame.mean"
+	]
+	base_results = dict(
+		(result["example"], result)
+		for result in baseline.get("results", [])
+	)
+
+	regressions = list()
+	for result in results:
+		base = base_results.get(result["example"])
+		if base is None: continue
+
+		for metric in metrics:
+			value = get_metric(result, metric)
+			base_value = get_metric(base, metric)
+			if value is None or base_value is None: continue
+
+			limit = base_value*(1.0+options.threshold/100.0)
+			if metric.split('.')[0].endswith("_ms"):
+				limit = max(limit, base_value+options.min_ms)
+			if value > limit and value > base_value:
+				regressions.append(
+					"%s: %s is %g, baseline %g" % (
+						result["example"],
+						metric,
+						value,
+						base_value
+					)
+				)
+	return regressions
+
+def main():
+	from shutil import rmtree
+	from tempfile import mkdtemp
+
+	options = parse_args(sys.argv)
+	options.width = options.frame_size[0]
+	options.height= options.frame_size[1]
+
+	if options.count_gl_calls:
+		enable_gl_dispatch(options)
+
+	example_dir = get_example_dir(options)
+	examples = options.examples or list_examples(example_dir)
+	env = make_environment(options)
+
+	results = list()
+	failures = list()
+
+	work_dir = mkdtemp()
+	try:
+		for example in examples:
+			sys.stdout.write("Benchmarking %s ... " % example)
+			sys.stdout.flush()
+			try:
+				result = run_benchmark(
+					example_dir,
+					example,
+					work_dir,
+					env,
+					options
+				)
+				results.append(result)
+				print("%.3f ms (CPU p50)" % result["cpu_ms"]["p50"])
+			except Exception as error:
+				failures.append({"example": example, "error": str(error)})
+				print("Failed (%s)" % str(error))
+	finally: rmtree(work_dir)
+
+	with open(options.json_output, "w") as json_file:
+		json.dump({
+				"frames": options.frames,
+				"width": options.width,
+				"height": options.height,
+				"samples": options.samples,
+				"software": not options.hardware,
+				"results": results,
+				"failures": failures
+			},
+			json_file,
+			indent=1,
+			sort_keys=True
+		)
+
+	if options.csv_output:
+		write_csv(options.csv_output, results)
+
+	status = 0
+	if failures:
+		print("%d of %d examples failed" % (len(failures), len(examples)))
+		status = 1
+
+	if options.baseline:
+		with open(options.baseline) as baseline_file:
+			baseline = json.load(baseline_file)
+		regressions = find_regressions(results, baseline, options)
+		for regression in regressions:
+			print("Regression: %s" % regression)
+		if regressions: status = 1
+
+	sys.exit(status)
+
+# run the main function
+if __name__ == "__main__": main()